@@ -7,13 +7,177 @@
 
 #include <Metal/Metal.hpp>
 
+#include <cstring>
+
 #include "MyAppDelegate.hpp"
+#include "Math/SinCosBenchmark.hpp"
+#include "Renderer/Buffer/DeferredDeletionCheck.hpp"
+#include "Renderer/Buffer/UploadSchedulerCheck.hpp"
+#include "Renderer/Culling/LodBenchmark.hpp"
+#include "Renderer/DynamicResolution/DynamicResolutionCheck.hpp"
+#include "Renderer/Encoding/DrawListBenchmark.hpp"
+#include "Renderer/Encoding/EncoderBenchmark.hpp"
+#include "Renderer/Instances/InstanceBenchmark.hpp"
+#include "Renderer/Instances/InstancePoolCheck.hpp"
+#include "Renderer/Instances/InstanceUpdateCheck.hpp"
+#include "Renderer/Pipeline/ShaderRegistryCheck.hpp"
+#include "Renderer/PointCloud/PointRasterBenchmark.hpp"
+#include "Renderer/PointCloud/PointReprojectionCheck.hpp"
+#include "Renderer/PointCloud/SplatCheck.hpp"
+#include "Renderer/RenderGraph/RenderGraphCheck.hpp"
+#include "Renderer/Scene/EntityWorldCheck.hpp"
+#include "Renderer/Scene/TransformBenchmark.hpp"
+#include "Renderer/Threading/FramePacerCheck.hpp"
 
 int main( int argc, char* argv[] )
 {
+    // Headless, prints the per-instance transform costs from 1K to 1M instances and
+    // the compact encoding round-trip error, fails past CompactInstance's bounds
+    if ( argc > 1 && std::strcmp( argv[ 1 ], "--instance-benchmark" ) == 0 )
+    {
+        return PCR::printInstanceBenchmark( PCR::runInstanceBenchmark( { 1000, 4000, 16000, 64000, 256000, 1000000 } ) ) ? 0 : 1;
+    }
+    
+    // Headless, hierarchy updates for deep, wide and bushy scenes as single nodes move
+    if ( argc > 1 && std::strcmp( argv[ 1 ], "--transform-benchmark" ) == 0 )
+    {
+        return PCR::printTransformBenchmark( PCR::runTransformBenchmark( { 1000, 16000, 256000 } ) ) ? 0 : 1;
+    }
+    
+    // Headless, batched sincos against libm on every path the CPU has, fails past the error bound
+    if ( argc > 1 && std::strcmp( argv[ 1 ], "--sincos-benchmark" ) == 0 )
+    {
+        return PCR::Math::printSinCosBenchmark( PCR::Math::runSinCosBenchmark( 16 * 1024 * 1024 ) ) ? 0 : 1;
+    }
+    
+    // Headless, shader registration, function constant variants and cache hits against a stub compiler
+    if ( argc > 1 && std::strcmp( argv[ 1 ], "--shader-registry-check" ) == 0 )
+    {
+        return PCR::runShaderRegistryChecks() ? 0 : 1;
+    }
+    
+    // Headless, draw lists encoded in parallel into the null backend with 1 to 8 workers and
+    // all cores, fails if a merged stream changes between runs or draws differently from one thread
+    if ( argc > 1 && std::strcmp( argv[ 1 ], "--encoder-benchmark" ) == 0 )
+    {
+        return PCR::printEncoderBenchmark( PCR::runEncoderBenchmark( { 1000, 16000, 256000 }, { 1, 2, 4, 8, 0 } ) ) ? 0 : 1;
+    }
+    
+    // Headless, sorted draw lists over a few state mixes against the null backend: binds
+    // before and after sorting, fails if the order, submission or a rebuild is wrong
+    if ( argc > 1 && std::strcmp( argv[ 1 ], "--draw-list-benchmark" ) == 0 )
+    {
+        return PCR::printDrawListBenchmark( PCR::runDrawListBenchmark( { { 1000, 4, 16, 8 }, { 10000, 4, 16, 8 }, { 10000, 64, 1024, 256 }, { 100000, 4, 16, 8 } } ) ) ? 0 : 1;
+    }
+    
+    // Headless, LOD bucketing of placed instances against expected lists, then indices drawn
+    // per LOD for a 200K-instance field, fails if a list is wrong
+    if ( argc > 1 && std::strcmp( argv[ 1 ], "--lod-benchmark" ) == 0 )
+    {
+        return PCR::runLodBenchmark( 200000 ) ? 0 : 1;
+    }
+    
+    // Headless, upload scheduling against a simulated copy queue: budget, merging, ring
+    // wrap-around, stalls and the bytes that land
+    if ( argc > 1 && std::strcmp( argv[ 1 ], "--upload-check" ) == 0 )
+    {
+        return PCR::runUploadSchedulerChecks() ? 0 : 1;
+    }
+    
+    // Headless, deferred deletion over stub resources: release timing with frames in flight,
+    // completion ordering and completions from another thread
+    if ( argc > 1 && std::strcmp( argv[ 1 ], "--deletion-check" ) == 0 )
+    {
+        return PCR::runDeferredDeletionChecks() ? 0 : 1;
+    }
+    
+    // Headless, frame pacing against a simulated GPU thread: frames ahead and time waited for
+    // each frames-in-flight count, and changing it at runtime
+    if ( argc > 1 && std::strcmp( argv[ 1 ], "--pacing-check" ) == 0 )
+    {
+        return PCR::runFramePacerChecks() ? 0 : 1;
+    }
+    
+    // Headless, the parallel instance update against the serial one for several worker counts,
+    // byte for byte
+    if ( argc > 1 && std::strcmp( argv[ 1 ], "--instance-update-check" ) == 0 )
+    {
+        return PCR::runInstanceUpdateChecks() ? 0 : 1;
+    }
+    
+    // Headless, instance pool slots and handles with an InstanceStore following the moves,
+    // generations and capacity doubling
+    if ( argc > 1 && std::strcmp( argv[ 1 ], "--instance-pool-check" ) == 0 )
+    {
+        return PCR::runInstancePoolChecks() ? 0 : 1;
+    }
+    
+    // Headless, entity storage: swap-remove on destroy, generation handles and the numbering
+    // parallel chunk iteration hands out
+    if ( argc > 1 && std::strcmp( argv[ 1 ], "--entity-check" ) == 0 )
+    {
+        return PCR::runEntityWorldChecks() ? 0 : 1;
+    }
+    
+    // Headless, the dynamic resolution controller against synthetic frame-time traces
+    if ( argc > 1 && std::strcmp( argv[ 1 ], "--resolution-check" ) == 0 )
+    {
+        return PCR::runDynamicResolutionChecks() ? 0 : 1;
+    }
+    
+    // Headless, compiles a small frame graph and checks culling, the wait lists, attachment
+    // actions and heap aliasing, exits non-zero on a failure
+    if ( argc > 1 && std::strcmp( argv[ 1 ], "--render-graph-check" ) == 0 )
+    {
+        return PCR::runRenderGraphChecks() ? 0 : 1;
+    }
+    
+    // Headless, CPU point rasterization by scatter and by binning from 1M to 8M points,
+    // fails if the two framebuffers differ in any pixel
+    if ( argc > 1 && std::strcmp( argv[ 1 ], "--point-raster-benchmark" ) == 0 )
+    {
+        return PCR::printPointRasterBenchmark( PCR::runPointRasterBenchmark( { 1000000, 4000000, 8000000 } ) ) ? 0 : 1;
+    }
+    
+    // Headless, point reprojection against a moving occluder: the disocclusion mask, distinct
+    // points drawn and the node refresh rotation converging on a full render
+    if ( argc > 1 && std::strcmp( argv[ 1 ], "--reprojection-check" ) == 0 )
+    {
+        return PCR::runPointReprojectionChecks() ? 0 : 1;
+    }
+    
+    // Headless, CPU splats: coverage, depth blending, the same image for any point order or
+    // worker count, and the tolerance the GPU splats are validated with
+    if ( argc > 1 && std::strcmp( argv[ 1 ], "--splat-check" ) == 0 )
+    {
+        return PCR::runSplatChecks() ? 0 : 1;
+    }
+    
+    // Windowed, every frame's GPU animation, cull, visibility resolve and splats are read back and
+    // checked against the CPU references across the instance formats, animation paths and render
+    // paths, exits non-zero on a mismatch
+    const bool validateGpu = argc > 1 && std::strcmp( argv[ 1 ], "--validate-gpu" ) == 0;
+    
+    // Windowed, an orbiting generated point cloud drawn with reprojection in place of the cubes,
+    // prints the share of points drawn and of reprojected samples still valid
+    const bool pointCloud = argc > 1 && std::strcmp( argv[ 1 ], "--point-cloud" ) == 0;
+    
+    // Windowed, the same cloud as GPU splats, prints each splat pass's GPU time
+    const bool splats = argc > 1 && std::strcmp( argv[ 1 ], "--splats" ) == 0;
+    
+    PCR::PointCloudMode pointCloudMode = PCR::PointCloudMode::Off;
+    if ( pointCloud )
+    {
+        pointCloudMode = PCR::PointCloudMode::Reprojected;
+    }
+    else if ( splats )
+    {
+        pointCloudMode = PCR::PointCloudMode::Splats;
+    }
+    
     NS::AutoreleasePool* pAutoreleasePool = NS::AutoreleasePool::alloc()->init();
 
-    PCR::MyAppDelegate del;
+    PCR::MyAppDelegate del( validateGpu, pointCloudMode );
 
     NS::Application* pSharedApplication = NS::Application::sharedApplication();
     pSharedApplication->setDelegate( &del );
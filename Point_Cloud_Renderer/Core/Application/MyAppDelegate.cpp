@@ -13,6 +13,12 @@
 
 namespace PCR
 {
+    MyAppDelegate::MyAppDelegate( bool validateGpu, PointCloudMode pointCloudMode )
+    :   _validateGpu{ validateGpu }
+    ,   _pointCloudMode{ pointCloudMode }
+    {
+    }
+
     MyAppDelegate::~MyAppDelegate()
     {
         _pMtkView->release();
@@ -76,12 +82,11 @@ namespace PCR
         _pMtkView = MTK::View::alloc()->init( windowProperties() , _pDevice );
         _pMtkView->setColorPixelFormat( MTL::PixelFormat::PixelFormatBGRA8Unorm_sRGB );
         _pMtkView->setClearColor( MTL::ClearColor::Make( 0.1, 0.1, 0.1, 1.0 ) );
-        _pMtkView->setDepthStencilPixelFormat( MTL::PixelFormat::PixelFormatDepth16Unorm );
         _pMtkView->setClearDepth( 1.0 );
         
         //_pMtkView->setPreferredFramesPerSecond( 1000 );
 	
-        _pViewDelegate = new MyMTKViewDelegate( _pDevice );
+        _pViewDelegate = new MyMTKViewDelegate( _pDevice, _validateGpu, _pointCloudMode );
         _pMtkView->setDelegate( _pViewDelegate );
 
         pWindow->create( _pMtkView );
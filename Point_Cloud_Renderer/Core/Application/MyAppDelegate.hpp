@@ -11,6 +11,8 @@
 
 #include <memory>
 
+#include "Renderer/PointCloud/PointCloudMode.hpp"
+
 namespace PCR
 {
     class Window;
@@ -24,6 +26,9 @@ namespace PCR
     class MyAppDelegate : public NS::ApplicationDelegate
     {
     public:
+        // See MyMTKViewDelegate for validateGpu and pointCloudMode
+        explicit MyAppDelegate( bool validateGpu = false, PointCloudMode pointCloudMode = PointCloudMode::Off );
+        
         ~MyAppDelegate();
 
         NS::Menu* createMenuBar();
@@ -42,6 +47,10 @@ namespace PCR
         MTL::Device* _pDevice;
         
         MyMTKViewDelegate* _pViewDelegate = nullptr;
+        
+        bool _validateGpu;
+        
+        PointCloudMode _pointCloudMode;
     };
 }
 
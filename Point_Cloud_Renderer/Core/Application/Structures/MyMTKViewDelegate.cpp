@@ -7,14 +7,64 @@
 
 #include "MyMTKViewDelegate.hpp"
 
+#include <cstdlib>
+#include <iterator>
+
 #include "Renderer/Renderer.hpp"
 
 namespace PCR
 {
-    MyMTKViewDelegate::MyMTKViewDelegate( MTL::Device* pDevice )
+    namespace
+    {
+        // Four times the default grid, outgrows the pool's first capacity twice
+        constexpr uint32_t VALIDATION_GROWN_DEPTH{ DEFAULT_INSTANCE_DEPTH * 4 };
+        
+        struct ValidationConfiguration
+        {
+            InstanceFormat instanceFormat;
+            
+            bool gpuAnimation;
+            
+            RenderPath renderPath;
+            
+            // Rows and columns stay at their defaults. Switching between depths grows the
+            // instance buffers mid-run and frees slots again on the way back.
+            uint32_t instanceDepth;
+            
+            // Splats are read back and checked against SplatRasterizer, the cubes still go
+            // through the animation and cull passes under them
+            PointCloudMode pointCloudMode;
+        };
+        
+        constexpr ValidationConfiguration VALIDATION_CONFIGURATIONS[]
+        {
+            { InstanceFormat::Compact, true, RenderPath::Forward, DEFAULT_INSTANCE_DEPTH, PointCloudMode::Off },
+            { InstanceFormat::Compact, false, RenderPath::Forward, DEFAULT_INSTANCE_DEPTH, PointCloudMode::Off },
+            { InstanceFormat::Full, true, RenderPath::Forward, VALIDATION_GROWN_DEPTH, PointCloudMode::Off },
+            { InstanceFormat::Full, false, RenderPath::Forward, VALIDATION_GROWN_DEPTH, PointCloudMode::Off },
+            { InstanceFormat::Compact, true, RenderPath::VisibilityBuffer, DEFAULT_INSTANCE_DEPTH, PointCloudMode::Off },
+            { InstanceFormat::Compact, false, RenderPath::VisibilityBuffer, DEFAULT_INSTANCE_DEPTH, PointCloudMode::Off },
+            { InstanceFormat::Full, true, RenderPath::VisibilityBuffer, VALIDATION_GROWN_DEPTH, PointCloudMode::Off },
+            { InstanceFormat::Full, false, RenderPath::VisibilityBuffer, VALIDATION_GROWN_DEPTH, PointCloudMode::Off },
+            { InstanceFormat::Compact, true, RenderPath::Forward, DEFAULT_INSTANCE_DEPTH, PointCloudMode::Splats }
+        };
+        
+        constexpr uint32_t VALIDATION_FRAME_COUNT{ GPU_VALIDATION_FRAMES_PER_CONFIGURATION * std::size( VALIDATION_CONFIGURATIONS ) };
+        
+        // Frames between point cloud reports
+        constexpr uint32_t POINT_CLOUD_REPORT_INTERVAL{ 300 };
+    }
+
+    MyMTKViewDelegate::MyMTKViewDelegate( MTL::Device* pDevice, bool validateGpu, PointCloudMode pointCloudMode )
         : MTK::ViewDelegate()
         , _pRenderer( new Renderer( pDevice ) )
-    { }
+        , _validateGpu( validateGpu )
+        , _validationFrame( 0 )
+        , _frame( 0 )
+    {
+        _pRenderer->setGpuValidation( _validateGpu );
+        _pRenderer->setPointCloudMode( pointCloudMode );
+    }
 
     MyMTKViewDelegate::~MyMTKViewDelegate()
     {
@@ -23,6 +73,69 @@ namespace PCR
 
     void MyMTKViewDelegate::drawInMTKView( MTK::View* pView )
     {
+        if ( _validateGpu )
+        {
+            advanceValidation();
+        }
         _pRenderer->draw( pView );
+        
+        if ( _pRenderer->getPointCloudMode() != PointCloudMode::Off && ++_frame % POINT_CLOUD_REPORT_INTERVAL == 0 )
+        {
+            reportPointCloud();
+        }
+    }
+
+    void MyMTKViewDelegate::advanceValidation()
+    {
+        if ( _validationFrame < VALIDATION_FRAME_COUNT )
+        {
+            if ( _validationFrame % GPU_VALIDATION_FRAMES_PER_CONFIGURATION == 0 )
+            {
+                const ValidationConfiguration& configuration = VALIDATION_CONFIGURATIONS[ _validationFrame / GPU_VALIDATION_FRAMES_PER_CONFIGURATION ];
+                _pRenderer->setInstanceFormat( configuration.instanceFormat );
+                _pRenderer->setInstanceGrid( DEFAULT_INSTANCE_ROWS, DEFAULT_INSTANCE_COLUMNS, configuration.instanceDepth );
+                _pRenderer->setGpuAnimation( configuration.gpuAnimation );
+                _pRenderer->setRenderPath( configuration.renderPath );
+                _pRenderer->setPointCloudMode( configuration.pointCloudMode );
+            }
+            ++_validationFrame;
+            return;
+        }
+        
+        // Every validated frame has been drawn, wait for their readbacks to be compared
+        const GpuValidationStats stats = _pRenderer->getGpuValidationStats();
+        if ( stats.checkedFrames < VALIDATION_FRAME_COUNT )
+        {
+            return;
+        }
+        
+        __builtin_printf( "GPU validation: %u frames checked, %u cull, %u animation, %u visibility resolve and %u splat mismatches\n",
+                          stats.checkedFrames,
+                          stats.cullMismatches,
+                          stats.animationMismatches,
+                          stats.visibilityMismatches,
+                          stats.splatMismatches );
+        std::exit( stats.cullMismatches == 0 && stats.animationMismatches == 0 && stats.visibilityMismatches == 0 && stats.splatMismatches == 0 ? 0 : 1 );
+    }
+
+    void MyMTKViewDelegate::reportPointCloud() const
+    {
+        if ( _pRenderer->getPointCloudMode() == PointCloudMode::Splats )
+        {
+            // One GPU time per splat pass, all three taken inside the frame's command buffer
+            for ( const auto& [ name, timing ] : _pRenderer->getProfiler().getGpuTimings() )
+            {
+                __builtin_printf( "%s: %.3f ms GPU, %.3f ms average\n", name.c_str(), timing.lastMs, timing.averageMs );
+            }
+            return;
+        }
+        
+        const ReprojectionTotals& totals = _pRenderer->getReprojectionTotals();
+        __builtin_printf( "Point cloud: %zu points, %llu frames, %.1f%% of the points drawn, %.1f%% of the reprojected samples valid, %llu full refreshes\n",
+                          _pRenderer->getPointCount(),
+                          static_cast< unsigned long long >( totals.frames ),
+                          100.0f * totals.getDrawnRatio(),
+                          100.0f * totals.getValidRatio(),
+                          static_cast< unsigned long long >( totals.fullRefreshes ) );
     }
 }
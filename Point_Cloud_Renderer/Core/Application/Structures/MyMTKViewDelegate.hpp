@@ -9,6 +9,10 @@
 
 #include <MetalKit/MetalKit.hpp>
 
+#include <cstdint>
+
+#include "Renderer/PointCloud/PointCloudMode.hpp"
+
 // Forward Declerations
 namespace PCR
 {
@@ -20,7 +24,11 @@ namespace PCR
     class MyMTKViewDelegate : public MTK::ViewDelegate
     {
         public:
-            MyMTKViewDelegate( MTL::Device* pDevice );
+            // With validateGpu the renderer checks its GPU passes against the CPU references,
+            // runs through every instance format, animation path, render path and the splats, and
+            // exits with the result. Any pointCloudMode but Off draws a generated cloud and
+            // prints how much of it was reused, or with splats the GPU time of each pass
+            MyMTKViewDelegate( MTL::Device* pDevice, bool validateGpu = false, PointCloudMode pointCloudMode = PointCloudMode::Off );
         
             virtual ~MyMTKViewDelegate() override;
         
@@ -28,5 +36,15 @@ namespace PCR
 
         private:
             Renderer* _pRenderer;
+        
+            bool _validateGpu;
+        
+            uint32_t _validationFrame;
+        
+            uint32_t _frame;
+        
+            void advanceValidation();
+        
+            void reportPointCloud() const;
     };
 }
@@ -20,19 +20,32 @@ namespace MTK                       \
 namespace NS {                      \
     class String;                   \
     class Window;                   \
+    class Error;                    \
 }
 
 #define FD_MTL                      \
 namespace MTL {                     \
     class Device;                   \
     class CommandQueue;             \
+    class CommandBuffer;            \
     class RenderPipelineState;      \
     class Library;                  \
+    class Function;                 \
     class Buffer;                   \
     class DepthStencilState;        \
     class Texture;                  \
     class ComputePipelineState;     \
     class VertexDescriptor;         \
+    class Heap;                     \
+    class Fence;                    \
+    class Event;                    \
+    class RenderCommandEncoder;     \
+    class ComputeCommandEncoder;    \
+    class BlitCommandEncoder;       \
+    class ComputePassDescriptor;    \
+    class BlitPassDescriptor;       \
+    class CounterSampleBuffer;      \
+    class Resource;                 \
 }
 
 #endif  /* Core_hpp */
@@ -8,6 +8,32 @@
 #include <metal_stdlib>
 using namespace metal;
 
+// Compact instances are decoded back into an InstanceData per vertex
+#include "InstanceLayout.h"
+
+// Specialised per pipeline (FUNCTION_CONSTANT_COLOR_MODE on the host), the branches
+// not taken are compiled out instead of being evaluated per vertex
+constant uint colorMode [[ function_constant( 0 ) ]];
+constant uint COLOR_MODE = is_function_constant_defined( colorMode ) ? colorMode : 0;
+
+// Set when instances were culled on the GPU, instance_id then indexes the
+// compacted visible list (FUNCTION_CONSTANT_INSTANCE_INDIRECTION on the host)
+constant bool instanceIndirection [[ function_constant( 1 ) ]];
+constant bool INSTANCE_INDIRECTION = is_function_constant_defined( instanceIndirection ) && instanceIndirection;
+
+// Which LOD the draw renders (FUNCTION_CONSTANT_INSTANCE_LOD on the host), every LOD
+// draws a prefix of the cube's index list: all six faces, the front, right and top
+// faces mirrored towards the camera, or the front face as a camera-facing quad
+constant uint instanceLod [[ function_constant( 3 ) ]];
+constant uint INSTANCE_LOD = is_function_constant_defined( instanceLod ) ? instanceLod : 0;
+
+constant uint INSTANCE_LOD_REDUCED = 1;
+constant uint INSTANCE_LOD_IMPOSTOR = 2;
+
+constant uint COLOR_MODE_INSTANCE = 0;
+constant uint COLOR_MODE_NORMAL = 1;
+constant uint COLOR_MODE_WHITE = 2;
+
 struct v2f
 {
     float4 position [[position]];
@@ -23,13 +49,6 @@ struct VertexData
     float2 texCoord;
 };
 
-struct InstanceData
-{
-    float4x4 transform;
-    float3x3 normalTransform;
-    float4 color;
-};
-
 struct CameraData
 {
     float4x4 perspectiveTransform;
@@ -41,24 +60,69 @@ v2f vertex vertexMain( uint vertexId   [[ vertex_id ]],
                        uint instanceID [[ instance_id ]],
                        device const VertexData*   vertexData   [[ buffer( 0 ) ]],
                        device const InstanceData* instanceData [[ buffer( 1 ) ]],
-                       device const CameraData*   cameraData   [[ buffer( 2 ) ]] )
+                       device const CameraData*   cameraData   [[ buffer( 2 ) ]],
+                       device const uint*         visibleInstances [[ buffer( 3 ), function_constant( instanceIndirection ) ]] )
 {
     v2f o;
 
-    const device VertexData& vd = vertexData[ vertexId ];
-
-    float4 pos = float4( vd.position, 1.0 );
-    pos = instanceData[ instanceID ].transform * pos;
-    pos = cameraData->perspectiveTransform * cameraData->worldTransform * pos;
-    o.position = pos;
+    if ( INSTANCE_INDIRECTION )
+    {
+        instanceID = visibleInstances[ instanceID ];
+    }
 
-    float3 normal = instanceData[ instanceID ].normalTransform * vd.normal;
-    normal = cameraData->worldNormalTransform * normal;
+    const device VertexData& vd = vertexData[ vertexId ];
+    const InstanceData instance = loadInstance( instanceData, instanceID );
+
+    float3 position = vd.position;
+    float3 normal = vd.normal;
+    if ( INSTANCE_LOD == INSTANCE_LOD_REDUCED )
+    {
+        // Flips each of the three faces onto the side of its axis the camera is on, the
+        // camera sits at the origin of view space
+        const float3 toCamera = -( cameraData->worldTransform * instance.transform[ 3 ] ).xyz;
+        const float3 side = float3( dot( toCamera, ( cameraData->worldTransform * instance.transform[ 0 ] ).xyz ),
+                                    dot( toCamera, ( cameraData->worldTransform * instance.transform[ 1 ] ).xyz ),
+                                    dot( toCamera, ( cameraData->worldTransform * instance.transform[ 2 ] ).xyz ) );
+        const float3 mirror = select( float3( -1.0 ), float3( 1.0 ), side >= 0.0 );
+        position *= mirror;
+        normal *= mirror;
+    }
+
+    if ( INSTANCE_LOD == INSTANCE_LOD_IMPOSTOR )
+    {
+        // The front face's corners spread out in view space around the instance's centre,
+        // sqrt( 2 ) times the cube's side is about its average silhouette
+        const float4 center = cameraData->worldTransform * instance.transform[ 3 ];
+        const float size = length( instance.transform[ 0 ].xyz ) * 1.4142136;
+        o.position = cameraData->perspectiveTransform * float4( center.xyz + float3( vd.position.xy * size, 0.0 ), 1.0 );
+        normal = normalize( -center.xyz );
+    }
+    else
+    {
+        float4 pos = float4( position, 1.0 );
+        pos = instance.transform * pos;
+        pos = cameraData->perspectiveTransform * cameraData->worldTransform * pos;
+        o.position = pos;
+
+        normal = instance.normalTransform * normal;
+        normal = cameraData->worldNormalTransform * normal;
+    }
     o.normal = normal;
 
     o.texCoord = vd.texCoord;
 
-    o.color = half3 ( instanceData[ instanceID ].color.rgb );
+    if ( COLOR_MODE == COLOR_MODE_NORMAL )
+    {
+        o.color = half3( normalize( normal ) * 0.5 + 0.5 );
+    }
+    else if ( COLOR_MODE == COLOR_MODE_WHITE )
+    {
+        o.color = half3( 1.0 );
+    }
+    else
+    {
+        o.color = half3 ( instance.color.rgb );
+    }
 
     return o;
 }
@@ -0,0 +1,78 @@
+//
+//  InstanceAnimation_Compute.metal
+//  Point_Cloud_Renderer
+//
+//  Created by Vatsalya Yadav on 10/19/26.
+//
+
+#include <metal_stdlib>
+using namespace metal;
+
+// COMPACT_INSTANCES picks the layout the kernel writes
+#include "InstanceLayout.h"
+
+struct InstanceAnimationUniforms
+{
+    float4 origin;
+    float angle;
+    float scale;
+    uint rows;
+    uint columns;
+    uint depth;
+    uint instanceCount;
+};
+
+// One thread per instance, everything is derived from the index and u.angle so the host
+// uploads nothing per instance. PCR::InstanceAnimation is the CPU version of this kernel.
+// The angles grow without bound, precise:: keeps the trigonometry close to the host's.
+kernel void animate_instances( device InstanceData*                instanceData [[ buffer( 0 ) ]],
+                               constant InstanceAnimationUniforms& u            [[ buffer( 1 ) ]],
+                               uint index [[ thread_position_in_grid ]] )
+{
+    if ( index >= u.instanceCount )
+    {
+        return;
+    }
+
+    // Rows vary fastest, then columns, then depth, as in getInstanceGridCoordinate
+    const float3 cell = float3( index % u.rows, ( index / u.rows ) % u.columns, index / ( u.rows * u.columns ) );
+    const float3 halfGrid = float3( u.rows, u.columns, u.depth ) * 0.5;
+    const float3 offset = ( cell - halfGrid ) * ( 2.0 * u.scale ) + float3( u.scale, u.scale, 0.0 );
+
+    // makeYRotate( -angle / 2 ) on the host, the grid's two turns folded into one
+    const float gridAngle = -0.5 * u.angle;
+    const float gridSin = precise::sin( gridAngle );
+    const float gridCos = precise::cos( gridAngle );
+    const float3 translation = u.origin.xyz + float3( gridCos * offset.x + gridSin * offset.z, offset.y, gridCos * offset.z - gridSin * offset.x );
+
+    // Spin about the instance's own Z, clockwise like makeZRotate
+    const float spinHalfAngle = -0.5 * u.angle * ( precise::sin( cell.x ) + precise::cos( cell.y ) );
+    const float2 spin = float2( precise::sin( spinHalfAngle ), precise::cos( spinHalfAngle ) );
+    const float2 grid = float2( precise::sin( 0.5 * gridAngle ), precise::cos( 0.5 * gridAngle ) );
+
+    // ( 0, grid.x, 0, grid.y ) * ( 0, 0, spin.x, spin.y )
+    const float4 rotation = float4( grid.x * spin.x, grid.x * spin.y, grid.y * spin.x, grid.y * spin.y );
+
+    const float t = float( index ) / float( u.instanceCount );
+    const float4 color = float4( t, 1.0 - t, precise::sin( 2.0 * M_PI_F * t ), 1.0 );
+
+    if ( COMPACT_INSTANCES )
+    {
+        CompactInstanceData compact;
+        compact.translation = packed_float3( translation );
+        compact.scale = u.scale;
+        compact.rotation = uint2( pack_float_to_snorm2x16( rotation.xy ), pack_float_to_snorm2x16( rotation.zw ) );
+        compact.color = pack_float_to_unorm4x8( color );
+        compact.padding = 0;
+        reinterpret_cast< device CompactInstanceData* >( instanceData )[ index ] = compact;
+        return;
+    }
+
+    const float3x3 basis = rotationFromQuaternion( rotation ) * u.scale;
+
+    InstanceData instance;
+    instance.transform = float4x4( float4( basis[ 0 ], 0.0 ), float4( basis[ 1 ], 0.0 ), float4( basis[ 2 ], 0.0 ), float4( translation, 1.0 ) );
+    instance.normalTransform = basis;
+    instance.color = color;
+    instanceData[ index ] = instance;
+}
@@ -0,0 +1,106 @@
+//
+//  InstanceCull_Compute.metal
+//  Point_Cloud_Renderer
+//
+//  Created by Vatsalya Yadav on 10/19/26.
+//
+
+#include <metal_stdlib>
+using namespace metal;
+
+#include "InstanceLayout.h"
+
+struct CullUniforms
+{
+    float4 frustumPlanes[ 6 ];
+    float4 cameraPosition;
+    float lodDistancesSq[ 2 ];
+    float boundingRadiusSq;
+    uint instanceCount;
+    uint lodListCapacity;
+    uint lodCount;
+};
+
+// Full, reduced, impostor
+constant uint INSTANCE_LOD_COUNT = 3;
+
+struct DrawIndexedArguments
+{
+    uint indexCount;
+    atomic_uint instanceCount;
+    uint indexStart;
+    int baseVertex;
+    uint baseInstance;
+};
+
+// Explicit fma everywhere so fast-math has nothing to contract or reorder,
+// PCR::InstanceCulling on the host evaluates exactly the same operations
+static float lengthSq( float3 v )
+{
+    return fma( v.z, v.z, fma( v.y, v.y, v.x * v.x ) );
+}
+
+static float getScaleSq( float4x4 transform )
+{
+    return max( lengthSq( transform[ 0 ].xyz ), max( lengthSq( transform[ 1 ].xyz ), lengthSq( transform[ 2 ].xyz ) ) );
+}
+
+static bool isInstanceVisible( float4x4 transform, float scaleSq, constant CullUniforms& u )
+{
+    const float radiusSq = u.boundingRadiusSq * scaleSq;
+
+    const float4 center = transform[ 3 ];
+    for ( uint i = 0; i < 6; ++i )
+    {
+        const float4 plane = u.frustumPlanes[ i ];
+        const float distance = fma( plane.z, center.z, fma( plane.y, center.y, fma( plane.x, center.x, plane.w ) ) );
+        if ( distance < 0.0 && distance * distance > radiusSq )
+        {
+            return false;
+        }
+    }
+    return true;
+}
+
+// Distance from the camera measured in instance scales, so the switch happens at about
+// the same size on screen whatever the instance's size
+static uint selectLod( float4x4 transform, float scaleSq, constant CullUniforms& u )
+{
+    const float distanceSq = lengthSq( transform[ 3 ].xyz - u.cameraPosition.xyz );
+
+    uint lod = 0;
+    for ( uint i = 0; i + 1 < min( u.lodCount, INSTANCE_LOD_COUNT ); ++i )
+    {
+        if ( distanceSq > u.lodDistancesSq[ i ] * scaleSq )
+        {
+            lod = i + 1;
+        }
+    }
+    return lod;
+}
+
+// One thread per instance. Survivors are appended to their LOD's list in visibleInstances
+// and counted straight into that LOD's indirect draw arguments, which the host resets
+// every frame.
+kernel void cull_instances( device const InstanceData*   instanceData     [[ buffer( 0 ) ]],
+                            constant CullUniforms&       u                [[ buffer( 1 ) ]],
+                            device uint*                 visibleInstances [[ buffer( 2 ) ]],
+                            device DrawIndexedArguments* arguments        [[ buffer( 3 ) ]],
+                            uint index [[ thread_position_in_grid ]] )
+{
+    if ( index >= u.instanceCount )
+    {
+        return;
+    }
+
+    const float4x4 transform = loadInstance( instanceData, index ).transform;
+    const float scaleSq = getScaleSq( transform );
+    if ( !isInstanceVisible( transform, scaleSq, u ) )
+    {
+        return;
+    }
+
+    const uint lod = selectLod( transform, scaleSq, u );
+    const uint slot = atomic_fetch_add_explicit( &arguments[ lod ].instanceCount, 1, memory_order_relaxed );
+    visibleInstances[ lod * u.lodListCapacity + slot ] = index;
+}
@@ -0,0 +1,80 @@
+//
+//  InstanceLayout.h
+//  Point_Cloud_Renderer
+//
+//  Created by Vatsalya Yadav on 10/19/26.
+//
+
+#ifndef InstanceLayout_h
+#define InstanceLayout_h
+
+#include <metal_stdlib>
+using namespace metal;
+
+// Set when instance buffers hold 32-byte CompactInstanceData instead of InstanceData
+// (FUNCTION_CONSTANT_COMPACT_INSTANCES on the host)
+constant bool compactInstances [[ function_constant( 2 ) ]];
+constant bool COMPACT_INSTANCES = is_function_constant_defined( compactInstances ) && compactInstances;
+
+// PCR::InstanceData
+struct InstanceData
+{
+    float4x4 transform;
+    float3x3 normalTransform;
+    float4 color;
+};
+
+// PCR::CompactInstanceData
+struct CompactInstanceData
+{
+    packed_float3 translation;
+    float scale;
+    uint2 rotation;
+    uint color;
+    uint padding;
+};
+
+// Rotation matrix columns of a unit quaternion
+static float3x3 rotationFromQuaternion( float4 q )
+{
+    float3 q2 = q.xyz * 2.0;
+
+    float xx = q.x * q2.x;
+    float yy = q.y * q2.y;
+    float zz = q.z * q2.z;
+    float xy = q.x * q2.y;
+    float xz = q.x * q2.z;
+    float yz = q.y * q2.z;
+    float wx = q.w * q2.x;
+    float wy = q.w * q2.y;
+    float wz = q.w * q2.z;
+
+    return float3x3( float3( 1.0 - ( yy + zz ), xy + wz, xz - wy ),
+                     float3( xy - wz, 1.0 - ( xx + zz ), yz + wx ),
+                     float3( xz + wy, yz - wx, 1.0 - ( xx + yy ) ) );
+}
+
+// Same math as PCR::CompactInstance::decode on the host
+static InstanceData decodeInstance( CompactInstanceData compact )
+{
+    float4 q = normalize( float4( unpack_snorm2x16_to_float( compact.rotation.x ), unpack_snorm2x16_to_float( compact.rotation.y ) ) );
+    float3x3 basis = rotationFromQuaternion( q ) * compact.scale;
+
+    InstanceData instance;
+    instance.transform = float4x4( float4( basis[ 0 ], 0.0 ), float4( basis[ 1 ], 0.0 ), float4( basis[ 2 ], 0.0 ), float4( float3( compact.translation ), 1.0 ) );
+    instance.normalTransform = basis;
+    instance.color = unpack_unorm4x8_to_float( compact.color );
+    return instance;
+}
+
+// Reads either layout, COMPACT_INSTANCES picks which one the buffer holds
+static InstanceData loadInstance( device const InstanceData* instanceData, uint index )
+{
+    if ( COMPACT_INSTANCES )
+    {
+        return decodeInstance( reinterpret_cast< device const CompactInstanceData* >( instanceData )[ index ] );
+    }
+    return instanceData[ index ];
+}
+
+#endif /* InstanceLayout_h */
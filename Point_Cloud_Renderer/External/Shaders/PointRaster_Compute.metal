@@ -0,0 +1,273 @@
+//
+//  PointRaster_Compute.metal
+//  Point_Cloud_Renderer
+//
+//  Created by Vatsalya Yadav on 10/19/26.
+//
+
+#include <metal_stdlib>
+using namespace metal;
+
+constant uint TILE_SIZE = 32;
+constant uint TILE_PIXELS = TILE_SIZE * TILE_SIZE;
+constant uint RESOLVE_THREADS = 256;
+constant uint PREFIX_THREADS = 256;
+constant uint EMPTY_DEPTH = 0xFFFFFFFF;
+
+struct PointData
+{
+    float3 position;
+    uint color;
+};
+
+struct PointRasterUniforms
+{
+    float4x4 viewProjection;
+    uint width;
+    uint height;
+    uint tilesX;
+    uint tileCount;
+    uint pointCount;
+};
+
+struct BinnedPoint
+{
+    uint pointIndex;
+    uint depth;
+    uint localPixel;
+};
+
+static bool projectPoint( float3 position, constant PointRasterUniforms& u, thread uint2& pixel, thread uint& depth )
+{
+    float4 clip = u.viewProjection * float4( position, 1.0 );
+    if ( clip.w <= 0.0 )
+    {
+        return false;
+    }
+
+    float3 ndc = clip.xyz / clip.w;
+    if ( ndc.x < -1.0 || ndc.x >= 1.0 || ndc.y <= -1.0 || ndc.y > 1.0 || ndc.z < 0.0 || ndc.z > 1.0 )
+    {
+        return false;
+    }
+
+    pixel.x = min( uint( ( ndc.x * 0.5 + 0.5 ) * u.width ), u.width - 1 );
+    pixel.y = min( uint( ( 0.5 - ndc.y * 0.5 ) * u.height ), u.height - 1 );
+
+    // Positive floats keep their order when compared as integers
+    depth = as_type< uint >( ndc.z );
+    return true;
+}
+
+// Unbinned path: every point does an atomic min straight into the full-size depth buffer.
+// Points at equal depth leave the lowest index, the tie-break PointRasterizer's packed
+// depth | index values make, so the image doesn't depend on which thread stores last.
+// A point that moves the depth forward drops the index an earlier encode left there.
+
+kernel void point_scatter_depth( device const PointData* points     [[ buffer(0) ]],
+                                 constant PointRasterUniforms& u     [[ buffer(1) ]],
+                                 device atomic_uint* depthBuffer     [[ buffer(2) ]],
+                                 device uint* indexBuffer            [[ buffer(3) ]],
+                                 uint index                          [[ thread_position_in_grid ]] )
+{
+    uint2 pixel;
+    uint depth;
+    if ( index >= u.pointCount || !projectPoint( points[ index ].position, u, pixel, depth ) )
+    {
+        return;
+    }
+
+    uint pixelIndex = pixel.y * u.width + pixel.x;
+    if ( depth < atomic_fetch_min_explicit( &depthBuffer[ pixelIndex ], depth, memory_order_relaxed ) )
+    {
+        indexBuffer[ pixelIndex ] = EMPTY_DEPTH;
+    }
+}
+
+kernel void point_scatter_index( device const PointData* points     [[ buffer(0) ]],
+                                 constant PointRasterUniforms& u     [[ buffer(1) ]],
+                                 device const uint* depthBuffer      [[ buffer(2) ]],
+                                 device atomic_uint* indexBuffer     [[ buffer(3) ]],
+                                 uint index                          [[ thread_position_in_grid ]] )
+{
+    uint2 pixel;
+    uint depth;
+    if ( index >= u.pointCount || !projectPoint( points[ index ].position, u, pixel, depth ) )
+    {
+        return;
+    }
+
+    uint pixelIndex = pixel.y * u.width + pixel.x;
+    if ( depthBuffer[ pixelIndex ] == depth )
+    {
+        atomic_fetch_min_explicit( &indexBuffer[ pixelIndex ], index, memory_order_relaxed );
+    }
+}
+
+// Binned path: count points per tile, prefix sum, scatter into tile order,
+// then resolve each tile in threadgroup memory
+
+kernel void point_bin_count( device const PointData* points     [[ buffer(0) ]],
+                             constant PointRasterUniforms& u     [[ buffer(1) ]],
+                             device atomic_uint* tileCounts      [[ buffer(2) ]],
+                             uint index                          [[ thread_position_in_grid ]] )
+{
+    uint2 pixel;
+    uint depth;
+    if ( index >= u.pointCount || !projectPoint( points[ index ].position, u, pixel, depth ) )
+    {
+        return;
+    }
+
+    uint tile = ( pixel.y / TILE_SIZE ) * u.tilesX + pixel.x / TILE_SIZE;
+    atomic_fetch_add_explicit( &tileCounts[ tile ], 1, memory_order_relaxed );
+}
+
+// Single threadgroup exclusive scan. tileCounts is turned into write cursors in place,
+// tileOffsets keeps tileCount + 1 entries for the resolve pass.
+kernel void point_bin_prefix( constant PointRasterUniforms& u     [[ buffer(1) ]],
+                              device uint* tileCounts             [[ buffer(2) ]],
+                              device uint* tileOffsets            [[ buffer(3) ]],
+                              uint tid                            [[ thread_index_in_threadgroup ]] )
+{
+    threadgroup uint partials[ PREFIX_THREADS ];
+
+    uint perThread = ( u.tileCount + PREFIX_THREADS - 1 ) / PREFIX_THREADS;
+    uint first = min( tid * perThread, u.tileCount );
+    uint last = min( first + perThread, u.tileCount );
+
+    uint sum = 0;
+    for ( uint i = first; i < last; ++i )
+    {
+        sum += tileCounts[ i ];
+    }
+    partials[ tid ] = sum;
+    threadgroup_barrier( mem_flags::mem_threadgroup );
+
+    for ( uint stride = 1; stride < PREFIX_THREADS; stride *= 2 )
+    {
+        uint value = ( tid >= stride ) ? partials[ tid - stride ] : 0;
+        threadgroup_barrier( mem_flags::mem_threadgroup );
+        partials[ tid ] += value;
+        threadgroup_barrier( mem_flags::mem_threadgroup );
+    }
+
+    uint running = partials[ tid ] - sum;
+    for ( uint i = first; i < last; ++i )
+    {
+        uint count = tileCounts[ i ];
+        tileOffsets[ i ] = running;
+        tileCounts[ i ] = running;
+        running += count;
+    }
+
+    if ( tid == PREFIX_THREADS - 1 )
+    {
+        tileOffsets[ u.tileCount ] = partials[ tid ];
+    }
+}
+
+kernel void point_bin_scatter( device const PointData* points     [[ buffer(0) ]],
+                               constant PointRasterUniforms& u     [[ buffer(1) ]],
+                               device atomic_uint* tileCursors     [[ buffer(2) ]],
+                               device BinnedPoint* binnedPoints    [[ buffer(4) ]],
+                               uint index                          [[ thread_position_in_grid ]] )
+{
+    uint2 pixel;
+    uint depth;
+    if ( index >= u.pointCount || !projectPoint( points[ index ].position, u, pixel, depth ) )
+    {
+        return;
+    }
+
+    uint tile = ( pixel.y / TILE_SIZE ) * u.tilesX + pixel.x / TILE_SIZE;
+    uint slot = atomic_fetch_add_explicit( &tileCursors[ tile ], 1, memory_order_relaxed );
+
+    BinnedPoint binned;
+    binned.pointIndex = index;
+    binned.depth = depth;
+    binned.localPixel = ( pixel.y % TILE_SIZE ) * TILE_SIZE + pixel.x % TILE_SIZE;
+    binnedPoints[ slot ] = binned;
+}
+
+kernel void point_tile_resolve( constant PointRasterUniforms& u     [[ buffer(1) ]],
+                                device const uint* tileOffsets      [[ buffer(3) ]],
+                                device const BinnedPoint* binned    [[ buffer(4) ]],
+                                device uint* depthBuffer            [[ buffer(5) ]],
+                                device uint* indexBuffer            [[ buffer(6) ]],
+                                uint tile                           [[ threadgroup_position_in_grid ]],
+                                uint tid                            [[ thread_index_in_threadgroup ]] )
+{
+    threadgroup atomic_uint localDepth[ TILE_PIXELS ];
+    threadgroup atomic_uint localIndex[ TILE_PIXELS ];
+
+    // Uniform across the threadgroup, so returning before the barriers is fine
+    uint first = tileOffsets[ tile ];
+    uint last = tileOffsets[ tile + 1 ];
+    if ( first == last )
+    {
+        return;
+    }
+
+    uint2 origin = uint2( tile % u.tilesX, tile / u.tilesX ) * TILE_SIZE;
+
+    for ( uint i = tid; i < TILE_PIXELS; i += RESOLVE_THREADS )
+    {
+        uint2 pixel = origin + uint2( i % TILE_SIZE, i / TILE_SIZE );
+        bool inside = pixel.x < u.width && pixel.y < u.height;
+        uint pixelIndex = pixel.y * u.width + pixel.x;
+        atomic_store_explicit( &localDepth[ i ], inside ? depthBuffer[ pixelIndex ] : EMPTY_DEPTH, memory_order_relaxed );
+        atomic_store_explicit( &localIndex[ i ], inside ? indexBuffer[ pixelIndex ] : EMPTY_DEPTH, memory_order_relaxed );
+    }
+    threadgroup_barrier( mem_flags::mem_threadgroup );
+
+    for ( uint i = first + tid; i < last; i += RESOLVE_THREADS )
+    {
+        BinnedPoint point = binned[ i ];
+        if ( point.depth < atomic_fetch_min_explicit( &localDepth[ point.localPixel ], point.depth, memory_order_relaxed ) )
+        {
+            atomic_store_explicit( &localIndex[ point.localPixel ], EMPTY_DEPTH, memory_order_relaxed );
+        }
+    }
+    threadgroup_barrier( mem_flags::mem_threadgroup );
+
+    // Lowest index on equal depth, like the scatter path
+    for ( uint i = first + tid; i < last; i += RESOLVE_THREADS )
+    {
+        BinnedPoint point = binned[ i ];
+        if ( atomic_load_explicit( &localDepth[ point.localPixel ], memory_order_relaxed ) == point.depth )
+        {
+            atomic_fetch_min_explicit( &localIndex[ point.localPixel ], point.pointIndex, memory_order_relaxed );
+        }
+    }
+    threadgroup_barrier( mem_flags::mem_threadgroup );
+
+    for ( uint i = tid; i < TILE_PIXELS; i += RESOLVE_THREADS )
+    {
+        uint2 pixel = origin + uint2( i % TILE_SIZE, i / TILE_SIZE );
+        if ( pixel.x < u.width && pixel.y < u.height )
+        {
+            uint pixelIndex = pixel.y * u.width + pixel.x;
+            depthBuffer[ pixelIndex ] = atomic_load_explicit( &localDepth[ i ], memory_order_relaxed );
+            indexBuffer[ pixelIndex ] = atomic_load_explicit( &localIndex[ i ], memory_order_relaxed );
+        }
+    }
+}
+
+// Shared by both paths
+
+kernel void point_resolve_color( device const PointData* points     [[ buffer(0) ]],
+                                 constant PointRasterUniforms& u     [[ buffer(1) ]],
+                                 device const uint* indexBuffer      [[ buffer(6) ]],
+                                 texture2d< half, access::write > target [[ texture(0) ]],
+                                 uint2 pixel                         [[ thread_position_in_grid ]] )
+{
+    if ( pixel.x >= u.width || pixel.y >= u.height )
+    {
+        return;
+    }
+
+    uint pointIndex = indexBuffer[ pixel.y * u.width + pixel.x ];
+    half4 color = ( pointIndex == EMPTY_DEPTH ) ? half4( 0.1, 0.1, 0.1, 1.0 ) : half4( unpack_unorm4x8_to_half( points[ pointIndex ].color ) );
+    target.write( color, pixel );
+}
@@ -0,0 +1,147 @@
+//
+//  Splat_Compute.metal
+//  Point_Cloud_Renderer
+//
+//  Created by Vatsalya Yadav on 10/19/26.
+//
+
+#include <metal_stdlib>
+using namespace metal;
+
+struct PointData
+{
+    float3 position;
+    uint color;
+};
+
+struct SplatUniforms
+{
+    float4x4 viewProjection;
+    uint width;
+    uint height;
+    int radius;
+    float depthEpsilon;
+    uint pointCount;
+};
+
+// Integer weights and sums keep the result independent of the order the atomics land in.
+// SplatRasterizer matches it on the CPU up to the projection's rounding, see there.
+
+static bool projectSplat( float3 position, constant SplatUniforms& u, thread int2& pixel, thread float& viewDepth )
+{
+    float4 clip = u.viewProjection * float4( position, 1.0 );
+    if ( clip.w <= 0.0 )
+    {
+        return false;
+    }
+
+    float3 ndc = clip.xyz / clip.w;
+    if ( ndc.x < -1.0 || ndc.x >= 1.0 || ndc.y <= -1.0 || ndc.y > 1.0 || ndc.z < 0.0 || ndc.z > 1.0 )
+    {
+        return false;
+    }
+
+    pixel.x = min( int( ( ndc.x * 0.5 + 0.5 ) * u.width ), int( u.width ) - 1 );
+    pixel.y = min( int( ( 0.5 - ndc.y * 0.5 ) * u.height ), int( u.height ) - 1 );
+    viewDepth = clip.w;
+    return true;
+}
+
+static uint splatWeight( int dx, int dy, int radius )
+{
+    int outer = ( radius + 1 ) * ( radius + 1 );
+    return uint( ( outer - ( dx * dx + dy * dy ) ) * 255 / outer );
+}
+
+static bool insideSplat( int2 pixel, int dx, int dy, constant SplatUniforms& u )
+{
+    int x = pixel.x + dx;
+    int y = pixel.y + dy;
+    return dx * dx + dy * dy <= u.radius * u.radius + u.radius && x >= 0 && y >= 0 && x < int( u.width ) && y < int( u.height );
+}
+
+kernel void splat_depth( device const PointData* points     [[ buffer(0) ]],
+                         constant SplatUniforms& u           [[ buffer(1) ]],
+                         device atomic_uint* depthBuffer     [[ buffer(2) ]],
+                         uint index                          [[ thread_position_in_grid ]] )
+{
+    int2 pixel;
+    float viewDepth;
+    if ( index >= u.pointCount || !projectSplat( points[ index ].position, u, pixel, viewDepth ) )
+    {
+        return;
+    }
+
+    for ( int dy = -u.radius; dy <= u.radius; ++dy )
+    {
+        for ( int dx = -u.radius; dx <= u.radius; ++dx )
+        {
+            if ( insideSplat( pixel, dx, dy, u ) )
+            {
+                uint pixelIndex = uint( pixel.y + dy ) * u.width + uint( pixel.x + dx );
+                atomic_fetch_min_explicit( &depthBuffer[ pixelIndex ], as_type< uint >( viewDepth ), memory_order_relaxed );
+            }
+        }
+    }
+}
+
+kernel void splat_accumulate( device const PointData* points     [[ buffer(0) ]],
+                              constant SplatUniforms& u           [[ buffer(1) ]],
+                              device const float* depthBuffer     [[ buffer(2) ]],
+                              device atomic_uint* accumulation    [[ buffer(3) ]],
+                              uint index                          [[ thread_position_in_grid ]] )
+{
+    int2 pixel;
+    float viewDepth;
+    if ( index >= u.pointCount || !projectSplat( points[ index ].position, u, pixel, viewDepth ) )
+    {
+        return;
+    }
+
+    uint color = points[ index ].color;
+    uint3 rgb = uint3( color & 0xFF, ( color >> 8 ) & 0xFF, ( color >> 16 ) & 0xFF );
+
+    for ( int dy = -u.radius; dy <= u.radius; ++dy )
+    {
+        for ( int dx = -u.radius; dx <= u.radius; ++dx )
+        {
+            if ( !insideSplat( pixel, dx, dy, u ) )
+            {
+                continue;
+            }
+
+            uint pixelIndex = uint( pixel.y + dy ) * u.width + uint( pixel.x + dx );
+            if ( viewDepth > depthBuffer[ pixelIndex ] + u.depthEpsilon )
+            {
+                continue;
+            }
+
+            uint weight = splatWeight( dx, dy, u.radius );
+            atomic_fetch_add_explicit( &accumulation[ pixelIndex * 4 + 0 ], rgb.r * weight, memory_order_relaxed );
+            atomic_fetch_add_explicit( &accumulation[ pixelIndex * 4 + 1 ], rgb.g * weight, memory_order_relaxed );
+            atomic_fetch_add_explicit( &accumulation[ pixelIndex * 4 + 2 ], rgb.b * weight, memory_order_relaxed );
+            atomic_fetch_add_explicit( &accumulation[ pixelIndex * 4 + 3 ], weight, memory_order_relaxed );
+        }
+    }
+}
+
+kernel void splat_normalize( constant SplatUniforms& u           [[ buffer(1) ]],
+                             device const uint4* accumulation    [[ buffer(3) ]],
+                             texture2d< half, access::write > target [[ texture(0) ]],
+                             uint2 pixel                         [[ thread_position_in_grid ]] )
+{
+    if ( pixel.x >= u.width || pixel.y >= u.height )
+    {
+        return;
+    }
+
+    uint4 sum = accumulation[ pixel.y * u.width + pixel.x ];
+    if ( sum.w == 0 )
+    {
+        target.write( half4( 0.1, 0.1, 0.1, 1.0 ), pixel );
+        return;
+    }
+
+    uint3 rgb = ( sum.rgb + sum.w / 2 ) / sum.w;
+    target.write( half4( half3( rgb ) / 255.0h, 1.0 ), pixel );
+}
@@ -0,0 +1,45 @@
+//
+//  Upscale.metal
+//  Point_Cloud_Renderer
+//
+//  Created by Vatsalya Yadav on 10/19/26.
+//
+
+#include <metal_stdlib>
+using namespace metal;
+
+struct UpscaleUniforms
+{
+    // Rendered region of the source texture, in UV space
+    float2 uvScale;
+    
+    // Last texel center inside that region, keeps the bilinear filter from
+    // reading the stale border outside it
+    float2 uvMax;
+};
+
+struct UpscaleVertexOut
+{
+    float4 position [[position]];
+    float2 texCoord;
+};
+
+// Single triangle covering the screen, no vertex buffer needed
+vertex UpscaleVertexOut upscaleVertex( uint vertexId [[ vertex_id ]] )
+{
+    float2 uv = float2( ( vertexId << 1 ) & 2, vertexId & 2 );
+
+    UpscaleVertexOut o;
+    o.position = float4( uv * float2( 2.0, -2.0 ) + float2( -1.0, 1.0 ), 0.0, 1.0 );
+    o.texCoord = uv;
+    return o;
+}
+
+half4 fragment upscaleFragment( UpscaleVertexOut in [[ stage_in ]],
+                                texture2d< half, access::sample > source [[ texture( 0 ) ]],
+                                constant UpscaleUniforms& uniforms [[ buffer( 0 ) ]] )
+{
+    constexpr sampler s( address::clamp_to_edge, filter::linear );
+    float2 uv = min( in.texCoord * uniforms.uvScale, uniforms.uvMax );
+    return source.sample( s, uv );
+}
@@ -0,0 +1,145 @@
+//
+//  VisibilityBuffer.metal
+//  Point_Cloud_Renderer
+//
+//  Created by Vatsalya Yadav on 10/19/26.
+//
+
+#include <metal_stdlib>
+using namespace metal;
+
+#include "InstanceLayout.h"
+
+constant uint EMPTY_ID = 0xFFFFFFFF;
+
+// Same as in Basic.metal, the ID buffer always stores the real instance index
+constant bool instanceIndirection [[ function_constant( 1 ) ]];
+constant bool INSTANCE_INDIRECTION = is_function_constant_defined( instanceIndirection ) && instanceIndirection;
+
+struct CameraData
+{
+    float4x4 perspectiveTransform;
+    float4x4 worldTransform;
+    float3x3 worldNormalTransform;
+};
+
+struct VisibilityResolveUniforms
+{
+    float2 renderSize;
+};
+
+struct VisibilityVertexOut
+{
+    float4 position [[position]];
+    uint instanceID [[flat]];
+};
+
+struct VisibilityResolveIn
+{
+    float4 position [[position]];
+};
+
+// Raster pass: position only, every covered pixel ends up with instance + primitive ID
+
+vertex VisibilityVertexOut visibilityVertex( uint vertexId   [[ vertex_id ]],
+                                             uint instanceID [[ instance_id ]],
+                                             device const VertexData*   vertexData   [[ buffer( 0 ) ]],
+                                             device const InstanceData* instanceData [[ buffer( 1 ) ]],
+                                             device const CameraData*   cameraData   [[ buffer( 2 ) ]],
+                                             device const uint*         visibleInstances [[ buffer( 3 ), function_constant( instanceIndirection ) ]] )
+{
+    if ( INSTANCE_INDIRECTION )
+    {
+        instanceID = visibleInstances[ instanceID ];
+    }
+
+    float4 pos = float4( vertexData[ vertexId ].position, 1.0 );
+    pos = loadInstance( instanceData, instanceID ).transform * pos;
+
+    VisibilityVertexOut o;
+    o.position = cameraData->perspectiveTransform * cameraData->worldTransform * pos;
+    o.instanceID = instanceID;
+    return o;
+}
+
+fragment uint2 visibilityFragment( VisibilityVertexOut in [[ stage_in ]],
+                                   uint primitiveID [[ primitive_id ]] )
+{
+    return uint2( in.instanceID, primitiveID );
+}
+
+// Resolve pass: one full-screen triangle, shades each visible pixel exactly once
+
+vertex VisibilityResolveIn visibilityResolveVertex( uint vertexId [[ vertex_id ]] )
+{
+    float2 uv = float2( ( vertexId << 1 ) & 2, vertexId & 2 );
+
+    VisibilityResolveIn o;
+    o.position = float4( uv * float2( 2.0, -2.0 ) + float2( -1.0, 1.0 ), 0.0, 1.0 );
+    return o;
+}
+
+// Perspective-correct barycentrics of an NDC position inside a clip-space triangle
+static float3 computeBarycentrics( float4 c0, float4 c1, float4 c2, float2 ndc )
+{
+    float2 s0 = c0.xy / c0.w;
+    float2 e1 = c1.xy / c1.w - s0;
+    float2 e2 = c2.xy / c2.w - s0;
+    float2 d = ndc - s0;
+
+    float invDet = 1.0 / ( e1.x * e2.y - e1.y * e2.x );
+    float l1 = ( d.x * e2.y - d.y * e2.x ) * invDet;
+    float l2 = ( e1.x * d.y - e1.y * d.x ) * invDet;
+
+    float3 b = float3( 1.0 - l1 - l2, l1, l2 ) / float3( c0.w, c1.w, c2.w );
+    return b / ( b.x + b.y + b.z );
+}
+
+half4 fragment visibilityResolveFragment( VisibilityResolveIn in [[ stage_in ]],
+                                          texture2d< uint, access::read > visibility [[ texture( 0 ) ]],
+                                          texture2d< half, access::sample > tex      [[ texture( 1 ) ]],
+                                          device const VertexData*   vertexData      [[ buffer( 0 ) ]],
+                                          device const InstanceData* instanceData    [[ buffer( 1 ) ]],
+                                          device const CameraData*   cameraData      [[ buffer( 2 ) ]],
+                                          device const ushort*       indices         [[ buffer( 3 ) ]],
+                                          constant VisibilityResolveUniforms& u      [[ buffer( 4 ) ]] )
+{
+    uint2 ids = visibility.read( uint2( in.position.xy ) ).xy;
+    if ( ids.x == EMPTY_ID )
+    {
+        discard_fragment();
+    }
+
+    const InstanceData instance = loadInstance( instanceData, ids.x );
+    float4x4 objectToClip = cameraData->perspectiveTransform * cameraData->worldTransform * instance.transform;
+
+    const device VertexData& v0 = vertexData[ indices[ ids.y * 3 + 0 ] ];
+    const device VertexData& v1 = vertexData[ indices[ ids.y * 3 + 1 ] ];
+    const device VertexData& v2 = vertexData[ indices[ ids.y * 3 + 2 ] ];
+
+    float2 ndc = float2( in.position.x / u.renderSize.x * 2.0 - 1.0, 1.0 - in.position.y / u.renderSize.y * 2.0 );
+    float3 b = computeBarycentrics( objectToClip * float4( v0.position, 1.0 ),
+                                    objectToClip * float4( v1.position, 1.0 ),
+                                    objectToClip * float4( v2.position, 1.0 ),
+                                    ndc );
+
+    float3 normal = v0.normal * b.x + v1.normal * b.y + v2.normal * b.z;
+    normal = cameraData->worldNormalTransform * ( instance.normalTransform * normal );
+    float2 texCoord = v0.texCoord * b.x + v1.texCoord * b.y + v2.texCoord * b.z;
+
+    // Same lighting as fragmentMain. Derivatives are meaningless here, sample the top level.
+    constexpr sampler s( address::repeat, filter::linear );
+    half3 texel = tex.sample( s, texCoord, level( 0 ) ).rgb;
+    half3 color = half3( instance.color.rgb );
+
+    float3 L = normalize( float3( 1.0, 1.0, 0.8 ) );
+    float3 N = normalize( normal );
+
+    half NdotL = half( saturate( dot( N, L ) ) );
+
+    half3 ambient = ( color * texel * 0.1 );
+    half3 diffuse = ( color * texel * NdotL );
+    half3 illum = ambient + diffuse;
+
+    return half4( illum, 1.0 );
+}
@@ -0,0 +1,138 @@
+//
+//  FloatLanes.hpp
+//  Point_Cloud_Renderer
+//
+//  Created by Vatsalya Yadav on 10/19/26.
+//
+
+#ifndef FloatLanes_hpp
+#define FloatLanes_hpp
+
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+
+#if defined( __AVX__ ) || defined( __SSE2__ ) || defined( _M_X64 )
+#include <immintrin.h>
+#elif defined( __ARM_NEON )
+#include <arm_neon.h>
+#endif
+
+// The widest float vector the target was compiled for, AVX (8 lanes), SSE or NEON
+// (4 lanes), plain floats otherwise. Kernels written against these few functions
+// run unchanged on Intel and Apple silicon. Loads and stores are unaligned, storeRounded
+// rounds to nearest even like lrintf in the default rounding mode.
+namespace PCR::Math::FloatLanes
+{
+#if defined( __AVX__ )
+    using Register = __m256;
+
+    constexpr size_t WIDTH{ 8 };
+
+    constexpr const char* NAME{ "AVX" };
+
+    inline Register load( const float* p ) { return _mm256_loadu_ps( p ); }
+
+    inline void store( float* p, Register v ) { _mm256_storeu_ps( p, v ); }
+
+    inline Register broadcast( float value ) { return _mm256_set1_ps( value ); }
+
+    inline Register add( Register a, Register b ) { return _mm256_add_ps( a, b ); }
+
+    inline Register sub( Register a, Register b ) { return _mm256_sub_ps( a, b ); }
+
+    inline Register mul( Register a, Register b ) { return _mm256_mul_ps( a, b ); }
+
+#if defined( __FMA__ )
+    inline Register multiplyAdd( Register a, Register b, Register c ) { return _mm256_fmadd_ps( a, b, c ); }
+#else
+    inline Register multiplyAdd( Register a, Register b, Register c ) { return _mm256_add_ps( _mm256_mul_ps( a, b ), c ); }
+#endif
+
+    inline Register min( Register a, Register b ) { return _mm256_min_ps( a, b ); }
+
+    inline Register max( Register a, Register b ) { return _mm256_max_ps( a, b ); }
+
+    inline void storeRounded( int32_t* p, Register v ) { _mm256_storeu_si256( reinterpret_cast< __m256i* >( p ), _mm256_cvtps_epi32( v ) ); }
+#elif defined( __SSE2__ ) || defined( _M_X64 )
+    using Register = __m128;
+
+    constexpr size_t WIDTH{ 4 };
+
+    constexpr const char* NAME{ "SSE" };
+
+    inline Register load( const float* p ) { return _mm_loadu_ps( p ); }
+
+    inline void store( float* p, Register v ) { _mm_storeu_ps( p, v ); }
+
+    inline Register broadcast( float value ) { return _mm_set1_ps( value ); }
+
+    inline Register add( Register a, Register b ) { return _mm_add_ps( a, b ); }
+
+    inline Register sub( Register a, Register b ) { return _mm_sub_ps( a, b ); }
+
+    inline Register mul( Register a, Register b ) { return _mm_mul_ps( a, b ); }
+
+    inline Register multiplyAdd( Register a, Register b, Register c ) { return _mm_add_ps( _mm_mul_ps( a, b ), c ); }
+
+    inline Register min( Register a, Register b ) { return _mm_min_ps( a, b ); }
+
+    inline Register max( Register a, Register b ) { return _mm_max_ps( a, b ); }
+
+    inline void storeRounded( int32_t* p, Register v ) { _mm_storeu_si128( reinterpret_cast< __m128i* >( p ), _mm_cvtps_epi32( v ) ); }
+#elif defined( __ARM_NEON )
+    using Register = float32x4_t;
+
+    constexpr size_t WIDTH{ 4 };
+
+    constexpr const char* NAME{ "NEON" };
+
+    inline Register load( const float* p ) { return vld1q_f32( p ); }
+
+    inline void store( float* p, Register v ) { vst1q_f32( p, v ); }
+
+    inline Register broadcast( float value ) { return vdupq_n_f32( value ); }
+
+    inline Register add( Register a, Register b ) { return vaddq_f32( a, b ); }
+
+    inline Register sub( Register a, Register b ) { return vsubq_f32( a, b ); }
+
+    inline Register mul( Register a, Register b ) { return vmulq_f32( a, b ); }
+
+    inline Register multiplyAdd( Register a, Register b, Register c ) { return vfmaq_f32( c, a, b ); }
+
+    inline Register min( Register a, Register b ) { return vminq_f32( a, b ); }
+
+    inline Register max( Register a, Register b ) { return vmaxq_f32( a, b ); }
+
+    inline void storeRounded( int32_t* p, Register v ) { vst1q_s32( p, vcvtnq_s32_f32( v ) ); }
+#else
+    using Register = float;
+
+    constexpr size_t WIDTH{ 1 };
+
+    constexpr const char* NAME{ "Scalar" };
+
+    inline Register load( const float* p ) { return *p; }
+
+    inline void store( float* p, Register v ) { *p = v; }
+
+    inline Register broadcast( float value ) { return value; }
+
+    inline Register add( Register a, Register b ) { return a + b; }
+
+    inline Register sub( Register a, Register b ) { return a - b; }
+
+    inline Register mul( Register a, Register b ) { return a * b; }
+
+    inline Register multiplyAdd( Register a, Register b, Register c ) { return a * b + c; }
+
+    inline Register min( Register a, Register b ) { return a < b ? a : b; }
+
+    inline Register max( Register a, Register b ) { return a > b ? a : b; }
+
+    inline void storeRounded( int32_t* p, Register v ) { *p = static_cast< int32_t >( lrintf( v ) ); }
+#endif
+}
+
+#endif /* FloatLanes_hpp */
@@ -0,0 +1,282 @@
+//
+//  SinCos.cpp
+//  Point_Cloud_Renderer
+//
+//  Created by Vatsalya Yadav on 10/19/26.
+//
+
+#include "SinCos.hpp"
+
+#include <array>
+#include <cassert>
+
+#if defined( __x86_64__ )
+#include <immintrin.h>
+#elif defined( __ARM_NEON )
+#include <arm_neon.h>
+#endif
+
+namespace PCR::Math
+{
+    namespace
+    {
+        namespace P = SinCosPolynomial;
+        
+        using Kernel = void ( * )( const float*, float*, float*, size_t, float );
+        
+        constexpr std::array< SinCosPath, 4 > PATHS_FASTEST_FIRST{ SinCosPath::Avx2, SinCosPath::Neon, SinCosPath::Sse, SinCosPath::Scalar };
+        
+        // Lanes flagged in mask (bit i for lane i) were out of range, redone one at a time from
+        // the scaled angles, since pSin or pCos may have overwritten the inputs
+        void fixLanes( uint32_t mask, const float* pLaneAngles, float* pSin, float* pCos )
+        {
+            for ( size_t lane = 0; mask != 0; ++lane, mask >>= 1 )
+            {
+                if ( mask & 1 )
+                {
+                    sinCos( pLaneAngles[ lane ], pSin[ lane ], pCos[ lane ] );
+                }
+            }
+        }
+        
+        void sinCosScalar( const float* pAngles, float* pSin, float* pCos, size_t count, float scale )
+        {
+            for ( size_t i = 0; i < count; ++i )
+            {
+                sinCos( scale * pAngles[ i ], pSin[ i ], pCos[ i ] );
+            }
+        }
+
+#if defined( __x86_64__ )
+        void sinCosSse( const float* pAngles, float* pSin, float* pCos, size_t count, float scale )
+        {
+            const __m128 scaleLanes = _mm_set1_ps( scale );
+            const __m128 absMask = _mm_castsi128_ps( _mm_set1_epi32( 0x7fffffff ) );
+            const __m128 maxArgument = _mm_set1_ps( SINCOS_MAX_ARGUMENT );
+            const __m128i one = _mm_set1_epi32( 1 );
+            const __m128i two = _mm_set1_epi32( 2 );
+            
+            size_t i = 0;
+            for ( ; i + 4 <= count; i += 4 )
+            {
+                const __m128 angle = _mm_mul_ps( _mm_loadu_ps( pAngles + i ), scaleLanes );
+                
+                // Rounds to nearest even like rint in the default rounding mode
+                const __m128i q = _mm_cvtps_epi32( _mm_mul_ps( angle, _mm_set1_ps( P::TWO_OVER_PI ) ) );
+                const __m128 quadrant = _mm_cvtepi32_ps( q );
+                
+                __m128 r = _mm_sub_ps( angle, _mm_mul_ps( quadrant, _mm_set1_ps( P::PI_OVER_TWO_HIGH ) ) );
+                r = _mm_sub_ps( r, _mm_mul_ps( quadrant, _mm_set1_ps( P::PI_OVER_TWO_MIDDLE ) ) );
+                r = _mm_sub_ps( r, _mm_mul_ps( quadrant, _mm_set1_ps( P::PI_OVER_TWO_LOW ) ) );
+                const __m128 r2 = _mm_mul_ps( r, r );
+                
+                __m128 sinR = _mm_add_ps( _mm_mul_ps( _mm_set1_ps( P::SIN_2 ), r2 ), _mm_set1_ps( P::SIN_1 ) );
+                sinR = _mm_add_ps( _mm_mul_ps( sinR, r2 ), _mm_set1_ps( P::SIN_0 ) );
+                sinR = _mm_add_ps( r, _mm_mul_ps( _mm_mul_ps( r, r2 ), sinR ) );
+                
+                __m128 cosR = _mm_add_ps( _mm_mul_ps( _mm_set1_ps( P::COS_2 ), r2 ), _mm_set1_ps( P::COS_1 ) );
+                cosR = _mm_add_ps( _mm_mul_ps( cosR, r2 ), _mm_set1_ps( P::COS_0 ) );
+                cosR = _mm_add_ps( _mm_sub_ps( _mm_set1_ps( 1.0f ), _mm_mul_ps( _mm_set1_ps( 0.5f ), r2 ) ), _mm_mul_ps( _mm_mul_ps( r2, r2 ), cosR ) );
+                
+                const __m128 swap = _mm_castsi128_ps( _mm_cmpeq_epi32( _mm_and_si128( q, one ), one ) );
+                const __m128 sinSign = _mm_castsi128_ps( _mm_slli_epi32( _mm_and_si128( q, two ), 30 ) );
+                const __m128 cosSign = _mm_castsi128_ps( _mm_slli_epi32( _mm_and_si128( _mm_add_epi32( q, one ), two ), 30 ) );
+                const __m128 sinValue = _mm_or_ps( _mm_and_ps( swap, cosR ), _mm_andnot_ps( swap, sinR ) );
+                const __m128 cosValue = _mm_or_ps( _mm_and_ps( swap, sinR ), _mm_andnot_ps( swap, cosR ) );
+                _mm_storeu_ps( pSin + i, _mm_xor_ps( sinValue, sinSign ) );
+                _mm_storeu_ps( pCos + i, _mm_xor_ps( cosValue, cosSign ) );
+                
+                // Not less or equal, so NaNs are caught too
+                const auto outOfRange = static_cast< uint32_t >( _mm_movemask_ps( _mm_cmpnle_ps( _mm_and_ps( angle, absMask ), maxArgument ) ) );
+                if ( outOfRange )
+                {
+                    float laneAngles[ 4 ];
+                    _mm_storeu_ps( laneAngles, angle );
+                    fixLanes( outOfRange, laneAngles, pSin + i, pCos + i );
+                }
+            }
+            
+            sinCosScalar( pAngles + i, pSin + i, pCos + i, count - i, scale );
+        }
+        
+        __attribute__(( target( "avx2,fma" ) ))
+        void sinCosAvx2( const float* pAngles, float* pSin, float* pCos, size_t count, float scale )
+        {
+            const __m256 scaleLanes = _mm256_set1_ps( scale );
+            const __m256 absMask = _mm256_castsi256_ps( _mm256_set1_epi32( 0x7fffffff ) );
+            const __m256 maxArgument = _mm256_set1_ps( SINCOS_MAX_ARGUMENT );
+            const __m256i one = _mm256_set1_epi32( 1 );
+            const __m256i two = _mm256_set1_epi32( 2 );
+            
+            size_t i = 0;
+            for ( ; i + 8 <= count; i += 8 )
+            {
+                const __m256 angle = _mm256_mul_ps( _mm256_loadu_ps( pAngles + i ), scaleLanes );
+                
+                const __m256i q = _mm256_cvtps_epi32( _mm256_mul_ps( angle, _mm256_set1_ps( P::TWO_OVER_PI ) ) );
+                const __m256 quadrant = _mm256_cvtepi32_ps( q );
+                
+                __m256 r = _mm256_fnmadd_ps( quadrant, _mm256_set1_ps( P::PI_OVER_TWO_HIGH ), angle );
+                r = _mm256_fnmadd_ps( quadrant, _mm256_set1_ps( P::PI_OVER_TWO_MIDDLE ), r );
+                r = _mm256_fnmadd_ps( quadrant, _mm256_set1_ps( P::PI_OVER_TWO_LOW ), r );
+                const __m256 r2 = _mm256_mul_ps( r, r );
+                
+                __m256 sinR = _mm256_fmadd_ps( _mm256_set1_ps( P::SIN_2 ), r2, _mm256_set1_ps( P::SIN_1 ) );
+                sinR = _mm256_fmadd_ps( sinR, r2, _mm256_set1_ps( P::SIN_0 ) );
+                sinR = _mm256_fmadd_ps( _mm256_mul_ps( r, r2 ), sinR, r );
+                
+                __m256 cosR = _mm256_fmadd_ps( _mm256_set1_ps( P::COS_2 ), r2, _mm256_set1_ps( P::COS_1 ) );
+                cosR = _mm256_fmadd_ps( cosR, r2, _mm256_set1_ps( P::COS_0 ) );
+                cosR = _mm256_fmadd_ps( _mm256_mul_ps( r2, r2 ), cosR, _mm256_fnmadd_ps( _mm256_set1_ps( 0.5f ), r2, _mm256_set1_ps( 1.0f ) ) );
+                
+                const __m256 swap = _mm256_castsi256_ps( _mm256_cmpeq_epi32( _mm256_and_si256( q, one ), one ) );
+                const __m256 sinSign = _mm256_castsi256_ps( _mm256_slli_epi32( _mm256_and_si256( q, two ), 30 ) );
+                const __m256 cosSign = _mm256_castsi256_ps( _mm256_slli_epi32( _mm256_and_si256( _mm256_add_epi32( q, one ), two ), 30 ) );
+                _mm256_storeu_ps( pSin + i, _mm256_xor_ps( _mm256_blendv_ps( sinR, cosR, swap ), sinSign ) );
+                _mm256_storeu_ps( pCos + i, _mm256_xor_ps( _mm256_blendv_ps( cosR, sinR, swap ), cosSign ) );
+                
+                const auto outOfRange = static_cast< uint32_t >( _mm256_movemask_ps( _mm256_cmp_ps( _mm256_and_ps( angle, absMask ), maxArgument, _CMP_NLE_UQ ) ) );
+                if ( outOfRange )
+                {
+                    float laneAngles[ 8 ];
+                    _mm256_storeu_ps( laneAngles, angle );
+                    fixLanes( outOfRange, laneAngles, pSin + i, pCos + i );
+                }
+            }
+            
+            sinCosSse( pAngles + i, pSin + i, pCos + i, count - i, scale );
+        }
+#elif defined( __ARM_NEON )
+        void sinCosNeon( const float* pAngles, float* pSin, float* pCos, size_t count, float scale )
+        {
+            const float32x4_t maxArgument = vdupq_n_f32( SINCOS_MAX_ARGUMENT );
+            const int32x4_t one = vdupq_n_s32( 1 );
+            const int32x4_t two = vdupq_n_s32( 2 );
+            const uint32x4_t laneBits = { 1, 2, 4, 8 };
+            
+            size_t i = 0;
+            for ( ; i + 4 <= count; i += 4 )
+            {
+                const float32x4_t angle = vmulq_n_f32( vld1q_f32( pAngles + i ), scale );
+                
+                const int32x4_t q = vcvtnq_s32_f32( vmulq_n_f32( angle, P::TWO_OVER_PI ) );
+                const float32x4_t quadrant = vcvtq_f32_s32( q );
+                
+                float32x4_t r = vfmsq_f32( angle, quadrant, vdupq_n_f32( P::PI_OVER_TWO_HIGH ) );
+                r = vfmsq_f32( r, quadrant, vdupq_n_f32( P::PI_OVER_TWO_MIDDLE ) );
+                r = vfmsq_f32( r, quadrant, vdupq_n_f32( P::PI_OVER_TWO_LOW ) );
+                const float32x4_t r2 = vmulq_f32( r, r );
+                
+                float32x4_t sinR = vfmaq_f32( vdupq_n_f32( P::SIN_1 ), vdupq_n_f32( P::SIN_2 ), r2 );
+                sinR = vfmaq_f32( vdupq_n_f32( P::SIN_0 ), sinR, r2 );
+                sinR = vfmaq_f32( r, vmulq_f32( r, r2 ), sinR );
+                
+                float32x4_t cosR = vfmaq_f32( vdupq_n_f32( P::COS_1 ), vdupq_n_f32( P::COS_2 ), r2 );
+                cosR = vfmaq_f32( vdupq_n_f32( P::COS_0 ), cosR, r2 );
+                cosR = vfmaq_f32( vfmsq_f32( vdupq_n_f32( 1.0f ), vdupq_n_f32( 0.5f ), r2 ), vmulq_f32( r2, r2 ), cosR );
+                
+                const uint32x4_t swap = vceqq_s32( vandq_s32( q, one ), one );
+                const uint32x4_t sinSign = vreinterpretq_u32_s32( vshlq_n_s32( vandq_s32( q, two ), 30 ) );
+                const uint32x4_t cosSign = vreinterpretq_u32_s32( vshlq_n_s32( vandq_s32( vaddq_s32( q, one ), two ), 30 ) );
+                const uint32x4_t sinValue = vreinterpretq_u32_f32( vbslq_f32( swap, cosR, sinR ) );
+                const uint32x4_t cosValue = vreinterpretq_u32_f32( vbslq_f32( swap, sinR, cosR ) );
+                vst1q_f32( pSin + i, vreinterpretq_f32_u32( veorq_u32( sinValue, sinSign ) ) );
+                vst1q_f32( pCos + i, vreinterpretq_f32_u32( veorq_u32( cosValue, cosSign ) ) );
+                
+                // Not less or equal, so NaNs are caught too
+                const uint32x4_t inRange = vcaleq_f32( angle, maxArgument );
+                const uint32_t outOfRange = vaddvq_u32( vbicq_u32( laneBits, inRange ) );
+                if ( outOfRange )
+                {
+                    float laneAngles[ 4 ];
+                    vst1q_f32( laneAngles, angle );
+                    fixLanes( outOfRange, laneAngles, pSin + i, pCos + i );
+                }
+            }
+            
+            sinCosScalar( pAngles + i, pSin + i, pCos + i, count - i, scale );
+        }
+#endif
+
+        Kernel getKernel( SinCosPath path )
+        {
+            switch ( path )
+            {
+#if defined( __x86_64__ )
+                case SinCosPath::Sse:
+                    return sinCosSse;
+                case SinCosPath::Avx2:
+                    return sinCosAvx2;
+#elif defined( __ARM_NEON )
+                case SinCosPath::Neon:
+                    return sinCosNeon;
+#endif
+                default:
+                    return sinCosScalar;
+            }
+        }
+    }
+
+    SinCosPath getSinCosPath()
+    {
+        static const SinCosPath path = []{
+            for ( SinCosPath candidate : PATHS_FASTEST_FIRST )
+            {
+                if ( isSinCosPathSupported( candidate ) )
+                {
+                    return candidate;
+                }
+            }
+            return SinCosPath::Scalar;
+        }();
+        return path;
+    }
+
+    bool isSinCosPathSupported( SinCosPath path )
+    {
+        switch ( path )
+        {
+            case SinCosPath::Scalar:
+                return true;
+#if defined( __x86_64__ )
+            case SinCosPath::Sse:
+                return true;
+            case SinCosPath::Avx2:
+                return __builtin_cpu_supports( "avx2" ) && __builtin_cpu_supports( "fma" );
+#elif defined( __ARM_NEON )
+            case SinCosPath::Neon:
+                return true;
+#endif
+            default:
+                return false;
+        }
+    }
+
+    const char* getSinCosPathName( SinCosPath path )
+    {
+        switch ( path )
+        {
+            case SinCosPath::Scalar:
+                return "Scalar";
+            case SinCosPath::Sse:
+                return "SSE";
+            case SinCosPath::Avx2:
+                return "AVX2";
+            case SinCosPath::Neon:
+                return "NEON";
+        }
+        return "Unknown";
+    }
+
+    void sinCos( const float* pAngles, float* pSin, float* pCos, size_t count, float scale /* = 1.0f */ )
+    {
+        static const Kernel kernel = getKernel( getSinCosPath() );
+        kernel( pAngles, pSin, pCos, count, scale );
+    }
+
+    void sinCos( SinCosPath path, const float* pAngles, float* pSin, float* pCos, size_t count, float scale /* = 1.0f */ )
+    {
+        assert( isSinCosPathSupported( path ) );
+        getKernel( path )( pAngles, pSin, pCos, count, scale );
+    }
+}
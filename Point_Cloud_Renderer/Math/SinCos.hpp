@@ -0,0 +1,108 @@
+//
+//  SinCos.hpp
+//  Point_Cloud_Renderer
+//
+//  Created by Vatsalya Yadav on 10/19/26.
+//
+
+#ifndef SinCos_hpp
+#define SinCos_hpp
+
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+
+// Sine and cosine together from one range reduction. The angle is reduced by the nearest
+// multiple of pi / 2 in three steps (Cody-Waite), then minimax polynomials of degree 7 and 8
+// on [ -pi / 4, pi / 4 ] give both values and the quadrant picks and signs them. Every path,
+// scalar or vector, stays within SINCOS_MAX_ERROR of the exact values up to
+// SINCOS_MAX_ARGUMENT; larger angles, infinities and NaNs go to sinf and cosf instead.
+namespace PCR::Math
+{
+    // The reduction stays exact while the quadrant fits in 13 bits
+    constexpr float SINCOS_MAX_ARGUMENT{ 8192.0f };
+
+    // Absolute, against double precision over [ -SINCOS_MAX_ARGUMENT, SINCOS_MAX_ARGUMENT ]. The
+    // worst case measured over every float in that range is about 9.4e-8, near 1 ulp of 0.5.
+    constexpr float SINCOS_MAX_ERROR{ 1.5e-7f };
+
+    namespace SinCosPolynomial
+    {
+        constexpr float TWO_OVER_PI{ 0.636619772367581343f };
+        
+        // pi / 2 split so that quadrant * PI_OVER_TWO_HIGH is exact
+        constexpr float PI_OVER_TWO_HIGH{ 1.5703125f };
+        
+        constexpr float PI_OVER_TWO_MIDDLE{ 4.837512969970703125e-4f };
+        
+        constexpr float PI_OVER_TWO_LOW{ 7.54978995489188216e-8f };
+        
+        constexpr float SIN_0{ -1.6666654611e-1f };
+        
+        constexpr float SIN_1{ 8.3321608736e-3f };
+        
+        constexpr float SIN_2{ -1.9515295891e-4f };
+        
+        constexpr float COS_0{ 4.166664568298827e-2f };
+        
+        constexpr float COS_1{ -1.388731625493765e-3f };
+        
+        constexpr float COS_2{ 2.443315711809948e-5f };
+    }
+
+    enum class SinCosPath
+    {
+        Scalar,
+        
+        // 4 lanes, every x86-64 CPU has it
+        Sse,
+        
+        // 8 lanes with fused multiply-add, picked at runtime when the CPU has both
+        Avx2,
+        
+        // 4 lanes with fused multiply-add, every arm64 CPU has it
+        Neon
+    };
+
+    // One angle, what the batched paths do per lane
+    inline void sinCos( float angle, float& outSin, float& outCos )
+    {
+        namespace P = SinCosPolynomial;
+        
+        if ( !( std::fabs( angle ) <= SINCOS_MAX_ARGUMENT ) )
+        {
+            outSin = sinf( angle );
+            outCos = cosf( angle );
+            return;
+        }
+        
+        const float quadrant = std::rint( angle * P::TWO_OVER_PI );
+        const float r = ( ( angle - quadrant * P::PI_OVER_TWO_HIGH ) - quadrant * P::PI_OVER_TWO_MIDDLE ) - quadrant * P::PI_OVER_TWO_LOW;
+        const float r2 = r * r;
+        
+        const float sinR = r + r * r2 * ( ( P::SIN_2 * r2 + P::SIN_1 ) * r2 + P::SIN_0 );
+        const float cosR = 1.0f - 0.5f * r2 + r2 * r2 * ( ( P::COS_2 * r2 + P::COS_1 ) * r2 + P::COS_0 );
+        
+        // Odd quadrants swap the two, quadrants 2 and 3 negate the sine, 1 and 2 the cosine
+        const auto q = static_cast< int32_t >( quadrant );
+        const bool swap = ( q & 1 ) != 0;
+        outSin = ( q & 2 ) ? -( swap ? cosR : sinR ) : ( swap ? cosR : sinR );
+        outCos = ( ( q + 1 ) & 2 ) ? -( swap ? sinR : cosR ) : ( swap ? sinR : cosR );
+    }
+
+    // The fastest path this CPU runs, picked on first use
+    SinCosPath getSinCosPath();
+
+    bool isSinCosPathSupported( SinCosPath path );
+
+    const char* getSinCosPathName( SinCosPath path );
+
+    // pSin[ i ] and pCos[ i ] of scale * pAngles[ i ]. pAngles may be pSin or pCos, otherwise
+    // the arrays mustn't overlap.
+    void sinCos( const float* pAngles, float* pSin, float* pCos, size_t count, float scale = 1.0f );
+
+    // Same on a given path, which has to be supported
+    void sinCos( SinCosPath path, const float* pAngles, float* pSin, float* pCos, size_t count, float scale = 1.0f );
+}
+
+#endif /* SinCos_hpp */
@@ -0,0 +1,192 @@
+//
+//  SinCosBenchmark.cpp
+//  Point_Cloud_Renderer
+//
+//  Created by Vatsalya Yadav on 10/19/26.
+//
+
+#include "SinCosBenchmark.hpp"
+
+#include <algorithm>
+#include <array>
+#include <chrono>
+#include <cmath>
+#include <cstring>
+#include <limits>
+
+namespace PCR::Math
+{
+    namespace
+    {
+        // Three streams of this many floats stay in L1
+        constexpr size_t THROUGHPUT_BLOCK_SIZE{ 2048 };
+        
+        constexpr size_t ANGLES_PER_PATH{ 16 * 1024 * 1024 };
+        
+        // Ulps either side of each multiple of pi / 2, where the reduction cancels the most
+        constexpr int32_t QUADRANT_NEIGHBOURS{ 4 };
+        
+        constexpr std::array< SinCosPath, 4 > PATHS{ SinCosPath::Scalar, SinCosPath::Sse, SinCosPath::Avx2, SinCosPath::Neon };
+        
+        template < typename Function >
+        double measureNsPerAngle( Function&& function )
+        {
+            const size_t iterations = ANGLES_PER_PATH / THROUGHPUT_BLOCK_SIZE;
+            
+            function();
+            
+            const auto start = std::chrono::steady_clock::now();
+            for ( size_t iteration = 0; iteration < iterations; ++iteration )
+            {
+                function();
+            }
+            const double elapsedNs = std::chrono::duration< double, std::nano >( std::chrono::steady_clock::now() - start ).count();
+            return elapsedNs / static_cast< double >( iterations * THROUGHPUT_BLOCK_SIZE );
+        }
+        
+        float nextAfter( float value, int32_t ulps )
+        {
+            int32_t bits;
+            std::memcpy( &bits, &value, sizeof( bits ) );
+            bits += value < 0.0f ? -ulps : ulps;
+            std::memcpy( &value, &bits, sizeof( value ) );
+            return value;
+        }
+        
+        std::vector< float > makeAccuracyAngles( size_t angleCount )
+        {
+            std::vector< float > angles;
+            angles.reserve( angleCount + 2 * ( 2 * QUADRANT_NEIGHBOURS + 1 ) * static_cast< size_t >( SINCOS_MAX_ARGUMENT ) );
+            
+            const double step = 2.0 * SINCOS_MAX_ARGUMENT / static_cast< double >( std::max< size_t >( angleCount, 2 ) - 1 );
+            for ( size_t i = 0; i < angleCount; ++i )
+            {
+                angles.push_back( static_cast< float >( -SINCOS_MAX_ARGUMENT + step * static_cast< double >( i ) ) );
+            }
+            
+            const auto quadrantCount = static_cast< int32_t >( SINCOS_MAX_ARGUMENT / M_PI_2 );
+            for ( int32_t quadrant = -quadrantCount; quadrant <= quadrantCount; ++quadrant )
+            {
+                const auto center = static_cast< float >( quadrant * M_PI_2 );
+                for ( int32_t ulps = -QUADRANT_NEIGHBOURS; ulps <= QUADRANT_NEIGHBOURS; ++ulps )
+                {
+                    angles.push_back( nextAfter( center, ulps ) );
+                }
+            }
+            return angles;
+        }
+        
+        bool matchesLibm( float value, float expected )
+        {
+            return std::isnan( expected ) ? std::isnan( value ) : value == expected;
+        }
+    }
+
+    std::vector< SinCosBenchmarkResult > runSinCosBenchmark( size_t angleCount )
+    {
+        std::vector< SinCosBenchmarkResult > results;
+        
+        const std::vector< float > accuracyAngles = makeAccuracyAngles( angleCount );
+        std::vector< float > sines( accuracyAngles.size() );
+        std::vector< float > cosines( accuracyAngles.size() );
+        
+        // Spins times the angle a few minutes in
+        std::vector< float > throughputAngles( THROUGHPUT_BLOCK_SIZE );
+        for ( size_t i = 0; i < THROUGHPUT_BLOCK_SIZE; ++i )
+        {
+            throughputAngles[ i ] = 20.0f * std::sin( static_cast< float >( i ) );
+        }
+        std::vector< float > throughputSines( THROUGHPUT_BLOCK_SIZE );
+        std::vector< float > throughputCosines( THROUGHPUT_BLOCK_SIZE );
+        
+        const std::array< float, 9 > fallbackAngles{ std::numeric_limits< float >::quiet_NaN(),
+                                                     std::numeric_limits< float >::infinity(),
+                                                     -std::numeric_limits< float >::infinity(),
+                                                     std::numeric_limits< float >::max(),
+                                                     1.0e6f,
+                                                     -1.0e6f,
+                                                     nextAfter( SINCOS_MAX_ARGUMENT, 1 ),
+                                                     -nextAfter( SINCOS_MAX_ARGUMENT, 1 ),
+                                                     123456.78f };
+        
+        SinCosBenchmarkResult libm;
+        libm.ns = measureNsPerAngle( [ & ]{
+            for ( size_t i = 0; i < THROUGHPUT_BLOCK_SIZE; ++i )
+            {
+                throughputSines[ i ] = sinf( throughputAngles[ i ] );
+                throughputCosines[ i ] = cosf( throughputAngles[ i ] );
+            }
+        });
+        for ( size_t i = 0; i < accuracyAngles.size(); ++i )
+        {
+            const double angle = accuracyAngles[ i ];
+            libm.maxSinError = std::max( libm.maxSinError, std::fabs( sinf( accuracyAngles[ i ] ) - std::sin( angle ) ) );
+            libm.maxCosError = std::max( libm.maxCosError, std::fabs( cosf( accuracyAngles[ i ] ) - std::cos( angle ) ) );
+        }
+        results.push_back( libm );
+        
+        for ( SinCosPath path : PATHS )
+        {
+            if ( !isSinCosPathSupported( path ) )
+            {
+                continue;
+            }
+            
+            SinCosBenchmarkResult result;
+            result.name = getSinCosPathName( path );
+            result.ns = measureNsPerAngle( [ & ]{
+                sinCos( path, throughputAngles.data(), throughputSines.data(), throughputCosines.data(), THROUGHPUT_BLOCK_SIZE );
+            });
+            
+            sinCos( path, accuracyAngles.data(), sines.data(), cosines.data(), accuracyAngles.size() );
+            for ( size_t i = 0; i < accuracyAngles.size(); ++i )
+            {
+                const double angle = accuracyAngles[ i ];
+                result.maxSinError = std::max( result.maxSinError, std::fabs( sines[ i ] - std::sin( angle ) ) );
+                result.maxCosError = std::max( result.maxCosError, std::fabs( cosines[ i ] - std::cos( angle ) ) );
+            }
+            
+            // Every lane of a full vector, and the scalar tail, has to fall back
+            std::array< float, fallbackAngles.size() > fallbackSines;
+            std::array< float, fallbackAngles.size() > fallbackCosines;
+            sinCos( path, fallbackAngles.data(), fallbackSines.data(), fallbackCosines.data(), fallbackAngles.size() );
+            for ( size_t i = 0; i < fallbackAngles.size(); ++i )
+            {
+                result.fallbackMatches = result.fallbackMatches
+                                      && matchesLibm( fallbackSines[ i ], sinf( fallbackAngles[ i ] ) )
+                                      && matchesLibm( fallbackCosines[ i ], cosf( fallbackAngles[ i ] ) );
+            }
+            
+            results.push_back( result );
+        }
+        
+        return results;
+    }
+
+    bool printSinCosBenchmark( const std::vector< SinCosBenchmarkResult >& results )
+    {
+        bool passed = true;
+        
+        __builtin_printf( "Batched sincos, default path %s, bound %.2e up to %.0f\n", getSinCosPathName( getSinCosPath() ), SINCOS_MAX_ERROR, SINCOS_MAX_ARGUMENT );
+        __builtin_printf( "%8s %10s %9s %12s %12s %10s\n", "path", "ns/angle", "speedup", "sinError", "cosError", "fallback" );
+        for ( const SinCosBenchmarkResult& result : results )
+        {
+            const bool isLibm = result.name == nullptr;
+            const bool withinBound = isLibm || ( result.maxSinError <= SINCOS_MAX_ERROR && result.maxCosError <= SINCOS_MAX_ERROR );
+            passed = passed && withinBound && result.fallbackMatches;
+            
+            __builtin_printf( "%8s %10.3f %8.1fx %12.2e %12.2e %10s\n",
+                              isLibm ? "libm" : result.name,
+                              result.ns,
+                              results.front().ns / result.ns,
+                              result.maxSinError,
+                              result.maxCosError,
+                              isLibm ? "-" : ( result.fallbackMatches ? "exact" : "MISMATCH" ) );
+            if ( !withinBound )
+            {
+                __builtin_printf( "SinCos: %s is over the error bound\n", result.name );
+            }
+        }
+        return passed;
+    }
+}
@@ -0,0 +1,44 @@
+//
+//  SinCosBenchmark.hpp
+//  Point_Cloud_Renderer
+//
+//  Created by Vatsalya Yadav on 10/19/26.
+//
+
+#ifndef SinCosBenchmark_hpp
+#define SinCosBenchmark_hpp
+
+#include <cstddef>
+#include <vector>
+
+#include "Math/SinCos.hpp"
+
+namespace PCR::Math
+{
+    // One row per path this CPU supports, plus sinf and cosf
+    struct SinCosBenchmarkResult
+    {
+        // Null for libm
+        const char* name = nullptr;
+        
+        // Nanoseconds for one angle's sine and cosine
+        double ns = 0.0;
+        
+        // Absolute, against double precision
+        double maxSinError = 0.0;
+        
+        double maxCosError = 0.0;
+        
+        // Out-of-range angles, infinities and NaNs gave exactly what sinf and cosf give
+        bool fallbackMatches = true;
+    };
+
+    // Accuracy over angleCount angles spread across [ -SINCOS_MAX_ARGUMENT, SINCOS_MAX_ARGUMENT ],
+    // throughput over a block of animation-sized angles
+    std::vector< SinCosBenchmarkResult > runSinCosBenchmark( size_t angleCount );
+
+    // Returns false if a path breaks SINCOS_MAX_ERROR or the fallback
+    bool printSinCosBenchmark( const std::vector< SinCosBenchmarkResult >& results );
+}
+
+#endif /* SinCosBenchmark_hpp */
@@ -10,6 +10,8 @@
 
 #include <simd/simd.h>
 
+#include "SinCos.hpp"
+
 namespace PCR::Math
 {
     static constexpr simd::float4x4 makeIdentity()
@@ -35,27 +37,33 @@ namespace PCR::Math
     
     static simd::float4x4 makeXRotate( float angleRadians )
     {
-        const float a = angleRadians;
+        float s;
+        float c;
+        sinCos( angleRadians, s, c );
         return simd_matrix_from_rows((simd::float4){ 1.0f, 0.0f, 0.0f, 0.0f },
-                                     (simd::float4){ 0.0f, cosf( a ), sinf( a ), 0.0f },
-                                     (simd::float4){ 0.0f, -sinf( a ), cosf( a ), 0.0f },
+                                     (simd::float4){ 0.0f, c, s, 0.0f },
+                                     (simd::float4){ 0.0f, -s, c, 0.0f },
                                      (simd::float4){ 0.0f, 0.0f, 0.0f, 1.0f });
     }
 
     static simd::float4x4 makeYRotate( float angleRadians )
     {
-        const float a = angleRadians;
-        return simd_matrix_from_rows((simd::float4){ cosf( a ), 0.0f, sinf( a ), 0.0f },
+        float s;
+        float c;
+        sinCos( angleRadians, s, c );
+        return simd_matrix_from_rows((simd::float4){ c, 0.0f, s, 0.0f },
                                      (simd::float4){ 0.0f, 1.0f, 0.0f, 0.0f },
-                                     (simd::float4){ -sinf( a ), 0.0f, cosf( a ), 0.0f },
+                                     (simd::float4){ -s, 0.0f, c, 0.0f },
                                      (simd::float4){ 0.0f, 0.0f, 0.0f, 1.0f });
     }
 
     static simd::float4x4 makeZRotate( float angleRadians )
     {
-        const float a = angleRadians;
-        return simd_matrix_from_rows((simd::float4){ cosf( a ), sinf( a ), 0.0f, 0.0f },
-                                     (simd::float4){ -sinf( a ), cosf( a ), 0.0f, 0.0f },
+        float s;
+        float c;
+        sinCos( angleRadians, s, c );
+        return simd_matrix_from_rows((simd::float4){ c, s, 0.0f, 0.0f },
+                                     (simd::float4){ -s, c, 0.0f, 0.0f },
                                      (simd::float4){ 0.0f, 0.0f, 1.0f, 0.0f },
                                      (simd::float4){ 0.0f, 0.0f, 0.0f, 1.0f });
     }
@@ -0,0 +1,193 @@
+//
+//  DeferredDeletionCheck.cpp
+//  Point_Cloud_Renderer
+//
+//  Created by Vatsalya Yadav on 10/19/26.
+//
+
+#include "DeferredDeletionCheck.hpp"
+
+#include <atomic>
+#include <thread>
+#include <vector>
+
+#include "Renderer/Buffer/DeferredDeletionQueue.hpp"
+#include "Renderer/Validation/CheckReport.hpp"
+
+namespace PCR
+{
+    namespace
+    {
+        constexpr uint64_t FRAMES_IN_FLIGHT{ 3 };
+        
+        constexpr uint64_t FRAME_COUNT{ 64 };
+        
+        // Stands in for an MTL::Resource, retire() only needs release()
+        struct StubResource
+        {
+            const DeferredDeletionQueue* pQueue = nullptr;
+            
+            uint64_t lastUsedFrame = 0;
+            
+            uint32_t releaseCount = 0;
+            
+            // Frame the render loop was on when it went
+            uint64_t releasedAtFrame = 0;
+            
+            // Released before the completion handler reported its frame
+            bool releasedEarly = false;
+            
+            static uint64_t currentFrame;
+            
+            void release()
+            {
+                ++releaseCount;
+                releasedAtFrame = currentFrame;
+                releasedEarly = releasedEarly || pQueue->getCompletedFrame() < lastUsedFrame;
+            }
+        };
+        
+        uint64_t StubResource::currentFrame = 0;
+        
+        bool releasedOnceInTime( const std::vector< StubResource >& resources )
+        {
+            for ( const StubResource& resource : resources )
+            {
+                if ( resource.releaseCount != 1 || resource.releasedEarly )
+                {
+                    return false;
+                }
+            }
+            return true;
+        }
+        
+        void checkRenderLoop( CheckReport& report )
+        {
+            std::vector< StubResource > resources( FRAME_COUNT );
+            bool exactlyLate = true;
+            bool batchedPerFrame = true;
+            {
+                DeferredDeletionQueue queue;
+                
+                // Frame indices start at 1, like FramePacer's
+                for ( uint64_t frame = 1; frame <= FRAME_COUNT; ++frame )
+                {
+                    // The pacer has let frame - FRAMES_IN_FLIGHT finish before this one starts
+                    StubResource::currentFrame = frame;
+                    if ( frame > FRAMES_IN_FLIGHT )
+                    {
+                        queue.markFrameCompleted( frame - FRAMES_IN_FLIGHT );
+                    }
+                    queue.collect();
+                    batchedPerFrame = batchedPerFrame && queue.getStats().releasedLastCollect == ( frame > FRAMES_IN_FLIGHT ? 1 : 0 );
+                    
+                    StubResource& resource = resources[ frame - 1 ];
+                    resource.pQueue = &queue;
+                    resource.lastUsedFrame = frame;
+                    queue.retire( &resource, frame );
+                }
+                
+                for ( uint64_t frame = 1; frame + FRAMES_IN_FLIGHT <= FRAME_COUNT; ++frame )
+                {
+                    exactlyLate = exactlyLate && resources[ frame - 1 ].releasedAtFrame == frame + FRAMES_IN_FLIGHT;
+                }
+                report.expect( queue.getStats().pendingCount == FRAMES_IN_FLIGHT, "render loop: the last three frames' resources are still held" );
+                
+                // The destructor releases the rest, as at shutdown once the GPU is idle
+                StubResource::currentFrame = FRAME_COUNT + 1;
+                queue.markFrameCompleted( FRAME_COUNT );
+            }
+            report.expect( exactlyLate, "render loop: each resource went exactly three frames after it was retired" );
+            report.expect( batchedPerFrame, "render loop: one batch released per collect" );
+            report.expect( releasedOnceInTime( resources ), "render loop: every resource released once, never before its frame completed" );
+        }
+        
+        void checkCompletionOrder( CheckReport& report )
+        {
+            std::vector< StubResource > resources( 3 );
+            DeferredDeletionQueue queue;
+            for ( StubResource& resource : resources )
+            {
+                resource.pQueue = &queue;
+            }
+            
+            // Retired for frame 10, then one last used in frame 7 joins that batch
+            resources[ 0 ].lastUsedFrame = 10;
+            resources[ 1 ].lastUsedFrame = 10;
+            queue.retire( &resources[ 0 ], 10 );
+            queue.retire( &resources[ 1 ], 7 );
+            queue.retire< StubResource >( nullptr, 10 );
+            report.expect( queue.getStats().pendingCount == 2, "ordering: null retirements are ignored" );
+            
+            queue.collect();
+            report.expect( resources[ 0 ].releaseCount == 0, "ordering: nothing goes before any frame completes" );
+            
+            queue.markFrameCompleted( 7 );
+            queue.collect();
+            report.expect( resources[ 1 ].releaseCount == 0, "ordering: an older frame joins the newest batch and waits for it" );
+            
+            queue.markFrameCompleted( 12 );
+            queue.markFrameCompleted( 9 );
+            report.expect( queue.getCompletedFrame() == 12, "ordering: a stale completion mark doesn't move the watermark back" );
+            
+            queue.collect();
+            report.expect( resources[ 0 ].releaseCount == 1 && resources[ 1 ].releaseCount == 1 && queue.getStats().pendingCount == 0,
+                           "ordering: both go once frame 10 has completed" );
+            
+            resources[ 2 ].lastUsedFrame = 20;
+            queue.retire( &resources[ 2 ], 20 );
+            queue.releaseAll();
+            report.expect( resources[ 2 ].releaseCount == 1 && queue.getStats().releasedTotal == 3, "ordering: releaseAll empties the queue" );
+        }
+        
+        void checkCompletionThread( CheckReport& report )
+        {
+            std::vector< StubResource > resources( FRAME_COUNT * 16 );
+            {
+                DeferredDeletionQueue queue;
+                std::atomic< uint64_t > submittedFrame{ 0 };
+                
+                // Reports frames as they're submitted, racing the render thread's collects
+                std::thread completionThread( [ & ]{
+                    for ( uint64_t completed = 0; completed < FRAME_COUNT; )
+                    {
+                        const uint64_t submitted = submittedFrame.load( std::memory_order_acquire );
+                        while ( completed < submitted )
+                        {
+                            queue.markFrameCompleted( ++completed );
+                        }
+                        std::this_thread::yield();
+                    }
+                });
+                
+                size_t next = 0;
+                for ( uint64_t frame = 1; frame <= FRAME_COUNT; ++frame )
+                {
+                    StubResource::currentFrame = frame;
+                    queue.collect();
+                    for ( size_t i = 0; i < 16; ++i, ++next )
+                    {
+                        resources[ next ].pQueue = &queue;
+                        resources[ next ].lastUsedFrame = frame;
+                        queue.retire( &resources[ next ], frame );
+                    }
+                    submittedFrame.store( frame, std::memory_order_release );
+                }
+                
+                completionThread.join();
+                queue.collect();
+                report.expect( queue.getStats().pendingCount == 0, "completion thread: everything is released once every frame completed" );
+            }
+            report.expect( releasedOnceInTime( resources ), "completion thread: every resource released once, never before its frame completed" );
+        }
+    }
+
+    bool runDeferredDeletionChecks()
+    {
+        CheckReport report( "Deferred deletion, stub resources" );
+        checkRenderLoop( report );
+        checkCompletionOrder( report );
+        checkCompletionThread( report );
+        return report.finish();
+    }
+}
@@ -0,0 +1,21 @@
+//
+//  DeferredDeletionCheck.hpp
+//  Point_Cloud_Renderer
+//
+//  Created by Vatsalya Yadav on 10/19/26.
+//
+
+#ifndef DeferredDeletionCheck_hpp
+#define DeferredDeletionCheck_hpp
+
+namespace PCR
+{
+    // DeferredDeletionQueue over stub resources that record when they're released: a render
+    // loop with three frames in flight releases each one exactly three frames after it was
+    // retired, late or stale completion marks change nothing, and every resource is released
+    // exactly once, including with completions reported from another thread.
+    // Returns false if any check fails.
+    bool runDeferredDeletionChecks();
+}
+
+#endif /* DeferredDeletionCheck_hpp */
@@ -0,0 +1,92 @@
+//
+//  DeferredDeletionQueue.cpp
+//  Point_Cloud_Renderer
+//
+//  Created by Vatsalya Yadav on 10/19/26.
+//
+
+#include "DeferredDeletionQueue.hpp"
+
+namespace PCR
+{
+    DeferredDeletionQueue::DeferredDeletionQueue()
+    :   _completedFrame{ 0 }
+    ,   _pendingCount{ 0 }
+    ,   _releasedLastCollect{ 0 }
+    ,   _releasedTotal{ 0 }
+    {
+    }
+
+    DeferredDeletionQueue::~DeferredDeletionQueue()
+    {
+        releaseAll();
+    }
+
+    void DeferredDeletionQueue::retire( void* pObject, ReleaseFunction release, uint64_t lastUsedFrame )
+    {
+        if ( !pObject )
+        {
+            return;
+        }
+        
+        // Tagging with the newest batch's frame is conservative, it only ever delays the release
+        if ( _batches.empty() || _batches.back().frameIndex < lastUsedFrame )
+        {
+            _batches.push_back( Batch{ lastUsedFrame, {} } );
+        }
+        
+        _batches.back().objects.push_back( RetiredObject{ pObject, release } );
+        ++_pendingCount;
+    }
+
+    void DeferredDeletionQueue::markFrameCompleted( uint64_t frameIndex )
+    {
+        uint64_t completed = _completedFrame.load( std::memory_order_relaxed );
+        while ( frameIndex > completed && !_completedFrame.compare_exchange_weak( completed, frameIndex, std::memory_order_release, std::memory_order_relaxed ) )
+        { }
+    }
+
+    void DeferredDeletionQueue::collect()
+    {
+        const uint64_t completedFrame = _completedFrame.load( std::memory_order_acquire );
+        
+        _releasedLastCollect = 0;
+        while ( !_batches.empty() && _batches.front().frameIndex <= completedFrame )
+        {
+            releaseBatch( _batches.front() );
+            _batches.pop_front();
+        }
+    }
+
+    void DeferredDeletionQueue::releaseAll()
+    {
+        _releasedLastCollect = 0;
+        for ( Batch& batch : _batches )
+        {
+            releaseBatch( batch );
+        }
+        _batches.clear();
+    }
+
+    uint64_t DeferredDeletionQueue::getCompletedFrame() const
+    {
+        return _completedFrame.load( std::memory_order_acquire );
+    }
+
+    DeferredDeletionStats DeferredDeletionQueue::getStats() const
+    {
+        return DeferredDeletionStats{ _pendingCount, _releasedLastCollect, _releasedTotal };
+    }
+
+    void DeferredDeletionQueue::releaseBatch( Batch& batch )
+    {
+        for ( const RetiredObject& object : batch.objects )
+        {
+            object.release( object.pObject );
+        }
+        
+        _pendingCount -= batch.objects.size();
+        _releasedLastCollect += batch.objects.size();
+        _releasedTotal += batch.objects.size();
+    }
+}
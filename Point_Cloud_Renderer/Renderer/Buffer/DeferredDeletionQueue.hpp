@@ -0,0 +1,97 @@
+//
+//  DeferredDeletionQueue.hpp
+//  Point_Cloud_Renderer
+//
+//  Created by Vatsalya Yadav on 10/19/26.
+//
+
+#ifndef DeferredDeletionQueue_hpp
+#define DeferredDeletionQueue_hpp
+
+#include <atomic>
+#include <cstdint>
+#include <deque>
+#include <vector>
+
+namespace PCR
+{
+    struct DeferredDeletionStats
+    {
+        size_t pendingCount = 0;
+        
+        size_t releasedLastCollect = 0;
+        
+        size_t releasedTotal = 0;
+    };
+
+    // Holds on to resources that were retired while frames using them may still be in
+    // flight. Each one is tagged with the last frame that used it and released, batched
+    // per frame, once the completion handler has reported that frame done. Nothing ever
+    // waits on the GPU. Not thread-safe apart from markFrameCompleted.
+    class DeferredDeletionQueue
+    {
+    public:
+        using ReleaseFunction = void (*)( void* pObject );
+        
+        DeferredDeletionQueue();
+        
+        ~DeferredDeletionQueue();
+        
+        DeferredDeletionQueue( const DeferredDeletionQueue& ) = delete;
+        
+        DeferredDeletionQueue& operator=( const DeferredDeletionQueue& ) = delete;
+        
+        void retire( void* pObject, ReleaseFunction release, uint64_t lastUsedFrame );
+        
+        // Anything with release(), MTL::Buffer, MTL::Texture, ...
+        template < typename T >
+        void retire( T* pResource, uint64_t lastUsedFrame )
+        {
+            retire( pResource, []( void* pObject ){ static_cast< T* >( pObject )->release(); }, lastUsedFrame );
+        }
+        
+        // Called from command buffer completion handlers, frames complete in order
+        void markFrameCompleted( uint64_t frameIndex );
+        
+        // Releases every batch whose frame has completed, once per frame on the render thread
+        void collect();
+        
+        // Shutdown only, the caller has to know the GPU is idle
+        void releaseAll();
+        
+        uint64_t getCompletedFrame() const;
+        
+        DeferredDeletionStats getStats() const;
+
+    private:
+        struct RetiredObject
+        {
+            void* pObject;
+            
+            ReleaseFunction release;
+        };
+        
+        struct Batch
+        {
+            uint64_t frameIndex;
+            
+            std::vector< RetiredObject > objects;
+        };
+        
+        // Ordered by frame, retirements for older frames join the newest batch
+        std::deque< Batch > _batches;
+        
+        // Frame indices start at 1, 0 means nothing has completed yet
+        std::atomic< uint64_t > _completedFrame;
+        
+        size_t _pendingCount;
+        
+        size_t _releasedLastCollect;
+        
+        size_t _releasedTotal;
+        
+        void releaseBatch( Batch& batch );
+    };
+}
+
+#endif /* DeferredDeletionQueue_hpp */
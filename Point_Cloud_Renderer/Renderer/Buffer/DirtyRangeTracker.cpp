@@ -0,0 +1,106 @@
+//
+//  DirtyRangeTracker.cpp
+//  Point_Cloud_Renderer
+//
+//  Created by Vatsalya Yadav on 10/19/26.
+//
+
+#include "DirtyRangeTracker.hpp"
+
+#include <algorithm>
+#include <cassert>
+
+namespace PCR
+{
+    namespace
+    {
+        // Scattered single-element marks are merged once a copy owes this many ranges
+        constexpr size_t COALESCE_THRESHOLD{ 256 };
+    }
+
+    void coalesceRanges( std::vector< DirtyRange >& ranges, size_t mergeGap /* = 0 */ )
+    {
+        if ( ranges.size() < 2 )
+        {
+            return;
+        }
+        
+        std::sort( ranges.begin(), ranges.end(), []( const DirtyRange& a, const DirtyRange& b ){
+            return a.begin < b.begin;
+        });
+        
+        size_t last = 0;
+        for ( size_t i = 1; i < ranges.size(); ++i )
+        {
+            if ( ranges[ i ].begin <= ranges[ last ].end + mergeGap )
+            {
+                ranges[ last ].end = std::max( ranges[ last ].end, ranges[ i ].end );
+            }
+            else
+            {
+                ranges[ ++last ] = ranges[ i ];
+            }
+        }
+        ranges.resize( last + 1 );
+    }
+
+    void appendRange( std::vector< DirtyRange >& ranges, size_t begin, size_t end )
+    {
+        if ( begin >= end )
+        {
+            return;
+        }
+        
+        if ( !ranges.empty() && begin <= ranges.back().end && end >= ranges.back().begin )
+        {
+            ranges.back().begin = std::min( ranges.back().begin, begin );
+            ranges.back().end = std::max( ranges.back().end, end );
+            return;
+        }
+        
+        ranges.push_back( DirtyRange{ begin, end } );
+    }
+
+    DirtyRangeTracker::DirtyRangeTracker( uint32_t copyCount /* = MAX_FRAMES_IN_FLIGHT */ )
+    :   _pendingRanges( copyCount )
+    {
+        assert( copyCount > 0 );
+    }
+
+    void DirtyRangeTracker::markDirty( size_t begin, size_t end )
+    {
+        for ( std::vector< DirtyRange >& ranges : _pendingRanges )
+        {
+            appendRange( ranges, begin, end );
+            // Only at powers of two, so marks that never merge stay cheap on average
+            const size_t rangeCount = ranges.size();
+            if ( rangeCount >= COALESCE_THRESHOLD && ( rangeCount & ( rangeCount - 1 ) ) == 0 )
+            {
+                coalesceRanges( ranges );
+            }
+        }
+    }
+
+    void DirtyRangeTracker::markDirtyCopy( uint32_t copyIndex, size_t begin, size_t end )
+    {
+        appendRange( _pendingRanges[ copyIndex ], begin, end );
+    }
+
+    std::vector< DirtyRange > DirtyRangeTracker::takeRanges( uint32_t copyIndex )
+    {
+        std::vector< DirtyRange > ranges;
+        ranges.swap( _pendingRanges[ copyIndex ] );
+        coalesceRanges( ranges );
+        return ranges;
+    }
+
+    bool DirtyRangeTracker::isClean( uint32_t copyIndex ) const
+    {
+        return _pendingRanges[ copyIndex ].empty();
+    }
+
+    uint32_t DirtyRangeTracker::getCopyCount() const
+    {
+        return static_cast< uint32_t >( _pendingRanges.size() );
+    }
+}
@@ -0,0 +1,58 @@
+//
+//  DirtyRangeTracker.hpp
+//  Point_Cloud_Renderer
+//
+//  Created by Vatsalya Yadav on 10/19/26.
+//
+
+#ifndef DirtyRangeTracker_hpp
+#define DirtyRangeTracker_hpp
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+#include "Renderer/Data/Constants.hpp"
+
+namespace PCR
+{
+    // [ begin, end ), in whatever unit the owner counts in
+    struct DirtyRange
+    {
+        size_t begin = 0;
+        
+        size_t end = 0;
+    };
+
+    // Sorts the ranges and merges the ones that overlap, touch or are less than mergeGap apart
+    void coalesceRanges( std::vector< DirtyRange >& ranges, size_t mergeGap = 0 );
+
+    // Appends [ begin, end ), extending the last range instead when the two touch
+    void appendRange( std::vector< DirtyRange >& ranges, size_t begin, size_t end );
+
+    // Dirty ranges of a buffer kept once per frame in flight. A range marked dirty is
+    // owed to every copy and is handed out once per copy, when that copy is next
+    // written, so a change made once reaches all copies without rewriting the rest.
+    class DirtyRangeTracker
+    {
+    public:
+        explicit DirtyRangeTracker( uint32_t copyCount = MAX_FRAMES_IN_FLIGHT );
+        
+        void markDirty( size_t begin, size_t end );
+        
+        // Just one copy, e.g. to hand back a range it couldn't write yet
+        void markDirtyCopy( uint32_t copyIndex, size_t begin, size_t end );
+        
+        // Coalesced and sorted, forgotten for this copy afterwards
+        std::vector< DirtyRange > takeRanges( uint32_t copyIndex );
+        
+        bool isClean( uint32_t copyIndex ) const;
+        
+        uint32_t getCopyCount() const;
+
+    private:
+        std::vector< std::vector< DirtyRange > > _pendingRanges;
+    };
+}
+
+#endif /* DirtyRangeTracker_hpp */
@@ -0,0 +1,121 @@
+//
+//  FrameRingAllocator.cpp
+//  Point_Cloud_Renderer
+//
+//  Created by Vatsalya Yadav on 10/19/26.
+//
+
+#include "FrameRingAllocator.hpp"
+
+#include <algorithm>
+#include <cassert>
+
+#include <Metal/Metal.hpp>
+
+namespace PCR
+{
+    FrameRingAllocator::FrameRingAllocator( MTL::Device* pDevice,
+                                            NS::UInteger partitionSize,
+                                            uint32_t partitionCount /* = MAX_FRAMES_IN_FLIGHT */ )
+    :   _pDevice{ pDevice }
+    ,   _partitionSize{ ( partitionSize + DEFAULT_ALIGNMENT - 1 ) / DEFAULT_ALIGNMENT * DEFAULT_ALIGNMENT }
+    ,   _partitionCount{ partitionCount }
+    ,   _currentPartition{ partitionCount - 1 }
+    ,   _usedBytes{ 0 }
+    ,   _highWaterMark{ 0 }
+    ,   _partitionBusy{ std::make_unique< std::atomic< bool >[] >( partitionCount ) }
+    {
+        _pBuffer = pDevice->newBuffer( _partitionSize * _partitionCount, MTL::ResourceStorageModeManaged );
+        
+        for ( uint32_t i = 0; i < _partitionCount; ++i )
+        {
+            _partitionBusy[ i ].store( false );
+        }
+    }
+
+    FrameRingAllocator::~FrameRingAllocator()
+    {
+        _pBuffer->release();
+    }
+
+    void FrameRingAllocator::beginFrame()
+    {
+        _currentPartition = ( _currentPartition + 1 ) % _partitionCount;
+        assert( !_partitionBusy[ _currentPartition ].load( std::memory_order_acquire ) );
+        
+        _usedBytes = 0;
+    }
+
+    FrameAllocation FrameRingAllocator::allocate( NS::UInteger size, NS::UInteger alignment /* = DEFAULT_ALIGNMENT */ )
+    {
+        const NS::UInteger offset = ( _usedBytes + alignment - 1 ) / alignment * alignment;
+        if ( offset + size > _partitionSize )
+        {
+            __builtin_printf( "FrameRingAllocator: %lu bytes requested, %lu of %lu left\n",
+                              static_cast< unsigned long >( size ),
+                              static_cast< unsigned long >( _partitionSize - std::min( offset, _partitionSize ) ),
+                              static_cast< unsigned long >( _partitionSize ) );
+            assert( false );
+            
+            // Release builds keep the frame drawing rather than hand out a null pointer
+            MTL::Buffer* pOverflowBuffer = _pDevice->newBuffer( size, MTL::ResourceStorageModeManaged );
+            _overflowBuffers.push_back( pOverflowBuffer );
+            
+            FrameAllocation allocation;
+            allocation.pBuffer = pOverflowBuffer;
+            allocation.size = size;
+            allocation.pData = pOverflowBuffer->contents();
+            return allocation;
+        }
+        
+        _usedBytes = offset + size;
+        
+        FrameAllocation allocation;
+        allocation.pBuffer = _pBuffer;
+        allocation.offset = _currentPartition * _partitionSize + offset;
+        allocation.size = size;
+        allocation.pData = static_cast< uint8_t* >( _pBuffer->contents() ) + allocation.offset;
+        return allocation;
+    }
+
+    void FrameRingAllocator::endFrame( MTL::CommandBuffer* pCommandBuffer )
+    {
+        if ( _usedBytes > 0 )
+        {
+            _pBuffer->didModifyRange( NS::Range::Make( _currentPartition * _partitionSize, _usedBytes ) );
+        }
+        _highWaterMark = std::max( _highWaterMark, _usedBytes );
+        
+        for ( MTL::Buffer* pOverflowBuffer : _overflowBuffers )
+        {
+            pOverflowBuffer->didModifyRange( NS::Range::Make( 0, pOverflowBuffer->length() ) );
+        }
+        const std::vector< MTL::Buffer* > overflowBuffers = std::move( _overflowBuffers );
+        _overflowBuffers.clear();
+        
+        const uint32_t partition = _currentPartition;
+        _partitionBusy[ partition ].store( true, std::memory_order_release );
+        pCommandBuffer->addCompletedHandler( ^void( MTL::CommandBuffer* ){
+            this->_partitionBusy[ partition ].store( false, std::memory_order_release );
+            for ( MTL::Buffer* pOverflowBuffer : overflowBuffers )
+            {
+                pOverflowBuffer->release();
+            }
+        });
+    }
+
+    NS::UInteger FrameRingAllocator::getPartitionSize() const
+    {
+        return _partitionSize;
+    }
+
+    NS::UInteger FrameRingAllocator::getUsedBytes() const
+    {
+        return _usedBytes;
+    }
+
+    NS::UInteger FrameRingAllocator::getHighWaterMark() const
+    {
+        return _highWaterMark;
+    }
+}
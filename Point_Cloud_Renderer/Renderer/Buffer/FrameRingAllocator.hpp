@@ -0,0 +1,118 @@
+//
+//  FrameRingAllocator.hpp
+//  Point_Cloud_Renderer
+//
+//  Created by Vatsalya Yadav on 10/19/26.
+//
+
+#ifndef FrameRingAllocator_hpp
+#define FrameRingAllocator_hpp
+
+#include <atomic>
+#include <memory>
+#include <span>
+#include <vector>
+
+#include <Foundation/Foundation.hpp>
+
+#include "Core/Core.hpp"
+#include "Renderer/Data/Constants.hpp"
+
+FD_MTL
+
+namespace PCR
+{
+    struct FrameAllocation
+    {
+        MTL::Buffer* pBuffer = nullptr;
+        
+        NS::UInteger offset = 0;
+        
+        NS::UInteger size = 0;
+        
+        void* pData = nullptr;
+        
+        template < typename T >
+        T* as() const
+        {
+            return reinterpret_cast< T* >( pData );
+        }
+    };
+
+    // One buffer split into a partition per frame in flight. Each frame bump-allocates
+    // from its own partition and the partition is handed back when the command buffer
+    // that used it completes, so per-frame data of any kind shares a single allocation.
+    class FrameRingAllocator
+    {
+    public:
+        // Buffer offsets bound to the constant address space have to be 256-byte aligned on macOS
+        static constexpr NS::UInteger DEFAULT_ALIGNMENT{ 256 };
+        
+        // Partition that fits one allocation of each size, every one starting aligned
+        static constexpr NS::UInteger computePartitionSize( std::span< const NS::UInteger > allocationSizes, NS::UInteger alignment = DEFAULT_ALIGNMENT )
+        {
+            NS::UInteger partitionSize = 0;
+            for ( NS::UInteger size : allocationSizes )
+            {
+                partitionSize += ( size + alignment - 1 ) / alignment * alignment;
+            }
+            return partitionSize;
+        }
+        
+        FrameRingAllocator( MTL::Device* pDevice,
+                            NS::UInteger partitionSize,
+                            uint32_t partitionCount = MAX_FRAMES_IN_FLIGHT );
+        
+        ~FrameRingAllocator();
+        
+        FrameRingAllocator( const FrameRingAllocator& ) = delete;
+        
+        FrameRingAllocator& operator=( const FrameRingAllocator& ) = delete;
+        
+        // Moves on to the next partition. The caller's frame throttling must make sure
+        // that partition's previous frame has completed.
+        void beginFrame();
+        
+        // Past the end of the partition it asserts, then hands out a buffer of its own that
+        // is released with the frame
+        FrameAllocation allocate( NS::UInteger size, NS::UInteger alignment = DEFAULT_ALIGNMENT );
+        
+        template < typename T >
+        FrameAllocation allocate( NS::UInteger count = 1 )
+        {
+            return allocate( count * sizeof( T ) );
+        }
+        
+        // Flushes the written range and recycles the partition once pCommandBuffer completes.
+        void endFrame( MTL::CommandBuffer* pCommandBuffer );
+        
+        NS::UInteger getPartitionSize() const;
+        
+        NS::UInteger getUsedBytes() const;
+        
+        // Largest getUsedBytes() seen at endFrame, useful for sizing the partitions
+        NS::UInteger getHighWaterMark() const;
+        
+    private:
+        MTL::Device* _pDevice;
+        
+        MTL::Buffer* _pBuffer;
+        
+        NS::UInteger _partitionSize;
+        
+        uint32_t _partitionCount;
+        
+        uint32_t _currentPartition;
+        
+        NS::UInteger _usedBytes;
+        
+        NS::UInteger _highWaterMark;
+        
+        std::unique_ptr< std::atomic< bool >[] > _partitionBusy;
+        
+        // This frame's allocations that didn't fit the partition
+        std::vector< MTL::Buffer* > _overflowBuffers;
+    };
+}
+
+#endif /* FrameRingAllocator_hpp */
@@ -0,0 +1,90 @@
+//
+//  GrowableBuffer.cpp
+//  Point_Cloud_Renderer
+//
+//  Created by Vatsalya Yadav on 10/19/26.
+//
+
+#include "GrowableBuffer.hpp"
+
+#include <algorithm>
+#include <cassert>
+
+#include <Metal/Metal.hpp>
+
+namespace PCR
+{
+    GrowableBuffer::GrowableBuffer( MTL::Device* pDevice, NS::UInteger size )
+    :   _pDevice{ pDevice }
+    ,   _pPendingBuffer{ nullptr }
+    {
+        _pBuffer = _pDevice->newBuffer( std::max< NS::UInteger >( size, 4 ), MTL::ResourceStorageModePrivate );
+    }
+
+    GrowableBuffer::~GrowableBuffer()
+    {
+        if ( _pPendingBuffer )
+        {
+            _pPendingBuffer->release();
+        }
+        _pBuffer->release();
+    }
+
+    void GrowableBuffer::reserve( NS::UInteger size )
+    {
+        const NS::UInteger pendingSize = _pPendingBuffer ? _pPendingBuffer->length() : _pBuffer->length();
+        if ( size <= pendingSize )
+        {
+            return;
+        }
+        
+        // Not swapped in yet, a larger one can take its place
+        if ( _pPendingBuffer )
+        {
+            _pPendingBuffer->release();
+        }
+        
+        // Doubling keeps the number of grows logarithmic in the final size
+        const NS::UInteger newSize = std::max( size, _pBuffer->length() * 2 );
+        _pPendingBuffer = _pDevice->newBuffer( newSize, MTL::ResourceStorageModePrivate );
+        if ( !_pPendingBuffer )
+        {
+            __builtin_printf( "GrowableBuffer: couldn't allocate %lu bytes\n", static_cast< unsigned long >( newSize ) );
+            assert( false );
+        }
+    }
+
+    void GrowableBuffer::beginFrame( DeferredDeletionQueue& deletionQueue, uint64_t frameIndex )
+    {
+        if ( !_pPendingBuffer )
+        {
+            return;
+        }
+        
+        // Frames up to this one may still read the old buffer
+        deletionQueue.retire( _pBuffer, frameIndex );
+        _pBuffer = _pPendingBuffer;
+        _pPendingBuffer = nullptr;
+        _stats.growCount += 1;
+    }
+
+    MTL::Buffer* GrowableBuffer::getBuffer() const
+    {
+        return _pBuffer;
+    }
+
+    NS::UInteger GrowableBuffer::getSize() const
+    {
+        return _pBuffer->length();
+    }
+
+    bool GrowableBuffer::isGrowing() const
+    {
+        return _pPendingBuffer != nullptr;
+    }
+
+    const GrowableBufferStats& GrowableBuffer::getStats() const
+    {
+        return _stats;
+    }
+}
@@ -0,0 +1,71 @@
+//
+//  GrowableBuffer.hpp
+//  Point_Cloud_Renderer
+//
+//  Created by Vatsalya Yadav on 10/19/26.
+//
+
+#ifndef GrowableBuffer_hpp
+#define GrowableBuffer_hpp
+
+#include <Foundation/Foundation.hpp>
+
+#include <cstdint>
+
+#include "Core/Core.hpp"
+#include "Renderer/Buffer/DeferredDeletionQueue.hpp"
+
+FD_MTL
+
+namespace PCR
+{
+    struct GrowableBufferStats
+    {
+        uint32_t growCount = 0;
+    };
+
+    // Private buffer that is resized without stalling a frame, for data the GPU rewrites
+    // in full every frame before reading it. Growing allocates the new buffer at least
+    // twice as large and nothing is copied across: frames keep using the old buffer until
+    // the next frame boundary, where the larger one is swapped in and the old one goes to
+    // the deletion queue.
+    class GrowableBuffer
+    {
+    public:
+        GrowableBuffer( MTL::Device* pDevice, NS::UInteger size );
+        
+        ~GrowableBuffer();
+        
+        GrowableBuffer( const GrowableBuffer& ) = delete;
+        
+        GrowableBuffer& operator=( const GrowableBuffer& ) = delete;
+        
+        // Nothing changes until the next beginFrame
+        void reserve( NS::UInteger size );
+        
+        // Before anything this frame uses getBuffer(), swaps in a pending grow
+        void beginFrame( DeferredDeletionQueue& deletionQueue, uint64_t frameIndex );
+        
+        // The buffer frames use now, getSize() bytes
+        MTL::Buffer* getBuffer() const;
+        
+        NS::UInteger getSize() const;
+        
+        // A larger buffer has been allocated but hasn't been swapped in yet
+        bool isGrowing() const;
+        
+        const GrowableBufferStats& getStats() const;
+
+    private:
+        MTL::Device* _pDevice;
+        
+        MTL::Buffer* _pBuffer;
+        
+        // Swapped in at the next frame boundary, null when not growing
+        MTL::Buffer* _pPendingBuffer;
+        
+        GrowableBufferStats _stats;
+    };
+}
+
+#endif /* GrowableBuffer_hpp */
@@ -0,0 +1,77 @@
+//
+//  UploadManager.cpp
+//  Point_Cloud_Renderer
+//
+//  Created by Vatsalya Yadav on 10/19/26.
+//
+
+#include "UploadManager.hpp"
+
+#include <Metal/Metal.hpp>
+
+namespace PCR
+{
+    UploadManager::UploadManager( MTL::Device* pDevice,
+                                  NS::UInteger stagingSize /* = UPLOAD_STAGING_SIZE */,
+                                  NS::UInteger frameBudget /* = UPLOAD_FRAME_BUDGET */ )
+    :   _pDevice{ pDevice->retain() }
+    {
+        stagingSize = ( stagingSize + UploadScheduler::STAGING_ALIGNMENT - 1 ) / UploadScheduler::STAGING_ALIGNMENT * UploadScheduler::STAGING_ALIGNMENT;
+        
+        // Written once by the CPU and read once by the blit, write-combined is enough
+        _pStagingBuffer = _pDevice->newBuffer( stagingSize, MTL::ResourceStorageModeShared | MTL::ResourceCPUCacheModeWriteCombined );
+        _pStagingBuffer->setLabel( CreateUTF8String( "Upload Staging" ) );
+        
+        _pScheduler = new UploadScheduler( static_cast< uint8_t* >( _pStagingBuffer->contents() ), stagingSize, frameBudget );
+    }
+
+    UploadManager::~UploadManager()
+    {
+        delete _pScheduler;
+        _pStagingBuffer->release();
+        _pDevice->release();
+    }
+
+    MTL::Buffer* UploadManager::newPrivateBuffer( NS::UInteger size ) const
+    {
+        return _pDevice->newBuffer( size, MTL::ResourceStorageModePrivate );
+    }
+
+    void UploadManager::upload( MTL::Buffer* pDestination, NS::UInteger destinationOffset, const void* pData, NS::UInteger size )
+    {
+        _pScheduler->upload( pDestination, destinationOffset, pData, size );
+    }
+
+    void UploadManager::flush( MTL::CommandBuffer* pCommandBuffer )
+    {
+        const std::vector< UploadCopy >& copies = _pScheduler->endFrame();
+        if ( !copies.empty() )
+        {
+            MTL::BlitCommandEncoder* pBlitEncoder = pCommandBuffer->blitCommandEncoder();
+            pBlitEncoder->setLabel( CreateUTF8String( "Uploads" ) );
+            for ( const UploadCopy& copy : copies )
+            {
+                pBlitEncoder->copyFromBuffer( _pStagingBuffer, copy.stagingOffset, copy.pDestination, copy.destinationOffset, copy.size );
+            }
+            pBlitEncoder->endEncoding();
+            
+            const uint64_t retirePosition = _pScheduler->getRetirePosition();
+            UploadScheduler* pScheduler = _pScheduler;
+            pCommandBuffer->addCompletedHandler( ^void( MTL::CommandBuffer* ){
+                pScheduler->retire( retirePosition );
+            });
+        }
+        
+        _pScheduler->beginFrame();
+    }
+
+    void UploadManager::setFrameBudget( NS::UInteger frameBudget )
+    {
+        _pScheduler->setFrameBudget( frameBudget );
+    }
+
+    const UploadStats& UploadManager::getStats() const
+    {
+        return _pScheduler->getStats();
+    }
+}
@@ -0,0 +1,61 @@
+//
+//  UploadManager.hpp
+//  Point_Cloud_Renderer
+//
+//  Created by Vatsalya Yadav on 10/19/26.
+//
+
+#ifndef UploadManager_hpp
+#define UploadManager_hpp
+
+#include <Foundation/Foundation.hpp>
+
+#include "Core/Core.hpp"
+#include "Renderer/Data/Constants.hpp"
+#include "Renderer/Buffer/UploadScheduler.hpp"
+
+FD_MTL
+
+namespace PCR
+{
+    // Gets data into private buffers through one shared staging ring. Uploads are
+    // batched into a single blit encoder per frame, neighbouring ones merged into one
+    // copy, and at most the frame budget is moved per frame so large streams are
+    // spread out instead of showing up as a spike.
+    class UploadManager
+    {
+    public:
+        UploadManager( MTL::Device* pDevice,
+                       NS::UInteger stagingSize = UPLOAD_STAGING_SIZE,
+                       NS::UInteger frameBudget = UPLOAD_FRAME_BUDGET );
+        
+        ~UploadManager();
+        
+        UploadManager( const UploadManager& ) = delete;
+        
+        UploadManager& operator=( const UploadManager& ) = delete;
+        
+        // Private storage, only reachable through upload()
+        MTL::Buffer* newPrivateBuffer( NS::UInteger size ) const;
+        
+        // pData can be reused as soon as this returns. Offset and size must be multiples of 4.
+        void upload( MTL::Buffer* pDestination, NS::UInteger destinationOffset, const void* pData, NS::UInteger size );
+        
+        // Encodes this frame's copies ahead of anything encoded later into pCommandBuffer
+        void flush( MTL::CommandBuffer* pCommandBuffer );
+        
+        void setFrameBudget( NS::UInteger frameBudget );
+        
+        // Bytes and copies of the last flush
+        const UploadStats& getStats() const;
+
+    private:
+        MTL::Device* _pDevice;
+        
+        MTL::Buffer* _pStagingBuffer;
+        
+        UploadScheduler* _pScheduler;
+    };
+}
+
+#endif /* UploadManager_hpp */
@@ -0,0 +1,162 @@
+//
+//  UploadScheduler.cpp
+//  Point_Cloud_Renderer
+//
+//  Created by Vatsalya Yadav on 10/19/26.
+//
+
+#include "UploadScheduler.hpp"
+
+#include <algorithm>
+#include <cassert>
+#include <cstring>
+
+namespace PCR
+{
+    UploadScheduler::UploadScheduler( uint8_t* pStagingMemory, uint64_t stagingSize, uint64_t frameBudget )
+    :   _pStagingMemory{ pStagingMemory }
+    ,   _stagingSize{ stagingSize }
+    ,   _frameBudget{ 0 }
+    ,   _head{ 0 }
+    ,   _tail{ 0 }
+    ,   _frameBytes{ 0 }
+    ,   _frameUploads{ 0 }
+    ,   _pendingBytes{ 0 }
+    {
+        assert( stagingSize % STAGING_ALIGNMENT == 0 );
+        setFrameBudget( frameBudget );
+    }
+
+    void UploadScheduler::upload( MTL::Buffer* pDestination, uint64_t destinationOffset, const void* pData, uint64_t size )
+    {
+        assert( destinationOffset % 4 == 0 && size % 4 == 0 );
+        
+        const auto* pBytes = static_cast< const uint8_t* >( pData );
+        while ( size > 0 )
+        {
+            const uint64_t pieceSize = std::min( size, _frameBudget );
+            
+            // Anything queued is older and has to land first
+            if ( !_pending.empty() || !tryStage( pDestination, destinationOffset, pBytes, pieceSize ) )
+            {
+                _pending.push_back( PendingUpload{ pDestination, destinationOffset, std::vector< uint8_t >( pBytes, pBytes + pieceSize ) } );
+                _pendingBytes += pieceSize;
+            }
+            
+            pBytes += pieceSize;
+            destinationOffset += pieceSize;
+            size -= pieceSize;
+        }
+    }
+
+    const std::vector< UploadCopy >& UploadScheduler::endFrame()
+    {
+        _stats.bytesUploaded = _frameBytes;
+        _stats.uploadCount = _frameUploads;
+        _stats.copyCount = static_cast< uint32_t >( _copies.size() );
+        _stats.deferredBytes = _pendingBytes;
+        _stats.deferredUploads = static_cast< uint32_t >( _pending.size() );
+        return _copies;
+    }
+
+    void UploadScheduler::beginFrame()
+    {
+        _copies.clear();
+        _frameBytes = 0;
+        _frameUploads = 0;
+        drainPending();
+    }
+
+    uint64_t UploadScheduler::getRetirePosition() const
+    {
+        return _head;
+    }
+
+    void UploadScheduler::retire( uint64_t position )
+    {
+        // Command buffers on one queue complete in order, so this only ever moves forward
+        uint64_t tail = _tail.load( std::memory_order_relaxed );
+        while ( position > tail && !_tail.compare_exchange_weak( tail, position, std::memory_order_release, std::memory_order_relaxed ) )
+        { }
+    }
+
+    void UploadScheduler::setFrameBudget( uint64_t frameBudget )
+    {
+        // A piece has to fit the ring, keep it to half so one frame can't starve the next
+        _frameBudget = std::clamp< uint64_t >( frameBudget / 4 * 4, 4, _stagingSize / 2 );
+    }
+
+    uint64_t UploadScheduler::getFrameBudget() const
+    {
+        return _frameBudget;
+    }
+
+    uint64_t UploadScheduler::getStagingSize() const
+    {
+        return _stagingSize;
+    }
+
+    const UploadStats& UploadScheduler::getStats() const
+    {
+        return _stats;
+    }
+
+    bool UploadScheduler::tryStage( MTL::Buffer* pDestination, uint64_t destinationOffset, const void* pData, uint64_t size )
+    {
+        // The first piece of a frame always goes, it may predate a smaller budget
+        if ( _frameBytes > 0 && _frameBytes + size > _frameBudget )
+        {
+            return false;
+        }
+        
+        const uint64_t alignedSize = ( size + STAGING_ALIGNMENT - 1 ) / STAGING_ALIGNMENT * STAGING_ALIGNMENT;
+        
+        // Never split a copy across the end of the ring, skip to the start instead
+        const uint64_t ringOffset = _head % _stagingSize;
+        const uint64_t padding = ( ringOffset + alignedSize > _stagingSize ) ? _stagingSize - ringOffset : 0;
+        if ( _head + padding + alignedSize - _tail.load( std::memory_order_acquire ) > _stagingSize )
+        {
+            return false;
+        }
+        
+        _head += padding;
+        const uint64_t stagingOffset = _head % _stagingSize;
+        _head += alignedSize;
+        
+        std::memcpy( _pStagingMemory + stagingOffset, pData, size );
+        _frameBytes += size;
+        ++_frameUploads;
+        
+        // Neighbouring writes into the same buffer from neighbouring staging space become one copy
+        if ( !_copies.empty() )
+        {
+            UploadCopy& last = _copies.back();
+            if ( last.pDestination == pDestination
+              && last.destinationOffset + last.size == destinationOffset
+              && last.stagingOffset + last.size == stagingOffset
+              && last.size % STAGING_ALIGNMENT == 0 )
+            {
+                last.size += size;
+                return true;
+            }
+        }
+        
+        _copies.push_back( UploadCopy{ pDestination, destinationOffset, stagingOffset, size } );
+        return true;
+    }
+
+    void UploadScheduler::drainPending()
+    {
+        while ( !_pending.empty() )
+        {
+            PendingUpload& upload = _pending.front();
+            if ( !tryStage( upload.pDestination, upload.destinationOffset, upload.data.data(), upload.data.size() ) )
+            {
+                break;
+            }
+            
+            _pendingBytes -= upload.data.size();
+            _pending.pop_front();
+        }
+    }
+}
@@ -0,0 +1,125 @@
+//
+//  UploadScheduler.hpp
+//  Point_Cloud_Renderer
+//
+//  Created by Vatsalya Yadav on 10/19/26.
+//
+
+#ifndef UploadScheduler_hpp
+#define UploadScheduler_hpp
+
+#include <atomic>
+#include <cstdint>
+#include <deque>
+#include <vector>
+
+#include "Core/Core.hpp"
+
+FD_MTL
+
+namespace PCR
+{
+    struct UploadCopy
+    {
+        MTL::Buffer* pDestination = nullptr;
+        
+        uint64_t destinationOffset = 0;
+        
+        uint64_t stagingOffset = 0;
+        
+        uint64_t size = 0;
+    };
+
+    struct UploadStats
+    {
+        uint64_t bytesUploaded = 0;
+        
+        // Upload requests staged this frame
+        uint32_t uploadCount = 0;
+        
+        // Blit copies after merging neighbouring uploads
+        uint32_t copyCount = 0;
+        
+        // Left for later frames by the budget or a full staging ring
+        uint64_t deferredBytes = 0;
+        
+        uint32_t deferredUploads = 0;
+    };
+
+    // Staging ring and transfer scheduling behind UploadManager, kept free of Metal so
+    // it runs anywhere. Uploads are copied into the ring straight away while the frame's
+    // byte budget and the ring allow it, otherwise they wait in a queue and go out in
+    // order over the next frames. Space is handed back once the GPU has done the copies.
+    class UploadScheduler
+    {
+    public:
+        // Copies on macOS need 4-byte aligned offsets and sizes, 16 keeps staging reads aligned
+        static constexpr uint64_t STAGING_ALIGNMENT{ 16 };
+        
+        UploadScheduler( uint8_t* pStagingMemory, uint64_t stagingSize, uint64_t frameBudget );
+        
+        // Larger uploads are split into budget-sized pieces so each fits a frame
+        void upload( MTL::Buffer* pDestination, uint64_t destinationOffset, const void* pData, uint64_t size );
+        
+        // Copies staged since the last beginFrame, in submission order
+        const std::vector< UploadCopy >& endFrame();
+        
+        // Opens the next frame's budget and moves queued uploads into the ring first
+        void beginFrame();
+        
+        // Ring position after the last staged byte, hand it to retire() once the
+        // copies recorded up to here have executed. Thread-safe with respect to retire.
+        uint64_t getRetirePosition() const;
+        
+        void retire( uint64_t position );
+        
+        void setFrameBudget( uint64_t frameBudget );
+        
+        uint64_t getFrameBudget() const;
+        
+        uint64_t getStagingSize() const;
+        
+        // Stats of the last frame passed to endFrame
+        const UploadStats& getStats() const;
+
+    private:
+        struct PendingUpload
+        {
+            MTL::Buffer* pDestination;
+            
+            uint64_t destinationOffset;
+            
+            std::vector< uint8_t > data;
+        };
+        
+        uint8_t* _pStagingMemory;
+        
+        uint64_t _stagingSize;
+        
+        uint64_t _frameBudget;
+        
+        // Monotonic, the ring offset is position % _stagingSize
+        uint64_t _head;
+        
+        // Advanced from GPU completion handlers
+        std::atomic< uint64_t > _tail;
+        
+        uint64_t _frameBytes;
+        
+        uint32_t _frameUploads;
+        
+        std::vector< UploadCopy > _copies;
+        
+        std::deque< PendingUpload > _pending;
+        
+        uint64_t _pendingBytes;
+        
+        UploadStats _stats;
+        
+        bool tryStage( MTL::Buffer* pDestination, uint64_t destinationOffset, const void* pData, uint64_t size );
+        
+        void drainPending();
+    };
+}
+
+#endif /* UploadScheduler_hpp */
@@ -0,0 +1,220 @@
+//
+//  UploadSchedulerCheck.cpp
+//  Point_Cloud_Renderer
+//
+//  Created by Vatsalya Yadav on 10/19/26.
+//
+
+#include "UploadSchedulerCheck.hpp"
+
+#include <cstring>
+#include <deque>
+#include <map>
+#include <vector>
+
+#include "Renderer/Buffer/UploadScheduler.hpp"
+#include "Renderer/Validation/CheckReport.hpp"
+
+namespace PCR
+{
+    namespace
+    {
+        constexpr uint64_t STAGING_SIZE{ 1024 * 1024 };
+        
+        constexpr uint64_t FRAME_BUDGET{ 256 * 1024 };
+        
+        constexpr uint64_t SMALL_UPLOAD_SIZE{ 4 * 1024 };
+        
+        constexpr uint64_t SMALL_UPLOAD_COUNT{ 300 };
+        
+        constexpr uint64_t LARGE_UPLOAD_SIZE{ 3 * 1024 * 1024 };
+        
+        constexpr size_t FRAMES_IN_FLIGHT{ 2 };
+        
+        // Only ever compared, never dereferenced
+        alignas( 16 ) char destinationStandIns[ 2 ][ 16 ];
+        
+        std::vector< uint8_t > makeBytes( uint64_t size, uint32_t seed )
+        {
+            // Hashed, so no two ring-sized stretches repeat and an overwrite can't go unnoticed
+            std::vector< uint8_t > bytes( size );
+            for ( uint64_t i = 0; i < size; ++i )
+            {
+                uint32_t hash = static_cast< uint32_t >( i ) * 2654435761u + seed;
+                hash ^= hash >> 15;
+                hash *= 0x2C1B3C6Du;
+                hash ^= hash >> 12;
+                bytes[ i ] = static_cast< uint8_t >( hash );
+            }
+            return bytes;
+        }
+        
+        struct SubmittedFrame
+        {
+            std::vector< UploadCopy > copies;
+            
+            uint64_t retirePosition;
+        };
+        
+        // Stands in for the copy queue: a frame's copies read the staging ring when they
+        // execute, and only then is their space handed back
+        class SimulatedGpu
+        {
+        public:
+            SimulatedGpu( UploadScheduler& scheduler, const uint8_t* pStaging )
+            :   _scheduler{ scheduler }
+            ,   _pStaging{ pStaging }
+            {
+            }
+            
+            void addDestination( const void* pBuffer, uint64_t size )
+            {
+                _destinations[ pBuffer ].assign( size, 0 );
+            }
+            
+            const std::vector< uint8_t >& getDestination( const void* pBuffer ) const
+            {
+                return _destinations.at( pBuffer );
+            }
+            
+            void submit( const std::vector< UploadCopy >& copies )
+            {
+                _inFlight.push_back( SubmittedFrame{ copies, _scheduler.getRetirePosition() } );
+            }
+            
+            // Completes frames until at most framesInFlight are left
+            void complete( size_t framesInFlight )
+            {
+                while ( _inFlight.size() > framesInFlight )
+                {
+                    const SubmittedFrame& frame = _inFlight.front();
+                    for ( const UploadCopy& copy : frame.copies )
+                    {
+                        std::vector< uint8_t >& destination = _destinations.at( copy.pDestination );
+                        std::memcpy( destination.data() + copy.destinationOffset, _pStaging + copy.stagingOffset, copy.size );
+                    }
+                    _scheduler.retire( frame.retirePosition );
+                    _inFlight.pop_front();
+                }
+            }
+        
+        private:
+            UploadScheduler& _scheduler;
+            
+            const uint8_t* _pStaging;
+            
+            std::map< const void*, std::vector< uint8_t > > _destinations;
+            
+            std::deque< SubmittedFrame > _inFlight;
+        };
+        
+        void checkStreaming( CheckReport& report )
+        {
+            std::vector< uint8_t > staging( STAGING_SIZE );
+            UploadScheduler scheduler( staging.data(), STAGING_SIZE, FRAME_BUDGET );
+            SimulatedGpu gpu( scheduler, staging.data() );
+            
+            auto* pSmallDestination = reinterpret_cast< MTL::Buffer* >( destinationStandIns[ 0 ] );
+            auto* pLargeDestination = reinterpret_cast< MTL::Buffer* >( destinationStandIns[ 1 ] );
+            const std::vector< uint8_t > smallBytes = makeBytes( SMALL_UPLOAD_SIZE * SMALL_UPLOAD_COUNT, 7 );
+            const std::vector< uint8_t > largeBytes = makeBytes( LARGE_UPLOAD_SIZE, 91 );
+            gpu.addDestination( pSmallDestination, smallBytes.size() );
+            gpu.addDestination( pLargeDestination, largeBytes.size() );
+            
+            for ( uint64_t i = 0; i < SMALL_UPLOAD_COUNT; ++i )
+            {
+                scheduler.upload( pSmallDestination, i * SMALL_UPLOAD_SIZE, smallBytes.data() + i * SMALL_UPLOAD_SIZE, SMALL_UPLOAD_SIZE );
+            }
+            scheduler.upload( pLargeDestination, 0, largeBytes.data(), largeBytes.size() );
+            
+            bool withinBudget = true;
+            bool oneCopyPerFrame = true;
+            bool wrapped = false;
+            uint64_t totalBytes = 0;
+            uint32_t frameCount = 0;
+            
+            // Enough frames for everything to go out at the budget, plus a margin
+            const uint32_t maxFrames = static_cast< uint32_t >( ( smallBytes.size() + largeBytes.size() ) / FRAME_BUDGET ) + 8;
+            for ( ; frameCount < maxFrames; ++frameCount )
+            {
+                const std::vector< UploadCopy >& copies = scheduler.endFrame();
+                const UploadStats& stats = scheduler.getStats();
+                withinBudget = withinBudget && stats.bytesUploaded <= FRAME_BUDGET;
+                oneCopyPerFrame = oneCopyPerFrame && copies.size() <= 1;
+                wrapped = wrapped || ( frameCount > 0 && !copies.empty() && copies.front().stagingOffset == 0 );
+                totalBytes += stats.bytesUploaded;
+                
+                gpu.submit( copies );
+                gpu.complete( FRAMES_IN_FLIGHT );
+                
+                if ( stats.deferredUploads == 0 && copies.empty() )
+                {
+                    break;
+                }
+                scheduler.beginFrame();
+            }
+            gpu.complete( 0 );
+            
+            report.expect( totalBytes == smallBytes.size() + largeBytes.size(), "streaming: every byte was staged exactly once" );
+            report.expect( withinBudget, "streaming: no frame staged more than the budget" );
+            report.expect( oneCopyPerFrame, "streaming: contiguous uploads merged into one copy per frame" );
+            report.expect( frameCount <= maxFrames - 4, "streaming: the queue drained at the budget's pace" );
+            report.expect( wrapped, "streaming: staging wrapped around the ring" );
+            report.expect( gpu.getDestination( pSmallDestination ) == smallBytes, "streaming: the 4 KB uploads landed byte for byte" );
+            report.expect( gpu.getDestination( pLargeDestination ) == largeBytes, "streaming: the upload larger than the ring landed byte for byte" );
+        }
+        
+        void checkStalledGpu( CheckReport& report )
+        {
+            std::vector< uint8_t > staging( STAGING_SIZE );
+            UploadScheduler scheduler( staging.data(), STAGING_SIZE, FRAME_BUDGET );
+            SimulatedGpu gpu( scheduler, staging.data() );
+            
+            auto* pDestination = reinterpret_cast< MTL::Buffer* >( destinationStandIns[ 0 ] );
+            const std::vector< uint8_t > bytes = makeBytes( 2 * STAGING_SIZE, 3 );
+            gpu.addDestination( pDestination, bytes.size() );
+            scheduler.upload( pDestination, 0, bytes.data(), bytes.size() );
+            
+            // Nothing completes, so at most the ring's worth can be staged
+            uint64_t stagedBytes = 0;
+            for ( uint32_t frame = 0; frame < 8; ++frame )
+            {
+                gpu.submit( scheduler.endFrame() );
+                stagedBytes += scheduler.getStats().bytesUploaded;
+                scheduler.beginFrame();
+            }
+            report.expect( stagedBytes == STAGING_SIZE, "stalled GPU: staging stops once the ring is full" );
+            
+            gpu.complete( 0 );
+            for ( uint32_t frame = 0; frame < 16 && scheduler.getStats().deferredUploads > 0; ++frame )
+            {
+                gpu.submit( scheduler.endFrame() );
+                gpu.complete( FRAMES_IN_FLIGHT );
+                scheduler.beginFrame();
+            }
+            gpu.submit( scheduler.endFrame() );
+            gpu.complete( 0 );
+            report.expect( gpu.getDestination( pDestination ) == bytes, "stalled GPU: staging resumes on completion and nothing was overwritten" );
+        }
+        
+        void checkBudgetClamp( CheckReport& report )
+        {
+            std::vector< uint8_t > staging( STAGING_SIZE );
+            UploadScheduler scheduler( staging.data(), STAGING_SIZE, FRAME_BUDGET );
+            
+            scheduler.setFrameBudget( 2 );
+            const bool clampedUp = scheduler.getFrameBudget() == 4;
+            scheduler.setFrameBudget( 4 * STAGING_SIZE );
+            report.expect( clampedUp && scheduler.getFrameBudget() == STAGING_SIZE / 2, "budget: kept between 4 bytes and half the ring" );
+        }
+    }
+
+    bool runUploadSchedulerChecks()
+    {
+        CheckReport report( "Upload scheduler, simulated copy queue" );
+        checkStreaming( report );
+        checkStalledGpu( report );
+        checkBudgetClamp( report );
+        return report.finish();
+    }
+}
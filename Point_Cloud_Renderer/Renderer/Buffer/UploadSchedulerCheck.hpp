@@ -0,0 +1,22 @@
+//
+//  UploadSchedulerCheck.hpp
+//  Point_Cloud_Renderer
+//
+//  Created by Vatsalya Yadav on 10/19/26.
+//
+
+#ifndef UploadSchedulerCheck_hpp
+#define UploadSchedulerCheck_hpp
+
+namespace PCR
+{
+    // UploadScheduler against a simulated GPU that runs each frame's copies two frames late:
+    // a stream of contiguous uploads and one larger than the ring go out within the budget,
+    // merged into one copy per frame, wrap the ring and land byte for byte. A GPU that stops
+    // completing stalls staging instead of overwriting the ring. The half of UploadManager
+    // that touches Metal only records the copies, so it isn't covered.
+    // Returns false if any check fails.
+    bool runUploadSchedulerChecks();
+}
+
+#endif /* UploadSchedulerCheck_hpp */
@@ -0,0 +1,250 @@
+//
+//  InstanceCulling.cpp
+//  Point_Cloud_Renderer
+//
+//  Created by Vatsalya Yadav on 10/19/26.
+//
+
+#include "InstanceCulling.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <vector>
+
+#include "Renderer/Instances/CompactInstance.hpp"
+
+namespace PCR::InstanceCulling
+{
+    namespace
+    {
+        simd::float4 getRow( const simd::float4x4& m, int row )
+        {
+            return simd::float4{ m.columns[ 0 ][ row ], m.columns[ 1 ][ row ], m.columns[ 2 ][ row ], m.columns[ 3 ][ row ] };
+        }
+        
+        simd::float4 normalizePlane( const simd::float4& plane )
+        {
+            const float invLength = 1.0f / std::sqrt( plane.x * plane.x + plane.y * plane.y + plane.z * plane.z );
+            return plane * invLength;
+        }
+        
+        // Mirrors lengthSq in the kernel
+        float lengthSq( float x, float y, float z )
+        {
+            return std::fma( z, z, std::fma( y, y, x * x ) );
+        }
+        
+        // The largest axis scale, squared to stay clear of sqrt
+        float getScaleSq( const simd::float4x4& transform )
+        {
+            const simd::float4& c0 = transform.columns[ 0 ];
+            const simd::float4& c1 = transform.columns[ 1 ];
+            const simd::float4& c2 = transform.columns[ 2 ];
+            return std::max( lengthSq( c0.x, c0.y, c0.z ), std::max( lengthSq( c1.x, c1.y, c1.z ), lengthSq( c2.x, c2.y, c2.z ) ) );
+        }
+        
+        bool isInstanceVisible( const simd::float4x4& transform, float scaleSq, const CullUniforms& uniforms )
+        {
+            // The largest axis scale grows the sphere
+            const float radiusSq = uniforms.boundingRadiusSq * scaleSq;
+            
+            const simd::float4& center = transform.columns[ 3 ];
+            for ( int i = 0; i < 6; ++i )
+            {
+                const simd::float4& plane = uniforms.frustumPlanes[ i ];
+                const float distance = std::fma( plane.z, center.z, std::fma( plane.y, center.y, std::fma( plane.x, center.x, plane.w ) ) );
+                if ( distance < 0.0f && distance * distance > radiusSq )
+                {
+                    return false;
+                }
+            }
+            return true;
+        }
+        
+        // Mirrors selectLod in the kernel
+        InstanceLod selectLod( const simd::float4x4& transform, float scaleSq, const CullUniforms& uniforms )
+        {
+            const simd::float4& center = transform.columns[ 3 ];
+            const float distanceSq = lengthSq( center.x - uniforms.cameraPosition.x,
+                                               center.y - uniforms.cameraPosition.y,
+                                               center.z - uniforms.cameraPosition.z );
+            
+            uint32_t lod = 0;
+            for ( uint32_t i = 0; i + 1 < std::min( uniforms.lodCount, INSTANCE_LOD_COUNT ); ++i )
+            {
+                if ( distanceSq > uniforms.lodDistancesSq[ i ] * scaleSq )
+                {
+                    lod = i + 1;
+                }
+            }
+            return static_cast< InstanceLod >( lod );
+        }
+        
+        template < typename LoadTransform >
+        void cullTransforms( const LoadTransform& loadTransform,
+                             const CullUniforms& uniforms,
+                             uint32_t* pVisibleInstances,
+                             DrawIndexedArguments* pArguments )
+        {
+            for ( uint32_t i = 0; i < uniforms.instanceCount; ++i )
+            {
+                const simd::float4x4 transform = loadTransform( i );
+                const float scaleSq = getScaleSq( transform );
+                if ( isInstanceVisible( transform, scaleSq, uniforms ) )
+                {
+                    const auto lod = static_cast< uint32_t >( selectLod( transform, scaleSq, uniforms ) );
+                    pVisibleInstances[ lod * uniforms.lodListCapacity + pArguments[ lod ].instanceCount++ ] = i;
+                }
+            }
+        }
+    }
+
+    void extractFrustumPlanes( const simd::float4x4& viewProjection, simd::float4* pPlanes )
+    {
+        const simd::float4 r0 = getRow( viewProjection, 0 );
+        const simd::float4 r1 = getRow( viewProjection, 1 );
+        const simd::float4 r2 = getRow( viewProjection, 2 );
+        const simd::float4 r3 = getRow( viewProjection, 3 );
+        
+        pPlanes[ 0 ] = normalizePlane( r3 + r0 );
+        pPlanes[ 1 ] = normalizePlane( r3 - r0 );
+        pPlanes[ 2 ] = normalizePlane( r3 + r1 );
+        pPlanes[ 3 ] = normalizePlane( r3 - r1 );
+        pPlanes[ 4 ] = normalizePlane( r2 );
+        pPlanes[ 5 ] = normalizePlane( r3 - r2 );
+    }
+
+    CullUniforms makeUniforms( const simd::float4x4& viewProjection, float boundingRadius, uint32_t instanceCount )
+    {
+        CullUniforms uniforms{};
+        extractFrustumPlanes( viewProjection, uniforms.frustumPlanes );
+        uniforms.boundingRadiusSq = boundingRadius * boundingRadius;
+        uniforms.instanceCount = instanceCount;
+        uniforms.lodListCapacity = instanceCount;
+        
+        // A distance standing in for "never" would be an infinity or overflow to one once scaled,
+        // and fast-math may assume neither exists, so the selection is skipped instead
+        uniforms.lodCount = 1;
+        return uniforms;
+    }
+
+    void setLodDistances( CullUniforms& uniforms, const simd::float3& cameraPosition, float reducedDistance, float impostorDistance )
+    {
+        uniforms.cameraPosition = simd::float4{ cameraPosition.x, cameraPosition.y, cameraPosition.z, 1.0f };
+        uniforms.lodDistancesSq[ 0 ] = reducedDistance * reducedDistance;
+        uniforms.lodDistancesSq[ 1 ] = impostorDistance * impostorDistance;
+        uniforms.lodCount = INSTANCE_LOD_COUNT;
+    }
+
+    bool isInstanceVisible( const simd::float4x4& transform, const CullUniforms& uniforms )
+    {
+        return isInstanceVisible( transform, getScaleSq( transform ), uniforms );
+    }
+
+    InstanceLod selectLod( const simd::float4x4& transform, const CullUniforms& uniforms )
+    {
+        return selectLod( transform, getScaleSq( transform ), uniforms );
+    }
+
+    void cullInstances( const InstanceData* pInstances,
+                        const CullUniforms& uniforms,
+                        uint32_t* pVisibleInstances,
+                        DrawIndexedArguments* pArguments )
+    {
+        cullTransforms( [ pInstances ]( uint32_t i ){ return pInstances[ i ].transform; }, uniforms, pVisibleInstances, pArguments );
+    }
+
+    void cullInstances( const CompactInstanceData* pInstances,
+                        const CullUniforms& uniforms,
+                        uint32_t* pVisibleInstances,
+                        DrawIndexedArguments* pArguments )
+    {
+        cullTransforms( [ pInstances ]( uint32_t i ){ return CompactInstance::decode( pInstances[ i ] ).transform; }, uniforms, pVisibleInstances, pArguments );
+    }
+
+    bool matchesReference( const InstanceData* pInstances,
+                           const CullUniforms& uniforms,
+                           const uint32_t* pVisibleInstances,
+                           const DrawIndexedArguments* pArguments )
+    {
+        DrawIndexedArguments expectedArguments[ INSTANCE_LOD_COUNT ];
+        for ( uint32_t lod = 0; lod < INSTANCE_LOD_COUNT; ++lod )
+        {
+            expectedArguments[ lod ] = pArguments[ lod ];
+            expectedArguments[ lod ].instanceCount = 0;
+        }
+        std::vector< uint32_t > expected( static_cast< size_t >( uniforms.lodListCapacity ) * INSTANCE_LOD_COUNT );
+        cullInstances( pInstances, uniforms, expected.data(), expectedArguments );
+        
+        for ( uint32_t lod = 0; lod < INSTANCE_LOD_COUNT; ++lod )
+        {
+            if ( expectedArguments[ lod ].instanceCount != pArguments[ lod ].instanceCount )
+            {
+                return false;
+            }
+            
+            const size_t listStart = static_cast< size_t >( lod ) * uniforms.lodListCapacity;
+            std::vector< uint32_t > visible( pVisibleInstances + listStart, pVisibleInstances + listStart + pArguments[ lod ].instanceCount );
+            std::sort( visible.begin(), visible.end() );
+            if ( !std::equal( visible.begin(), visible.end(), expected.begin() + static_cast< std::ptrdiff_t >( listStart ) ) )
+            {
+                return false;
+            }
+        }
+        return true;
+    }
+
+    bool matchesReference( const CompactInstanceData* pInstances,
+                           const CullUniforms& uniforms,
+                           const uint32_t* pVisibleInstances,
+                           const DrawIndexedArguments* pArguments )
+    {
+        // Which list the kernel put each instance in, INSTANCE_LOD_COUNT for none
+        std::vector< uint32_t > listedLod( uniforms.instanceCount, INSTANCE_LOD_COUNT );
+        for ( uint32_t lod = 0; lod < INSTANCE_LOD_COUNT; ++lod )
+        {
+            if ( pArguments[ lod ].instanceCount > uniforms.lodListCapacity )
+            {
+                return false;
+            }
+            
+            const uint32_t* pList = pVisibleInstances + static_cast< size_t >( lod ) * uniforms.lodListCapacity;
+            for ( uint32_t slot = 0; slot < pArguments[ lod ].instanceCount; ++slot )
+            {
+                const uint32_t index = pList[ slot ];
+                if ( index >= uniforms.instanceCount || listedLod[ index ] != INSTANCE_LOD_COUNT )
+                {
+                    return false;
+                }
+                listedLod[ index ] = lod;
+            }
+        }
+        
+        // A larger scale only ever grows the bounding sphere and picks a finer LOD, so the
+        // two ends of the tolerance bound every decision the kernel could have made
+        for ( uint32_t i = 0; i < uniforms.instanceCount; ++i )
+        {
+            const simd::float4x4 transform = CompactInstance::decode( pInstances[ i ] ).transform;
+            const float scaleSq = getScaleSq( transform );
+            const float smallScaleSq = scaleSq * ( 1.0f - COMPACT_SCALE_TOLERANCE );
+            const float largeScaleSq = scaleSq * ( 1.0f + COMPACT_SCALE_TOLERANCE );
+            
+            if ( listedLod[ i ] == INSTANCE_LOD_COUNT )
+            {
+                if ( isInstanceVisible( transform, smallScaleSq, uniforms ) )
+                {
+                    return false;
+                }
+                continue;
+            }
+            
+            const auto finestLod = static_cast< uint32_t >( selectLod( transform, largeScaleSq, uniforms ) );
+            const auto coarsestLod = static_cast< uint32_t >( selectLod( transform, smallScaleSq, uniforms ) );
+            if ( !isInstanceVisible( transform, largeScaleSq, uniforms ) || listedLod[ i ] < finestLod || listedLod[ i ] > coarsestLod )
+            {
+                return false;
+            }
+        }
+        return true;
+    }
+}
@@ -0,0 +1,106 @@
+//
+//  InstanceCulling.hpp
+//  Point_Cloud_Renderer
+//
+//  Created by Vatsalya Yadav on 10/19/26.
+//
+
+#ifndef InstanceCulling_hpp
+#define InstanceCulling_hpp
+
+#include <cstddef>
+#include <cstdint>
+
+#include <simd/simd.h>
+
+#include "Renderer/Data/Constants.hpp"
+#include "Renderer/Structures/CompactInstanceData.hpp"
+#include "Renderer/Structures/CullUniforms.hpp"
+#include "Renderer/Structures/InstanceData.hpp"
+
+// CPU emulation of cull_instances in InstanceCull_Compute.metal. Every multiply-add is
+// an explicit fma on both sides and the remaining operations are single multiplies and
+// compares, so fast-math can't reorder anything and for InstanceData each visibility
+// decision matches the GPU bit for bit, and so does each LOD choice. Compact instances
+// are decoded first, which only agrees to a tolerance, see matchesReference.
+namespace PCR::InstanceCulling
+{
+    // Values of the instanceLod function constant in Basic.metal, finest first
+    enum class InstanceLod : uint32_t
+    {
+        // The whole cube, 36 indices
+        Full,
+        
+        // The three faces towards the camera, 18 indices
+        Reduced,
+        
+        // One camera-facing quad, 6 indices
+        Impostor
+    };
+
+    // Every LOD draws a prefix of the cube's index list, see Renderer::buildBuffers
+    constexpr uint32_t LOD_INDEX_COUNTS[ INSTANCE_LOD_COUNT ]{ 6 * 6, 3 * 6, 6 };
+
+    // Same layout as MTL::DrawIndexedPrimitivesIndirectArguments
+    struct DrawIndexedArguments
+    {
+        uint32_t indexCount = 0;
+        
+        uint32_t instanceCount = 0;
+        
+        uint32_t indexStart = 0;
+        
+        int32_t baseVertex = 0;
+        
+        uint32_t baseInstance = 0;
+    };
+
+    // Metal clip space, 0 <= z <= w
+    void extractFrustumPlanes( const simd::float4x4& viewProjection, simd::float4* pPlanes );
+
+    // Every visible instance goes to the Full list until setLodDistances
+    CullUniforms makeUniforms( const simd::float4x4& viewProjection, float boundingRadius, uint32_t instanceCount );
+
+    // Distances in multiples of the instance's scale, so larger instances keep detail longer
+    void setLodDistances( CullUniforms& uniforms, const simd::float3& cameraPosition, float reducedDistance, float impostorDistance );
+
+    bool isInstanceVisible( const simd::float4x4& transform, const CullUniforms& uniforms );
+
+    InstanceLod selectLod( const simd::float4x4& transform, const CullUniforms& uniforms );
+
+    // Buckets the visible instances by LOD: list l of pVisibleInstances, which starts at
+    // l * uniforms.lodListCapacity, gets its indices in ascending order and pArguments[ l ]
+    // counts them. pArguments holds INSTANCE_LOD_COUNT draws with the frame's initial values
+    // like the GPU buffer does.
+    void cullInstances( const InstanceData* pInstances,
+                        const CullUniforms& uniforms,
+                        uint32_t* pVisibleInstances,
+                        DrawIndexedArguments* pArguments );
+
+    // Decodes each instance with CompactInstance::decode, the same normalize and rotation
+    // rebuild as loadInstance in the kernel
+    void cullInstances( const CompactInstanceData* pInstances,
+                        const CullUniforms& uniforms,
+                        uint32_t* pVisibleInstances,
+                        DrawIndexedArguments* pArguments );
+
+    // The kernel appends with an atomic so its order varies, compares each list as a set
+    bool matchesReference( const InstanceData* pInstances,
+                           const CullUniforms& uniforms,
+                           const uint32_t* pVisibleInstances,
+                           const DrawIndexedArguments* pArguments );
+
+    // Under fast-math the kernel's normalize may round differently from the host's, which
+    // moves the decoded scale by a few ulps; translations are stored as is. An instance
+    // whose visibility or LOD flips within COMPACT_SCALE_TOLERANCE of its scale may be in
+    // either list, every other one has to be exactly where the reference puts it.
+    bool matchesReference( const CompactInstanceData* pInstances,
+                           const CullUniforms& uniforms,
+                           const uint32_t* pVisibleInstances,
+                           const DrawIndexedArguments* pArguments );
+
+    // Relative, on the squared scale of a decoded compact instance
+    constexpr float COMPACT_SCALE_TOLERANCE{ 1e-5f };
+}
+
+#endif /* InstanceCulling_hpp */
@@ -0,0 +1,250 @@
+//
+//  LodBenchmark.cpp
+//  Point_Cloud_Renderer
+//
+//  Created by Vatsalya Yadav on 10/19/26.
+//
+
+#include "LodBenchmark.hpp"
+
+#include <algorithm>
+#include <array>
+#include <chrono>
+#include <random>
+#include <vector>
+
+#include "Math/Utility.hpp"
+#include "Renderer/Culling/InstanceCulling.hpp"
+#include "Renderer/Instances/InstanceStore.hpp"
+#include "Renderer/Validation/CheckReport.hpp"
+
+namespace PCR
+{
+    namespace
+    {
+        // What Renderer::draw uses
+        constexpr float CUBE_BOUNDING_RADIUS{ 0.5f * 1.7320508f };
+        
+        constexpr float FIELD_SCALE{ 0.2f };
+        
+        // Unique vertices each LOD's index prefix touches
+        constexpr uint32_t LOD_VERTEX_COUNTS[ INSTANCE_LOD_COUNT ]{ 24, 12, 4 };
+        
+        constexpr const char* LOD_NAMES[ INSTANCE_LOD_COUNT ]{ "full", "reduced", "impostor" };
+        
+        struct Placement
+        {
+            simd::float3 translation;
+            
+            float scale;
+        };
+        
+        // Camera at the origin looking down -Z, like Renderer::draw
+        simd::float4x4 makeViewProjection()
+        {
+            return Math::makePerspective( 45.0f * M_PI / 180.0f, 1.0f, 0.03f, 500.0f );
+        }
+        
+        // Full and compact copies of the same instances, from the same store path the renderer uses
+        void buildInstances( const std::vector< Placement >& placements, std::vector< InstanceData >& instances, std::vector< CompactInstanceData >& compactInstances )
+        {
+            const size_t count = placements.size();
+            InstanceStore store( count );
+            for ( size_t i = 0; i < count; ++i )
+            {
+                store.setTranslation( i, placements[ i ].translation );
+                store.setScale( i, simd::float3{ placements[ i ].scale, placements[ i ].scale, placements[ i ].scale } );
+                store.setColor( i, simd::float4{ 1.0f, 1.0f, 1.0f, 1.0f } );
+            }
+            
+            instances.resize( count );
+            compactInstances.resize( count );
+            const simd::float4x4 identity = Math::makeTranslate( simd::float3{ 0.0f, 0.0f, 0.0f } );
+            store.composeTransforms( identity, instances.data(), 0, count );
+            store.encodeCompactTransforms( identity, compactInstances.data(), 0, count );
+        }
+        
+        CullUniforms makeUniforms( uint32_t instanceCount, bool withLod )
+        {
+            CullUniforms uniforms = InstanceCulling::makeUniforms( makeViewProjection(), CUBE_BOUNDING_RADIUS, instanceCount );
+            if ( withLod )
+            {
+                InstanceCulling::setLodDistances( uniforms, simd::float3{ 0.0f, 0.0f, 0.0f }, INSTANCE_LOD_REDUCED_DISTANCE, INSTANCE_LOD_IMPOSTOR_DISTANCE );
+            }
+            return uniforms;
+        }
+        
+        // The lists and counts the cull produced
+        struct Buckets
+        {
+            std::vector< uint32_t > visibleInstances;
+            
+            std::array< InstanceCulling::DrawIndexedArguments, INSTANCE_LOD_COUNT > arguments;
+            
+            std::vector< uint32_t > getList( uint32_t lod, uint32_t capacity ) const
+            {
+                const auto first = visibleInstances.begin() + static_cast< ptrdiff_t >( lod ) * capacity;
+                return std::vector< uint32_t >( first, first + arguments[ lod ].instanceCount );
+            }
+        };
+        
+        template < typename Instance >
+        Buckets bucket( const Instance* pInstances, const CullUniforms& uniforms )
+        {
+            Buckets buckets;
+            buckets.visibleInstances.assign( static_cast< size_t >( uniforms.lodListCapacity ) * INSTANCE_LOD_COUNT, UINT32_MAX );
+            for ( uint32_t lod = 0; lod < INSTANCE_LOD_COUNT; ++lod )
+            {
+                buckets.arguments[ lod ] = InstanceCulling::DrawIndexedArguments{};
+                buckets.arguments[ lod ].indexCount = InstanceCulling::LOD_INDEX_COUNTS[ lod ];
+            }
+            InstanceCulling::cullInstances( pInstances, uniforms, buckets.visibleInstances.data(), buckets.arguments.data() );
+            return buckets;
+        }
+        
+        void checkPlacedInstances( CheckReport& report )
+        {
+            // Scale 0.2 switches at 12 and 50 units, scale 1 at 60 and 250
+            const std::vector< Placement > placements
+            {
+                { { 0.0f, 0.0f, -5.0f }, FIELD_SCALE },      // 0 full
+                { { 0.0f, 0.0f, -20.0f }, FIELD_SCALE },     // 1 reduced
+                { { 1.0f, 0.0f, -80.0f }, FIELD_SCALE },     // 2 impostor
+                { { 0.0f, 0.0f, 5.0f }, FIELD_SCALE },       // 3 behind the camera
+                { { 0.0f, 0.0f, -20.0f }, 1.0f },            // 4 full, larger instances keep detail longer
+                { { 200.0f, 0.0f, -5.0f }, FIELD_SCALE },    // 5 outside the left/right planes
+                { { 0.0f, 0.0f, -11.9f }, FIELD_SCALE },     // 6 just inside the reduced distance
+                { { 0.0f, 0.0f, -12.1f }, FIELD_SCALE },     // 7 just past it
+                { { 0.0f, 0.0f, -49.9f }, FIELD_SCALE },     // 8 just inside the impostor distance
+                { { 0.0f, 0.0f, -50.1f }, FIELD_SCALE },     // 9 just past it
+                { { 0.0f, 0.0f, -600.0f }, FIELD_SCALE }     // 10 past the far plane
+            };
+            const std::array< std::vector< uint32_t >, INSTANCE_LOD_COUNT > expectedLists{ std::vector< uint32_t >{ 0, 4, 6 },
+                                                                                           std::vector< uint32_t >{ 1, 7, 8 },
+                                                                                           std::vector< uint32_t >{ 2, 9 } };
+            
+            std::vector< InstanceData > instances;
+            std::vector< CompactInstanceData > compactInstances;
+            buildInstances( placements, instances, compactInstances );
+            const auto count = static_cast< uint32_t >( placements.size() );
+            
+            const CullUniforms uniforms = makeUniforms( count, true );
+            const Buckets full = bucket( instances.data(), uniforms );
+            const Buckets compact = bucket( compactInstances.data(), uniforms );
+            
+            bool listsMatch = true;
+            bool countsMatch = true;
+            bool indexCountsKept = true;
+            bool compactMatches = true;
+            for ( uint32_t lod = 0; lod < INSTANCE_LOD_COUNT; ++lod )
+            {
+                listsMatch = listsMatch && full.getList( lod, count ) == expectedLists[ lod ];
+                countsMatch = countsMatch && full.arguments[ lod ].instanceCount == expectedLists[ lod ].size();
+                indexCountsKept = indexCountsKept && full.arguments[ lod ].indexCount == InstanceCulling::LOD_INDEX_COUNTS[ lod ];
+                compactMatches = compactMatches && compact.getList( lod, count ) == expectedLists[ lod ];
+            }
+            report.expect( countsMatch, "placed instances: 3 full, 3 reduced, 2 impostor, 3 culled" );
+            report.expect( listsMatch, "placed instances: each list holds the expected indices in ascending order" );
+            report.expect( indexCountsKept, "placed instances: the cull leaves each LOD's index count alone" );
+            report.expect( compactMatches, "placed instances: compact instances bucket the same way" );
+            report.expect( InstanceCulling::matchesReference( instances.data(), uniforms, full.visibleInstances.data(), full.arguments.data() )
+                        && InstanceCulling::matchesReference( compactInstances.data(), uniforms, compact.visibleInstances.data(), compact.arguments.data() ),
+                           "placed instances: matchesReference accepts both layouts" );
+            
+            // Without distances every visible instance stays on the full list
+            const Buckets unlodded = bucket( instances.data(), makeUniforms( count, false ) );
+            report.expect( unlodded.getList( 0, count ) == std::vector< uint32_t >{ 0, 1, 2, 4, 6, 7, 8, 9 }
+                        && unlodded.arguments[ 1 ].instanceCount == 0
+                        && unlodded.arguments[ 2 ].instanceCount == 0,
+                           "placed instances: without LOD distances all 8 visible go to the full list" );
+            
+            // Listed in reverse, as the atomics in the kernel could leave them
+            Buckets shuffled = full;
+            std::reverse( shuffled.visibleInstances.begin(), shuffled.visibleInstances.begin() + full.arguments[ 0 ].instanceCount );
+            report.expect( InstanceCulling::matchesReference( instances.data(), uniforms, shuffled.visibleInstances.data(), shuffled.arguments.data() ),
+                           "placed instances: list order doesn't matter to matchesReference" );
+            
+            Buckets moved = full;
+            moved.visibleInstances[ count + 0 ] = 0;
+            report.expect( !InstanceCulling::matchesReference( instances.data(), uniforms, moved.visibleInstances.data(), moved.arguments.data() ),
+                           "placed instances: an instance in the wrong list is caught" );
+        }
+        
+        void benchmarkField( CheckReport& report, size_t instanceCount )
+        {
+            // Fixed seed and plain modulo, the same field on every standard library. The box
+            // covers the view out to where even the impostors are a few pixels.
+            std::mt19937 random( 0x10D );
+            auto uniform = [ & ]( float low, float high ){
+                return low + ( high - low ) * static_cast< float >( random() % 1000000 ) / 1000000.0f;
+            };
+            std::vector< Placement > placements( instanceCount );
+            for ( Placement& placement : placements )
+            {
+                placement.translation = simd::float3{ uniform( -60.0f, 60.0f ), uniform( -60.0f, 60.0f ), uniform( -150.0f, -1.0f ) };
+                placement.scale = FIELD_SCALE;
+            }
+            
+            std::vector< InstanceData > instances;
+            std::vector< CompactInstanceData > compactInstances;
+            buildInstances( placements, instances, compactInstances );
+            const auto count = static_cast< uint32_t >( instanceCount );
+            const CullUniforms uniforms = makeUniforms( count, true );
+            
+            const auto start = std::chrono::steady_clock::now();
+            const Buckets buckets = bucket( instances.data(), uniforms );
+            const double cullMs = std::chrono::duration< double, std::milli >( std::chrono::steady_clock::now() - start ).count();
+            
+            uint32_t visibleCount = 0;
+            for ( uint32_t i = 0; i < count; ++i )
+            {
+                visibleCount += InstanceCulling::isInstanceVisible( instances[ i ].transform, uniforms ) ? 1 : 0;
+            }
+            
+            uint32_t listedCount = 0;
+            uint64_t lodIndices = 0;
+            uint64_t lodVertices = 0;
+            __builtin_printf( "%zu random cubes of scale %.1f, %u visible, CPU cull %.2f ms\n", instanceCount, FIELD_SCALE, visibleCount, cullMs );
+            __builtin_printf( "%10s %10s %8s %12s %12s\n", "lod", "instances", "share", "indices", "vertices" );
+            for ( uint32_t lod = 0; lod < INSTANCE_LOD_COUNT; ++lod )
+            {
+                const uint32_t lodCount = buckets.arguments[ lod ].instanceCount;
+                const uint64_t indices = static_cast< uint64_t >( lodCount ) * InstanceCulling::LOD_INDEX_COUNTS[ lod ];
+                const uint64_t vertices = static_cast< uint64_t >( lodCount ) * LOD_VERTEX_COUNTS[ lod ];
+                listedCount += lodCount;
+                lodIndices += indices;
+                lodVertices += vertices;
+                __builtin_printf( "%10s %10u %7.1f%% %12llu %12llu\n",
+                                  LOD_NAMES[ lod ],
+                                  lodCount,
+                                  visibleCount ? 100.0 * lodCount / visibleCount : 0.0,
+                                  static_cast< unsigned long long >( indices ),
+                                  static_cast< unsigned long long >( vertices ) );
+            }
+            
+            const uint64_t fullIndices = static_cast< uint64_t >( visibleCount ) * InstanceCulling::LOD_INDEX_COUNTS[ 0 ];
+            const uint64_t fullVertices = static_cast< uint64_t >( visibleCount ) * LOD_VERTEX_COUNTS[ 0 ];
+            __builtin_printf( "%10s %10u %8s %12llu %12llu\n", "all full", visibleCount, "", static_cast< unsigned long long >( fullIndices ), static_cast< unsigned long long >( fullVertices ) );
+            __builtin_printf( "Indices drawn cut %.1fx, vertices %.1fx, the index floor is %.1fx\n",
+                              lodIndices ? static_cast< double >( fullIndices ) / lodIndices : 0.0,
+                              lodVertices ? static_cast< double >( fullVertices ) / lodVertices : 0.0,
+                              static_cast< double >( InstanceCulling::LOD_INDEX_COUNTS[ 0 ] ) / InstanceCulling::LOD_INDEX_COUNTS[ INSTANCE_LOD_COUNT - 1 ] );
+            
+            report.expect( listedCount == visibleCount, "field: every visible instance is in exactly one list" );
+            report.expect( InstanceCulling::matchesReference( instances.data(), uniforms, buckets.visibleInstances.data(), buckets.arguments.data() ),
+                           "field: the lists match the reference" );
+            
+            const Buckets compact = bucket( compactInstances.data(), uniforms );
+            report.expect( InstanceCulling::matchesReference( compactInstances.data(), uniforms, compact.visibleInstances.data(), compact.arguments.data() ),
+                           "field: compact lists match the compact reference" );
+        }
+    }
+
+    bool runLodBenchmark( size_t fieldInstanceCount )
+    {
+        CheckReport report( "Instance LOD bucketing" );
+        checkPlacedInstances( report );
+        benchmarkField( report, fieldInstanceCount );
+        return report.finish();
+    }
+}
@@ -12,13 +12,58 @@ namespace PCR
 {
     constexpr int MAX_FRAMES_IN_FLIGHT{ 3 };
     
-    constexpr int INSTANCE_ROWS{ 10 };
-    constexpr int INSTANCE_COLUMNS{ 10 };
-    constexpr int INSTANCE_DEPTH{ 10 };
-    constexpr size_t MAX_NUM_INSTANCES{ INSTANCE_ROWS * INSTANCE_COLUMNS * INSTANCE_DEPTH };
+    // Grid the renderer starts with, Renderer::setInstanceGrid changes it at runtime
+    constexpr uint32_t DEFAULT_INSTANCE_ROWS{ 10 };
+    constexpr uint32_t DEFAULT_INSTANCE_COLUMNS{ 10 };
+    constexpr uint32_t DEFAULT_INSTANCE_DEPTH{ 10 };
+    
+    // Instance pools start this large and double whenever they're outgrown
+    constexpr size_t INSTANCE_POOL_MIN_CAPACITY{ 1024 };
+    
+    // Full mesh, reduced mesh, impostor
+    constexpr uint32_t INSTANCE_LOD_COUNT{ 3 };
+    
+    // Camera distance in multiples of the instance's scale past which each coarser LOD takes over
+    constexpr float INSTANCE_LOD_REDUCED_DISTANCE{ 60.0f };
+    constexpr float INSTANCE_LOD_IMPOSTOR_DISTANCE{ 250.0f };
     
     constexpr uint32_t DEFAULT_TEXTURE_WIDTH{ 128 };
     constexpr uint32_t DEFAULT_TEXTURE_HEIGHT{ 128 };
+    
+    constexpr uint32_t POINT_RASTER_TILE_SIZE{ 32 };
+    constexpr uint32_t POINT_RASTER_TILE_PIXELS{ POINT_RASTER_TILE_SIZE * POINT_RASTER_TILE_SIZE };
+    
+    constexpr uint32_t POINT_NODE_SIZE{ 4096 };
+    constexpr uint32_t REPROJECTION_REFRESH_PERIOD{ 4 };
+    
+    constexpr int32_t SPLAT_DEFAULT_RADIUS{ 1 };
+    constexpr float SPLAT_DEFAULT_DEPTH_EPSILON{ 0.01f };
+    
+    // --validate-gpu lets a splat pixel's 8-bit channels be this far off SplatRasterizer's, and
+    // this share of the pixels differ by more, see SplatRasterizer for why they aren't exact
+    constexpr uint32_t SPLAT_VALIDATION_CHANNEL_TOLERANCE{ 1 };
+    constexpr float SPLAT_VALIDATION_PIXEL_TOLERANCE{ 0.01f };
+    
+    constexpr const char* PIPELINE_MANIFEST_FILE_NAME{ "Point_Cloud_Renderer_Pipelines.txt" };
+    
+    constexpr uint32_t FUNCTION_CONSTANT_COLOR_MODE{ 0 };
+    constexpr uint32_t FUNCTION_CONSTANT_INSTANCE_INDIRECTION{ 1 };
+    constexpr uint32_t FUNCTION_CONSTANT_COMPACT_INSTANCES{ 2 };
+    constexpr uint32_t FUNCTION_CONSTANT_INSTANCE_LOD{ 3 };
+    
+    constexpr size_t PARALLEL_ENCODE_MIN_ITEMS{ 256 };
+    
+    constexpr size_t UPLOAD_STAGING_SIZE{ 64 * 1024 * 1024 };
+    constexpr size_t UPLOAD_FRAME_BUDGET{ 8 * 1024 * 1024 };
+    
+    // Multiple of every FloatLanes::WIDTH, so only the last chunk has a scalar tail
+    constexpr size_t INSTANCE_UPDATE_GRAIN_SIZE{ 4096 };
+    
+    // Bytes per EntityWorld chunk, each archetype fits as many entities into one as it can
+    constexpr size_t ENTITY_CHUNK_SIZE{ 16 * 1024 };
+    
+    // --validate-gpu draws this many frames with each instance format, animation path and render path, and with splats
+    constexpr uint32_t GPU_VALIDATION_FRAMES_PER_CONFIGURATION{ 30 };
 }
 
 #endif /* Constants_hpp */
@@ -0,0 +1,197 @@
+//
+//  DynamicResolutionCheck.cpp
+//  Point_Cloud_Renderer
+//
+//  Created by Vatsalya Yadav on 10/19/26.
+//
+
+#include "DynamicResolutionCheck.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <vector>
+
+#include "Renderer/DynamicResolution/DynamicResolutionController.hpp"
+#include "Renderer/Validation/CheckReport.hpp"
+
+namespace PCR
+{
+    namespace
+    {
+        // A spike has to be under target again within this many frames. A jump from a light
+        // load lags the most, the average has to climb out of the light frames before the
+        // last step down, which takes 18 frames at the default smoothing.
+        constexpr size_t SETTLE_FRAMES{ 20 };
+        
+        constexpr size_t PHASE_FRAMES{ 400 };
+        
+        constexpr double LIGHT_CPU_MS{ 4.0 };
+        
+        // Floating point slack on scale comparisons
+        constexpr float SCALE_EPSILON{ 1e-4f };
+        
+        struct TraceFrame
+        {
+            float scale = 1.0f;
+            
+            double gpuMs = 0.0;
+            
+            bool changed = false;
+        };
+        
+        // fullScaleGpuMs( frame ) is the load at scale 1, each frame costs that times scale squared
+        std::vector< TraceFrame > runTrace( DynamicResolutionController& controller,
+                                            size_t frameCount,
+                                            const std::function< double( size_t ) >& fullScaleGpuMs,
+                                            double cpuMs = LIGHT_CPU_MS )
+        {
+            std::vector< TraceFrame > trace;
+            for ( size_t frame = 0; frame < frameCount; ++frame )
+            {
+                TraceFrame sample;
+                const float scale = controller.getScale();
+                sample.gpuMs = fullScaleGpuMs( frame ) * scale * scale;
+                sample.changed = controller.addFrame( cpuMs, sample.gpuMs );
+                sample.scale = controller.getScale();
+                trace.push_back( sample );
+            }
+            return trace;
+        }
+        
+        bool withinBounds( const std::vector< TraceFrame >& trace, const DynamicResolutionSettings& settings )
+        {
+            return std::all_of( trace.begin(), trace.end(), [ & ]( const TraceFrame& frame ){
+                return frame.scale >= settings.minScale - SCALE_EPSILON && frame.scale <= settings.maxScale + SCALE_EPSILON;
+            });
+        }
+        
+        // Every frame from SETTLE_FRAMES after begin until end is under target
+        bool settles( const std::vector< TraceFrame >& trace, size_t begin, size_t end, double targetMs )
+        {
+            for ( size_t frame = begin + SETTLE_FRAMES; frame < end; ++frame )
+            {
+                if ( trace[ frame ].gpuMs > targetMs )
+                {
+                    return false;
+                }
+            }
+            return true;
+        }
+        
+        size_t countChanges( const std::vector< TraceFrame >& trace, size_t begin, size_t end )
+        {
+            return static_cast< size_t >( std::count_if( trace.begin() + static_cast< std::ptrdiff_t >( begin ), trace.begin() + static_cast< std::ptrdiff_t >( end ), []( const TraceFrame& frame ){ return frame.changed; } ) );
+        }
+        
+        void checkSpikeTrace( CheckReport& report )
+        {
+            const DynamicResolutionSettings settings;
+            DynamicResolutionController controller( settings );
+            
+            // 30 ms, then 8 ms, then 30 ms again, all at full scale
+            const std::vector< TraceFrame > trace = runTrace( controller, 3 * PHASE_FRAMES, []( size_t frame ){
+                return frame / PHASE_FRAMES == 1 ? 8.0 : 30.0;
+            });
+            
+            report.expect( withinBounds( trace, settings ), "30 / 8 / 30 ms: the scale stays inside [ minScale, maxScale ]" );
+            report.expect( settles( trace, 0, PHASE_FRAMES, settings.targetFrameMs ) && settles( trace, 2 * PHASE_FRAMES, 3 * PHASE_FRAMES, settings.targetFrameMs ),
+                           "30 / 8 / 30 ms: under target within 20 frames of each spike" );
+            report.expect( countChanges( trace, SETTLE_FRAMES, PHASE_FRAMES ) == 0 && countChanges( trace, 2 * PHASE_FRAMES + SETTLE_FRAMES, 3 * PHASE_FRAMES ) == 0,
+                           "30 / 8 / 30 ms: the scale holds once settled under a steady load" );
+            
+            // Coming back up: one step at a time, never sooner than the delay after the last change.
+            // The frames at 0.7 during the first spike were already under budget, so the first
+            // step can come as soon as the load drops.
+            bool singleSteps = true;
+            bool delayed = true;
+            size_t lastChange = 0;
+            for ( size_t frame = 1; frame < 2 * PHASE_FRAMES; ++frame )
+            {
+                if ( !trace[ frame ].changed )
+                {
+                    continue;
+                }
+                if ( frame >= PHASE_FRAMES )
+                {
+                    singleSteps = singleSteps && std::fabs( trace[ frame ].scale - trace[ frame - 1 ].scale - settings.scaleStep ) < SCALE_EPSILON;
+                    delayed = delayed && frame - lastChange >= settings.upscaleDelayFrames;
+                }
+                lastChange = frame;
+            }
+            report.expect( singleSteps, "30 / 8 / 30 ms: the scale climbs back one step at a time" );
+            report.expect( delayed, "30 / 8 / 30 ms: each step up waits upscaleDelayFrames under budget" );
+            report.expect( std::fabs( trace[ 2 * PHASE_FRAMES - 1 ].scale - settings.maxScale ) < SCALE_EPSILON, "30 / 8 / 30 ms: full scale again before the second spike" );
+        }
+        
+        void checkRamp( CheckReport& report )
+        {
+            const DynamicResolutionSettings settings;
+            DynamicResolutionController controller( settings );
+            
+            // 8 ms up to 40 ms and back down, past what minScale can absorb at the top
+            const std::vector< TraceFrame > trace = runTrace( controller, 2 * PHASE_FRAMES, []( size_t frame ){
+                const double t = frame < PHASE_FRAMES ? static_cast< double >( frame ) / PHASE_FRAMES : static_cast< double >( 2 * PHASE_FRAMES - frame ) / PHASE_FRAMES;
+                return 8.0 + 32.0 * t;
+            });
+            
+            bool noStepUpWhileRising = true;
+            for ( size_t frame = 1; frame < PHASE_FRAMES; ++frame )
+            {
+                noStepUpWhileRising = noStepUpWhileRising && trace[ frame ].scale <= trace[ frame - 1 ].scale;
+            }
+            
+            // Over target only while the average catches up with a step of the ramp
+            const auto overTarget = std::count_if( trace.begin(), trace.end(), [ & ]( const TraceFrame& frame ){
+                return frame.gpuMs > settings.targetFrameMs * 1.05;
+            });
+            
+            report.expect( withinBounds( trace, settings ), "ramp: the scale stays inside [ minScale, maxScale ]" );
+            report.expect( noStepUpWhileRising, "ramp: never steps up while the load rises" );
+            report.expect( overTarget <= static_cast< std::ptrdiff_t >( SETTLE_FRAMES ), "ramp: frames stay within 5% of target" );
+            report.expect( std::fabs( trace.back().scale - settings.maxScale ) < 2.0f * settings.scaleStep, "ramp: back near full scale once the load is light again" );
+            
+            DynamicResolutionController overloaded( settings );
+            const std::vector< TraceFrame > overloadTrace = runTrace( overloaded, PHASE_FRAMES, []( size_t ){ return 200.0; } );
+            report.expect( withinBounds( overloadTrace, settings ) && std::fabs( overloadTrace.back().scale - settings.minScale ) < SCALE_EPSILON,
+                           "overload: a load minScale can't absorb pins the scale at minScale" );
+        }
+        
+        void checkHysteresis( CheckReport& report )
+        {
+            const DynamicResolutionSettings settings;
+            
+            // Jitter of up to 8% around 95% of the budget at scale 0.75, deterministic
+            DynamicResolutionController jittered( settings );
+            const double steadyMs = settings.targetFrameMs * settings.headroom * 0.95 / ( 0.75 * 0.75 );
+            const std::vector< TraceFrame > trace = runTrace( jittered, 2 * PHASE_FRAMES, [ & ]( size_t frame ){
+                return steadyMs * ( 1.0 + 0.08 * std::sin( 0.7 * static_cast< double >( frame ) ) * std::cos( 0.13 * static_cast< double >( frame ) ) );
+            });
+            report.expect( countChanges( trace, SETTLE_FRAMES, trace.size() ) == 0, "hysteresis: jitter around the budget doesn't move the scale" );
+            
+            // CPU bound with the GPU mostly idle, a lower resolution wouldn't help
+            DynamicResolutionController cpuBound( settings );
+            const std::vector< TraceFrame > cpuTrace = runTrace( cpuBound, PHASE_FRAMES, []( size_t ){ return 10.0; }, 25.0 );
+            report.expect( countChanges( cpuTrace, 0, cpuTrace.size() ) == 0 && std::fabs( cpuTrace.back().scale - settings.maxScale ) < SCALE_EPSILON,
+                           "CPU bound: the scale is left alone" );
+            
+            DynamicResolutionController sized( settings );
+            runTrace( sized, PHASE_FRAMES, []( size_t ){ return 30.0; } );
+            uint32_t width = 0;
+            uint32_t height = 0;
+            sized.getRenderSize( 1024, 1000, width, height );
+            report.expect( width % 8 == 0 && height % 8 == 0 && width < 1024 && height < 1000, "render size: scaled, on multiples of 8, inside the output" );
+        }
+    }
+
+    bool runDynamicResolutionChecks()
+    {
+        CheckReport report( "Dynamic resolution, synthetic frame-time traces" );
+        checkSpikeTrace( report );
+        checkRamp( report );
+        checkHysteresis( report );
+        return report.finish();
+    }
+}
@@ -0,0 +1,22 @@
+//
+//  DynamicResolutionCheck.hpp
+//  Point_Cloud_Renderer
+//
+//  Created by Vatsalya Yadav on 10/19/26.
+//
+
+#ifndef DynamicResolutionCheck_hpp
+#define DynamicResolutionCheck_hpp
+
+namespace PCR
+{
+    // DynamicResolutionController against synthetic traces where GPU time follows the scale
+    // squared: a 30 / 8 / 30 ms load at full scale, a ramp up and back down, jitter around
+    // the budget and a CPU-bound stretch. The scale has to stay inside its bounds, get the
+    // frame back under target within a few frames of a spike, climb back one step per delay
+    // and hold still while the load only jitters.
+    // Returns false if any check fails.
+    bool runDynamicResolutionChecks();
+}
+
+#endif /* DynamicResolutionCheck_hpp */
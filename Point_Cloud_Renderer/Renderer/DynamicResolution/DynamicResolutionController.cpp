@@ -0,0 +1,142 @@
+//
+//  DynamicResolutionController.cpp
+//  Point_Cloud_Renderer
+//
+//  Created by Vatsalya Yadav on 10/19/26.
+//
+
+#include "DynamicResolutionController.hpp"
+
+#include <algorithm>
+#include <cmath>
+
+namespace PCR
+{
+    namespace
+    {
+        constexpr uint32_t RENDER_SIZE_ALIGNMENT{ 8 };
+        
+        uint32_t alignRenderSize( float size, uint32_t outputSize )
+        {
+            const auto aligned = static_cast< uint32_t >( size / RENDER_SIZE_ALIGNMENT + 0.5f ) * RENDER_SIZE_ALIGNMENT;
+            return std::clamp( aligned, std::min( RENDER_SIZE_ALIGNMENT, outputSize ), outputSize );
+        }
+    }
+
+    DynamicResolutionController::DynamicResolutionController( const DynamicResolutionSettings& settings /* = DynamicResolutionSettings{} */ )
+    :   _settings{ settings }
+    {
+        reset();
+    }
+
+    bool DynamicResolutionController::addFrame( double cpuFrameMs, double gpuFrameMs )
+    {
+        if ( !_hasSample )
+        {
+            _smoothedGpuMs = gpuFrameMs;
+            _hasSample = true;
+        }
+        else
+        {
+            _smoothedGpuMs += ( gpuFrameMs - _smoothedGpuMs ) * _settings.smoothing;
+        }
+        
+        const double budgetMs = _settings.targetFrameMs * _settings.headroom;
+        
+        // CPU bound, resolution wouldn't help either way
+        if ( cpuFrameMs > _settings.targetFrameMs && _smoothedGpuMs <= budgetMs )
+        {
+            _framesUnderBudget = 0;
+            return false;
+        }
+        
+        const float idealScale = _scale * static_cast< float >( std::sqrt( budgetMs / std::max( _smoothedGpuMs, 1e-3 ) ) );
+        
+        if ( _smoothedGpuMs > _settings.targetFrameMs )
+        {
+            _framesUnderBudget = 0;
+            
+            const float newScale = std::max( quantizeDown( idealScale ), _settings.minScale );
+            if ( newScale < _scale )
+            {
+                applyScale( newScale );
+                return true;
+            }
+            return false;
+        }
+        
+        if ( _smoothedGpuMs > budgetMs )
+        {
+            _framesUnderBudget = 0;
+            return false;
+        }
+        
+        if ( ++_framesUnderBudget < _settings.upscaleDelayFrames )
+        {
+            return false;
+        }
+        
+        const float newScale = std::min( { quantizeDown( idealScale ), _scale + _settings.scaleStep, _settings.maxScale } );
+        if ( newScale > _scale )
+        {
+            applyScale( newScale );
+            return true;
+        }
+        
+        return false;
+    }
+
+    float DynamicResolutionController::getScale() const
+    {
+        return _scale;
+    }
+
+    double DynamicResolutionController::getSmoothedGpuFrameMs() const
+    {
+        return _smoothedGpuMs;
+    }
+
+    void DynamicResolutionController::getRenderSize( uint32_t outputWidth,
+                                                     uint32_t outputHeight,
+                                                     uint32_t& outWidth,
+                                                     uint32_t& outHeight ) const
+    {
+        outWidth = alignRenderSize( outputWidth * _scale, outputWidth );
+        outHeight = alignRenderSize( outputHeight * _scale, outputHeight );
+    }
+
+    const DynamicResolutionSettings& DynamicResolutionController::getSettings() const
+    {
+        return _settings;
+    }
+
+    void DynamicResolutionController::setSettings( const DynamicResolutionSettings& settings )
+    {
+        _settings = settings;
+        _scale = std::clamp( _scale, _settings.minScale, _settings.maxScale );
+    }
+
+    void DynamicResolutionController::reset()
+    {
+        _scale = _settings.maxScale;
+        _smoothedGpuMs = 0.0;
+        _framesUnderBudget = 0;
+        _hasSample = false;
+    }
+
+    float DynamicResolutionController::quantizeDown( float scale ) const
+    {
+        // Small bias so a scale that is already on a step doesn't fall to the one below
+        return std::floor( scale / _settings.scaleStep + 1e-3f ) * _settings.scaleStep;
+    }
+
+    void DynamicResolutionController::applyScale( float scale )
+    {
+        // The average was measured at the old resolution, carry it over so the
+        // next frames don't react to the same overload twice
+        const float ratio = scale / _scale;
+        _smoothedGpuMs *= ratio * ratio;
+        _scale = scale;
+        _framesUnderBudget = 0;
+    }
+}
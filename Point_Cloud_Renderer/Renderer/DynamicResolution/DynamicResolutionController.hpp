@@ -0,0 +1,80 @@
+//
+//  DynamicResolutionController.hpp
+//  Point_Cloud_Renderer
+//
+//  Created by Vatsalya Yadav on 10/19/26.
+//
+
+#ifndef DynamicResolutionController_hpp
+#define DynamicResolutionController_hpp
+
+#include <cstdint>
+
+namespace PCR
+{
+    struct DynamicResolutionSettings
+    {
+        double targetFrameMs = 1000.0 / 60.0;
+        
+        float minScale = 0.5f;
+        
+        float maxScale = 1.0f;
+        
+        // Scale is kept on multiples of this, so small jitter doesn't reallocate anything
+        float scaleStep = 0.05f;
+        
+        // Aim for this fraction of the target to leave room for spikes
+        double headroom = 0.9;
+        
+        // Weight of the newest sample in the moving average
+        double smoothing = 0.2;
+        
+        // Consecutive frames under budget before the scale is allowed to go up
+        uint32_t upscaleDelayFrames = 30;
+    };
+
+    // Picks the internal render scale from measured frame times. Only the GPU time
+    // responds to resolution, so a frame that is CPU bound leaves the scale alone.
+    // GPU cost is assumed to follow pixel count, i.e. scale squared. The scale drops as
+    // soon as the average goes over target and climbs back one step at a time.
+    //
+    // Nothing in here touches Metal, it can be driven with synthetic frame times.
+    class DynamicResolutionController
+    {
+    public:
+        explicit DynamicResolutionController( const DynamicResolutionSettings& settings = DynamicResolutionSettings{} );
+        
+        // Returns true if the scale changed.
+        bool addFrame( double cpuFrameMs, double gpuFrameMs );
+        
+        float getScale() const;
+        
+        double getSmoothedGpuFrameMs() const;
+        
+        // Scaled size, rounded to multiples of 8 and clamped to the output size.
+        void getRenderSize( uint32_t outputWidth, uint32_t outputHeight, uint32_t& outWidth, uint32_t& outHeight ) const;
+        
+        const DynamicResolutionSettings& getSettings() const;
+        
+        void setSettings( const DynamicResolutionSettings& settings );
+        
+        void reset();
+        
+    private:
+        DynamicResolutionSettings _settings;
+        
+        float _scale;
+        
+        double _smoothedGpuMs;
+        
+        uint32_t _framesUnderBudget;
+        
+        bool _hasSample;
+        
+        float quantizeDown( float scale ) const;
+        
+        void applyScale( float scale );
+    };
+}
+
+#endif /* DynamicResolutionController_hpp */
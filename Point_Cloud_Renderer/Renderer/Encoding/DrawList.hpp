@@ -0,0 +1,58 @@
+//
+//  DrawList.hpp
+//  Point_Cloud_Renderer
+//
+//  Created by Vatsalya Yadav on 10/19/26.
+//
+
+#ifndef DrawList_hpp
+#define DrawList_hpp
+
+#include <cstdint>
+
+#include "Core/Core.hpp"
+
+FD_MTL
+
+namespace PCR
+{
+    // One non-indexed draw with its own vertex buffer binding, e.g. a point cloud node
+    struct DrawItem
+    {
+        MTL::Buffer* pVertexBuffer = nullptr;
+        
+        uint64_t vertexBufferOffset = 0;
+        
+        uint32_t vertexStart = 0;
+        
+        uint32_t vertexCount = 0;
+        
+        uint32_t instanceCount = 1;
+        
+        uint32_t baseInstance = 0;
+    };
+
+    // Encodes pItems[ begin, end ) into any encoder with the MTL::RenderCommandEncoder
+    // method names. A buffer that is already bound only has its offset moved.
+    template < typename RenderEncoder, typename PrimitiveType >
+    void encodeDrawItems( RenderEncoder* pEncoder, const DrawItem* pItems, size_t begin, size_t end, uint32_t vertexBufferIndex, PrimitiveType primitiveType )
+    {
+        const MTL::Buffer* pBoundBuffer = nullptr;
+        for ( size_t i = begin; i < end; ++i )
+        {
+            const DrawItem& item = pItems[ i ];
+            if ( item.pVertexBuffer == pBoundBuffer )
+            {
+                pEncoder->setVertexBufferOffset( item.vertexBufferOffset, vertexBufferIndex );
+            }
+            else
+            {
+                pEncoder->setVertexBuffer( item.pVertexBuffer, item.vertexBufferOffset, vertexBufferIndex );
+                pBoundBuffer = item.pVertexBuffer;
+            }
+            pEncoder->drawPrimitives( primitiveType, item.vertexStart, item.vertexCount, item.instanceCount, item.baseInstance );
+        }
+    }
+}
+
+#endif /* DrawList_hpp */
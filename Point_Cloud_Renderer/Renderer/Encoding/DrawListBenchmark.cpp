@@ -0,0 +1,187 @@
+//
+//  DrawListBenchmark.cpp
+//  Point_Cloud_Renderer
+//
+//  Created by Vatsalya Yadav on 10/19/26.
+//
+
+#include "DrawListBenchmark.hpp"
+
+#include <algorithm>
+#include <random>
+
+#include "Renderer/Encoding/NullCommandEncoder.hpp"
+
+namespace PCR
+{
+    namespace
+    {
+        constexpr size_t DRAWS_PER_SCENE{ 1024 * 1024 };
+        
+        constexpr uint32_t MAX_SCENE_STATES{ DrawListBuilder::MAX_STATE_IDS };
+        
+        // MTL::PrimitiveTypeTriangle and MTL::IndexTypeUInt16
+        constexpr uint64_t PRIMITIVE_TYPE_TRIANGLE{ 3 };
+        
+        constexpr uint64_t INDEX_TYPE_UINT16{ 0 };
+        
+        // Only ever compared, never dereferenced
+        alignas( 16 ) char stateStandIns[ 3 ][ MAX_SCENE_STATES ][ 16 ];
+        
+        std::vector< DrawPacket > makeDrawPackets( const DrawListScene& scene )
+        {
+            // Fixed seed and plain modulo, the same frame on every standard library
+            std::mt19937 random( 0x5EED );
+            
+            std::vector< DrawPacket > packets( scene.drawCount );
+            for ( size_t i = 0; i < scene.drawCount; ++i )
+            {
+                DrawPacket& packet = packets[ i ];
+                packet.pPipelineState = reinterpret_cast< const MTL::RenderPipelineState* >( stateStandIns[ 0 ][ random() % scene.pipelineCount ] );
+                packet.pTexture = reinterpret_cast< const MTL::Texture* >( stateStandIns[ 1 ][ random() % scene.textureCount ] );
+                packet.pVertexBuffer = reinterpret_cast< const MTL::Buffer* >( stateStandIns[ 2 ][ random() % scene.vertexBufferCount ] );
+                packet.elementCount = 36;
+                
+                // Identifies the draw once it has been submitted
+                packet.baseInstance = static_cast< uint32_t >( i );
+                packet.depth = static_cast< float >( random() % 100000 ) * 0.01f;
+            }
+            return packets;
+        }
+        
+        bool isSorted( const DrawListBuilder& builder, size_t drawCount )
+        {
+            const std::vector< uint64_t >& keys = builder.getSortedKeys();
+            std::vector< uint32_t > indices = builder.getSortedIndices();
+            std::sort( indices.begin(), indices.end() );
+            
+            bool permutation = indices.size() == drawCount;
+            for ( size_t i = 0; permutation && i < indices.size(); ++i )
+            {
+                permutation = indices[ i ] == i;
+            }
+            return permutation && std::is_sorted( keys.begin(), keys.end() );
+        }
+    }
+
+    std::vector< DrawListBenchmarkResult > runDrawListBenchmark( const std::vector< DrawListScene >& scenes )
+    {
+        std::vector< DrawListBenchmarkResult > results;
+        
+        for ( const DrawListScene& scene : scenes )
+        {
+            DrawListBenchmarkResult result;
+            result.scene = scene;
+            if ( scene.pipelineCount > MAX_SCENE_STATES || scene.textureCount > MAX_SCENE_STATES || scene.vertexBufferCount > MAX_SCENE_STATES )
+            {
+                __builtin_printf( "DrawListBenchmark: scenes are limited to %u states of a kind\n", MAX_SCENE_STATES );
+                result.sorted = false;
+                results.push_back( result );
+                continue;
+            }
+            
+            const std::vector< DrawPacket > packets = makeDrawPackets( scene );
+            
+            DrawListBuilder builder;
+            std::vector< uint64_t > firstKeys;
+            std::vector< uint32_t > firstIndices;
+            
+            const size_t iterations = std::max< size_t >( 2, DRAWS_PER_SCENE / std::max< size_t >( scene.drawCount, 1 ) );
+            double totalSortMs = 0.0;
+            for ( size_t iteration = 0; iteration < iterations; ++iteration )
+            {
+                builder.reset();
+                for ( const DrawPacket& packet : packets )
+                {
+                    builder.addDraw( packet );
+                }
+                builder.sort();
+                totalSortMs += builder.getStats().sortMs;
+                
+                if ( iteration == 0 )
+                {
+                    firstKeys = builder.getSortedKeys();
+                    firstIndices = builder.getSortedIndices();
+                }
+                else
+                {
+                    result.deterministic = result.deterministic && builder.getSortedKeys() == firstKeys && builder.getSortedIndices() == firstIndices;
+                }
+            }
+            result.stats = builder.getStats();
+            result.stats.sortMs = totalSortMs / static_cast< double >( iterations );
+            result.sorted = isSorted( builder, scene.drawCount );
+            
+            NullRenderCommandEncoder nullEncoder;
+            builder.submit( &nullEncoder, PRIMITIVE_TYPE_TRIANGLE, INDEX_TYPE_UINT16, 0, 0 );
+            nullEncoder.endEncoding();
+            
+            result.encodedStateChanges = static_cast< uint32_t >( nullEncoder.getCommandCount( NullCommandType::SetRenderPipelineState )
+                                                                + nullEncoder.getCommandCount( NullCommandType::SetVertexBuffer )
+                                                                + nullEncoder.getCommandCount( NullCommandType::SetVertexBufferOffset )
+                                                                + nullEncoder.getCommandCount( NullCommandType::SetFragmentTexture ) );
+            
+            std::vector< bool > submitted( scene.drawCount, false );
+            size_t drawCount = 0;
+            for ( const NullCommand& command : nullEncoder.getCommands() )
+            {
+                if ( command.type != NullCommandType::DrawPrimitives )
+                {
+                    continue;
+                }
+                
+                const uint64_t baseInstance = command.arguments[ 4 ];
+                result.matchesSubmission = result.matchesSubmission && baseInstance < scene.drawCount && !submitted[ baseInstance ];
+                if ( baseInstance < scene.drawCount )
+                {
+                    submitted[ baseInstance ] = true;
+                }
+                ++drawCount;
+            }
+            result.matchesSubmission = result.matchesSubmission
+                                    && drawCount == scene.drawCount
+                                    && result.encodedStateChanges == result.stats.sortedStateChanges;
+            
+            results.push_back( result );
+        }
+        
+        return results;
+    }
+
+    bool printDrawListBenchmark( const std::vector< DrawListBenchmarkResult >& results )
+    {
+        bool passed = true;
+        
+        __builtin_printf( "Sorted draw lists, state binds per frame before and after sorting\n" );
+        __builtin_printf( "%8s %5s %5s %5s %8s %9s %8s %9s %9s %7s %10s %6s\n",
+                          "draws", "pipes", "texs", "bufs", "naive", "unsorted", "sorted", "pipeline", "texture", "buffer", "sort ms", "checks" );
+        for ( const DrawListBenchmarkResult& result : results )
+        {
+            const bool resultPassed = result.sorted && result.matchesSubmission && result.deterministic;
+            passed = passed && resultPassed;
+            
+            __builtin_printf( "%8zu %5u %5u %5u %8u %9u %8u %9u %9u %7u %10.3f %6s\n",
+                              result.scene.drawCount,
+                              result.scene.pipelineCount,
+                              result.scene.textureCount,
+                              result.scene.vertexBufferCount,
+                              result.stats.naiveStateChanges,
+                              result.stats.unsortedStateChanges,
+                              result.stats.sortedStateChanges,
+                              result.stats.pipelineChanges,
+                              result.stats.textureChanges,
+                              result.stats.vertexBufferChanges,
+                              result.stats.sortMs,
+                              resultPassed ? "ok" : "FAIL" );
+            if ( !resultPassed )
+            {
+                __builtin_printf( "DrawListBenchmark: %zu draws %s%s%s\n",
+                                  result.scene.drawCount,
+                                  result.sorted ? "" : "didn't sort, ",
+                                  result.matchesSubmission ? "" : "submitted differently from the list, ",
+                                  result.deterministic ? "" : "changed between rebuilds" );
+            }
+        }
+        return passed;
+    }
+}
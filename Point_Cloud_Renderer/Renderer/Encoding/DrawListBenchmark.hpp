@@ -0,0 +1,57 @@
+//
+//  DrawListBenchmark.hpp
+//  Point_Cloud_Renderer
+//
+//  Created by Vatsalya Yadav on 10/19/26.
+//
+
+#ifndef DrawListBenchmark_hpp
+#define DrawListBenchmark_hpp
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+#include "Renderer/Encoding/DrawListBuilder.hpp"
+
+namespace PCR
+{
+    // Draws spread at random over this many pipelines, textures and vertex buffers
+    struct DrawListScene
+    {
+        size_t drawCount = 0;
+        
+        uint32_t pipelineCount = 0;
+        
+        uint32_t textureCount = 0;
+        
+        uint32_t vertexBufferCount = 0;
+    };
+
+    struct DrawListBenchmarkResult
+    {
+        DrawListScene scene;
+        
+        // From the last run, sortMs replaced by the average over every run
+        DrawListStats stats;
+        
+        // Binds the null encoder recorded from submit()
+        uint32_t encodedStateChanges = 0;
+        
+        // Keys come out in ascending order and the indices are a permutation of the draws
+        bool sorted = true;
+        
+        // Every draw was submitted exactly once and binds matched sortedStateChanges
+        bool matchesSubmission = true;
+        
+        // Rebuilding the same frame gave the same keys and order
+        bool deterministic = true;
+    };
+
+    std::vector< DrawListBenchmarkResult > runDrawListBenchmark( const std::vector< DrawListScene >& scenes );
+
+    // Returns false if a sort, submission or rebuild check failed
+    bool printDrawListBenchmark( const std::vector< DrawListBenchmarkResult >& results );
+}
+
+#endif /* DrawListBenchmark_hpp */
@@ -0,0 +1,156 @@
+//
+//  DrawListBuilder.cpp
+//  Point_Cloud_Renderer
+//
+//  Created by Vatsalya Yadav on 10/19/26.
+//
+
+#include "DrawListBuilder.hpp"
+
+#include <algorithm>
+#include <cassert>
+#include <chrono>
+#include <cstring>
+#include <numeric>
+
+namespace PCR
+{
+    void DrawListBuilder::reset()
+    {
+        _packets.clear();
+        _keys.clear();
+        _sortedKeys.clear();
+        _sortedIndices.clear();
+        _pipelineIds.clear();
+        _textureIds.clear();
+        _vertexBufferIds.clear();
+        _stats = DrawListStats{};
+    }
+
+    void DrawListBuilder::addDraw( const DrawPacket& packet )
+    {
+        const uint32_t pipelineId = getStateId( _pipelineIds, packet.pPipelineState );
+        const uint32_t textureId = getStateId( _textureIds, packet.pTexture );
+        const uint32_t vertexBufferId = getStateId( _vertexBufferIds, packet.pVertexBuffer );
+        
+        _keys.push_back( makeSortKey( pipelineId, textureId, vertexBufferId, packet.depth ) );
+        _packets.push_back( packet );
+    }
+
+    void DrawListBuilder::sort()
+    {
+        const auto start = std::chrono::steady_clock::now();
+        const size_t count = _keys.size();
+        
+        _sortedKeys = _keys;
+        _sortedIndices.resize( count );
+        std::iota( _sortedIndices.begin(), _sortedIndices.end(), 0u );
+        _scratchKeys.resize( count );
+        _scratchIndices.resize( count );
+        
+        // LSD radix sort, 8 bits per pass. Stable, so draws with equal keys keep their
+        // submission order. A pass where every key has the same digit is skipped, with
+        // few distinct states most of the upper passes go away.
+        for ( uint32_t shift = 0; shift < 64; shift += 8 )
+        {
+            uint32_t histogram[ 256 ] = {};
+            for ( uint64_t key : _sortedKeys )
+            {
+                ++histogram[ ( key >> shift ) & 0xFF ];
+            }
+            
+            if ( count == 0 || histogram[ ( _sortedKeys[ 0 ] >> shift ) & 0xFF ] == count )
+            {
+                continue;
+            }
+            
+            uint32_t offset = 0;
+            for ( uint32_t& bucket : histogram )
+            {
+                const uint32_t bucketCount = bucket;
+                bucket = offset;
+                offset += bucketCount;
+            }
+            
+            for ( size_t i = 0; i < count; ++i )
+            {
+                const uint32_t destination = histogram[ ( _sortedKeys[ i ] >> shift ) & 0xFF ]++;
+                _scratchKeys[ destination ] = _sortedKeys[ i ];
+                _scratchIndices[ destination ] = _sortedIndices[ i ];
+            }
+            
+            _sortedKeys.swap( _scratchKeys );
+            _sortedIndices.swap( _scratchIndices );
+        }
+        
+        std::vector< uint32_t > submissionOrder( count );
+        std::iota( submissionOrder.begin(), submissionOrder.end(), 0u );
+        const DrawListStats unsortedStats = countStateChanges( submissionOrder );
+        
+        _stats = countStateChanges( _sortedIndices );
+        _stats.drawCount = static_cast< uint32_t >( count );
+        _stats.naiveStateChanges = static_cast< uint32_t >( count * 3 );
+        _stats.unsortedStateChanges = unsortedStats.sortedStateChanges;
+        _stats.sortMs = std::chrono::duration< double, std::milli >( std::chrono::steady_clock::now() - start ).count();
+    }
+
+    const std::vector< uint64_t >& DrawListBuilder::getSortedKeys() const
+    {
+        return _sortedKeys;
+    }
+
+    const std::vector< uint32_t >& DrawListBuilder::getSortedIndices() const
+    {
+        return _sortedIndices;
+    }
+
+    const DrawListStats& DrawListBuilder::getStats() const
+    {
+        return _stats;
+    }
+
+    uint64_t DrawListBuilder::makeSortKey( uint32_t pipelineId, uint32_t textureId, uint32_t vertexBufferId, float depth )
+    {
+        // Negative and NaN depths go first
+        uint32_t depthBits = 0;
+        if ( depth > 0.0f )
+        {
+            std::memcpy( &depthBits, &depth, sizeof( depthBits ) );
+        }
+        
+        return ( static_cast< uint64_t >( pipelineId ) << 52 )
+             | ( static_cast< uint64_t >( textureId ) << 40 )
+             | ( static_cast< uint64_t >( vertexBufferId ) << 28 )
+             | ( static_cast< uint64_t >( depthBits >> ( 32 - DEPTH_BITS ) ) << 4 );
+    }
+
+    uint32_t DrawListBuilder::getStateId( std::unordered_map< const void*, uint32_t >& ids, const void* pObject )
+    {
+        // Past the field's range every new state shares the last ID. submit() binds by pointer,
+        // so those draws still encode correctly, they just stop being grouped by that state.
+        // Reported once per frame.
+        const auto [ it, inserted ] = ids.try_emplace( pObject, static_cast< uint32_t >( std::min< size_t >( ids.size(), MAX_STATE_IDS - 1 ) ) );
+        if ( inserted && ids.size() == MAX_STATE_IDS + 1 )
+        {
+            __builtin_printf( "DrawListBuilder: more than %u distinct states in one frame\n", MAX_STATE_IDS );
+            assert( false );
+        }
+        return it->second;
+    }
+
+    DrawListStats DrawListBuilder::countStateChanges( const std::vector< uint32_t >& order ) const
+    {
+        DrawListStats stats;
+        const DrawPacket* pPrevious = nullptr;
+        for ( uint32_t packetIndex : order )
+        {
+            const DrawPacket& packet = _packets[ packetIndex ];
+            stats.pipelineChanges += ( !pPrevious || packet.pPipelineState != pPrevious->pPipelineState ) ? 1 : 0;
+            stats.vertexBufferChanges += ( !pPrevious || packet.pVertexBuffer != pPrevious->pVertexBuffer || packet.vertexBufferOffset != pPrevious->vertexBufferOffset ) ? 1 : 0;
+            stats.textureChanges += ( !pPrevious || packet.pTexture != pPrevious->pTexture ) ? 1 : 0;
+            pPrevious = &packet;
+        }
+        stats.sortedStateChanges = stats.pipelineChanges + stats.vertexBufferChanges + stats.textureChanges;
+        return stats;
+    }
+}
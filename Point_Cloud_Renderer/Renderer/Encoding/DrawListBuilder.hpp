@@ -0,0 +1,182 @@
+//
+//  DrawListBuilder.hpp
+//  Point_Cloud_Renderer
+//
+//  Created by Vatsalya Yadav on 10/19/26.
+//
+
+#ifndef DrawListBuilder_hpp
+#define DrawListBuilder_hpp
+
+#include <cstdint>
+#include <unordered_map>
+#include <vector>
+
+#include "Core/Core.hpp"
+
+FD_MTL
+
+namespace PCR
+{
+    struct DrawPacket
+    {
+        const MTL::RenderPipelineState* pPipelineState = nullptr;
+        
+        const MTL::Buffer* pVertexBuffer = nullptr;
+        
+        uint64_t vertexBufferOffset = 0;
+        
+        const MTL::Texture* pTexture = nullptr;
+        
+        // Null for a non-indexed draw, elementCount is then the vertex count
+        const MTL::Buffer* pIndexBuffer = nullptr;
+        
+        uint64_t indexBufferOffset = 0;
+        
+        uint32_t elementCount = 0;
+        
+        uint32_t instanceCount = 1;
+        
+        uint32_t baseInstance = 0;
+        
+        // View space distance, only orders draws that share all of their state
+        float depth = 0.0f;
+    };
+
+    struct DrawListStats
+    {
+        uint32_t drawCount = 0;
+        
+        // Every draw binding all of its own state, what a naive loop would encode
+        uint32_t naiveStateChanges = 0;
+        
+        // Redundant binds removed but draws left in submission order
+        uint32_t unsortedStateChanges = 0;
+        
+        // Redundant binds removed after sorting, what submit() encodes
+        uint32_t sortedStateChanges = 0;
+        
+        uint32_t pipelineChanges = 0;
+        
+        uint32_t vertexBufferChanges = 0;
+        
+        uint32_t textureChanges = 0;
+        
+        double sortMs = 0.0;
+    };
+
+    // Collects a frame's draws and orders them by a 64-bit key, most expensive state
+    // change in the top bits:
+    //
+    //   63      52 51      40 39      28 27              4 3    0
+    //   [pipeline] [texture ] [ buffer ] [  depth, 24 bit ] [ -- ]
+    //
+    // IDs are handed out per frame in first-use order, so two frames with the same
+    // submissions produce the same keys. States past MAX_STATE_IDS of a kind assert and
+    // share the last ID rather than spilling into the next field. Depth keeps the top bits of the float, which
+    // sort like integers for non-negative values, so draws sharing state go front to back.
+    class DrawListBuilder
+    {
+    public:
+        static constexpr uint32_t STATE_ID_BITS{ 12 };
+        
+        static constexpr uint32_t MAX_STATE_IDS{ 1u << STATE_ID_BITS };
+        
+        static constexpr uint32_t DEPTH_BITS{ 24 };
+        
+        void reset();
+        
+        void addDraw( const DrawPacket& packet );
+        
+        // Radix sorts the keys and fills in the stats
+        void sort();
+        
+        // Works with MTL::RenderCommandEncoder and NullRenderCommandEncoder, only binds
+        // what differs from the previous draw. Call sort() first.
+        template < typename RenderEncoder, typename PrimitiveType, typename IndexType >
+        void submit( RenderEncoder* pEncoder,
+                     PrimitiveType primitiveType,
+                     IndexType indexType,
+                     uint32_t vertexBufferIndex,
+                     uint32_t fragmentTextureIndex ) const
+        {
+            const MTL::RenderPipelineState* pPipelineState = nullptr;
+            const MTL::Buffer* pVertexBuffer = nullptr;
+            uint64_t vertexBufferOffset = 0;
+            const MTL::Texture* pTexture = nullptr;
+            
+            for ( uint32_t packetIndex : _sortedIndices )
+            {
+                const DrawPacket& packet = _packets[ packetIndex ];
+                if ( packet.pPipelineState != pPipelineState )
+                {
+                    pEncoder->setRenderPipelineState( packet.pPipelineState );
+                    pPipelineState = packet.pPipelineState;
+                }
+                
+                if ( packet.pVertexBuffer != pVertexBuffer )
+                {
+                    pEncoder->setVertexBuffer( packet.pVertexBuffer, packet.vertexBufferOffset, vertexBufferIndex );
+                    pVertexBuffer = packet.pVertexBuffer;
+                    vertexBufferOffset = packet.vertexBufferOffset;
+                }
+                else if ( packet.vertexBufferOffset != vertexBufferOffset )
+                {
+                    pEncoder->setVertexBufferOffset( packet.vertexBufferOffset, vertexBufferIndex );
+                    vertexBufferOffset = packet.vertexBufferOffset;
+                }
+                
+                if ( packet.pTexture != pTexture )
+                {
+                    pEncoder->setFragmentTexture( packet.pTexture, fragmentTextureIndex );
+                    pTexture = packet.pTexture;
+                }
+                
+                if ( packet.pIndexBuffer )
+                {
+                    pEncoder->drawIndexedPrimitives( primitiveType, packet.elementCount, indexType, packet.pIndexBuffer, packet.indexBufferOffset, packet.instanceCount, 0, packet.baseInstance );
+                }
+                else
+                {
+                    pEncoder->drawPrimitives( primitiveType, 0, packet.elementCount, packet.instanceCount, packet.baseInstance );
+                }
+            }
+        }
+        
+        const std::vector< uint64_t >& getSortedKeys() const;
+        
+        const std::vector< uint32_t >& getSortedIndices() const;
+        
+        const DrawListStats& getStats() const;
+        
+        static uint64_t makeSortKey( uint32_t pipelineId, uint32_t textureId, uint32_t vertexBufferId, float depth );
+
+    private:
+        std::vector< DrawPacket > _packets;
+        
+        std::vector< uint64_t > _keys;
+        
+        std::vector< uint64_t > _sortedKeys;
+        
+        std::vector< uint32_t > _sortedIndices;
+        
+        // Ping-pong storage for the radix passes
+        std::vector< uint64_t > _scratchKeys;
+        
+        std::vector< uint32_t > _scratchIndices;
+        
+        std::unordered_map< const void*, uint32_t > _pipelineIds;
+        
+        std::unordered_map< const void*, uint32_t > _textureIds;
+        
+        std::unordered_map< const void*, uint32_t > _vertexBufferIds;
+        
+        DrawListStats _stats;
+        
+        static uint32_t getStateId( std::unordered_map< const void*, uint32_t >& ids, const void* pObject );
+        
+        DrawListStats countStateChanges( const std::vector< uint32_t >& order ) const;
+    };
+}
+
+#endif /* DrawListBuilder_hpp */
@@ -0,0 +1,152 @@
+//
+//  EncoderBenchmark.cpp
+//  Point_Cloud_Renderer
+//
+//  Created by Vatsalya Yadav on 10/19/26.
+//
+
+#include "EncoderBenchmark.hpp"
+
+#include <algorithm>
+#include <chrono>
+
+#include "Renderer/Encoding/DrawList.hpp"
+#include "Renderer/Encoding/NullCommandEncoder.hpp"
+#include "Renderer/Encoding/ParallelEncoder.hpp"
+#include "Renderer/Threading/WorkerPool.hpp"
+
+namespace PCR
+{
+    namespace
+    {
+        constexpr size_t ITEMS_PER_SIZE{ 2 * 1024 * 1024 };
+        
+        // Point cloud nodes share a handful of vertex buffers, runs of items bind the same one
+        constexpr size_t VERTEX_BUFFER_COUNT{ 16 };
+        
+        constexpr size_t ITEMS_PER_BUFFER_RUN{ 24 };
+        
+        // MTL::PrimitiveTypePoint
+        constexpr uint64_t PRIMITIVE_TYPE_POINT{ 0 };
+        
+        // Only ever compared and hashed, never dereferenced
+        alignas( 16 ) char vertexBufferStandIns[ VERTEX_BUFFER_COUNT ][ 16 ];
+        
+        std::vector< DrawItem > makeDrawItems( size_t itemCount )
+        {
+            std::vector< DrawItem > items( itemCount );
+            for ( size_t i = 0; i < itemCount; ++i )
+            {
+                DrawItem& item = items[ i ];
+                item.pVertexBuffer = reinterpret_cast< MTL::Buffer* >( vertexBufferStandIns[ ( i / ITEMS_PER_BUFFER_RUN ) % VERTEX_BUFFER_COUNT ] );
+                item.vertexBufferOffset = ( i % ITEMS_PER_BUFFER_RUN ) * 4096;
+                item.vertexStart = 0;
+                item.vertexCount = 256 + static_cast< uint32_t >( i % 7 ) * 32;
+                item.baseInstance = static_cast< uint32_t >( i );
+            }
+            return items;
+        }
+        
+        std::vector< NullCommand > getDraws( const std::vector< NullCommand >& commands )
+        {
+            std::vector< NullCommand > draws;
+            std::copy_if( commands.begin(), commands.end(), std::back_inserter( draws ), []( const NullCommand& command ){
+                return command.type == NullCommandType::DrawPrimitives;
+            });
+            return draws;
+        }
+    }
+
+    std::vector< EncoderBenchmarkResult > runEncoderBenchmark( const std::vector< size_t >& itemCounts, const std::vector< uint32_t >& workerCounts )
+    {
+        std::vector< EncoderBenchmarkResult > results;
+        
+        for ( size_t itemCount : itemCounts )
+        {
+            const std::vector< DrawItem > items = makeDrawItems( itemCount );
+            
+            NullRenderCommandEncoder serialEncoder;
+            encodeDrawItems( &serialEncoder, items.data(), 0, itemCount, 0, PRIMITIVE_TYPE_POINT );
+            const uint64_t serialDrawHash = NullParallelRenderCommandEncoder::hashCommands( getDraws( serialEncoder.getCommands() ) );
+            
+            for ( uint32_t workerCount : workerCounts )
+            {
+                WorkerPool workerPool( workerCount );
+                ParallelEncoder parallelEncoder( workerPool );
+                
+                EncoderBenchmarkResult result;
+                result.itemCount = itemCount;
+                result.workerCount = workerPool.getWorkerCount();
+                result.chunkCount = parallelEncoder.getChunkCount( itemCount );
+                
+                uint64_t firstHash = 0;
+                const size_t iterations = std::max< size_t >( 2, ITEMS_PER_SIZE / itemCount );
+                double totalMs = 0.0;
+                for ( size_t iteration = 0; iteration < iterations; ++iteration )
+                {
+                    NullParallelRenderCommandEncoder nullEncoder;
+                    
+                    const auto start = std::chrono::steady_clock::now();
+                    parallelEncoder.encodeParallel( &nullEncoder, itemCount, [ & ]( NullRenderCommandEncoder* pSubEncoder, size_t begin, size_t end ){
+                        // A bind and a draw at most per item
+                        pSubEncoder->reserve( 2 * ( end - begin ) );
+                        encodeDrawItems( pSubEncoder, items.data(), begin, end, 0, PRIMITIVE_TYPE_POINT );
+                    });
+                    nullEncoder.endEncoding();
+                    
+                    // The first run warms the allocator and isn't timed
+                    if ( iteration > 0 )
+                    {
+                        totalMs += std::chrono::duration< double, std::milli >( std::chrono::steady_clock::now() - start ).count();
+                    }
+                    
+                    const std::vector< NullCommand > stream = nullEncoder.merge();
+                    const uint64_t hash = NullParallelRenderCommandEncoder::hashCommands( stream );
+                    if ( iteration == 0 )
+                    {
+                        firstHash = hash;
+                        result.matchesSerial = NullParallelRenderCommandEncoder::hashCommands( getDraws( stream ) ) == serialDrawHash;
+                    }
+                    else
+                    {
+                        result.deterministic = result.deterministic && hash == firstHash;
+                    }
+                }
+                result.encodeMs = totalMs / static_cast< double >( iterations - 1 );
+                
+                results.push_back( result );
+            }
+        }
+        
+        return results;
+    }
+
+    bool printEncoderBenchmark( const std::vector< EncoderBenchmarkResult >& results )
+    {
+        bool passed = true;
+        
+        __builtin_printf( "Parallel encoding into the null backend, ms per draw list\n" );
+        __builtin_printf( "%10s %8s %7s %10s %9s %14s %8s\n", "items", "workers", "chunks", "ms", "speedup", "deterministic", "serial" );
+        
+        double singleWorkerMs = 0.0;
+        for ( const EncoderBenchmarkResult& result : results )
+        {
+            // Speedups are against the first worker count of the same size
+            if ( &result == &results.front() || result.itemCount != ( &result - 1 )->itemCount )
+            {
+                singleWorkerMs = result.encodeMs;
+            }
+            
+            passed = passed && result.deterministic && result.matchesSerial;
+            __builtin_printf( "%10zu %8u %7u %10.3f %8.2fx %14s %8s\n",
+                              result.itemCount,
+                              result.workerCount,
+                              result.chunkCount,
+                              result.encodeMs,
+                              singleWorkerMs / result.encodeMs,
+                              result.deterministic ? "yes" : "NO",
+                              result.matchesSerial ? "same" : "DIFFERS" );
+        }
+        return passed;
+    }
+}
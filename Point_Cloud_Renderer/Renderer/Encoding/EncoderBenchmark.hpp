@@ -0,0 +1,43 @@
+//
+//  EncoderBenchmark.hpp
+//  Point_Cloud_Renderer
+//
+//  Created by Vatsalya Yadav on 10/19/26.
+//
+
+#ifndef EncoderBenchmark_hpp
+#define EncoderBenchmark_hpp
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace PCR
+{
+    // One draw list size encoded with one worker pool size, into the null backend
+    struct EncoderBenchmarkResult
+    {
+        size_t itemCount = 0;
+        
+        uint32_t workerCount = 0;
+        
+        uint32_t chunkCount = 0;
+        
+        // Milliseconds per encode of the whole list, sub-encoder creation included
+        double encodeMs = 0.0;
+        
+        // Every run produced the same merged stream
+        bool deterministic = true;
+        
+        // The merged stream draws exactly what one encoder on one thread draws, in order
+        bool matchesSerial = true;
+    };
+
+    // Every item count with every worker count, in that order
+    std::vector< EncoderBenchmarkResult > runEncoderBenchmark( const std::vector< size_t >& itemCounts, const std::vector< uint32_t >& workerCounts );
+
+    // Returns false if a run wasn't deterministic or didn't match the serial draws
+    bool printEncoderBenchmark( const std::vector< EncoderBenchmarkResult >& results );
+}
+
+#endif /* EncoderBenchmark_hpp */
@@ -0,0 +1,140 @@
+//
+//  NullCommandEncoder.cpp
+//  Point_Cloud_Renderer
+//
+//  Created by Vatsalya Yadav on 10/19/26.
+//
+
+#include "NullCommandEncoder.hpp"
+
+#include <cassert>
+
+namespace PCR
+{
+    void NullRenderCommandEncoder::setRenderPipelineState( const MTL::RenderPipelineState* pPipelineState )
+    {
+        assert( !_ended );
+        _commands.push_back( NullCommand{ NullCommandType::SetRenderPipelineState, { reinterpret_cast< uintptr_t >( pPipelineState ) } } );
+    }
+
+    void NullRenderCommandEncoder::setVertexBuffer( const MTL::Buffer* pBuffer, uint64_t offset, uint64_t index )
+    {
+        assert( !_ended );
+        _commands.push_back( NullCommand{ NullCommandType::SetVertexBuffer, { reinterpret_cast< uintptr_t >( pBuffer ), offset, index } } );
+    }
+
+    void NullRenderCommandEncoder::setVertexBufferOffset( uint64_t offset, uint64_t index )
+    {
+        assert( !_ended );
+        _commands.push_back( NullCommand{ NullCommandType::SetVertexBufferOffset, { offset, index } } );
+    }
+
+    void NullRenderCommandEncoder::setFragmentTexture( const MTL::Texture* pTexture, uint64_t index )
+    {
+        assert( !_ended );
+        _commands.push_back( NullCommand{ NullCommandType::SetFragmentTexture, { reinterpret_cast< uintptr_t >( pTexture ), index } } );
+    }
+
+    void NullRenderCommandEncoder::drawPrimitives( uint64_t primitiveType, uint64_t vertexStart, uint64_t vertexCount, uint64_t instanceCount, uint64_t baseInstance )
+    {
+        assert( !_ended );
+        _commands.push_back( NullCommand{ NullCommandType::DrawPrimitives, { primitiveType, vertexStart, vertexCount, instanceCount, baseInstance } } );
+    }
+
+    void NullRenderCommandEncoder::drawIndexedPrimitives( uint64_t primitiveType,
+                                                          uint64_t indexCount,
+                                                          uint64_t indexType,
+                                                          const MTL::Buffer* pIndexBuffer,
+                                                          uint64_t indexBufferOffset,
+                                                          uint64_t instanceCount,
+                                                          int64_t baseVertex,
+                                                          uint64_t baseInstance )
+    {
+        assert( !_ended );
+        _commands.push_back( NullCommand{ NullCommandType::DrawIndexedPrimitives, { primitiveType,
+                                                                                   indexCount,
+                                                                                   indexType,
+                                                                                   reinterpret_cast< uintptr_t >( pIndexBuffer ),
+                                                                                   indexBufferOffset,
+                                                                                   instanceCount,
+                                                                                   static_cast< uint64_t >( baseVertex ),
+                                                                                   baseInstance } } );
+    }
+
+    void NullRenderCommandEncoder::endEncoding()
+    {
+        _ended = true;
+    }
+
+    void NullRenderCommandEncoder::reserve( size_t commandCount )
+    {
+        _commands.reserve( commandCount );
+    }
+
+    const std::vector< NullCommand >& NullRenderCommandEncoder::getCommands() const
+    {
+        return _commands;
+    }
+
+    size_t NullRenderCommandEncoder::getCommandCount( NullCommandType type ) const
+    {
+        size_t count = 0;
+        for ( const NullCommand& command : _commands )
+        {
+            count += ( command.type == type ) ? 1 : 0;
+        }
+        return count;
+    }
+
+    bool NullRenderCommandEncoder::isEnded() const
+    {
+        return _ended;
+    }
+
+    NullRenderCommandEncoder* NullParallelRenderCommandEncoder::renderCommandEncoder()
+    {
+        _subEncoders.push_back( std::make_unique< NullRenderCommandEncoder >() );
+        return _subEncoders.back().get();
+    }
+
+    void NullParallelRenderCommandEncoder::endEncoding()
+    {
+        for ( const auto& pSubEncoder : _subEncoders )
+        {
+            // Same rule as Metal, every sub-encoder has to be ended first
+            assert( pSubEncoder->isEnded() );
+        }
+    }
+
+    std::vector< NullCommand > NullParallelRenderCommandEncoder::merge() const
+    {
+        std::vector< NullCommand > commands;
+        for ( const auto& pSubEncoder : _subEncoders )
+        {
+            commands.insert( commands.end(), pSubEncoder->getCommands().begin(), pSubEncoder->getCommands().end() );
+        }
+        return commands;
+    }
+
+    uint64_t NullParallelRenderCommandEncoder::hashCommands( const std::vector< NullCommand >& commands )
+    {
+        uint64_t hash = 14695981039346656037ull;
+        auto mix = [ &hash ]( uint64_t value )
+        {
+            for ( int byte = 0; byte < 8; ++byte )
+            {
+                hash ^= ( value >> ( byte * 8 ) ) & 0xFF;
+                hash *= 1099511628211ull;
+            }
+        };
+        for ( const NullCommand& command : commands )
+        {
+            mix( static_cast< uint64_t >( command.type ) );
+            for ( uint64_t argument : command.arguments )
+            {
+                mix( argument );
+            }
+        }
+        return hash;
+    }
+}
@@ -0,0 +1,98 @@
+//
+//  NullCommandEncoder.hpp
+//  Point_Cloud_Renderer
+//
+//  Created by Vatsalya Yadav on 10/19/26.
+//
+
+#ifndef NullCommandEncoder_hpp
+#define NullCommandEncoder_hpp
+
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+#include "Core/Core.hpp"
+
+FD_MTL
+
+namespace PCR
+{
+    enum class NullCommandType : uint32_t
+    {
+        SetRenderPipelineState,
+        SetVertexBuffer,
+        SetVertexBufferOffset,
+        SetFragmentTexture,
+        DrawPrimitives,
+        DrawIndexedPrimitives
+    };
+
+    struct NullCommand
+    {
+        NullCommandType type;
+        
+        uint64_t arguments[ 8 ];
+    };
+
+    // Records what would have been encoded, same method names as MTL::RenderCommandEncoder
+    // so encoding code can be templated over both. Resources are opaque pointers.
+    class NullRenderCommandEncoder
+    {
+    public:
+        void setRenderPipelineState( const MTL::RenderPipelineState* pPipelineState );
+        
+        void setVertexBuffer( const MTL::Buffer* pBuffer, uint64_t offset, uint64_t index );
+        
+        void setVertexBufferOffset( uint64_t offset, uint64_t index );
+        
+        void setFragmentTexture( const MTL::Texture* pTexture, uint64_t index );
+        
+        void drawPrimitives( uint64_t primitiveType, uint64_t vertexStart, uint64_t vertexCount, uint64_t instanceCount, uint64_t baseInstance );
+        
+        void drawIndexedPrimitives( uint64_t primitiveType,
+                                    uint64_t indexCount,
+                                    uint64_t indexType,
+                                    const MTL::Buffer* pIndexBuffer,
+                                    uint64_t indexBufferOffset,
+                                    uint64_t instanceCount,
+                                    int64_t baseVertex,
+                                    uint64_t baseInstance );
+        
+        void endEncoding();
+        
+        // Not part of the Metal interface, keeps vector growth out of encoding timings
+        void reserve( size_t commandCount );
+        
+        const std::vector< NullCommand >& getCommands() const;
+        
+        size_t getCommandCount( NullCommandType type ) const;
+        
+        bool isEnded() const;
+
+    private:
+        std::vector< NullCommand > _commands;
+        
+        bool _ended = false;
+    };
+
+    // Stand-in for MTL::ParallelRenderCommandEncoder. Sub-encoders execute in the order
+    // they were created, merge() concatenates them the same way the GPU would.
+    class NullParallelRenderCommandEncoder
+    {
+    public:
+        NullRenderCommandEncoder* renderCommandEncoder();
+        
+        void endEncoding();
+        
+        std::vector< NullCommand > merge() const;
+        
+        // FNV-1a over the merged stream, for comparing runs
+        static uint64_t hashCommands( const std::vector< NullCommand >& commands );
+
+    private:
+        std::vector< std::unique_ptr< NullRenderCommandEncoder > > _subEncoders;
+    };
+}
+
+#endif /* NullCommandEncoder_hpp */
@@ -0,0 +1,59 @@
+//
+//  ParallelEncoder.cpp
+//  Point_Cloud_Renderer
+//
+//  Created by Vatsalya Yadav on 10/19/26.
+//
+
+#include "ParallelEncoder.hpp"
+
+#include <algorithm>
+#include <chrono>
+
+namespace PCR
+{
+    ParallelEncoder::ParallelEncoder( WorkerPool& workerPool, size_t minItemsPerChunk /* = PARALLEL_ENCODE_MIN_ITEMS */ )
+    :   _workerPool{ workerPool }
+    ,   _minItemsPerChunk{ std::max< size_t >( minItemsPerChunk, 1 ) }
+    {
+    }
+
+    uint32_t ParallelEncoder::getChunkCount( size_t itemCount ) const
+    {
+        const size_t worthwhile = ( itemCount + _minItemsPerChunk - 1 ) / _minItemsPerChunk;
+        return static_cast< uint32_t >( std::clamp< size_t >( worthwhile, 1, _workerPool.getWorkerCount() ) );
+    }
+
+    void ParallelEncoder::getChunkRange( size_t itemCount, uint32_t chunkCount, uint32_t chunkIndex, size_t& begin, size_t& end )
+    {
+        // Spread the remainder over the first chunks so sizes differ by at most one
+        const size_t baseSize = itemCount / chunkCount;
+        const size_t remainder = itemCount % chunkCount;
+        begin = chunkIndex * baseSize + std::min< size_t >( chunkIndex, remainder );
+        end = begin + baseSize + ( chunkIndex < remainder ? 1 : 0 );
+    }
+
+    void ParallelEncoder::encode( size_t itemCount, uint32_t chunkCount, const ChunkFunction& function )
+    {
+        const auto start = std::chrono::steady_clock::now();
+        
+        _workerPool.parallelFor( chunkCount, 1, [ & ]( size_t chunkBegin, size_t chunkEnd, uint32_t ){
+            for ( size_t chunk = chunkBegin; chunk < chunkEnd; ++chunk )
+            {
+                size_t begin = 0;
+                size_t end = 0;
+                getChunkRange( itemCount, chunkCount, static_cast< uint32_t >( chunk ), begin, end );
+                function( static_cast< uint32_t >( chunk ), begin, end );
+            }
+        });
+        
+        _stats.chunkCount = chunkCount;
+        _stats.itemCount = itemCount;
+        _stats.encodeMs = std::chrono::duration< double, std::milli >( std::chrono::steady_clock::now() - start ).count();
+    }
+
+    const ParallelEncodeStats& ParallelEncoder::getStats() const
+    {
+        return _stats;
+    }
+}
@@ -0,0 +1,81 @@
+//
+//  ParallelEncoder.hpp
+//  Point_Cloud_Renderer
+//
+//  Created by Vatsalya Yadav on 10/19/26.
+//
+
+#ifndef ParallelEncoder_hpp
+#define ParallelEncoder_hpp
+
+#include <cstdint>
+#include <functional>
+#include <type_traits>
+#include <vector>
+
+#include "Renderer/Data/Constants.hpp"
+#include "Renderer/Threading/WorkerPool.hpp"
+
+namespace PCR
+{
+    struct ParallelEncodeStats
+    {
+        uint32_t chunkCount = 0;
+        
+        size_t itemCount = 0;
+        
+        double encodeMs = 0.0;
+    };
+
+    // Splits a draw list into contiguous chunks and encodes every chunk on a worker thread
+    // into its own sub-encoder. Chunk boundaries only depend on the item count and the
+    // chunk count, and sub-encoders are created in chunk order up front, so the merged
+    // command stream is the same however the threads get scheduled.
+    class ParallelEncoder
+    {
+    public:
+        using ChunkFunction = std::function< void( uint32_t chunkIndex, size_t begin, size_t end ) >;
+        
+        explicit ParallelEncoder( WorkerPool& workerPool, size_t minItemsPerChunk = PARALLEL_ENCODE_MIN_ITEMS );
+        
+        // One chunk per worker, fewer when there isn't enough work to pay for a sub-encoder
+        uint32_t getChunkCount( size_t itemCount ) const;
+        
+        static void getChunkRange( size_t itemCount, uint32_t chunkCount, uint32_t chunkIndex, size_t& begin, size_t& end );
+        
+        void encode( size_t itemCount, uint32_t chunkCount, const ChunkFunction& function );
+        
+        // Works with MTL::ParallelRenderCommandEncoder and NullParallelRenderCommandEncoder alike:
+        // encodeRange( pSubEncoder, begin, end ) fills one sub-encoder, which is ended afterwards.
+        template < typename ParallelRenderEncoder, typename EncodeRange >
+        void encodeParallel( ParallelRenderEncoder* pParallelEncoder, size_t itemCount, const EncodeRange& encodeRange )
+        {
+            using SubEncoder = std::remove_pointer_t< decltype( pParallelEncoder->renderCommandEncoder() ) >;
+            
+            const uint32_t chunkCount = getChunkCount( itemCount );
+            
+            // Creation order is execution order, so this stays on the calling thread
+            std::vector< SubEncoder* > subEncoders( chunkCount );
+            for ( uint32_t i = 0; i < chunkCount; ++i )
+            {
+                subEncoders[ i ] = pParallelEncoder->renderCommandEncoder();
+            }
+            
+            encode( itemCount, chunkCount, [ & ]( uint32_t chunkIndex, size_t begin, size_t end ){
+                encodeRange( subEncoders[ chunkIndex ], begin, end );
+                subEncoders[ chunkIndex ]->endEncoding();
+            });
+        }
+        
+        const ParallelEncodeStats& getStats() const;
+
+    private:
+        WorkerPool& _workerPool;
+        
+        size_t _minItemsPerChunk;
+        
+        ParallelEncodeStats _stats;
+    };
+}
+
+#endif /* ParallelEncoder_hpp */
@@ -0,0 +1,167 @@
+//
+//  CompactInstance.cpp
+//  Point_Cloud_Renderer
+//
+//  Created by Vatsalya Yadav on 10/19/26.
+//
+
+#include "CompactInstance.hpp"
+
+#include <algorithm>
+#include <cmath>
+
+namespace PCR::CompactInstance
+{
+    namespace
+    {
+        uint32_t packSnorm16( float value )
+        {
+            const float clamped = std::min( std::max( value, -1.0f ), 1.0f );
+            return static_cast< uint32_t >( static_cast< uint16_t >( static_cast< int16_t >( lrintf( clamped * 32767.0f ) ) ) );
+        }
+        
+        float unpackSnorm16( uint32_t bits )
+        {
+            const auto value = static_cast< int16_t >( static_cast< uint16_t >( bits ) );
+            return std::max( static_cast< float >( value ) / 32767.0f, -1.0f );
+        }
+        
+        uint32_t packUnorm8( float value )
+        {
+            return static_cast< uint32_t >( lrintf( std::min( std::max( value, 0.0f ), 1.0f ) * 255.0f ) );
+        }
+    }
+
+    uint32_t packSnorm16x2( float low, float high )
+    {
+        return packSnorm16( low ) | ( packSnorm16( high ) << 16 );
+    }
+
+    simd::float2 unpackSnorm16x2( uint32_t packed )
+    {
+        return simd::float2{ unpackSnorm16( packed & 0xffff ), unpackSnorm16( packed >> 16 ) };
+    }
+
+    uint32_t packUnorm4x8( const simd::float4& value )
+    {
+        return packUnorm8( value.x ) | ( packUnorm8( value.y ) << 8 ) | ( packUnorm8( value.z ) << 16 ) | ( packUnorm8( value.w ) << 24 );
+    }
+
+    simd::float4 unpackUnorm4x8( uint32_t packed )
+    {
+        return simd::float4{ static_cast< float >( packed & 0xff ),
+                             static_cast< float >( ( packed >> 8 ) & 0xff ),
+                             static_cast< float >( ( packed >> 16 ) & 0xff ),
+                             static_cast< float >( packed >> 24 ) } / 255.0f;
+    }
+
+    simd::float4 quaternionFromMatrix( const simd::float3x3& rotation )
+    {
+        // Column-major, m[ c ][ r ]
+        const simd::float3* m = rotation.columns;
+        const float trace = m[ 0 ].x + m[ 1 ].y + m[ 2 ].z;
+        
+        // Divide by the largest of 4w², 4x², 4y², 4z² to stay well conditioned
+        simd::float4 q;
+        if ( trace > 0.0f )
+        {
+            const float s = sqrtf( trace + 1.0f ) * 2.0f;
+            q = simd::float4{ ( m[ 1 ].z - m[ 2 ].y ) / s, ( m[ 2 ].x - m[ 0 ].z ) / s, ( m[ 0 ].y - m[ 1 ].x ) / s, 0.25f * s };
+        }
+        else if ( m[ 0 ].x > m[ 1 ].y && m[ 0 ].x > m[ 2 ].z )
+        {
+            const float s = sqrtf( 1.0f + m[ 0 ].x - m[ 1 ].y - m[ 2 ].z ) * 2.0f;
+            q = simd::float4{ 0.25f * s, ( m[ 1 ].x + m[ 0 ].y ) / s, ( m[ 2 ].x + m[ 0 ].z ) / s, ( m[ 1 ].z - m[ 2 ].y ) / s };
+        }
+        else if ( m[ 1 ].y > m[ 2 ].z )
+        {
+            const float s = sqrtf( 1.0f + m[ 1 ].y - m[ 0 ].x - m[ 2 ].z ) * 2.0f;
+            q = simd::float4{ ( m[ 1 ].x + m[ 0 ].y ) / s, 0.25f * s, ( m[ 2 ].y + m[ 1 ].z ) / s, ( m[ 2 ].x - m[ 0 ].z ) / s };
+        }
+        else
+        {
+            const float s = sqrtf( 1.0f + m[ 2 ].z - m[ 0 ].x - m[ 1 ].y ) * 2.0f;
+            q = simd::float4{ ( m[ 2 ].x + m[ 0 ].z ) / s, ( m[ 2 ].y + m[ 1 ].z ) / s, 0.25f * s, ( m[ 0 ].y - m[ 1 ].x ) / s };
+        }
+        return q / simd_length( q );
+    }
+
+    ParentDecomposition decomposeParent( const simd::float4x4& parent )
+    {
+        ParentDecomposition decomposition;
+        decomposition.scale = simd_length( parent.columns[ 0 ].xyz );
+        decomposition.rotation = quaternionFromMatrix( simd_matrix( parent.columns[ 0 ].xyz / decomposition.scale,
+                                                                    parent.columns[ 1 ].xyz / decomposition.scale,
+                                                                    parent.columns[ 2 ].xyz / decomposition.scale ) );
+        return decomposition;
+    }
+
+    InstanceData decode( const CompactInstanceData& compact )
+    {
+        const simd::float2 xy = unpackSnorm16x2( compact.rotation[ 0 ] );
+        const simd::float2 zw = unpackSnorm16x2( compact.rotation[ 1 ] );
+        simd::float4 q = simd::float4{ xy.x, xy.y, zw.x, zw.y };
+        q = q / simd_length( q );
+        
+        const float x2 = q.x * 2.0f;
+        const float y2 = q.y * 2.0f;
+        const float z2 = q.z * 2.0f;
+        const float xx = q.x * x2;
+        const float yy = q.y * y2;
+        const float zz = q.z * z2;
+        const float xy2 = q.x * y2;
+        const float xz = q.x * z2;
+        const float yz = q.y * z2;
+        const float wx = q.w * x2;
+        const float wy = q.w * y2;
+        const float wz = q.w * z2;
+        
+        const float s = compact.scale;
+        const simd::float3 c0 = simd::float3{ 1.0f - ( yy + zz ), xy2 + wz, xz - wy } * s;
+        const simd::float3 c1 = simd::float3{ xy2 - wz, 1.0f - ( xx + zz ), yz + wx } * s;
+        const simd::float3 c2 = simd::float3{ xz + wy, yz - wx, 1.0f - ( xx + yy ) } * s;
+        
+        InstanceData instance;
+        instance.transform = simd_matrix( simd::float4{ c0.x, c0.y, c0.z, 0.0f },
+                                          simd::float4{ c1.x, c1.y, c1.z, 0.0f },
+                                          simd::float4{ c2.x, c2.y, c2.z, 0.0f },
+                                          simd::float4{ compact.translation[ 0 ], compact.translation[ 1 ], compact.translation[ 2 ], 1.0f } );
+        instance.normalTransform = simd_matrix( c0, c1, c2 );
+        instance.color = unpackUnorm4x8( compact.color );
+        return instance;
+    }
+
+    RoundTripError measureRoundTrip( const InstanceData* pInstances, const CompactInstanceData* pCompactInstances, size_t count )
+    {
+        // Corners of the unit cube the renderer instances
+        constexpr float h = 0.5f;
+        const simd::float4 corners[ 8 ] =
+        {
+            { -h, -h, -h, 1.0f }, { +h, -h, -h, 1.0f }, { -h, +h, -h, 1.0f }, { +h, +h, -h, 1.0f },
+            { -h, -h, +h, 1.0f }, { +h, -h, +h, 1.0f }, { -h, +h, +h, 1.0f }, { +h, +h, +h, 1.0f }
+        };
+        
+        RoundTripError error;
+        for ( size_t i = 0; i < count; ++i )
+        {
+            const InstanceData& expected = pInstances[ i ];
+            const InstanceData decoded = decode( pCompactInstances[ i ] );
+            
+            const float scale = std::max( pCompactInstances[ i ].scale, 1e-20f );
+            for ( const simd::float4& corner : corners )
+            {
+                const simd::float4 difference = expected.transform * corner - decoded.transform * corner;
+                error.maxPositionError = std::max( error.maxPositionError, simd_length( difference.xyz ) / scale );
+            }
+            
+            for ( size_t c = 0; c < 3; ++c )
+            {
+                const simd::float3 difference = simd_abs( expected.normalTransform.columns[ c ] - decoded.normalTransform.columns[ c ] ) / scale;
+                error.maxNormalError = std::max( error.maxNormalError, simd_reduce_max( difference ) );
+            }
+            
+            error.maxColorError = std::max( error.maxColorError, simd_reduce_max( simd_abs( expected.color - decoded.color ) ) );
+        }
+        return error;
+    }
+}
@@ -0,0 +1,74 @@
+//
+//  CompactInstance.hpp
+//  Point_Cloud_Renderer
+//
+//  Created by Vatsalya Yadav on 10/19/26.
+//
+
+#ifndef CompactInstance_hpp
+#define CompactInstance_hpp
+
+#include <cstdint>
+
+#include <simd/simd.h>
+
+#include "Renderer/Structures/CompactInstanceData.hpp"
+#include "Renderer/Structures/InstanceData.hpp"
+
+// Packing for CompactInstanceData. The unpack side matches Metal's unpack_snorm2x16_to_float
+// and unpack_unorm4x8_to_float, and decode() rebuilds the matrices the way decodeInstance
+// in InstanceLayout.h does, so the CPU can check what the GPU will see.
+namespace PCR::CompactInstance
+{
+    // Bounds measureRoundTrip holds encodes to. A snorm16 quaternion component rounds by up to
+    // half of 1 / 32767, which moves a rotation matrix element by at most about 1.2e-4.
+    constexpr float MAX_NORMAL_ERROR{ 1.5e-4f };
+    
+    // A unit cube corner sums three elements at up to 0.5 each per axis, over three axes
+    constexpr float MAX_POSITION_ERROR{ 1.732f * 3.0f * 0.5f * MAX_NORMAL_ERROR };
+    
+    // Half a unorm8 step, plus float rounding
+    constexpr float MAX_COLOR_ERROR{ 0.5f / 255.0f + 1e-6f };
+
+    struct RoundTripError
+    {
+        // Largest distance between a mesh corner transformed by the full and the decoded
+        // matrix, relative to the instance scale
+        float maxPositionError = 0.0f;
+        
+        // Largest difference of a normal matrix element, relative to the instance scale
+        float maxNormalError = 0.0f;
+        
+        float maxColorError = 0.0f;
+    };
+
+    // A parent transform as compact instances carry it, uniform scale times a rotation
+    struct ParentDecomposition
+    {
+        // Unit quaternion, xyzw
+        simd::float4 rotation;
+        
+        float scale = 1.0f;
+    };
+
+    uint32_t packSnorm16x2( float low, float high );
+
+    simd::float2 unpackSnorm16x2( uint32_t packed );
+
+    uint32_t packUnorm4x8( const simd::float4& value );
+
+    simd::float4 unpackUnorm4x8( uint32_t packed );
+
+    // Unit quaternion of a rotation matrix, xyzw
+    simd::float4 quaternionFromMatrix( const simd::float3x3& rotation );
+
+    // Scale from the first column's length, shear and non-uniform scale are dropped
+    ParentDecomposition decomposeParent( const simd::float4x4& parent );
+
+    InstanceData decode( const CompactInstanceData& compact );
+
+    // Decodes every compact instance and compares against the full-precision ones
+    RoundTripError measureRoundTrip( const InstanceData* pInstances, const CompactInstanceData* pCompactInstances, size_t count );
+}
+
+#endif /* CompactInstance_hpp */
@@ -0,0 +1,195 @@
+//
+//  InstanceAnimation.cpp
+//  Point_Cloud_Renderer
+//
+//  Created by Vatsalya Yadav on 10/19/26.
+//
+
+#include "InstanceAnimation.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <type_traits>
+#include <vector>
+
+#include "Renderer/Data/Constants.hpp"
+#include "Renderer/Instances/CompactInstance.hpp"
+#include "Renderer/Instances/InstanceUpdate.hpp"
+#include "Math/Utility.hpp"
+
+namespace PCR::InstanceAnimation
+{
+    namespace
+    {
+        // Scratch streams stay in L1, multiple of every FloatLanes::WIDTH
+        constexpr size_t BLOCK_SIZE{ 256 };
+        
+        // Translations reach about 12 units from the origin
+        constexpr float FULL_TOLERANCE{ 1e-4f };
+        
+        // Rounding can land one unorm8 color step apart
+        constexpr float COMPACT_TOLERANCE{ 1.5f / 255.0f };
+        
+        template< typename T >
+        void animateBlocks( const InstanceAnimationUniforms& uniforms, T* pOut, size_t begin, size_t end )
+        {
+            const simd::float4x4 parent = makeParentTransform( uniforms );
+            
+            InstanceStore block;
+            std::vector< float > spin( BLOCK_SIZE );
+            for ( size_t blockBegin = begin; blockBegin < end; blockBegin += BLOCK_SIZE )
+            {
+                const size_t count = std::min( BLOCK_SIZE, end - blockBegin );
+                block.resize( count );
+                
+                writeRestPose( uniforms, block, spin.data(), blockBegin );
+                updateInstances( block, spin.data(), uniforms.angle, 0, count );
+                
+                if constexpr ( std::is_same_v< T, CompactInstanceData > )
+                {
+                    block.encodeCompactTransforms( parent, pOut + blockBegin, 0, count );
+                    block.encodeCompactColors( pOut + blockBegin, 0, count );
+                }
+                else
+                {
+                    block.composeTransforms( parent, pOut + blockBegin, 0, count );
+                    block.writeColors( pOut + blockBegin, 0, count );
+                }
+            }
+        }
+        
+        float maxDifference( const InstanceData& a, const InstanceData& b )
+        {
+            float difference = simd_reduce_max( simd_abs( a.color - b.color ) );
+            for ( int c = 0; c < 4; ++c )
+            {
+                difference = std::max( difference, simd_reduce_max( simd_abs( a.transform.columns[ c ] - b.transform.columns[ c ] ) ) );
+            }
+            for ( int c = 0; c < 3; ++c )
+            {
+                difference = std::max( difference, simd_reduce_max( simd_abs( a.normalTransform.columns[ c ] - b.normalTransform.columns[ c ] ) ) );
+            }
+            return difference;
+        }
+    }
+
+    InstanceAnimationUniforms makeUniforms( float angle, uint32_t rows, uint32_t columns, uint32_t depth )
+    {
+        InstanceAnimationUniforms uniforms{};
+        uniforms.origin = simd::float4{ 0.0f, 0.0f, -10.0f, 1.0f };
+        uniforms.angle = angle;
+        uniforms.scale = 0.2f;
+        uniforms.rows = rows;
+        uniforms.columns = columns;
+        uniforms.depth = depth;
+        uniforms.instanceCount = rows * columns * depth;
+        return uniforms;
+    }
+
+    simd::float4x4 makeParentTransform( const InstanceAnimationUniforms& uniforms )
+    {
+        const simd::float3 origin = uniforms.origin.xyz;
+        
+        // The grid's two turns, by -angle then angle / 2, folded into one
+        simd::float4x4 rt = Math::makeTranslate( origin );
+        simd::float4x4 rr = Math::makeYRotate( -0.5f * uniforms.angle );
+        simd::float4x4 rtInv = Math::makeTranslate( { -origin.x, -origin.y, -origin.z } );
+        return rt * rr * rtInv;
+    }
+
+    void writeRestPose( const InstanceAnimationUniforms& uniforms, InstanceStore& store, float* pSpin, size_t firstIndex )
+    {
+        const float scale = uniforms.scale;
+        const float doubleScale = scale * 2.0f;
+        
+        const float halfRows = static_cast< float >( uniforms.rows ) / 2.0f;
+        const float halfColumns = static_cast< float >( uniforms.columns ) / 2.0f;
+        const float halfDepth = static_cast< float >( uniforms.depth ) / 2.0f;
+        
+        float* pTranslationX = store.getStream( InstanceStream::TranslationX );
+        float* pTranslationY = store.getStream( InstanceStream::TranslationY );
+        float* pTranslationZ = store.getStream( InstanceStream::TranslationZ );
+        float* pScaleX = store.getStream( InstanceStream::ScaleX );
+        float* pScaleY = store.getStream( InstanceStream::ScaleY );
+        float* pScaleZ = store.getStream( InstanceStream::ScaleZ );
+        float* pColorR = store.getStream( InstanceStream::ColorR );
+        float* pColorG = store.getStream( InstanceStream::ColorG );
+        float* pColorB = store.getStream( InstanceStream::ColorB );
+        float* pColorA = store.getStream( InstanceStream::ColorA );
+        
+        for ( size_t i = 0; i < store.getCount(); ++i )
+        {
+            const size_t index = firstIndex + i;
+            const InstanceGridCoordinate coordinate = getInstanceGridCoordinate( index, uniforms.rows, uniforms.columns );
+            auto fx = static_cast< float >( coordinate.x );
+            auto fy = static_cast< float >( coordinate.y );
+            auto fz = static_cast< float >( coordinate.z );
+            
+            pTranslationX[ i ] = uniforms.origin.x + ( fx - halfRows ) * doubleScale + scale;
+            pTranslationY[ i ] = uniforms.origin.y + ( fy - halfColumns ) * doubleScale + scale;
+            pTranslationZ[ i ] = uniforms.origin.z + ( fz - halfDepth ) * doubleScale;
+            pScaleX[ i ] = scale;
+            pScaleY[ i ] = scale;
+            pScaleZ[ i ] = scale;
+            
+            // Both per-instance rotations are about Z, so their angles add up
+            pSpin[ i ] = sinf( fx ) + cosf( fy );
+            
+            const float t = index / static_cast< float >( uniforms.instanceCount );
+            pColorR[ i ] = t;
+            pColorG[ i ] = 1.0f - t;
+            pColorB[ i ] = sinf( M_PI * 2.0f * t );
+            pColorA[ i ] = 1.0f;
+        }
+        
+        store.markDirty( InstanceField::Transform, 0, store.getCount() );
+        store.markDirty( InstanceField::Color, 0, store.getCount() );
+    }
+
+    void animateInstances( const InstanceAnimationUniforms& uniforms, InstanceData* pOut, size_t begin, size_t end )
+    {
+        animateBlocks( uniforms, pOut, begin, end );
+    }
+
+    void animateInstances( const InstanceAnimationUniforms& uniforms, CompactInstanceData* pOut, size_t begin, size_t end )
+    {
+        animateBlocks( uniforms, pOut, begin, end );
+    }
+
+    float measureError( const InstanceData* pInstances, const InstanceAnimationUniforms& uniforms, size_t count )
+    {
+        std::vector< InstanceData > expected( std::min< size_t >( count, uniforms.instanceCount ) );
+        animateInstances( uniforms, expected.data(), 0, expected.size() );
+        
+        float error = 0.0f;
+        for ( size_t i = 0; i < expected.size(); ++i )
+        {
+            error = std::max( error, maxDifference( pInstances[ i ], expected[ i ] ) );
+        }
+        return error;
+    }
+
+    float measureError( const CompactInstanceData* pInstances, const InstanceAnimationUniforms& uniforms, size_t count )
+    {
+        // The kernel and the host may pick opposite signs for the same rotation, decoding hides that
+        std::vector< CompactInstanceData > expected( std::min< size_t >( count, uniforms.instanceCount ) );
+        animateInstances( uniforms, expected.data(), 0, expected.size() );
+        
+        float error = 0.0f;
+        for ( size_t i = 0; i < expected.size(); ++i )
+        {
+            error = std::max( error, maxDifference( CompactInstance::decode( pInstances[ i ] ), CompactInstance::decode( expected[ i ] ) ) );
+        }
+        return error;
+    }
+
+    bool matchesReference( const InstanceData* pInstances, const InstanceAnimationUniforms& uniforms, size_t count )
+    {
+        return measureError( pInstances, uniforms, count ) <= FULL_TOLERANCE;
+    }
+
+    bool matchesReference( const CompactInstanceData* pInstances, const InstanceAnimationUniforms& uniforms, size_t count )
+    {
+        return measureError( pInstances, uniforms, count ) <= COMPACT_TOLERANCE;
+    }
+}
@@ -0,0 +1,55 @@
+//
+//  InstanceAnimation.hpp
+//  Point_Cloud_Renderer
+//
+//  Created by Vatsalya Yadav on 10/19/26.
+//
+
+#ifndef InstanceAnimation_hpp
+#define InstanceAnimation_hpp
+
+#include <cstddef>
+#include <cstdint>
+
+#include <simd/simd.h>
+
+#include "Renderer/Instances/InstanceStore.hpp"
+#include "Renderer/Structures/CompactInstanceData.hpp"
+#include "Renderer/Structures/InstanceAnimationUniforms.hpp"
+#include "Renderer/Structures/InstanceData.hpp"
+
+// CPU version of animate_instances in InstanceAnimation_Compute.metal. Instances are
+// filled a block at a time into a scratch InstanceStore and composed with its SIMD
+// paths, so the reference runs anywhere and is quick enough to check a whole frame.
+namespace PCR::InstanceAnimation
+{
+    // The demo grid: rows x columns x depth cubes in front of the camera
+    InstanceAnimationUniforms makeUniforms( float angle, uint32_t rows, uint32_t columns, uint32_t depth );
+
+    // Turn of the whole grid about the Y axis through uniforms.origin
+    simd::float4x4 makeParentTransform( const InstanceAnimationUniforms& uniforms );
+
+    // Rest pose of instances [ firstIndex, firstIndex + store.getCount() ): translation
+    // relative to the parent, scale, color and the spin rate about Z, pSpin[ i ] radians
+    // per unit of angle. Rotations are left for updateInstances.
+    void writeRestPose( const InstanceAnimationUniforms& uniforms, InstanceStore& store, float* pSpin, size_t firstIndex );
+
+    // pOut[ i ] for i in [ begin, end ) at uniforms.angle
+    void animateInstances( const InstanceAnimationUniforms& uniforms, InstanceData* pOut, size_t begin, size_t end );
+
+    void animateInstances( const InstanceAnimationUniforms& uniforms, CompactInstanceData* pOut, size_t begin, size_t end );
+
+    // Largest difference of a transform, normal transform or color element between what
+    // the kernel wrote to the first count instances and the reference, compact instances are
+    // compared decoded. count can be below uniforms.instanceCount while a buffer grows.
+    float measureError( const InstanceData* pInstances, const InstanceAnimationUniforms& uniforms, size_t count );
+
+    float measureError( const CompactInstanceData* pInstances, const InstanceAnimationUniforms& uniforms, size_t count );
+
+    // Within single precision noise of the grid's extent, or one quantization step
+    bool matchesReference( const InstanceData* pInstances, const InstanceAnimationUniforms& uniforms, size_t count );
+
+    bool matchesReference( const CompactInstanceData* pInstances, const InstanceAnimationUniforms& uniforms, size_t count );
+}
+
+#endif /* InstanceAnimation_hpp */
@@ -0,0 +1,185 @@
+//
+//  InstanceBenchmark.cpp
+//  Point_Cloud_Renderer
+//
+//  Created by Vatsalya Yadav on 10/19/26.
+//
+
+#include "InstanceBenchmark.hpp"
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+
+#include <simd/simd.h>
+
+#include "Math/SinCos.hpp"
+#include "Math/Utility.hpp"
+#include "Renderer/Instances/CompactInstance.hpp"
+#include "Renderer/Instances/InstanceStore.hpp"
+#include "Renderer/Instances/InstanceUpdate.hpp"
+#include "Renderer/Threading/WorkerPool.hpp"
+
+namespace PCR
+{
+    namespace
+    {
+        constexpr size_t INSTANCES_PER_SIZE{ 4 * 1024 * 1024 };
+        
+        template < typename Function >
+        double measureNsPerInstance( size_t instanceCount, Function&& function )
+        {
+            const size_t iterations = std::max< size_t >( 1, INSTANCES_PER_SIZE / instanceCount );
+            
+            // One untimed pass so first-touch page faults don't land in the numbers
+            function( 0.0f );
+            
+            const auto start = std::chrono::steady_clock::now();
+            for ( size_t iteration = 0; iteration < iterations; ++iteration )
+            {
+                function( 0.01f * static_cast< float >( iteration + 1 ) );
+            }
+            const double elapsedNs = std::chrono::duration< double, std::nano >( std::chrono::steady_clock::now() - start ).count();
+            return elapsedNs / static_cast< double >( iterations * instanceCount );
+        }
+    }
+
+    std::vector< InstanceBenchmarkResult > runInstanceBenchmark( const std::vector< size_t >& instanceCounts )
+    {
+        std::vector< InstanceBenchmarkResult > results;
+        
+        const simd::float4x4 parent = Math::makeTranslate( { 0.0f, 0.0f, -10.0f } ) * Math::makeYRotate( 0.3f );
+        
+        WorkerPool workerPool;
+        
+        for ( size_t instanceCount : instanceCounts )
+        {
+            InstanceStore store( instanceCount );
+            std::vector< InstanceData > instances( instanceCount );
+            std::vector< CompactInstanceData > compactInstances( instanceCount );
+            std::vector< simd::float3 > translations( instanceCount );
+            std::vector< float > spinX( instanceCount );
+            std::vector< float > spinY( instanceCount );
+            std::vector< float > spins( instanceCount );
+            
+            for ( size_t i = 0; i < instanceCount; ++i )
+            {
+                const auto fx = static_cast< float >( i % 100 );
+                const auto fy = static_cast< float >( ( i / 100 ) % 100 );
+                translations[ i ] = simd::float3{ fx * 0.4f, fy * 0.4f, static_cast< float >( i / 10000 ) * 0.4f };
+                spinX[ i ] = sinf( fx );
+                spinY[ i ] = cosf( fy );
+                spins[ i ] = spinX[ i ] + spinY[ i ];
+                store.setTranslation( i, translations[ i ] );
+                store.setScale( i, simd::float3{ 0.2f, 0.2f, 0.2f } );
+                store.setColor( i, simd::float4{ 1.0f, 0.5f, 0.25f, 1.0f } );
+            }
+            
+            InstanceBenchmarkResult result;
+            result.instanceCount = instanceCount;
+            
+            result.matrixChainNs = measureNsPerInstance( instanceCount, [ & ]( float angle ){
+                const simd::float4x4 scale = Math::makeScale( simd::float3{ 0.2f, 0.2f, 0.2f } );
+                for ( size_t i = 0; i < instanceCount; ++i )
+                {
+                    const simd::float4x4 zRotation = Math::makeZRotate( angle * spinX[ i ] );
+                    const simd::float4x4 yRotation = Math::makeZRotate( angle * spinY[ i ] );
+                    const simd::float4x4 translate = Math::makeTranslate( translations[ i ] );
+                    instances[ i ].transform = parent * translate * yRotation * zRotation * scale;
+                    instances[ i ].normalTransform = Math::discardTranslation( instances[ i ].transform );
+                    instances[ i ].color = simd::float4{ 1.0f, 0.5f, 0.25f, 1.0f };
+                }
+            });
+            
+            result.rotationUpdateNs = measureNsPerInstance( instanceCount, [ & ]( float angle ){
+                // Both rotations are about Z, so they combine into one. makeZRotate
+                // turns clockwise, hence the negated half angle
+                float* pRotationZ = store.getStream( InstanceStream::RotationZ );
+                float* pRotationW = store.getStream( InstanceStream::RotationW );
+                Math::sinCos( spins.data(), pRotationZ, pRotationW, instanceCount, -0.5f * angle );
+            });
+            
+            result.composeScalarNs = measureNsPerInstance( instanceCount, [ & ]( float ){
+                store.composeTransformsScalar( parent, instances.data(), 0, instanceCount );
+            });
+            
+            result.composeSimdNs = measureNsPerInstance( instanceCount, [ & ]( float ){
+                store.composeTransforms( parent, instances.data(), 0, instanceCount );
+            });
+            
+            result.parallelUpdateNs = measureNsPerInstance( instanceCount, [ & ]( float angle ){
+                updateInstancesParallel( workerPool, store, spins.data(), angle );
+                writeInstancesParallel( workerPool, store, InstanceField::Transform, store.takeDirtyRanges( InstanceField::Transform ), parent, instances.data() );
+            });
+            
+            result.encodeCompactNs = measureNsPerInstance( instanceCount, [ & ]( float ){
+                store.encodeCompactTransforms( parent, compactInstances.data(), 0, instanceCount );
+            });
+            
+            // Round trip of the last pose the benchmark left in the store
+            store.composeTransforms( parent, instances.data(), 0, instanceCount );
+            store.writeColors( instances.data(), 0, instanceCount );
+            store.encodeCompactTransforms( parent, compactInstances.data(), 0, instanceCount );
+            store.encodeCompactColors( compactInstances.data(), 0, instanceCount );
+            const CompactInstance::RoundTripError error = CompactInstance::measureRoundTrip( instances.data(), compactInstances.data(), instanceCount );
+            result.maxPositionError = error.maxPositionError;
+            result.maxNormalError = error.maxNormalError;
+            result.maxColorError = error.maxColorError;
+            
+            results.push_back( result );
+        }
+        
+        return results;
+    }
+
+    bool printInstanceBenchmark( const std::vector< InstanceBenchmarkResult >& results )
+    {
+        bool passed = true;
+        
+        __builtin_printf( "Instance transforms, ns per instance, SIMD path %s, sincos path %s, %u workers\n",
+                          InstanceStore::getSimdPath(),
+                          Math::getSinCosPathName( Math::getSinCosPath() ),
+                          WorkerPool().getWorkerCount() );
+        __builtin_printf( "Speedups are rotation plus compose or compact encode against the matrix chain, the compact path's target is %.1fx\n", INSTANCE_UPDATE_TARGET_SPEEDUP );
+        __builtin_printf( "%10s %12s %10s %12s %10s %10s %10s %10s %10s\n", "instances", "matrixChain", "rotation", "soaScalar", "soaSimd", "full", "parallel", "compact", "speedup" );
+        for ( const InstanceBenchmarkResult& result : results )
+        {
+            const double soaSpeedup = result.matrixChainNs / ( result.rotationUpdateNs + result.composeSimdNs );
+            const double compactSpeedup = result.matrixChainNs / ( result.rotationUpdateNs + result.encodeCompactNs );
+            const bool metTarget = compactSpeedup >= INSTANCE_UPDATE_TARGET_SPEEDUP;
+            passed = passed && metTarget;
+            
+            __builtin_printf( "%10zu %12.2f %10.2f %12.2f %10.2f %9.1fx %10.2f %10.2f %9.1fx %s\n",
+                              result.instanceCount,
+                              result.matrixChainNs,
+                              result.rotationUpdateNs,
+                              result.composeScalarNs,
+                              result.composeSimdNs,
+                              soaSpeedup,
+                              result.parallelUpdateNs,
+                              result.encodeCompactNs,
+                              compactSpeedup,
+                              metTarget ? "ok" : "FAIL" );
+        }
+        
+        __builtin_printf( "Compact round trip, max error / bound: position / scale, normal matrix / scale, color\n" );
+        for ( const InstanceBenchmarkResult& result : results )
+        {
+            const bool withinBounds = result.maxPositionError <= CompactInstance::MAX_POSITION_ERROR
+                                   && result.maxNormalError <= CompactInstance::MAX_NORMAL_ERROR
+                                   && result.maxColorError <= CompactInstance::MAX_COLOR_ERROR;
+            passed = passed && withinBounds;
+            
+            __builtin_printf( "%10zu %12.2e / %.1e %12.2e / %.1e %12.2e / %.1e %s\n",
+                              result.instanceCount,
+                              result.maxPositionError,
+                              CompactInstance::MAX_POSITION_ERROR,
+                              result.maxNormalError,
+                              CompactInstance::MAX_NORMAL_ERROR,
+                              result.maxColorError,
+                              CompactInstance::MAX_COLOR_ERROR,
+                              withinBounds ? "ok" : "FAIL" );
+        }
+        return passed;
+    }
+}
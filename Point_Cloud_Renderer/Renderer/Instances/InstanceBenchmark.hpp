@@ -0,0 +1,60 @@
+//
+//  InstanceBenchmark.hpp
+//  Point_Cloud_Renderer
+//
+//  Created by Vatsalya Yadav on 10/19/26.
+//
+
+#ifndef InstanceBenchmark_hpp
+#define InstanceBenchmark_hpp
+
+#include <cstddef>
+#include <vector>
+
+namespace PCR
+{
+    // The request's "at least 5x lower CPU cost per instance", held by the path the renderer
+    // runs by default: this frame's rotations plus the SIMD encode into CompactInstanceData,
+    // against the matrix chain. The full-precision compose is printed alongside for
+    // InstanceFormat::Full but carries no target, past 16K instances its 112 bytes of output
+    // per instance make it bound by memory writes at about 3x.
+    constexpr double INSTANCE_UPDATE_TARGET_SPEEDUP{ 5.0 };
+
+    // Nanoseconds per instance
+    struct InstanceBenchmarkResult
+    {
+        size_t instanceCount = 0;
+        
+        // Translate * rotate * rotate * scale matrices per instance, the old Renderer::draw loop
+        double matrixChainNs = 0.0;
+        
+        // Writing this frame's rotations into the store, one batched sincos per instance
+        double rotationUpdateNs = 0.0;
+        
+        double composeScalarNs = 0.0;
+        
+        double composeSimdNs = 0.0;
+        
+        // Rotation update and SIMD compose split across a worker pool
+        double parallelUpdateNs = 0.0;
+        
+        // SIMD encode into CompactInstanceData
+        double encodeCompactNs = 0.0;
+        
+        // Decoded compact instances against the full-precision ones, see CompactInstance's bounds
+        float maxPositionError = 0.0f;
+        
+        float maxNormalError = 0.0f;
+        
+        float maxColorError = 0.0f;
+    };
+
+    // Runs every size enough times to cover a few million instances, results in the same order
+    std::vector< InstanceBenchmarkResult > runInstanceBenchmark( const std::vector< size_t >& instanceCounts );
+
+    // Returns false if the compact path misses INSTANCE_UPDATE_TARGET_SPEEDUP or a compact
+    // round trip is outside CompactInstance's bounds
+    bool printInstanceBenchmark( const std::vector< InstanceBenchmarkResult >& results );
+}
+
+#endif /* InstanceBenchmark_hpp */
@@ -0,0 +1,220 @@
+//
+//  InstanceBuffer.cpp
+//  Point_Cloud_Renderer
+//
+//  Created by Vatsalya Yadav on 10/19/26.
+//
+
+#include "InstanceBuffer.hpp"
+
+#include <algorithm>
+#include <cassert>
+#include <cstddef>
+#include <cstring>
+#include <vector>
+
+#include <Metal/Metal.hpp>
+
+#include "Renderer/Instances/InstanceUpdate.hpp"
+#include "Renderer/Scene/RenderSystems.hpp"
+
+namespace PCR
+{
+    namespace
+    {
+        // Flushing a few clean bytes between two ranges is cheaper than another call
+        constexpr size_t MODIFY_RANGE_MERGE_GAP{ 4096 };
+        
+        // Bytes of every instance a field occupies, color comes last in both formats
+        void getFieldBytes( InstanceFormat format, InstanceField field, size_t& offset, size_t& size )
+        {
+            const size_t colorOffset = format == InstanceFormat::Full ? offsetof( InstanceData, color ) : offsetof( CompactInstanceData, color );
+            if ( field == InstanceField::Transform )
+            {
+                offset = 0;
+                size = colorOffset;
+            }
+            else
+            {
+                offset = colorOffset;
+                size = ( format == InstanceFormat::Full ? sizeof( InstanceData::color ) : sizeof( CompactInstanceData::color ) );
+            }
+        }
+    }
+
+    InstanceBuffer::InstanceBuffer( MTL::Device* pDevice, size_t capacity, InstanceFormat format, uint32_t copyCount /* = MAX_FRAMES_IN_FLIGHT */ )
+    :   _pDevice{ pDevice }
+    ,   _pBuffer{ nullptr }
+    ,   _capacity{ 0 }
+    ,   _format{ format }
+    ,   _copyCount{ copyCount }
+    ,   _copySize{ 0 }
+    ,   _trackers{ DirtyRangeTracker( copyCount ), DirtyRangeTracker( copyCount ) }
+    ,   _parent{}
+    ,   _hasParent{ false }
+    {
+        allocate( capacity );
+    }
+
+    InstanceBuffer::~InstanceBuffer()
+    {
+        _pBuffer->release();
+    }
+
+    void InstanceBuffer::update( InstanceStore& store, const simd::float4x4& parent, WorkerPool& workerPool, uint32_t copyIndex )
+    {
+        assert( store.getCount() <= _capacity );
+        
+        DirtyRangeTracker& transformTracker = _trackers[ static_cast< size_t >( InstanceField::Transform ) ];
+        if ( !_hasParent || std::memcmp( &parent, &_parent, sizeof( parent ) ) != 0 )
+        {
+            transformTracker.markDirty( 0, store.getCount() );
+            _parent = parent;
+            _hasParent = true;
+        }
+        
+        for ( size_t field = 0; field < _trackers.size(); ++field )
+        {
+            for ( const DirtyRange& range : store.takeDirtyRanges( static_cast< InstanceField >( field ) ) )
+            {
+                _trackers[ field ].markDirty( range.begin, range.end );
+            }
+        }
+        
+        void* pCopy = static_cast< uint8_t* >( _pBuffer->contents() ) + copyIndex * _copySize;
+        const size_t stride = getStride();
+        
+        std::vector< DirtyRange > byteRanges;
+        for ( size_t field = 0; field < _trackers.size(); ++field )
+        {
+            // Ranges past the end of the store stay unwritten until it grows into them
+            std::vector< DirtyRange > ranges = _trackers[ field ].takeRanges( copyIndex );
+            std::vector< DirtyRange > storeRanges;
+            for ( DirtyRange& range : ranges )
+            {
+                if ( range.end > store.getCount() )
+                {
+                    _trackers[ field ].markDirtyCopy( copyIndex, std::max( range.begin, store.getCount() ), range.end );
+                    range.end = store.getCount();
+                }
+                if ( range.begin < range.end )
+                {
+                    storeRanges.push_back( range );
+                }
+            }
+            
+            const auto instanceField = static_cast< InstanceField >( field );
+            if ( _format == InstanceFormat::Full )
+            {
+                writeInstancesParallel( workerPool, store, instanceField, storeRanges, parent, static_cast< InstanceData* >( pCopy ) );
+            }
+            else
+            {
+                writeInstancesParallel( workerPool, store, instanceField, storeRanges, parent, static_cast< CompactInstanceData* >( pCopy ) );
+            }
+            
+            size_t fieldOffset = 0;
+            size_t fieldSize = 0;
+            getFieldBytes( _format, instanceField, fieldOffset, fieldSize );
+            for ( const DirtyRange& range : storeRanges )
+            {
+                byteRanges.push_back( DirtyRange{ range.begin * stride + fieldOffset, ( range.end - 1 ) * stride + fieldOffset + fieldSize } );
+            }
+        }
+        
+        coalesceRanges( byteRanges, MODIFY_RANGE_MERGE_GAP );
+        
+        _stats = InstanceBufferStats{};
+        for ( const DirtyRange& range : byteRanges )
+        {
+            _pBuffer->didModifyRange( NS::Range::Make( copyIndex * _copySize + range.begin, range.end - range.begin ) );
+            _stats.bytesModified += range.end - range.begin;
+            _stats.modifyRangeCount += 1;
+        }
+    }
+
+    size_t InstanceBuffer::gather( EntityWorld& world, const simd::float4x4& parent, WorkerPool& workerPool, uint32_t copyIndex )
+    {
+        void* pCopy = static_cast< uint8_t* >( _pBuffer->contents() ) + copyIndex * _copySize;
+        
+        size_t count = 0;
+        if ( _format == InstanceFormat::Full )
+        {
+            count = gatherInstances( world, workerPool, parent, static_cast< InstanceData* >( pCopy ), _capacity );
+        }
+        else
+        {
+            count = gatherInstances( world, workerPool, parent, static_cast< CompactInstanceData* >( pCopy ), _capacity );
+        }
+        
+        _stats = InstanceBufferStats{};
+        if ( count > 0 )
+        {
+            _pBuffer->didModifyRange( NS::Range::Make( copyIndex * _copySize, count * getStride() ) );
+            _stats.bytesModified = count * getStride();
+            _stats.modifyRangeCount = 1;
+        }
+        
+        // None of the copies hold the store's contents any more
+        for ( DirtyRangeTracker& tracker : _trackers )
+        {
+            tracker.markDirty( 0, _capacity );
+        }
+        _hasParent = false;
+        return count;
+    }
+
+    void InstanceBuffer::reserve( size_t capacity, DeferredDeletionQueue& deletionQueue, uint64_t frameIndex )
+    {
+        if ( capacity <= _capacity )
+        {
+            return;
+        }
+        
+        deletionQueue.retire( _pBuffer, frameIndex );
+        allocate( std::max( capacity, _capacity * 2 ) );
+    }
+
+    FrameAllocation InstanceBuffer::getAllocation( uint32_t copyIndex ) const
+    {
+        FrameAllocation allocation;
+        allocation.pBuffer = _pBuffer;
+        allocation.offset = copyIndex * _copySize;
+        allocation.size = _capacity * getStride();
+        allocation.pData = static_cast< uint8_t* >( _pBuffer->contents() ) + allocation.offset;
+        return allocation;
+    }
+
+    size_t InstanceBuffer::getCapacity() const
+    {
+        return _capacity;
+    }
+
+    InstanceFormat InstanceBuffer::getFormat() const
+    {
+        return _format;
+    }
+
+    size_t InstanceBuffer::getStride() const
+    {
+        return _format == InstanceFormat::Full ? sizeof( InstanceData ) : sizeof( CompactInstanceData );
+    }
+
+    const InstanceBufferStats& InstanceBuffer::getStats() const
+    {
+        return _stats;
+    }
+
+    void InstanceBuffer::allocate( size_t capacity )
+    {
+        _capacity = capacity;
+        _copySize = ( capacity * getStride() + FrameRingAllocator::DEFAULT_ALIGNMENT - 1 ) / FrameRingAllocator::DEFAULT_ALIGNMENT * FrameRingAllocator::DEFAULT_ALIGNMENT;
+        _pBuffer = _pDevice->newBuffer( _copySize * _copyCount, MTL::ResourceStorageModeManaged );
+        
+        // Nothing has been written yet, whatever the store says
+        for ( DirtyRangeTracker& tracker : _trackers )
+        {
+            tracker.markDirty( 0, capacity );
+        }
+    }
+}
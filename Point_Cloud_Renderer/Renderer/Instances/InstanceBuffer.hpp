@@ -0,0 +1,115 @@
+//
+//  InstanceBuffer.hpp
+//  Point_Cloud_Renderer
+//
+//  Created by Vatsalya Yadav on 10/19/26.
+//
+
+#ifndef InstanceBuffer_hpp
+#define InstanceBuffer_hpp
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+
+#include <simd/simd.h>
+
+#include "Core/Core.hpp"
+#include "Renderer/Buffer/DeferredDeletionQueue.hpp"
+#include "Renderer/Buffer/DirtyRangeTracker.hpp"
+#include "Renderer/Buffer/FrameRingAllocator.hpp"
+#include "Renderer/Instances/InstanceStore.hpp"
+#include "Renderer/Scene/EntityWorld.hpp"
+
+FD_MTL
+
+namespace PCR
+{
+    class WorkerPool;
+
+    enum class InstanceFormat
+    {
+        // InstanceData, 128 bytes
+        Full,
+        
+        // CompactInstanceData, 32 bytes, rigid transforms with uniform scale only
+        Compact
+    };
+
+    struct InstanceBufferStats
+    {
+        // Written and flushed by the last update
+        uint64_t bytesModified = 0;
+        
+        uint32_t modifyRangeCount = 0;
+    };
+
+    // GPU copy of an InstanceStore, one per frame in flight, that persists between
+    // frames. Each update rewrites only the fields and ranges this copy hasn't seen
+    // yet and flushes them with as few didModifyRange calls as it can, so a scene
+    // that isn't changing costs no bandwidth at all.
+    class InstanceBuffer
+    {
+    public:
+        // Every copy starts out dirty
+        InstanceBuffer( MTL::Device* pDevice, size_t capacity, InstanceFormat format, uint32_t copyCount = MAX_FRAMES_IN_FLIGHT );
+        
+        ~InstanceBuffer();
+        
+        InstanceBuffer( const InstanceBuffer& ) = delete;
+        
+        InstanceBuffer& operator=( const InstanceBuffer& ) = delete;
+        
+        // Picks up the store's dirty ranges for every copy, then brings copyIndex up to
+        // date. A new parent transform dirties every transform. The frame throttling
+        // must make sure the GPU is done with copyIndex's last frame.
+        void update( InstanceStore& store, const simd::float4x4& parent, WorkerPool& workerPool, uint32_t copyIndex );
+        
+        // Fills copyIndex from the entities instead, every gathered instance is rewritten
+        // and the next update() starts over from a fully dirty buffer. Returns the count.
+        size_t gather( EntityWorld& world, const simd::float4x4& parent, WorkerPool& workerPool, uint32_t copyIndex );
+        
+        // Replaces the buffer with one for at least capacity instances, doubling. Frames in
+        // flight keep reading the old one until frameIndex completes. Nothing is copied
+        // across, every copy starts out dirty and update() refills it from the store.
+        void reserve( size_t capacity, DeferredDeletionQueue& deletionQueue, uint64_t frameIndex );
+        
+        // getCapacity() instances of copyIndex
+        FrameAllocation getAllocation( uint32_t copyIndex ) const;
+        
+        size_t getCapacity() const;
+        
+        InstanceFormat getFormat() const;
+        
+        // Bytes per instance
+        size_t getStride() const;
+        
+        const InstanceBufferStats& getStats() const;
+
+    private:
+        MTL::Device* _pDevice;
+        
+        MTL::Buffer* _pBuffer;
+        
+        size_t _capacity;
+        
+        InstanceFormat _format;
+        
+        uint32_t _copyCount;
+        
+        NS::UInteger _copySize;
+        
+        std::array< DirtyRangeTracker, static_cast< size_t >( InstanceField::Count ) > _trackers;
+        
+        simd::float4x4 _parent;
+        
+        bool _hasParent;
+        
+        InstanceBufferStats _stats;
+        
+        // A new buffer of capacity instances per copy, with every copy dirty
+        void allocate( size_t capacity );
+    };
+}
+
+#endif /* InstanceBuffer_hpp */
@@ -0,0 +1,102 @@
+//
+//  InstancePool.cpp
+//  Point_Cloud_Renderer
+//
+//  Created by Vatsalya Yadav on 10/19/26.
+//
+
+#include "InstancePool.hpp"
+
+#include <algorithm>
+#include <cassert>
+
+namespace PCR
+{
+    namespace
+    {
+        // Slot of a handle index that's on the free list
+        constexpr uint32_t FREE_SLOT{ UINT32_MAX };
+    }
+
+    InstancePool::InstancePool( size_t minCapacity /* = INSTANCE_POOL_MIN_CAPACITY */ )
+    :   _capacity{ std::max< size_t >( minCapacity, 1 ) }
+    {
+    }
+
+    InstanceHandle InstancePool::allocate()
+    {
+        InstanceHandle handle;
+        if ( _freeIndices.empty() )
+        {
+            handle.index = static_cast< uint32_t >( _slots.size() );
+            _slots.push_back( FREE_SLOT );
+            _generations.push_back( 0 );
+        }
+        else
+        {
+            handle.index = _freeIndices.back();
+            _freeIndices.pop_back();
+        }
+        
+        handle.generation = _generations[ handle.index ];
+        _slots[ handle.index ] = static_cast< uint32_t >( _owners.size() );
+        _owners.push_back( handle.index );
+        
+        while ( _owners.size() > _capacity )
+        {
+            _capacity *= 2;
+        }
+        return handle;
+    }
+
+    InstanceMove InstancePool::free( InstanceHandle handle )
+    {
+        if ( !isAlive( handle ) )
+        {
+            return InstanceMove{};
+        }
+        
+        const size_t slot = _slots[ handle.index ];
+        const size_t last = _owners.size() - 1;
+        
+        // The last instance fills the hole
+        const uint32_t movedIndex = _owners[ last ];
+        _owners[ slot ] = movedIndex;
+        _slots[ movedIndex ] = static_cast< uint32_t >( slot );
+        _owners.pop_back();
+        
+        _slots[ handle.index ] = FREE_SLOT;
+        ++_generations[ handle.index ];
+        _freeIndices.push_back( handle.index );
+        return InstanceMove{ last, slot };
+    }
+
+    bool InstancePool::isAlive( InstanceHandle handle ) const
+    {
+        return handle.index < _slots.size()
+            && _slots[ handle.index ] != FREE_SLOT
+            && _generations[ handle.index ] == handle.generation;
+    }
+
+    size_t InstancePool::getSlot( InstanceHandle handle ) const
+    {
+        assert( isAlive( handle ) );
+        return _slots[ handle.index ];
+    }
+
+    InstanceHandle InstancePool::getHandle( size_t slot ) const
+    {
+        const uint32_t index = _owners[ slot ];
+        return InstanceHandle{ index, _generations[ index ] };
+    }
+
+    size_t InstancePool::getCount() const
+    {
+        return _owners.size();
+    }
+
+    size_t InstancePool::getCapacity() const
+    {
+        return _capacity;
+    }
+}
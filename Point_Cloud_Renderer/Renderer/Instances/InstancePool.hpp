@@ -0,0 +1,82 @@
+//
+//  InstancePool.hpp
+//  Point_Cloud_Renderer
+//
+//  Created by Vatsalya Yadav on 10/19/26.
+//
+
+#ifndef InstancePool_hpp
+#define InstancePool_hpp
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+#include "Renderer/Data/Constants.hpp"
+
+namespace PCR
+{
+    struct InstanceHandle
+    {
+        uint32_t index = UINT32_MAX;
+        
+        // Bumped when the index is reused, so stale handles stop resolving
+        uint32_t generation = 0;
+        
+        bool operator==( const InstanceHandle& other ) const = default;
+    };
+
+    constexpr InstanceHandle INVALID_INSTANCE_HANDLE{};
+
+    // The instance data at slot from has to be copied to slot to, nothing to do when they're equal
+    struct InstanceMove
+    {
+        size_t from = 0;
+        
+        size_t to = 0;
+    };
+
+    // Hands out stable handles to instances whose data sits in slots [ 0, getCount() ).
+    // Freeing moves the last instance into the hole, so the slots stay dense and a draw
+    // covers them without gaps; handle indices go on a free list and are reused. The
+    // capacity doubles whenever the count outgrows it, buffers sized from it grow rarely.
+    class InstancePool
+    {
+    public:
+        explicit InstancePool( size_t minCapacity = INSTANCE_POOL_MIN_CAPACITY );
+        
+        // The new instance's slot is getCount() - 1
+        InstanceHandle allocate();
+        
+        // Returns the move that keeps the slots dense, the caller moves its data to match
+        InstanceMove free( InstanceHandle handle );
+        
+        bool isAlive( InstanceHandle handle ) const;
+        
+        // Valid until the next free()
+        size_t getSlot( InstanceHandle handle ) const;
+        
+        // Handle of the instance in slot
+        InstanceHandle getHandle( size_t slot ) const;
+        
+        size_t getCount() const;
+        
+        // Never shrinks
+        size_t getCapacity() const;
+
+    private:
+        // Per handle index
+        std::vector< uint32_t > _slots;
+        
+        std::vector< uint32_t > _generations;
+        
+        // Per slot, the handle index living there
+        std::vector< uint32_t > _owners;
+        
+        std::vector< uint32_t > _freeIndices;
+        
+        size_t _capacity;
+    };
+}
+
+#endif /* InstancePool_hpp */
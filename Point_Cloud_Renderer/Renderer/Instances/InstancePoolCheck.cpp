@@ -0,0 +1,214 @@
+//
+//  InstancePoolCheck.cpp
+//  Point_Cloud_Renderer
+//
+//  Created by Vatsalya Yadav on 10/19/26.
+//
+
+#include "InstancePoolCheck.hpp"
+
+#include <vector>
+
+#include <simd/simd.h>
+
+#include "Renderer/Instances/InstancePool.hpp"
+#include "Renderer/Instances/InstanceStore.hpp"
+#include "Renderer/Validation/CheckReport.hpp"
+
+namespace PCR
+{
+    namespace
+    {
+        // Small, so a hundred instances double the capacity three times
+        constexpr size_t MIN_CAPACITY{ 16 };
+        
+        constexpr uint32_t INSTANCE_COUNT{ 100 };
+        
+        constexpr uint32_t CAPACITY_GROWS{ 3 };
+        
+        // Freed from the middle, with the last instance still alive
+        constexpr uint32_t MIDDLE_INSTANCE{ 10 };
+        
+        struct CreatedInstance
+        {
+            InstanceHandle handle;
+            
+            bool freed = false;
+        };
+        
+        // Every instance carries its creation order in a translation and a color stream, so
+        // its data can be found wherever it was moved
+        InstanceHandle allocateTagged( InstancePool& pool, InstanceStore& store, uint32_t id )
+        {
+            const InstanceHandle handle = pool.allocate();
+            store.resize( pool.getCount() );
+            
+            const auto value = static_cast< float >( id );
+            store.setTranslation( pool.getSlot( handle ), simd::float3{ value, 0.0f, -value } );
+            store.setColor( pool.getSlot( handle ), simd::float4{ value, 0.0f, 0.0f, 1.0f } );
+            return handle;
+        }
+        
+        InstanceMove freeTagged( InstancePool& pool, InstanceStore& store, InstanceHandle handle )
+        {
+            const InstanceMove move = pool.free( handle );
+            store.moveInstance( move.from, move.to );
+            store.resize( pool.getCount() );
+            return move;
+        }
+        
+        // Alive handles find their own data and the slot's handle is theirs, freed ones don't resolve
+        bool resolvesAll( const InstancePool& pool, const InstanceStore& store, const std::vector< CreatedInstance >& created )
+        {
+            if ( store.getCount() != pool.getCount() )
+            {
+                return false;
+            }
+            
+            const float* pTranslationX = store.getStream( InstanceStream::TranslationX );
+            const float* pTranslationZ = store.getStream( InstanceStream::TranslationZ );
+            const float* pColorR = store.getStream( InstanceStream::ColorR );
+            size_t aliveCount = 0;
+            for ( uint32_t i = 0; i < created.size(); ++i )
+            {
+                const InstanceHandle handle = created[ i ].handle;
+                if ( created[ i ].freed )
+                {
+                    if ( pool.isAlive( handle ) )
+                    {
+                        return false;
+                    }
+                    continue;
+                }
+                
+                if ( !pool.isAlive( handle ) )
+                {
+                    return false;
+                }
+                
+                const size_t slot = pool.getSlot( handle );
+                const auto value = static_cast< float >( i );
+                if ( slot >= pool.getCount() || pool.getHandle( slot ) != handle
+                     || pTranslationX[ slot ] != value || pTranslationZ[ slot ] != -value || pColorR[ slot ] != value )
+                {
+                    return false;
+                }
+                ++aliveCount;
+            }
+            return aliveCount == pool.getCount();
+        }
+        
+        void checkAllocateFree( CheckReport& report )
+        {
+            InstancePool pool( MIN_CAPACITY );
+            InstanceStore store;
+            std::vector< CreatedInstance > created;
+            
+            bool dense = true;
+            for ( uint32_t i = 0; i < INSTANCE_COUNT; ++i )
+            {
+                const InstanceHandle handle = allocateTagged( pool, store, i );
+                dense = dense && pool.getSlot( handle ) == i;
+                created.push_back( CreatedInstance{ handle } );
+            }
+            report.expect( dense && pool.getCount() == INSTANCE_COUNT, "allocate: each new instance takes the next slot" );
+            report.expect( resolvesAll( pool, store, created ), "allocate: every handle resolves to its own data" );
+            
+            store.takeDirtyRanges( InstanceField::Transform );
+            store.takeDirtyRanges( InstanceField::Color );
+            
+            const size_t hole = pool.getSlot( created[ MIDDLE_INSTANCE ].handle );
+            const InstanceHandle last = pool.getHandle( pool.getCount() - 1 );
+            const InstanceMove move = freeTagged( pool, store, created[ MIDDLE_INSTANCE ].handle );
+            created[ MIDDLE_INSTANCE ].freed = true;
+            report.expect( move.from == INSTANCE_COUNT - 1 && move.to == hole && pool.getSlot( last ) == hole, "free: the last instance moves into the hole" );
+            report.expect( resolvesAll( pool, store, created ), "free: moveInstance carries the moved instance's data into the hole" );
+            
+            // The instance buffer rewrites the hole, and only the hole
+            const std::vector< DirtyRange > transformRanges = store.takeDirtyRanges( InstanceField::Transform );
+            const std::vector< DirtyRange > colorRanges = store.takeDirtyRanges( InstanceField::Color );
+            const bool holeDirty = transformRanges.size() == 1 && transformRanges[ 0 ].begin == hole && transformRanges[ 0 ].end == hole + 1
+                                && colorRanges.size() == 1 && colorRanges[ 0 ].begin == hole && colorRanges[ 0 ].end == hole + 1;
+            report.expect( holeDirty, "free: the hole is marked dirty for every field" );
+            
+            // Which instance sits last is read back from its data
+            const size_t tailSlot = pool.getCount() - 1;
+            const auto tailId = static_cast< uint32_t >( store.getStream( InstanceStream::TranslationX )[ tailSlot ] );
+            const InstanceMove tailMove = freeTagged( pool, store, pool.getHandle( tailSlot ) );
+            created[ tailId ].freed = true;
+            report.expect( tailMove.from == tailMove.to && resolvesAll( pool, store, created ), "free: freeing the last slot moves nothing" );
+            
+            // Every third from the front, so nearly every free moves an instance
+            for ( uint32_t i = 0; i < INSTANCE_COUNT; i += 3 )
+            {
+                if ( !created[ i ].freed )
+                {
+                    freeTagged( pool, store, created[ i ].handle );
+                    created[ i ].freed = true;
+                }
+            }
+            report.expect( resolvesAll( pool, store, created ), "free: data follows every move across many frees" );
+            
+            const size_t count = pool.getCount();
+            const InstanceMove staleMove = pool.free( created[ MIDDLE_INSTANCE ].handle );
+            report.expect( pool.getCount() == count && staleMove.from == staleMove.to, "free: freeing a dead handle does nothing" );
+            
+            // Every freed index comes back once, with its generation bumped past the stale handle's
+            bool reusesIndices = true;
+            const auto freedCount = static_cast< uint32_t >( INSTANCE_COUNT - count );
+            for ( uint32_t i = 0; i < freedCount; ++i )
+            {
+                const InstanceHandle handle = allocateTagged( pool, store, static_cast< uint32_t >( created.size() ) );
+                reusesIndices = reusesIndices && handle.index < INSTANCE_COUNT && handle.generation == created[ handle.index ].handle.generation + 1;
+                created.push_back( CreatedInstance{ handle } );
+            }
+            report.expect( reusesIndices, "generations: freed indices are reused with a new generation" );
+            report.expect( resolvesAll( pool, store, created ), "generations: stale handles to reused indices stop resolving" );
+        }
+        
+        void checkCapacity( CheckReport& report )
+        {
+            InstancePool pool( MIN_CAPACITY );
+            report.expect( pool.getCapacity() == MIN_CAPACITY, "capacity: starts at the minimum" );
+            
+            bool doubles = true;
+            uint32_t grows = 0;
+            size_t capacity = MIN_CAPACITY;
+            std::vector< InstanceHandle > handles;
+            for ( uint32_t i = 0; i < INSTANCE_COUNT; ++i )
+            {
+                handles.push_back( pool.allocate() );
+                if ( pool.getCapacity() != capacity )
+                {
+                    doubles = doubles && pool.getCapacity() == capacity * 2 && pool.getCount() == capacity + 1;
+                    capacity = pool.getCapacity();
+                    ++grows;
+                }
+            }
+            report.expect( doubles && grows == CAPACITY_GROWS, "capacity: doubles exactly when the count outgrows it" );
+            
+            for ( const InstanceHandle handle : handles )
+            {
+                pool.free( handle );
+            }
+            report.expect( pool.getCount() == 0 && pool.getCapacity() == capacity, "capacity: never shrinks when instances are freed" );
+            
+            while ( pool.getCount() < capacity )
+            {
+                pool.allocate();
+            }
+            report.expect( pool.getCapacity() == capacity, "capacity: refilling up to it doesn't grow it" );
+            
+            pool.allocate();
+            report.expect( pool.getCapacity() == capacity * 2, "capacity: one instance past it doubles it" );
+        }
+    }
+
+    bool runInstancePoolChecks()
+    {
+        CheckReport report( "Instance pool" );
+        checkAllocateFree( report );
+        checkCapacity( report );
+        return report.finish();
+    }
+}
@@ -0,0 +1,22 @@
+//
+//  InstancePoolCheck.hpp
+//  Point_Cloud_Renderer
+//
+//  Created by Vatsalya Yadav on 10/19/26.
+//
+
+#ifndef InstancePoolCheck_hpp
+#define InstancePoolCheck_hpp
+
+namespace PCR
+{
+    // InstancePool with an InstanceStore following its moves through moveInstance, the way
+    // the renderer keeps them together: allocation hands out dense slots, freeing moves the
+    // last instance into the hole and its data with it, stale handles stop resolving once
+    // their index comes back with a new generation, and the capacity doubles exactly when
+    // the count outgrows it and never shrinks.
+    // Returns false if any check fails.
+    bool runInstancePoolChecks();
+}
+
+#endif /* InstancePoolCheck_hpp */
@@ -0,0 +1,420 @@
+//
+//  InstanceStore.cpp
+//  Point_Cloud_Renderer
+//
+//  Created by Vatsalya Yadav on 10/19/26.
+//
+
+#include "InstanceStore.hpp"
+
+#include "Math/FloatLanes.hpp"
+#include "Renderer/Instances/CompactInstance.hpp"
+
+namespace PCR
+{
+    namespace
+    {
+        namespace Lanes = Math::FloatLanes;
+        
+        constexpr size_t streamIndex( InstanceStream stream )
+        {
+            return static_cast< size_t >( stream );
+        }
+        
+        constexpr size_t fieldIndex( InstanceField field )
+        {
+            return static_cast< size_t >( field );
+        }
+        
+        // Column-major element index of row r, column c
+        constexpr size_t element( size_t r, size_t c )
+        {
+            return c * 4 + r;
+        }
+        
+        // Two snorm16 values already scaled and rounded
+        uint32_t packSnorm16Bits( int32_t low, int32_t high )
+        {
+            return static_cast< uint32_t >( static_cast< uint16_t >( low ) ) | ( static_cast< uint32_t >( static_cast< uint16_t >( high ) ) << 16 );
+        }
+    }
+
+    InstanceStore::InstanceStore( size_t count /* = 0 */ )
+    :   _count{ 0 }
+    {
+        resize( count );
+    }
+
+    void InstanceStore::resize( size_t count )
+    {
+        for ( size_t stream = 0; stream < _streams.size(); ++stream )
+        {
+            const bool isOne = stream == streamIndex( InstanceStream::RotationW )
+                            || stream >= streamIndex( InstanceStream::ScaleX );
+            _streams[ stream ].resize( count, isOne ? 1.0f : 0.0f );
+        }
+        
+        for ( size_t field = 0; field < _dirtyRanges.size(); ++field )
+        {
+            markDirty( static_cast< InstanceField >( field ), _count, count );
+        }
+        _count = count;
+    }
+
+    size_t InstanceStore::getCount() const
+    {
+        return _count;
+    }
+
+    void InstanceStore::setTranslation( size_t index, const simd::float3& translation )
+    {
+        _streams[ streamIndex( InstanceStream::TranslationX ) ][ index ] = translation.x;
+        _streams[ streamIndex( InstanceStream::TranslationY ) ][ index ] = translation.y;
+        _streams[ streamIndex( InstanceStream::TranslationZ ) ][ index ] = translation.z;
+        markDirty( InstanceField::Transform, index, index + 1 );
+    }
+
+    void InstanceStore::setRotation( size_t index, const simd::float4& quaternion )
+    {
+        _streams[ streamIndex( InstanceStream::RotationX ) ][ index ] = quaternion.x;
+        _streams[ streamIndex( InstanceStream::RotationY ) ][ index ] = quaternion.y;
+        _streams[ streamIndex( InstanceStream::RotationZ ) ][ index ] = quaternion.z;
+        _streams[ streamIndex( InstanceStream::RotationW ) ][ index ] = quaternion.w;
+        markDirty( InstanceField::Transform, index, index + 1 );
+    }
+
+    void InstanceStore::setScale( size_t index, const simd::float3& scale )
+    {
+        _streams[ streamIndex( InstanceStream::ScaleX ) ][ index ] = scale.x;
+        _streams[ streamIndex( InstanceStream::ScaleY ) ][ index ] = scale.y;
+        _streams[ streamIndex( InstanceStream::ScaleZ ) ][ index ] = scale.z;
+        markDirty( InstanceField::Transform, index, index + 1 );
+    }
+
+    void InstanceStore::setColor( size_t index, const simd::float4& color )
+    {
+        _streams[ streamIndex( InstanceStream::ColorR ) ][ index ] = color.x;
+        _streams[ streamIndex( InstanceStream::ColorG ) ][ index ] = color.y;
+        _streams[ streamIndex( InstanceStream::ColorB ) ][ index ] = color.z;
+        _streams[ streamIndex( InstanceStream::ColorA ) ][ index ] = color.w;
+        markDirty( InstanceField::Color, index, index + 1 );
+    }
+
+    void InstanceStore::moveInstance( size_t from, size_t to )
+    {
+        if ( from == to )
+        {
+            return;
+        }
+        
+        for ( std::vector< float >& stream : _streams )
+        {
+            stream[ to ] = stream[ from ];
+        }
+        markDirty( InstanceField::Transform, to, to + 1 );
+        markDirty( InstanceField::Color, to, to + 1 );
+    }
+
+    float* InstanceStore::getStream( InstanceStream stream )
+    {
+        return _streams[ streamIndex( stream ) ].data();
+    }
+
+    const float* InstanceStore::getStream( InstanceStream stream ) const
+    {
+        return _streams[ streamIndex( stream ) ].data();
+    }
+
+    void InstanceStore::markDirty( InstanceField field, size_t begin, size_t end )
+    {
+        appendRange( _dirtyRanges[ fieldIndex( field ) ], begin, end );
+    }
+
+    std::vector< DirtyRange > InstanceStore::takeDirtyRanges( InstanceField field )
+    {
+        std::vector< DirtyRange > ranges;
+        ranges.swap( _dirtyRanges[ fieldIndex( field ) ] );
+        coalesceRanges( ranges );
+        return ranges;
+    }
+
+    void InstanceStore::composeTransforms( const simd::float4x4& parent, InstanceData* pOut, size_t begin, size_t end ) const
+    {
+        const float* tx = getStream( InstanceStream::TranslationX );
+        const float* ty = getStream( InstanceStream::TranslationY );
+        const float* tz = getStream( InstanceStream::TranslationZ );
+        const float* qx = getStream( InstanceStream::RotationX );
+        const float* qy = getStream( InstanceStream::RotationY );
+        const float* qz = getStream( InstanceStream::RotationZ );
+        const float* qw = getStream( InstanceStream::RotationW );
+        const float* sx = getStream( InstanceStream::ScaleX );
+        const float* sy = getStream( InstanceStream::ScaleY );
+        const float* sz = getStream( InstanceStream::ScaleZ );
+        
+        Lanes::Register p[ 16 ];
+        for ( size_t c = 0; c < 4; ++c )
+        {
+            for ( size_t r = 0; r < 4; ++r )
+            {
+                p[ element( r, c ) ] = Lanes::broadcast( parent.columns[ c ][ r ] );
+            }
+        }
+        
+        const Lanes::Register one = Lanes::broadcast( 1.0f );
+        const Lanes::Register two = Lanes::broadcast( 2.0f );
+        
+        // Lane-major scratch, transposed into the per-instance layout below
+        alignas( 32 ) float m[ 16 ][ Lanes::WIDTH ];
+        
+        size_t i = begin;
+        for ( ; i + Lanes::WIDTH <= end; i += Lanes::WIDTH )
+        {
+            const Lanes::Register x = Lanes::load( qx + i );
+            const Lanes::Register y = Lanes::load( qy + i );
+            const Lanes::Register z = Lanes::load( qz + i );
+            const Lanes::Register w = Lanes::load( qw + i );
+            
+            const Lanes::Register x2 = Lanes::mul( x, two );
+            const Lanes::Register y2 = Lanes::mul( y, two );
+            const Lanes::Register z2 = Lanes::mul( z, two );
+            const Lanes::Register xx = Lanes::mul( x, x2 );
+            const Lanes::Register yy = Lanes::mul( y, y2 );
+            const Lanes::Register zz = Lanes::mul( z, z2 );
+            const Lanes::Register xy = Lanes::mul( x, y2 );
+            const Lanes::Register xz = Lanes::mul( x, z2 );
+            const Lanes::Register yz = Lanes::mul( y, z2 );
+            const Lanes::Register wx = Lanes::mul( w, x2 );
+            const Lanes::Register wy = Lanes::mul( w, y2 );
+            const Lanes::Register wz = Lanes::mul( w, z2 );
+            
+            const Lanes::Register scaleX = Lanes::load( sx + i );
+            const Lanes::Register scaleY = Lanes::load( sy + i );
+            const Lanes::Register scaleZ = Lanes::load( sz + i );
+            
+            // Columns of R * S
+            Lanes::Register l[ 3 ][ 3 ];
+            l[ 0 ][ 0 ] = Lanes::mul( Lanes::sub( one, Lanes::add( yy, zz ) ), scaleX );
+            l[ 0 ][ 1 ] = Lanes::mul( Lanes::add( xy, wz ), scaleX );
+            l[ 0 ][ 2 ] = Lanes::mul( Lanes::sub( xz, wy ), scaleX );
+            l[ 1 ][ 0 ] = Lanes::mul( Lanes::sub( xy, wz ), scaleY );
+            l[ 1 ][ 1 ] = Lanes::mul( Lanes::sub( one, Lanes::add( xx, zz ) ), scaleY );
+            l[ 1 ][ 2 ] = Lanes::mul( Lanes::add( yz, wx ), scaleY );
+            l[ 2 ][ 0 ] = Lanes::mul( Lanes::add( xz, wy ), scaleZ );
+            l[ 2 ][ 1 ] = Lanes::mul( Lanes::sub( yz, wx ), scaleZ );
+            l[ 2 ][ 2 ] = Lanes::mul( Lanes::sub( one, Lanes::add( xx, yy ) ), scaleZ );
+            
+            const Lanes::Register t[ 3 ] = { Lanes::load( tx + i ), Lanes::load( ty + i ), Lanes::load( tz + i ) };
+            
+            for ( size_t r = 0; r < 4; ++r )
+            {
+                for ( size_t c = 0; c < 3; ++c )
+                {
+                    Lanes::Register v = Lanes::mul( p[ element( r, 0 ) ], l[ c ][ 0 ] );
+                    v = Lanes::multiplyAdd( p[ element( r, 1 ) ], l[ c ][ 1 ], v );
+                    v = Lanes::multiplyAdd( p[ element( r, 2 ) ], l[ c ][ 2 ], v );
+                    Lanes::store( m[ element( r, c ) ], v );
+                }
+                
+                Lanes::Register v = Lanes::multiplyAdd( p[ element( r, 0 ) ], t[ 0 ], p[ element( r, 3 ) ] );
+                v = Lanes::multiplyAdd( p[ element( r, 1 ) ], t[ 1 ], v );
+                v = Lanes::multiplyAdd( p[ element( r, 2 ) ], t[ 2 ], v );
+                Lanes::store( m[ element( r, 3 ) ], v );
+            }
+            
+            for ( size_t lane = 0; lane < Lanes::WIDTH; ++lane )
+            {
+                InstanceData& out = pOut[ i + lane ];
+                for ( size_t c = 0; c < 4; ++c )
+                {
+                    out.transform.columns[ c ] = simd::float4{ m[ element( 0, c ) ][ lane ], m[ element( 1, c ) ][ lane ], m[ element( 2, c ) ][ lane ], m[ element( 3, c ) ][ lane ] };
+                }
+                for ( size_t c = 0; c < 3; ++c )
+                {
+                    out.normalTransform.columns[ c ] = simd::float3{ m[ element( 0, c ) ][ lane ], m[ element( 1, c ) ][ lane ], m[ element( 2, c ) ][ lane ] };
+                }
+            }
+        }
+        
+        composeTransformsScalar( parent, pOut, i, end );
+    }
+
+    void InstanceStore::composeTransformsScalar( const simd::float4x4& parent, InstanceData* pOut, size_t begin, size_t end ) const
+    {
+        for ( size_t i = begin; i < end; ++i )
+        {
+            const float x = _streams[ streamIndex( InstanceStream::RotationX ) ][ i ];
+            const float y = _streams[ streamIndex( InstanceStream::RotationY ) ][ i ];
+            const float z = _streams[ streamIndex( InstanceStream::RotationZ ) ][ i ];
+            const float w = _streams[ streamIndex( InstanceStream::RotationW ) ][ i ];
+            const float scaleX = _streams[ streamIndex( InstanceStream::ScaleX ) ][ i ];
+            const float scaleY = _streams[ streamIndex( InstanceStream::ScaleY ) ][ i ];
+            const float scaleZ = _streams[ streamIndex( InstanceStream::ScaleZ ) ][ i ];
+            
+            const float x2 = x * 2.0f;
+            const float y2 = y * 2.0f;
+            const float z2 = z * 2.0f;
+            const float xx = x * x2;
+            const float yy = y * y2;
+            const float zz = z * z2;
+            const float xy = x * y2;
+            const float xz = x * z2;
+            const float yz = y * z2;
+            const float wx = w * x2;
+            const float wy = w * y2;
+            const float wz = w * z2;
+            
+            simd::float4x4 local;
+            local.columns[ 0 ] = simd::float4{ ( 1.0f - ( yy + zz ) ) * scaleX, ( xy + wz ) * scaleX, ( xz - wy ) * scaleX, 0.0f };
+            local.columns[ 1 ] = simd::float4{ ( xy - wz ) * scaleY, ( 1.0f - ( xx + zz ) ) * scaleY, ( yz + wx ) * scaleY, 0.0f };
+            local.columns[ 2 ] = simd::float4{ ( xz + wy ) * scaleZ, ( yz - wx ) * scaleZ, ( 1.0f - ( xx + yy ) ) * scaleZ, 0.0f };
+            local.columns[ 3 ] = simd::float4{ _streams[ streamIndex( InstanceStream::TranslationX ) ][ i ],
+                                               _streams[ streamIndex( InstanceStream::TranslationY ) ][ i ],
+                                               _streams[ streamIndex( InstanceStream::TranslationZ ) ][ i ],
+                                               1.0f };
+            
+            InstanceData& out = pOut[ i ];
+            out.transform = parent * local;
+            out.normalTransform = simd_matrix( out.transform.columns[ 0 ].xyz, out.transform.columns[ 1 ].xyz, out.transform.columns[ 2 ].xyz );
+        }
+    }
+
+    void InstanceStore::writeColors( InstanceData* pOut, size_t begin, size_t end ) const
+    {
+        const float* cr = getStream( InstanceStream::ColorR );
+        const float* cg = getStream( InstanceStream::ColorG );
+        const float* cb = getStream( InstanceStream::ColorB );
+        const float* ca = getStream( InstanceStream::ColorA );
+        for ( size_t i = begin; i < end; ++i )
+        {
+            pOut[ i ].color = simd::float4{ cr[ i ], cg[ i ], cb[ i ], ca[ i ] };
+        }
+    }
+
+    void InstanceStore::encodeCompactTransforms( const simd::float4x4& parent, CompactInstanceData* pOut, size_t begin, size_t end ) const
+    {
+        const float* tx = getStream( InstanceStream::TranslationX );
+        const float* ty = getStream( InstanceStream::TranslationY );
+        const float* tz = getStream( InstanceStream::TranslationZ );
+        const float* qx = getStream( InstanceStream::RotationX );
+        const float* qy = getStream( InstanceStream::RotationY );
+        const float* qz = getStream( InstanceStream::RotationZ );
+        const float* qw = getStream( InstanceStream::RotationW );
+        const float* sx = getStream( InstanceStream::ScaleX );
+        
+        const CompactInstance::ParentDecomposition parentDecomposition = CompactInstance::decomposeParent( parent );
+        const float parentScale = parentDecomposition.scale;
+        const simd::float4 pq = parentDecomposition.rotation;
+        
+        const Lanes::Register px = Lanes::broadcast( pq.x );
+        const Lanes::Register py = Lanes::broadcast( pq.y );
+        const Lanes::Register pz = Lanes::broadcast( pq.z );
+        const Lanes::Register pw = Lanes::broadcast( pq.w );
+        const Lanes::Register ps = Lanes::broadcast( parentScale );
+        
+        Lanes::Register p[ 12 ];
+        for ( size_t c = 0; c < 4; ++c )
+        {
+            for ( size_t r = 0; r < 3; ++r )
+            {
+                p[ c * 3 + r ] = Lanes::broadcast( parent.columns[ c ][ r ] );
+            }
+        }
+        
+        const Lanes::Register snormMin = Lanes::broadcast( -1.0f );
+        const Lanes::Register snormMax = Lanes::broadcast( 1.0f );
+        const Lanes::Register snormScale = Lanes::broadcast( 32767.0f );
+        const auto quantize = [ & ]( Lanes::Register v ){
+            return Lanes::mul( Lanes::min( Lanes::max( v, snormMin ), snormMax ), snormScale );
+        };
+        
+        // Lane-major scratch: translation xyz and scale, then the quantized rotation
+        alignas( 32 ) float world[ 4 ][ Lanes::WIDTH ];
+        alignas( 32 ) int32_t rotation[ 4 ][ Lanes::WIDTH ];
+        
+        size_t i = begin;
+        for ( ; i + Lanes::WIDTH <= end; i += Lanes::WIDTH )
+        {
+            const Lanes::Register x = Lanes::load( qx + i );
+            const Lanes::Register y = Lanes::load( qy + i );
+            const Lanes::Register z = Lanes::load( qz + i );
+            const Lanes::Register w = Lanes::load( qw + i );
+            
+            // parent rotation * instance rotation
+            Lanes::Register v = Lanes::mul( pw, x );
+            v = Lanes::multiplyAdd( px, w, v );
+            v = Lanes::multiplyAdd( py, z, v );
+            Lanes::storeRounded( rotation[ 0 ], quantize( Lanes::sub( v, Lanes::mul( pz, y ) ) ) );
+            
+            v = Lanes::mul( pw, y );
+            v = Lanes::multiplyAdd( py, w, v );
+            v = Lanes::multiplyAdd( pz, x, v );
+            Lanes::storeRounded( rotation[ 1 ], quantize( Lanes::sub( v, Lanes::mul( px, z ) ) ) );
+            
+            v = Lanes::mul( pw, z );
+            v = Lanes::multiplyAdd( pz, w, v );
+            v = Lanes::multiplyAdd( px, y, v );
+            Lanes::storeRounded( rotation[ 2 ], quantize( Lanes::sub( v, Lanes::mul( py, x ) ) ) );
+            
+            v = Lanes::mul( pw, w );
+            v = Lanes::sub( v, Lanes::mul( px, x ) );
+            v = Lanes::sub( v, Lanes::mul( py, y ) );
+            Lanes::storeRounded( rotation[ 3 ], quantize( Lanes::sub( v, Lanes::mul( pz, z ) ) ) );
+            
+            const Lanes::Register t[ 3 ] = { Lanes::load( tx + i ), Lanes::load( ty + i ), Lanes::load( tz + i ) };
+            for ( size_t r = 0; r < 3; ++r )
+            {
+                v = Lanes::multiplyAdd( p[ r ], t[ 0 ], p[ 9 + r ] );
+                v = Lanes::multiplyAdd( p[ 3 + r ], t[ 1 ], v );
+                v = Lanes::multiplyAdd( p[ 6 + r ], t[ 2 ], v );
+                Lanes::store( world[ r ], v );
+            }
+            
+            Lanes::store( world[ 3 ], Lanes::mul( ps, Lanes::load( sx + i ) ) );
+            
+            for ( size_t lane = 0; lane < Lanes::WIDTH; ++lane )
+            {
+                CompactInstanceData& out = pOut[ i + lane ];
+                out.translation[ 0 ] = world[ 0 ][ lane ];
+                out.translation[ 1 ] = world[ 1 ][ lane ];
+                out.translation[ 2 ] = world[ 2 ][ lane ];
+                out.scale = world[ 3 ][ lane ];
+                out.rotation[ 0 ] = packSnorm16Bits( rotation[ 0 ][ lane ], rotation[ 1 ][ lane ] );
+                out.rotation[ 1 ] = packSnorm16Bits( rotation[ 2 ][ lane ], rotation[ 3 ][ lane ] );
+                out.padding = 0;
+            }
+        }
+        
+        for ( ; i < end; ++i )
+        {
+            const simd::float4 t = parent * simd::float4{ tx[ i ], ty[ i ], tz[ i ], 1.0f };
+            
+            CompactInstanceData& out = pOut[ i ];
+            out.translation[ 0 ] = t.x;
+            out.translation[ 1 ] = t.y;
+            out.translation[ 2 ] = t.z;
+            out.scale = parentScale * sx[ i ];
+            out.rotation[ 0 ] = CompactInstance::packSnorm16x2( pq.w * qx[ i ] + pq.x * qw[ i ] + pq.y * qz[ i ] - pq.z * qy[ i ],
+                                                                pq.w * qy[ i ] + pq.y * qw[ i ] + pq.z * qx[ i ] - pq.x * qz[ i ] );
+            out.rotation[ 1 ] = CompactInstance::packSnorm16x2( pq.w * qz[ i ] + pq.z * qw[ i ] + pq.x * qy[ i ] - pq.y * qx[ i ],
+                                                                pq.w * qw[ i ] - pq.x * qx[ i ] - pq.y * qy[ i ] - pq.z * qz[ i ] );
+            out.padding = 0;
+        }
+    }
+
+    void InstanceStore::encodeCompactColors( CompactInstanceData* pOut, size_t begin, size_t end ) const
+    {
+        const float* cr = getStream( InstanceStream::ColorR );
+        const float* cg = getStream( InstanceStream::ColorG );
+        const float* cb = getStream( InstanceStream::ColorB );
+        const float* ca = getStream( InstanceStream::ColorA );
+        for ( size_t i = begin; i < end; ++i )
+        {
+            pOut[ i ].color = CompactInstance::packUnorm4x8( simd::float4{ cr[ i ], cg[ i ], cb[ i ], ca[ i ] } );
+        }
+    }
+
+    const char* InstanceStore::getSimdPath()
+    {
+        return Lanes::NAME;
+    }
+}
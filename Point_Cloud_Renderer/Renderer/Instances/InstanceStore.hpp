@@ -0,0 +1,121 @@
+//
+//  InstanceStore.hpp
+//  Point_Cloud_Renderer
+//
+//  Created by Vatsalya Yadav on 10/19/26.
+//
+
+#ifndef InstanceStore_hpp
+#define InstanceStore_hpp
+
+#include <array>
+#include <cstddef>
+#include <vector>
+
+#include <simd/simd.h>
+
+#include "Renderer/Buffer/DirtyRangeTracker.hpp"
+#include "Renderer/Structures/CompactInstanceData.hpp"
+#include "Renderer/Structures/InstanceData.hpp"
+
+namespace PCR
+{
+    // One float array per component
+    enum class InstanceStream : size_t
+    {
+        TranslationX,
+        TranslationY,
+        TranslationZ,
+        
+        // Unit quaternion, w last
+        RotationX,
+        RotationY,
+        RotationZ,
+        RotationW,
+        
+        ScaleX,
+        ScaleY,
+        ScaleZ,
+        
+        ColorR,
+        ColorG,
+        ColorB,
+        ColorA,
+        
+        Count
+    };
+
+    // Groups of InstanceData members that change together
+    enum class InstanceField : size_t
+    {
+        // transform and normalTransform, from translation, rotation and scale
+        Transform,
+        
+        Color,
+        
+        Count
+    };
+
+    // Instance translation, rotation and scale in structure-of-arrays form. Final
+    // transforms are composed FloatLanes::WIDTH instances at a time straight into the
+    // GPU layout, instead of building and multiplying a chain of matrices per instance.
+    class InstanceStore
+    {
+    public:
+        explicit InstanceStore( size_t count = 0 );
+        
+        // New instances start at the origin, unrotated, unit scale, white, and dirty
+        void resize( size_t count );
+        
+        size_t getCount() const;
+        
+        // The setters mark the field they touch dirty
+        void setTranslation( size_t index, const simd::float3& translation );
+        
+        void setRotation( size_t index, const simd::float4& quaternion );
+        
+        void setScale( size_t index, const simd::float3& scale );
+        
+        void setColor( size_t index, const simd::float4& color );
+        
+        // Copies every stream of instance from over instance to and marks it dirty, for InstancePool moves
+        void moveInstance( size_t from, size_t to );
+        
+        // For bulk writers, getCount() floats. Writers call markDirty for what they changed.
+        float* getStream( InstanceStream stream );
+        
+        const float* getStream( InstanceStream stream ) const;
+        
+        void markDirty( InstanceField field, size_t begin, size_t end );
+        
+        // Instance ranges whose field changed since the last call, coalesced
+        std::vector< DirtyRange > takeDirtyRanges( InstanceField field );
+        
+        // pOut[ i ] = parent * T * R * S for i in [ begin, end ), with the normal
+        // transform filled in too. Disjoint ranges may run concurrently.
+        void composeTransforms( const simd::float4x4& parent, InstanceData* pOut, size_t begin, size_t end ) const;
+        
+        // One instance at a time, same math, the reference for the SIMD path
+        void composeTransformsScalar( const simd::float4x4& parent, InstanceData* pOut, size_t begin, size_t end ) const;
+        
+        void writeColors( InstanceData* pOut, size_t begin, size_t end ) const;
+        
+        // The same transforms in the 32-byte format. parent has to be a rotation and
+        // translation, optionally with uniform scale, and ScaleX stands in for the
+        // instance's uniform scale.
+        void encodeCompactTransforms( const simd::float4x4& parent, CompactInstanceData* pOut, size_t begin, size_t end ) const;
+        
+        void encodeCompactColors( CompactInstanceData* pOut, size_t begin, size_t end ) const;
+        
+        static const char* getSimdPath();
+
+    private:
+        std::array< std::vector< float >, static_cast< size_t >( InstanceStream::Count ) > _streams;
+        
+        std::array< std::vector< DirtyRange >, static_cast< size_t >( InstanceField::Count ) > _dirtyRanges;
+        
+        size_t _count;
+    };
+}
+
+#endif /* InstanceStore_hpp */
@@ -0,0 +1,87 @@
+//
+//  InstanceUpdate.cpp
+//  Point_Cloud_Renderer
+//
+//  Created by Vatsalya Yadav on 10/19/26.
+//
+
+#include "InstanceUpdate.hpp"
+
+#include <cstdint>
+
+#include "Math/SinCos.hpp"
+#include "Renderer/Data/Constants.hpp"
+#include "Renderer/Threading/WorkerPool.hpp"
+
+namespace PCR
+{
+    InstanceGridCoordinate getInstanceGridCoordinate( size_t index, size_t rows, size_t columns )
+    {
+        InstanceGridCoordinate coordinate;
+        coordinate.x = index % rows;
+        coordinate.y = ( index / rows ) % columns;
+        coordinate.z = index / ( rows * columns );
+        return coordinate;
+    }
+
+    void updateInstances( InstanceStore& store, const float* pSpin, float angle, size_t begin, size_t end )
+    {
+        // makeZRotate turns clockwise, hence the negated half angle
+        float* pRotationZ = store.getStream( InstanceStream::RotationZ );
+        float* pRotationW = store.getStream( InstanceStream::RotationW );
+        Math::sinCos( pSpin + begin, pRotationZ + begin, pRotationW + begin, end - begin, -0.5f * angle );
+    }
+
+    void updateInstancesParallel( WorkerPool& workerPool, InstanceStore& store, const float* pSpin, float angle )
+    {
+        workerPool.parallelFor( store.getCount(), INSTANCE_UPDATE_GRAIN_SIZE, [ & ]( size_t begin, size_t end, uint32_t ){
+            updateInstances( store, pSpin, angle, begin, end );
+        });
+        
+        store.markDirty( InstanceField::Transform, 0, store.getCount() );
+    }
+
+    void writeInstancesParallel( WorkerPool& workerPool,
+                                 const InstanceStore& store,
+                                 InstanceField field,
+                                 const std::vector< DirtyRange >& ranges,
+                                 const simd::float4x4& parent,
+                                 InstanceData* pOut )
+    {
+        for ( const DirtyRange& range : ranges )
+        {
+            workerPool.parallelFor( range.end - range.begin, INSTANCE_UPDATE_GRAIN_SIZE, [ & ]( size_t begin, size_t end, uint32_t ){
+                if ( field == InstanceField::Transform )
+                {
+                    store.composeTransforms( parent, pOut, range.begin + begin, range.begin + end );
+                }
+                else
+                {
+                    store.writeColors( pOut, range.begin + begin, range.begin + end );
+                }
+            });
+        }
+    }
+
+    void writeInstancesParallel( WorkerPool& workerPool,
+                                 const InstanceStore& store,
+                                 InstanceField field,
+                                 const std::vector< DirtyRange >& ranges,
+                                 const simd::float4x4& parent,
+                                 CompactInstanceData* pOut )
+    {
+        for ( const DirtyRange& range : ranges )
+        {
+            workerPool.parallelFor( range.end - range.begin, INSTANCE_UPDATE_GRAIN_SIZE, [ & ]( size_t begin, size_t end, uint32_t ){
+                if ( field == InstanceField::Transform )
+                {
+                    store.encodeCompactTransforms( parent, pOut, range.begin + begin, range.begin + end );
+                }
+                else
+                {
+                    store.encodeCompactColors( pOut, range.begin + begin, range.begin + end );
+                }
+            });
+        }
+    }
+}
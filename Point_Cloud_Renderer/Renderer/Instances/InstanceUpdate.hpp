@@ -0,0 +1,59 @@
+//
+//  InstanceUpdate.hpp
+//  Point_Cloud_Renderer
+//
+//  Created by Vatsalya Yadav on 10/19/26.
+//
+
+#ifndef InstanceUpdate_hpp
+#define InstanceUpdate_hpp
+
+#include <cstddef>
+#include <vector>
+
+#include <simd/simd.h>
+
+#include "Renderer/Instances/InstanceStore.hpp"
+
+namespace PCR
+{
+    class WorkerPool;
+
+    struct InstanceGridCoordinate
+    {
+        size_t x = 0;
+        
+        size_t y = 0;
+        
+        size_t z = 0;
+    };
+
+    // Rows vary fastest, then columns, then depth. Computed from the index alone so
+    // any range of the grid can be filled without walking the instances before it.
+    InstanceGridCoordinate getInstanceGridCoordinate( size_t index, size_t rows, size_t columns );
+
+    // One frame's animation for [ begin, end ): spins the Z rotations to angle * pSpin[ i ].
+    // Touches nothing outside the range and leaves marking it dirty to the caller.
+    void updateInstances( InstanceStore& store, const float* pSpin, float angle, size_t begin, size_t end );
+
+    // Same for every instance in the store, split into disjoint ranges across the pool,
+    // then marks all the transforms dirty
+    void updateInstancesParallel( WorkerPool& workerPool, InstanceStore& store, const float* pSpin, float angle );
+
+    // Rewrites one field of pOut over the given instance ranges, split across the pool
+    void writeInstancesParallel( WorkerPool& workerPool,
+                                 const InstanceStore& store,
+                                 InstanceField field,
+                                 const std::vector< DirtyRange >& ranges,
+                                 const simd::float4x4& parent,
+                                 InstanceData* pOut );
+
+    void writeInstancesParallel( WorkerPool& workerPool,
+                                 const InstanceStore& store,
+                                 InstanceField field,
+                                 const std::vector< DirtyRange >& ranges,
+                                 const simd::float4x4& parent,
+                                 CompactInstanceData* pOut );
+}
+
+#endif /* InstanceUpdate_hpp */
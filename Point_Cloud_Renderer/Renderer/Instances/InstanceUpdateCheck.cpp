@@ -0,0 +1,217 @@
+//
+//  InstanceUpdateCheck.cpp
+//  Point_Cloud_Renderer
+//
+//  Created by Vatsalya Yadav on 10/19/26.
+//
+
+#include "InstanceUpdateCheck.hpp"
+
+#include <array>
+#include <cmath>
+#include <cstring>
+#include <vector>
+
+#include <simd/simd.h>
+
+#include "Math/Utility.hpp"
+#include "Renderer/Data/Constants.hpp"
+#include "Renderer/Instances/InstanceStore.hpp"
+#include "Renderer/Instances/InstanceUpdate.hpp"
+#include "Renderer/Threading/WorkerPool.hpp"
+#include "Renderer/Validation/CheckReport.hpp"
+
+namespace PCR
+{
+    namespace
+    {
+        // Several grains and a partial one, so every worker gets chunks and the last is short
+        constexpr size_t INSTANCE_COUNT{ 9 * INSTANCE_UPDATE_GRAIN_SIZE + 123 };
+        
+        constexpr std::array< uint32_t, 4 > WORKER_COUNTS{ 1, 2, 4, 7 };
+        
+        constexpr float ANGLE{ 2.75f };
+        
+        // Fills outputs first, so padding compares equal and untouched instances stand out
+        constexpr int SENTINEL_BYTE{ 0xCD };
+        
+        struct UpdateOutput
+        {
+            std::vector< float > rotationZ;
+            
+            std::vector< float > rotationW;
+            
+            std::vector< InstanceData > instances;
+            
+            std::vector< CompactInstanceData > compactInstances;
+            
+            bool allDirty = true;
+        };
+        
+        void fillStore( InstanceStore& store, std::vector< float >& spins )
+        {
+            store.resize( INSTANCE_COUNT );
+            spins.resize( INSTANCE_COUNT );
+            for ( size_t i = 0; i < INSTANCE_COUNT; ++i )
+            {
+                const InstanceGridCoordinate coordinate = getInstanceGridCoordinate( i, 100, 100 );
+                store.setTranslation( i, simd::float3{ coordinate.x * 0.4f, coordinate.y * 0.4f, coordinate.z * 0.4f } );
+                store.setScale( i, simd::float3{ 0.2f, 0.1f + 0.001f * static_cast< float >( i % 97 ), 0.3f } );
+                store.setColor( i, simd::float4{ static_cast< float >( i % 255 ) / 255.0f, 0.5f, 0.25f, 1.0f } );
+                spins[ i ] = sinf( static_cast< float >( i ) );
+            }
+            store.takeDirtyRanges( InstanceField::Transform );
+            store.takeDirtyRanges( InstanceField::Color );
+        }
+        
+        UpdateOutput makeOutput()
+        {
+            UpdateOutput output;
+            output.instances.resize( INSTANCE_COUNT );
+            output.compactInstances.resize( INSTANCE_COUNT );
+            std::memset( static_cast< void* >( output.instances.data() ), SENTINEL_BYTE, output.instances.size() * sizeof( InstanceData ) );
+            std::memset( static_cast< void* >( output.compactInstances.data() ), SENTINEL_BYTE, output.compactInstances.size() * sizeof( CompactInstanceData ) );
+            return output;
+        }
+        
+        void copyRotations( const InstanceStore& store, UpdateOutput& output )
+        {
+            const float* pRotationZ = store.getStream( InstanceStream::RotationZ );
+            const float* pRotationW = store.getStream( InstanceStream::RotationW );
+            output.rotationZ.assign( pRotationZ, pRotationZ + INSTANCE_COUNT );
+            output.rotationW.assign( pRotationW, pRotationW + INSTANCE_COUNT );
+        }
+        
+        UpdateOutput runSerial( const simd::float4x4& parent )
+        {
+            InstanceStore store;
+            std::vector< float > spins;
+            fillStore( store, spins );
+            
+            UpdateOutput output = makeOutput();
+            updateInstances( store, spins.data(), ANGLE, 0, INSTANCE_COUNT );
+            store.composeTransforms( parent, output.instances.data(), 0, INSTANCE_COUNT );
+            store.writeColors( output.instances.data(), 0, INSTANCE_COUNT );
+            store.encodeCompactTransforms( parent, output.compactInstances.data(), 0, INSTANCE_COUNT );
+            store.encodeCompactColors( output.compactInstances.data(), 0, INSTANCE_COUNT );
+            copyRotations( store, output );
+            return output;
+        }
+        
+        UpdateOutput runParallel( WorkerPool& workerPool, const simd::float4x4& parent )
+        {
+            InstanceStore store;
+            std::vector< float > spins;
+            fillStore( store, spins );
+            
+            UpdateOutput output = makeOutput();
+            updateInstancesParallel( workerPool, store, spins.data(), ANGLE );
+            
+            const std::vector< DirtyRange > transformRanges = store.takeDirtyRanges( InstanceField::Transform );
+            output.allDirty = transformRanges.size() == 1 && transformRanges.front().begin == 0 && transformRanges.front().end == INSTANCE_COUNT;
+            
+            const std::vector< DirtyRange > allRanges{ { 0, INSTANCE_COUNT } };
+            writeInstancesParallel( workerPool, store, InstanceField::Transform, transformRanges, parent, output.instances.data() );
+            writeInstancesParallel( workerPool, store, InstanceField::Color, allRanges, parent, output.instances.data() );
+            writeInstancesParallel( workerPool, store, InstanceField::Transform, transformRanges, parent, output.compactInstances.data() );
+            writeInstancesParallel( workerPool, store, InstanceField::Color, allRanges, parent, output.compactInstances.data() );
+            copyRotations( store, output );
+            return output;
+        }
+        
+        template < typename T >
+        bool sameBytes( const std::vector< T >& a, const std::vector< T >& b )
+        {
+            return a.size() == b.size() && std::memcmp( a.data(), b.data(), a.size() * sizeof( T ) ) == 0;
+        }
+        
+        template < typename T >
+        bool isSentinel( const T& value )
+        {
+            const auto* pBytes = reinterpret_cast< const unsigned char* >( &value );
+            for ( size_t i = 0; i < sizeof( T ); ++i )
+            {
+                if ( pBytes[ i ] != SENTINEL_BYTE )
+                {
+                    return false;
+                }
+            }
+            return true;
+        }
+        
+        void checkParallelMatchesSerial( CheckReport& report, const simd::float4x4& parent )
+        {
+            const UpdateOutput serial = runSerial( parent );
+            
+            bool rotationsMatch = true;
+            bool instancesMatch = true;
+            bool compactMatch = true;
+            bool allDirty = true;
+            for ( uint32_t workerCount : WORKER_COUNTS )
+            {
+                WorkerPool workerPool( workerCount );
+                const UpdateOutput parallel = runParallel( workerPool, parent );
+                rotationsMatch = rotationsMatch && sameBytes( parallel.rotationZ, serial.rotationZ ) && sameBytes( parallel.rotationW, serial.rotationW );
+                instancesMatch = instancesMatch && sameBytes( parallel.instances, serial.instances );
+                compactMatch = compactMatch && sameBytes( parallel.compactInstances, serial.compactInstances );
+                allDirty = allDirty && parallel.allDirty;
+            }
+            
+            report.expect( rotationsMatch, "parallel: rotations are byte-identical to the serial update for 1, 2, 4 and 7 workers" );
+            report.expect( instancesMatch, "parallel: full instances are byte-identical to the serial update" );
+            report.expect( compactMatch, "parallel: compact instances are byte-identical to the serial update" );
+            report.expect( allDirty, "parallel: the update marks every transform dirty" );
+        }
+        
+        void checkPartialRanges( CheckReport& report, const simd::float4x4& parent )
+        {
+            InstanceStore store;
+            std::vector< float > spins;
+            fillStore( store, spins );
+            
+            // Straddling grain boundaries, and one inside a single grain
+            const std::vector< DirtyRange > ranges{ { 100, 2 * INSTANCE_UPDATE_GRAIN_SIZE + 7 },
+                                                    { 5 * INSTANCE_UPDATE_GRAIN_SIZE + 11, 5 * INSTANCE_UPDATE_GRAIN_SIZE + 12 },
+                                                    { 8 * INSTANCE_UPDATE_GRAIN_SIZE - 3, INSTANCE_COUNT } };
+            
+            UpdateOutput output = makeOutput();
+            std::vector< InstanceData > serialInstances( INSTANCE_COUNT );
+            for ( const DirtyRange& range : ranges )
+            {
+                store.composeTransforms( parent, serialInstances.data(), range.begin, range.end );
+            }
+            
+            WorkerPool workerPool( 4 );
+            writeInstancesParallel( workerPool, store, InstanceField::Transform, ranges, parent, output.instances.data() );
+            writeInstancesParallel( workerPool, store, InstanceField::Transform, ranges, parent, output.compactInstances.data() );
+            
+            bool insideMatches = true;
+            bool outsideUntouched = true;
+            size_t next = 0;
+            for ( const DirtyRange& range : ranges )
+            {
+                for ( ; next < range.begin; ++next )
+                {
+                    outsideUntouched = outsideUntouched && isSentinel( output.instances[ next ] ) && isSentinel( output.compactInstances[ next ] );
+                }
+                for ( ; next < range.end; ++next )
+                {
+                    insideMatches = insideMatches && std::memcmp( &output.instances[ next ].transform, &serialInstances[ next ].transform, sizeof( simd::float4x4 ) ) == 0
+                                                  && !isSentinel( output.compactInstances[ next ] );
+                }
+            }
+            
+            report.expect( insideMatches, "ranges: every instance inside a dirty range is written" );
+            report.expect( outsideUntouched, "ranges: nothing outside the dirty ranges is touched" );
+        }
+    }
+
+    bool runInstanceUpdateChecks()
+    {
+        CheckReport report( "Instance update, parallel against serial" );
+        const simd::float4x4 parent = Math::makeTranslate( simd::float3{ 1.0f, -2.0f, 0.5f } );
+        checkParallelMatchesSerial( report, parent );
+        checkPartialRanges( report, parent );
+        return report.finish();
+    }
+}
@@ -0,0 +1,21 @@
+//
+//  InstanceUpdateCheck.hpp
+//  Point_Cloud_Renderer
+//
+//  Created by Vatsalya Yadav on 10/19/26.
+//
+
+#ifndef InstanceUpdateCheck_hpp
+#define InstanceUpdateCheck_hpp
+
+namespace PCR
+{
+    // The per-frame instance update split across worker pools of several sizes against the
+    // same update run serially: rotations, full and compact transforms and colors come out
+    // byte-identical, and partial dirty ranges write nothing outside themselves. Build with
+    // -fsanitize=thread to have ThreadSanitizer watch the workers while it runs.
+    // Returns false if any check fails.
+    bool runInstanceUpdateChecks();
+}
+
+#endif /* InstanceUpdateCheck_hpp */
@@ -0,0 +1,120 @@
+//
+//  FunctionConstants.cpp
+//  Point_Cloud_Renderer
+//
+//  Created by Vatsalya Yadav on 10/19/26.
+//
+
+#include "FunctionConstants.hpp"
+
+#include <algorithm>
+#include <cstring>
+#include <sstream>
+
+namespace PCR
+{
+    namespace
+    {
+        constexpr char TYPE_CODES[]{ 'b', 'i', 'u', 'f' };
+        
+        bool parseUInt32( const std::string& text, uint32_t& value )
+        {
+            if ( text.empty() || text.size() > 10 || text.find_first_not_of( "0123456789" ) != std::string::npos )
+            {
+                return false;
+            }
+            const uint64_t parsed = std::stoull( text );
+            value = static_cast< uint32_t >( parsed );
+            return parsed <= UINT32_MAX;
+        }
+    }
+
+    FunctionConstantValues& FunctionConstantValues::setBool( uint32_t index, bool value )
+    {
+        return set( index, FunctionConstantType::Bool, value ? 1 : 0 );
+    }
+
+    FunctionConstantValues& FunctionConstantValues::setInt( uint32_t index, int32_t value )
+    {
+        return set( index, FunctionConstantType::Int, static_cast< uint32_t >( value ) );
+    }
+
+    FunctionConstantValues& FunctionConstantValues::setUInt( uint32_t index, uint32_t value )
+    {
+        return set( index, FunctionConstantType::UInt, value );
+    }
+
+    FunctionConstantValues& FunctionConstantValues::setFloat( uint32_t index, float value )
+    {
+        uint32_t bits;
+        std::memcpy( &bits, &value, sizeof( bits ) );
+        return set( index, FunctionConstantType::Float, bits );
+    }
+
+    const std::vector< FunctionConstant >& FunctionConstantValues::getConstants() const
+    {
+        return _constants;
+    }
+
+    bool FunctionConstantValues::empty() const
+    {
+        return _constants.empty();
+    }
+
+    std::string FunctionConstantValues::serialize() const
+    {
+        std::ostringstream stream;
+        for ( size_t i = 0; i < _constants.size(); ++i )
+        {
+            const FunctionConstant& constant = _constants[ i ];
+            stream << ( i ? ";" : "" ) << constant.index << ':' << TYPE_CODES[ static_cast< uint32_t >( constant.type ) ] << ':' << constant.bits;
+        }
+        return stream.str();
+    }
+
+    bool FunctionConstantValues::deserialize( const std::string& text, FunctionConstantValues& values )
+    {
+        values = FunctionConstantValues{};
+        
+        std::istringstream stream( text );
+        std::string item;
+        while ( std::getline( stream, item, ';' ) )
+        {
+            const size_t first = item.find( ':' );
+            const size_t second = item.find( ':', first + 1 );
+            if ( first == std::string::npos || second != first + 2 )
+            {
+                return false;
+            }
+            
+            const char* pTypeCode = std::find( std::begin( TYPE_CODES ), std::end( TYPE_CODES ), item[ first + 1 ] );
+            uint32_t index = 0;
+            uint32_t bits = 0;
+            if ( pTypeCode == std::end( TYPE_CODES )
+                || !parseUInt32( item.substr( 0, first ), index )
+                || !parseUInt32( item.substr( second + 1 ), bits ) )
+            {
+                return false;
+            }
+            values.set( index, static_cast< FunctionConstantType >( pTypeCode - std::begin( TYPE_CODES ) ), bits );
+        }
+        return true;
+    }
+
+    FunctionConstantValues& FunctionConstantValues::set( uint32_t index, FunctionConstantType type, uint32_t bits )
+    {
+        auto it = std::lower_bound( _constants.begin(), _constants.end(), index, []( const FunctionConstant& constant, uint32_t i ){
+            return constant.index < i;
+        });
+        if ( it != _constants.end() && it->index == index )
+        {
+            it->type = type;
+            it->bits = bits;
+        }
+        else
+        {
+            _constants.insert( it, FunctionConstant{ index, type, bits } );
+        }
+        return *this;
+    }
+}
@@ -0,0 +1,68 @@
+//
+//  FunctionConstants.hpp
+//  Point_Cloud_Renderer
+//
+//  Created by Vatsalya Yadav on 10/19/26.
+//
+
+#ifndef FunctionConstants_hpp
+#define FunctionConstants_hpp
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace PCR
+{
+    enum class FunctionConstantType : uint32_t
+    {
+        Bool,
+        Int,
+        UInt,
+        Float
+    };
+
+    struct FunctionConstant
+    {
+        uint32_t index = 0;
+        
+        FunctionConstantType type = FunctionConstantType::Bool;
+        
+        // Raw 32-bit pattern, floats are bit-cast so keys stay exact
+        uint32_t bits = 0;
+        
+        bool operator==( const FunctionConstant& other ) const = default;
+    };
+
+    // Values for [[ function_constant( index ) ]] declarations, kept sorted by index so
+    // the same set always produces the same key no matter the order it was filled in.
+    class FunctionConstantValues
+    {
+    public:
+        FunctionConstantValues& setBool( uint32_t index, bool value );
+        
+        FunctionConstantValues& setInt( uint32_t index, int32_t value );
+        
+        FunctionConstantValues& setUInt( uint32_t index, uint32_t value );
+        
+        FunctionConstantValues& setFloat( uint32_t index, float value );
+        
+        const std::vector< FunctionConstant >& getConstants() const;
+        
+        bool empty() const;
+        
+        // "index:type:bits" joined by ';', e.g. "0:u:2;3:b:1"
+        std::string serialize() const;
+        
+        static bool deserialize( const std::string& text, FunctionConstantValues& values );
+        
+        bool operator==( const FunctionConstantValues& other ) const = default;
+
+    private:
+        std::vector< FunctionConstant > _constants;
+        
+        FunctionConstantValues& set( uint32_t index, FunctionConstantType type, uint32_t bits );
+    };
+}
+
+#endif /* FunctionConstants_hpp */
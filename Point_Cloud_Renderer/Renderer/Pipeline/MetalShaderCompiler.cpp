@@ -0,0 +1,90 @@
+//
+//  MetalShaderCompiler.cpp
+//  Point_Cloud_Renderer
+//
+//  Created by Vatsalya Yadav on 10/19/26.
+//
+
+#include "MetalShaderCompiler.hpp"
+
+#include <Metal/Metal.hpp>
+
+namespace PCR
+{
+    namespace
+    {
+        MTL::DataType toMetal( FunctionConstantType type )
+        {
+            switch ( type )
+            {
+                case FunctionConstantType::Bool:  return MTL::DataTypeBool;
+                case FunctionConstantType::Int:   return MTL::DataTypeInt;
+                case FunctionConstantType::UInt:  return MTL::DataTypeUInt;
+                case FunctionConstantType::Float: return MTL::DataTypeFloat;
+            }
+            return MTL::DataTypeNone;
+        }
+    }
+
+    MetalShaderCompiler::MetalShaderCompiler( MTL::Device* pDevice )
+    :   _pDevice{ pDevice->retain() }
+    {
+    }
+
+    MetalShaderCompiler::~MetalShaderCompiler()
+    {
+        _pDevice->release();
+    }
+
+    MTL::Library* MetalShaderCompiler::loadLibrary( const std::string& libraryName )
+    {
+        if ( libraryName.empty() )
+        {
+            return _pDevice->newDefaultLibrary();
+        }
+        
+        NS::Bundle* pBundle = NS::Bundle::mainBundle();
+        const std::string path = std::string( pBundle->resourcePath()->utf8String() ) + "/" + libraryName + ".metallib";
+        
+        NS::Error* pError = nullptr;
+        MTL::Library* pLibrary = _pDevice->newLibrary( CreateUTF8String( path.c_str() ), &pError );
+        if ( !pLibrary )
+        {
+            __builtin_printf( "%s", pError->localizedDescription()->utf8String() );
+        }
+        return pLibrary;
+    }
+
+    MTL::Function* MetalShaderCompiler::newFunction( MTL::Library* pLibrary, const std::string& functionName, const FunctionConstantValues& constants )
+    {
+        if ( constants.empty() )
+        {
+            return pLibrary->newFunction( CreateUTF8String( functionName.c_str() ) );
+        }
+        
+        auto pConstantValues = NS::TransferPtr( MTL::FunctionConstantValues::alloc()->init() );
+        for ( const FunctionConstant& constant : constants.getConstants() )
+        {
+            // bool is one byte, the other types are 32-bit; little-endian makes the low byte right for both
+            pConstantValues->setConstantValue( &constant.bits, toMetal( constant.type ), constant.index );
+        }
+        
+        NS::Error* pError = nullptr;
+        MTL::Function* pFunction = pLibrary->newFunction( CreateUTF8String( functionName.c_str() ), pConstantValues.get(), &pError );
+        if ( !pFunction && pError )
+        {
+            __builtin_printf( "%s", pError->localizedDescription()->utf8String() );
+        }
+        return pFunction;
+    }
+
+    void MetalShaderCompiler::releaseLibrary( MTL::Library* pLibrary )
+    {
+        pLibrary->release();
+    }
+
+    void MetalShaderCompiler::releaseFunction( MTL::Function* pFunction )
+    {
+        pFunction->release();
+    }
+}
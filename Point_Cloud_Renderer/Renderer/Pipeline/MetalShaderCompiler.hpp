@@ -0,0 +1,36 @@
+//
+//  MetalShaderCompiler.hpp
+//  Point_Cloud_Renderer
+//
+//  Created by Vatsalya Yadav on 10/19/26.
+//
+
+#ifndef MetalShaderCompiler_hpp
+#define MetalShaderCompiler_hpp
+
+#include "Renderer/Pipeline/ShaderRegistry.hpp"
+
+namespace PCR
+{
+    // Named libraries are "<name>.metallib" files in the app bundle's resources
+    class MetalShaderCompiler : public ShaderCompiler
+    {
+    public:
+        explicit MetalShaderCompiler( MTL::Device* pDevice );
+        
+        ~MetalShaderCompiler() override;
+        
+        MTL::Library* loadLibrary( const std::string& libraryName ) override;
+        
+        MTL::Function* newFunction( MTL::Library* pLibrary, const std::string& functionName, const FunctionConstantValues& constants ) override;
+        
+        void releaseLibrary( MTL::Library* pLibrary ) override;
+        
+        void releaseFunction( MTL::Function* pFunction ) override;
+
+    private:
+        MTL::Device* _pDevice;
+    };
+}
+
+#endif /* MetalShaderCompiler_hpp */
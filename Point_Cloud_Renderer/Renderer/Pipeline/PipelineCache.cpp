@@ -0,0 +1,309 @@
+//
+//  PipelineCache.cpp
+//  Point_Cloud_Renderer
+//
+//  Created by Vatsalya Yadav on 10/19/26.
+//
+
+#include "PipelineCache.hpp"
+
+#include <algorithm>
+#include <cassert>
+#include <fstream>
+#include <vector>
+
+#include <Metal/Metal.hpp>
+
+namespace PCR
+{
+    PipelineCache::PipelineCache( MTL::Device* pDevice, ShaderRegistry* pShaderRegistry, const std::string& manifestPath )
+    :   _pDevice{ pDevice->retain() }
+    ,   _pShaderRegistry{ pShaderRegistry }
+    ,   _manifestPath{ manifestPath }
+    ,   _pendingCount{ 0 }
+    ,   _manifestDirty{ false }
+    ,   _savingManifest{ false }
+    {
+    }
+
+    PipelineCache::~PipelineCache()
+    {
+        waitForPending();
+        
+        for ( auto& [ hash, entry ] : _entries )
+        {
+            if ( entry.pRenderState )
+            {
+                entry.pRenderState->release();
+            }
+            if ( entry.pComputeState )
+            {
+                entry.pComputeState->release();
+            }
+        }
+        _pDevice->release();
+    }
+
+    void PipelineCache::prepare( const RenderPipelineDesc& desc )
+    {
+        const std::string key = desc.serialize();
+        const uint64_t hash = hashString( key );
+        if ( insert( hash, key, true ) )
+        {
+            compile( hash, desc );
+        }
+    }
+
+    void PipelineCache::prepare( const ComputePipelineDesc& desc )
+    {
+        const std::string key = desc.serialize();
+        const uint64_t hash = hashString( key );
+        if ( insert( hash, key, true ) )
+        {
+            compile( hash, desc );
+        }
+    }
+
+    MTL::RenderPipelineState* PipelineCache::getRenderPipeline( const RenderPipelineDesc& desc )
+    {
+        prepare( desc );
+        
+        const Entry& entry = waitForEntry( desc.hash() );
+        assert( !entry.failed && entry.pRenderState );
+        return entry.pRenderState;
+    }
+
+    MTL::ComputePipelineState* PipelineCache::getComputePipeline( const ComputePipelineDesc& desc )
+    {
+        prepare( desc );
+        
+        const Entry& entry = waitForEntry( desc.hash() );
+        assert( !entry.failed && entry.pComputeState );
+        return entry.pComputeState;
+    }
+
+    uint32_t PipelineCache::precompileManifest()
+    {
+        std::ifstream file( _manifestPath );
+        if ( !file )
+        {
+            return 0;
+        }
+        
+        uint32_t started = 0;
+        std::string line;
+        while ( std::getline( file, line ) )
+        {
+            RenderPipelineDesc renderDesc;
+            ComputePipelineDesc computeDesc;
+            const uint64_t hash = hashString( line );
+            
+            // Lines that no longer parse or name functions that no longer exist are skipped
+            if ( RenderPipelineDesc::deserialize( line, renderDesc ) && renderDesc.serialize() == line )
+            {
+                if ( insert( hash, line, false ) )
+                {
+                    compile( hash, renderDesc );
+                    ++started;
+                }
+            }
+            else if ( ComputePipelineDesc::deserialize( line, computeDesc ) && computeDesc.serialize() == line )
+            {
+                if ( insert( hash, line, false ) )
+                {
+                    compile( hash, computeDesc );
+                    ++started;
+                }
+            }
+        }
+        
+        std::lock_guard< std::mutex > lock( _mutex );
+        _stats.precompiled += started;
+        return started;
+    }
+
+    bool PipelineCache::saveManifest()
+    {
+        std::lock_guard< std::mutex > fileLock( _manifestMutex );
+        
+        std::vector< std::string > keys;
+        {
+            std::lock_guard< std::mutex > lock( _mutex );
+            _manifestDirty = false;
+            for ( const auto& [ hash, entry ] : _entries )
+            {
+                if ( entry.ready && !entry.failed )
+                {
+                    keys.push_back( entry.key );
+                }
+            }
+        }
+        std::sort( keys.begin(), keys.end() );
+        
+        std::ofstream file( _manifestPath, std::ios::trunc );
+        if ( !file )
+        {
+            return false;
+        }
+        for ( const std::string& key : keys )
+        {
+            file << key << '\n';
+        }
+        return static_cast< bool >( file );
+    }
+
+    void PipelineCache::waitForPending()
+    {
+        std::unique_lock< std::mutex > lock( _mutex );
+        _compiledCondition.wait( lock, [ this ]{ return _pendingCount == 0 && !_savingManifest; } );
+    }
+
+    PipelineCacheStats PipelineCache::getStats() const
+    {
+        std::lock_guard< std::mutex > lock( _mutex );
+        return _stats;
+    }
+
+    bool PipelineCache::insert( uint64_t hash, const std::string& key, bool isRequest )
+    {
+        std::lock_guard< std::mutex > lock( _mutex );
+        _stats.requests += isRequest ? 1 : 0;
+        
+        auto it = _entries.find( hash );
+        if ( it != _entries.end() )
+        {
+            // A 64-bit FNV collision between two live descriptions would be a bug worth knowing about
+            assert( it->second.key == key );
+            _stats.hits += isRequest ? 1 : 0;
+            return false;
+        }
+        
+        Entry& entry = _entries[ hash ];
+        entry.key = key;
+        entry.startTime = std::chrono::steady_clock::now();
+        ++_pendingCount;
+        return true;
+    }
+
+    void PipelineCache::compile( uint64_t hash, const RenderPipelineDesc& desc )
+    {
+        MTL::Function* pVertexFn = _pShaderRegistry->getFunction( desc.vertexFunction, desc.constants );
+        MTL::Function* pFragmentFn = desc.fragmentFunction.empty() ? nullptr : _pShaderRegistry->getFunction( desc.fragmentFunction, desc.constants );
+        if ( !pVertexFn || ( !desc.fragmentFunction.empty() && !pFragmentFn ) )
+        {
+            __builtin_printf( "Pipeline cache: missing function in \"%s\"\n", desc.serialize().c_str() );
+            finish( hash, nullptr, nullptr, nullptr );
+            return;
+        }
+        
+        auto pRenderPipelineDesc = NS::TransferPtr( MTL::RenderPipelineDescriptor::alloc()->init() );
+        pRenderPipelineDesc->setVertexFunction( pVertexFn );
+        pRenderPipelineDesc->setFragmentFunction( pFragmentFn );
+        pRenderPipelineDesc->setDepthAttachmentPixelFormat( static_cast< MTL::PixelFormat >( desc.depthPixelFormat ) );
+        pRenderPipelineDesc->setStencilAttachmentPixelFormat( static_cast< MTL::PixelFormat >( desc.stencilPixelFormat ) );
+        pRenderPipelineDesc->setRasterSampleCount( desc.sampleCount );
+        
+        for ( size_t i = 0; i < desc.colorAttachments.size(); ++i )
+        {
+            const PipelineColorAttachment& color = desc.colorAttachments[ i ];
+            MTL::RenderPipelineColorAttachmentDescriptor* pColorAttachment = pRenderPipelineDesc->colorAttachments()->object( i );
+            pColorAttachment->setPixelFormat( static_cast< MTL::PixelFormat >( color.pixelFormat ) );
+            pColorAttachment->setBlendingEnabled( color.blendingEnabled );
+            pColorAttachment->setSourceRGBBlendFactor( static_cast< MTL::BlendFactor >( color.sourceRGBBlendFactor ) );
+            pColorAttachment->setDestinationRGBBlendFactor( static_cast< MTL::BlendFactor >( color.destinationRGBBlendFactor ) );
+            pColorAttachment->setRgbBlendOperation( static_cast< MTL::BlendOperation >( color.rgbBlendOperation ) );
+            pColorAttachment->setSourceAlphaBlendFactor( static_cast< MTL::BlendFactor >( color.sourceAlphaBlendFactor ) );
+            pColorAttachment->setDestinationAlphaBlendFactor( static_cast< MTL::BlendFactor >( color.destinationAlphaBlendFactor ) );
+            pColorAttachment->setAlphaBlendOperation( static_cast< MTL::BlendOperation >( color.alphaBlendOperation ) );
+            pColorAttachment->setWriteMask( static_cast< MTL::ColorWriteMask >( color.writeMask ) );
+        }
+        
+        if ( !desc.vertexAttributes.empty() )
+        {
+            auto pVertexDesc = NS::TransferPtr( MTL::VertexDescriptor::alloc()->init() );
+            for ( const PipelineVertexAttribute& attribute : desc.vertexAttributes )
+            {
+                MTL::VertexAttributeDescriptor* pAttribute = pVertexDesc->attributes()->object( attribute.index );
+                pAttribute->setFormat( static_cast< MTL::VertexFormat >( attribute.format ) );
+                pAttribute->setOffset( attribute.offset );
+                pAttribute->setBufferIndex( attribute.bufferIndex );
+            }
+            for ( const PipelineVertexLayout& layout : desc.vertexLayouts )
+            {
+                MTL::VertexBufferLayoutDescriptor* pLayout = pVertexDesc->layouts()->object( layout.bufferIndex );
+                pLayout->setStride( layout.stride );
+                pLayout->setStepFunction( static_cast< MTL::VertexStepFunction >( layout.stepFunction ) );
+                pLayout->setStepRate( layout.stepRate );
+            }
+            pRenderPipelineDesc->setVertexDescriptor( pVertexDesc.get() );
+        }
+        
+        _pDevice->newRenderPipelineState( pRenderPipelineDesc.get(), ^void( MTL::RenderPipelineState* pState, NS::Error* pError ){
+            this->finish( hash, pState, nullptr, pError );
+        });
+    }
+
+    void PipelineCache::compile( uint64_t hash, const ComputePipelineDesc& desc )
+    {
+        MTL::Function* pFunction = _pShaderRegistry->getFunction( desc.function, desc.constants );
+        if ( !pFunction )
+        {
+            __builtin_printf( "Pipeline cache: missing function in \"%s\"\n", desc.serialize().c_str() );
+            finish( hash, nullptr, nullptr, nullptr );
+            return;
+        }
+        
+        _pDevice->newComputePipelineState( pFunction, ^void( MTL::ComputePipelineState* pState, NS::Error* pError ){
+            this->finish( hash, nullptr, pState, pError );
+        });
+    }
+
+    void PipelineCache::finish( uint64_t hash, MTL::RenderPipelineState* pRenderState, MTL::ComputePipelineState* pComputeState, NS::Error* pError )
+    {
+        if ( pError && !pRenderState && !pComputeState )
+        {
+            __builtin_printf( "%s", pError->localizedDescription()->utf8String() );
+        }
+        
+        bool saveNow = false;
+        {
+            std::lock_guard< std::mutex > lock( _mutex );
+            Entry& entry = _entries[ hash ];
+            // The handler doesn't hand over ownership
+            entry.pRenderState = pRenderState ? pRenderState->retain() : nullptr;
+            entry.pComputeState = pComputeState ? pComputeState->retain() : nullptr;
+            entry.failed = !pRenderState && !pComputeState;
+            entry.ready = true;
+            
+            ++( entry.failed ? _stats.failed : _stats.compiled );
+            _stats.compileMs += std::chrono::duration< double, std::milli >( std::chrono::steady_clock::now() - entry.startTime ).count();
+            --_pendingCount;
+            
+            _manifestDirty = _manifestDirty || !entry.failed;
+            saveNow = _pendingCount == 0 && _manifestDirty && !_savingManifest;
+            _savingManifest = _savingManifest || saveNow;
+            
+            // Under the lock, a waiter may destroy the cache as soon as it sees the count drop
+            _compiledCondition.notify_all();
+        }
+        
+        // Compiles that land during the write are picked up by another one
+        while ( saveNow )
+        {
+            saveManifest();
+            
+            std::lock_guard< std::mutex > lock( _mutex );
+            saveNow = _pendingCount == 0 && _manifestDirty;
+            _savingManifest = saveNow;
+            _compiledCondition.notify_all();
+        }
+    }
+
+    const PipelineCache::Entry& PipelineCache::waitForEntry( uint64_t hash )
+    {
+        std::unique_lock< std::mutex > lock( _mutex );
+        const Entry& entry = _entries.at( hash );
+        _compiledCondition.wait( lock, [ &entry ]{ return entry.ready; } );
+        return entry;
+    }
+}
@@ -0,0 +1,137 @@
+//
+//  PipelineCache.hpp
+//  Point_Cloud_Renderer
+//
+//  Created by Vatsalya Yadav on 10/19/26.
+//
+
+#ifndef PipelineCache_hpp
+#define PipelineCache_hpp
+
+#include <chrono>
+#include <condition_variable>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+
+#include "Core/Core.hpp"
+#include "Renderer/Pipeline/PipelineDesc.hpp"
+#include "Renderer/Pipeline/ShaderRegistry.hpp"
+
+FD_MTL
+FD_NS
+
+namespace PCR
+{
+    struct PipelineCacheStats
+    {
+        // get/prepare calls
+        uint32_t requests = 0;
+        
+        // Requests answered by an existing or in-flight entry
+        uint32_t hits = 0;
+        
+        uint32_t compiled = 0;
+        
+        uint32_t failed = 0;
+        
+        // Entries started from the manifest
+        uint32_t precompiled = 0;
+        
+        // Sum of per-pipeline compile latencies, compiles overlap so this exceeds wall time
+        double compileMs = 0.0;
+    };
+
+    // Owns every pipeline state in the renderer. Identical descriptions are compiled once,
+    // compilation runs on Metal's asynchronous path, and the descriptions in use are
+    // written to a manifest that the next launch compiles up front. The manifest is
+    // rewritten whenever the last compile in flight lands and something new compiled, so
+    // pipelines built after startup are kept too, even if the app never shuts down cleanly.
+    class PipelineCache
+    {
+    public:
+        PipelineCache( MTL::Device* pDevice, ShaderRegistry* pShaderRegistry, const std::string& manifestPath );
+        
+        ~PipelineCache();
+        
+        PipelineCache( const PipelineCache& ) = delete;
+        
+        PipelineCache& operator=( const PipelineCache& ) = delete;
+        
+        // Starts compiling in the background unless the same description is known already
+        void prepare( const RenderPipelineDesc& desc );
+        
+        void prepare( const ComputePipelineDesc& desc );
+        
+        // Blocks until the pipeline is ready, the cache keeps ownership
+        MTL::RenderPipelineState* getRenderPipeline( const RenderPipelineDesc& desc );
+        
+        MTL::ComputePipelineState* getComputePipeline( const ComputePipelineDesc& desc );
+        
+        // Prepares everything listed in the manifest, returns the number of entries started
+        uint32_t precompileManifest();
+        
+        // Every compiled description so far, done automatically as compiles land
+        bool saveManifest();
+        
+        // Until every compile has landed and the manifest write it started is done
+        void waitForPending();
+        
+        PipelineCacheStats getStats() const;
+
+    private:
+        struct Entry
+        {
+            std::string key;
+            
+            MTL::RenderPipelineState* pRenderState = nullptr;
+            
+            MTL::ComputePipelineState* pComputeState = nullptr;
+            
+            bool ready = false;
+            
+            bool failed = false;
+            
+            std::chrono::steady_clock::time_point startTime;
+        };
+        
+        MTL::Device* _pDevice;
+        
+        ShaderRegistry* _pShaderRegistry;
+        
+        std::string _manifestPath;
+        
+        mutable std::mutex _mutex;
+        
+        std::condition_variable _compiledCondition;
+        
+        // Node based, entries stay put while completion handlers look them up
+        std::unordered_map< uint64_t, Entry > _entries;
+        
+        uint32_t _pendingCount;
+        
+        // Compiled entries the manifest on disk doesn't have yet
+        bool _manifestDirty;
+        
+        // A completion handler is writing the manifest
+        bool _savingManifest;
+        
+        // Serialises writes of the manifest file
+        std::mutex _manifestMutex;
+        
+        PipelineCacheStats _stats;
+        
+        // Returns true when the caller has to start compiling the new entry
+        bool insert( uint64_t hash, const std::string& key, bool isRequest );
+        
+        void compile( uint64_t hash, const RenderPipelineDesc& desc );
+        
+        void compile( uint64_t hash, const ComputePipelineDesc& desc );
+        
+        void finish( uint64_t hash, MTL::RenderPipelineState* pRenderState, MTL::ComputePipelineState* pComputeState, NS::Error* pError );
+        
+        const Entry& waitForEntry( uint64_t hash );
+    };
+}
+
+#endif /* PipelineCache_hpp */
@@ -0,0 +1,232 @@
+//
+//  PipelineDesc.cpp
+//  Point_Cloud_Renderer
+//
+//  Created by Vatsalya Yadav on 10/19/26.
+//
+
+#include "PipelineDesc.hpp"
+
+#include <sstream>
+
+namespace PCR
+{
+    namespace
+    {
+        constexpr const char* RENDER_TAG{ "render" };
+        
+        constexpr const char* COMPUTE_TAG{ "compute" };
+        
+        // Comma separated unsigned integers, exactly count of them
+        bool parseNumbers( const std::string& text, uint64_t* pValues, size_t count )
+        {
+            std::istringstream stream( text );
+            std::string item;
+            size_t parsed = 0;
+            while ( std::getline( stream, item, ',' ) )
+            {
+                if ( parsed == count || item.empty() || item.find_first_not_of( "0123456789" ) != std::string::npos )
+                {
+                    return false;
+                }
+                pValues[ parsed++ ] = std::stoull( item );
+            }
+            return parsed == count;
+        }
+        
+        bool splitToken( const std::string& token, std::string& key, std::string& value )
+        {
+            const size_t separator = token.find( '=' );
+            if ( separator == std::string::npos )
+            {
+                return false;
+            }
+            key = token.substr( 0, separator );
+            value = token.substr( separator + 1 );
+            return true;
+        }
+    }
+
+    uint64_t hashString( const std::string& string )
+    {
+        uint64_t hash = 14695981039346656037ull;
+        for ( unsigned char c : string )
+        {
+            hash ^= c;
+            hash *= 1099511628211ull;
+        }
+        return hash;
+    }
+
+    std::string RenderPipelineDesc::serialize() const
+    {
+        std::ostringstream stream;
+        stream << RENDER_TAG
+               << " vs=" << vertexFunction
+               << " fs=" << fragmentFunction;
+        if ( !constants.empty() )
+        {
+            stream << " fc=" << constants.serialize();
+        }
+        stream
+               << " depth=" << depthPixelFormat
+               << " stencil=" << stencilPixelFormat
+               << " samples=" << sampleCount;
+        for ( const PipelineColorAttachment& color : colorAttachments )
+        {
+            stream << " color=" << color.pixelFormat
+                   << ',' << ( color.blendingEnabled ? 1 : 0 )
+                   << ',' << color.sourceRGBBlendFactor
+                   << ',' << color.destinationRGBBlendFactor
+                   << ',' << color.rgbBlendOperation
+                   << ',' << color.sourceAlphaBlendFactor
+                   << ',' << color.destinationAlphaBlendFactor
+                   << ',' << color.alphaBlendOperation
+                   << ',' << color.writeMask;
+        }
+        for ( const PipelineVertexAttribute& attribute : vertexAttributes )
+        {
+            stream << " attr=" << attribute.index
+                   << ',' << attribute.format
+                   << ',' << attribute.offset
+                   << ',' << attribute.bufferIndex;
+        }
+        for ( const PipelineVertexLayout& layout : vertexLayouts )
+        {
+            stream << " layout=" << layout.bufferIndex
+                   << ',' << layout.stride
+                   << ',' << layout.stepFunction
+                   << ',' << layout.stepRate;
+        }
+        return stream.str();
+    }
+
+    bool RenderPipelineDesc::deserialize( const std::string& line, RenderPipelineDesc& desc )
+    {
+        std::istringstream stream( line );
+        std::string token;
+        if ( !( stream >> token ) || token != RENDER_TAG )
+        {
+            return false;
+        }
+        
+        desc = RenderPipelineDesc{};
+        while ( stream >> token )
+        {
+            std::string key;
+            std::string value;
+            if ( !splitToken( token, key, value ) )
+            {
+                return false;
+            }
+            
+            if ( key == "vs" )
+            {
+                desc.vertexFunction = value;
+            }
+            else if ( key == "fs" )
+            {
+                desc.fragmentFunction = value;
+            }
+            else if ( key == "fc" )
+            {
+                if ( !FunctionConstantValues::deserialize( value, desc.constants ) )
+                {
+                    return false;
+                }
+            }
+            else if ( key == "depth" || key == "stencil" || key == "samples" )
+            {
+                uint64_t number = 0;
+                if ( !parseNumbers( value, &number, 1 ) )
+                {
+                    return false;
+                }
+                ( key == "depth" ? desc.depthPixelFormat : key == "stencil" ? desc.stencilPixelFormat : desc.sampleCount ) = number;
+            }
+            else if ( key == "color" )
+            {
+                uint64_t v[ 9 ];
+                if ( !parseNumbers( value, v, 9 ) )
+                {
+                    return false;
+                }
+                desc.colorAttachments.push_back( PipelineColorAttachment{ v[ 0 ], v[ 1 ] != 0, v[ 2 ], v[ 3 ], v[ 4 ], v[ 5 ], v[ 6 ], v[ 7 ], v[ 8 ] } );
+            }
+            else if ( key == "attr" )
+            {
+                uint64_t v[ 4 ];
+                if ( !parseNumbers( value, v, 4 ) )
+                {
+                    return false;
+                }
+                desc.vertexAttributes.push_back( PipelineVertexAttribute{ v[ 0 ], v[ 1 ], v[ 2 ], v[ 3 ] } );
+            }
+            else if ( key == "layout" )
+            {
+                uint64_t v[ 4 ];
+                if ( !parseNumbers( value, v, 4 ) )
+                {
+                    return false;
+                }
+                desc.vertexLayouts.push_back( PipelineVertexLayout{ v[ 0 ], v[ 1 ], v[ 2 ], v[ 3 ] } );
+            }
+            else
+            {
+                return false;
+            }
+        }
+        return !desc.vertexFunction.empty();
+    }
+
+    uint64_t RenderPipelineDesc::hash() const
+    {
+        return hashString( serialize() );
+    }
+
+    std::string ComputePipelineDesc::serialize() const
+    {
+        std::string line = std::string( COMPUTE_TAG ) + " fn=" + function;
+        if ( !constants.empty() )
+        {
+            line += " fc=" + constants.serialize();
+        }
+        return line;
+    }
+
+    bool ComputePipelineDesc::deserialize( const std::string& line, ComputePipelineDesc& desc )
+    {
+        std::istringstream stream( line );
+        std::string token;
+        if ( !( stream >> token ) || token != COMPUTE_TAG )
+        {
+            return false;
+        }
+        
+        desc = ComputePipelineDesc{};
+        while ( stream >> token )
+        {
+            std::string key;
+            std::string value;
+            if ( !splitToken( token, key, value ) )
+            {
+                return false;
+            }
+            
+            if ( key == "fn" )
+            {
+                desc.function = value;
+            }
+            else if ( key != "fc" || !FunctionConstantValues::deserialize( value, desc.constants ) )
+            {
+                return false;
+            }
+        }
+        return !desc.function.empty();
+    }
+
+    uint64_t ComputePipelineDesc::hash() const
+    {
+        return hashString( serialize() );
+    }
+}
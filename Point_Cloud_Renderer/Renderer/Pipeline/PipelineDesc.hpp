@@ -0,0 +1,111 @@
+//
+//  PipelineDesc.hpp
+//  Point_Cloud_Renderer
+//
+//  Created by Vatsalya Yadav on 10/19/26.
+//
+
+#ifndef PipelineDesc_hpp
+#define PipelineDesc_hpp
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include "Renderer/Pipeline/FunctionConstants.hpp"
+
+namespace PCR
+{
+    // Enum fields hold the MTL:: enum values as plain integers, with Metal's defaults,
+    // so descriptions can be hashed, compared and written to disk without Metal.
+
+    struct PipelineColorAttachment
+    {
+        uint64_t pixelFormat = 0;
+        
+        bool blendingEnabled = false;
+        
+        uint64_t sourceRGBBlendFactor = 1;          // MTL::BlendFactorOne
+        
+        uint64_t destinationRGBBlendFactor = 0;     // MTL::BlendFactorZero
+        
+        uint64_t rgbBlendOperation = 0;             // MTL::BlendOperationAdd
+        
+        uint64_t sourceAlphaBlendFactor = 1;
+        
+        uint64_t destinationAlphaBlendFactor = 0;
+        
+        uint64_t alphaBlendOperation = 0;
+        
+        uint64_t writeMask = 0xF;                   // MTL::ColorWriteMaskAll
+    };
+
+    struct PipelineVertexAttribute
+    {
+        uint64_t index = 0;
+        
+        uint64_t format = 0;
+        
+        uint64_t offset = 0;
+        
+        uint64_t bufferIndex = 0;
+    };
+
+    struct PipelineVertexLayout
+    {
+        uint64_t bufferIndex = 0;
+        
+        uint64_t stride = 0;
+        
+        uint64_t stepFunction = 1;                  // MTL::VertexStepFunctionPerVertex
+        
+        uint64_t stepRate = 1;
+    };
+
+    struct RenderPipelineDesc
+    {
+        std::string vertexFunction;
+        
+        std::string fragmentFunction;
+        
+        // Applied to both functions, constant indices are shared across the library
+        FunctionConstantValues constants;
+        
+        std::vector< PipelineColorAttachment > colorAttachments;
+        
+        uint64_t depthPixelFormat = 0;
+        
+        uint64_t stencilPixelFormat = 0;
+        
+        uint64_t sampleCount = 1;
+        
+        std::vector< PipelineVertexAttribute > vertexAttributes;
+        
+        std::vector< PipelineVertexLayout > vertexLayouts;
+        
+        // Canonical single-line form, also the manifest format
+        std::string serialize() const;
+        
+        static bool deserialize( const std::string& line, RenderPipelineDesc& desc );
+        
+        // FNV-1a of serialize(), stable across launches and machines
+        uint64_t hash() const;
+    };
+
+    struct ComputePipelineDesc
+    {
+        std::string function;
+        
+        FunctionConstantValues constants;
+        
+        std::string serialize() const;
+        
+        static bool deserialize( const std::string& line, ComputePipelineDesc& desc );
+        
+        uint64_t hash() const;
+    };
+
+    uint64_t hashString( const std::string& string );
+}
+
+#endif /* PipelineDesc_hpp */
@@ -0,0 +1,111 @@
+//
+//  ShaderRegistry.cpp
+//  Point_Cloud_Renderer
+//
+//  Created by Vatsalya Yadav on 10/19/26.
+//
+
+#include "ShaderRegistry.hpp"
+
+namespace PCR
+{
+    ShaderRegistry::ShaderRegistry( std::unique_ptr< ShaderCompiler > pCompiler )
+    :   _pCompiler{ std::move( pCompiler ) }
+    {
+    }
+
+    ShaderRegistry::~ShaderRegistry()
+    {
+        for ( auto& [ key, pFunction ] : _functions )
+        {
+            if ( pFunction )
+            {
+                _pCompiler->releaseFunction( pFunction );
+            }
+        }
+        for ( auto& [ name, pLibrary ] : _libraries )
+        {
+            if ( pLibrary )
+            {
+                _pCompiler->releaseLibrary( pLibrary );
+            }
+        }
+    }
+
+    MTL::Library* ShaderRegistry::getLibrary( const std::string& libraryName /* = "" */ )
+    {
+        std::lock_guard< std::mutex > lock( _mutex );
+        return getLibraryLocked( libraryName );
+    }
+
+    MTL::Function* ShaderRegistry::getFunction( const std::string& functionName,
+                                                const FunctionConstantValues& constants /* = FunctionConstantValues{} */,
+                                                const std::string& libraryName /* = "" */ )
+    {
+        const std::string key = makeFunctionKey( libraryName, functionName, constants );
+        
+        std::lock_guard< std::mutex > lock( _mutex );
+        auto it = _functions.find( key );
+        if ( it != _functions.end() )
+        {
+            ++_stats.functionHits;
+            return it->second;
+        }
+        
+        MTL::Library* pLibrary = getLibraryLocked( libraryName );
+        MTL::Function* pFunction = pLibrary ? _pCompiler->newFunction( pLibrary, functionName, constants ) : nullptr;
+        if ( pFunction )
+        {
+            ++_stats.functionCompiles;
+        }
+        else
+        {
+            __builtin_printf( "Shader registry: no function for %s\n", key.c_str() );
+            ++_stats.failures;
+        }
+        _functions.emplace( key, pFunction );
+        return pFunction;
+    }
+
+    std::string ShaderRegistry::makeFunctionKey( const std::string& libraryName, const std::string& functionName, const FunctionConstantValues& constants )
+    {
+        std::string key = libraryName;
+        key += '/';
+        key += functionName;
+        if ( !constants.empty() )
+        {
+            key += '[';
+            key += constants.serialize();
+            key += ']';
+        }
+        return key;
+    }
+
+    ShaderRegistryStats ShaderRegistry::getStats() const
+    {
+        std::lock_guard< std::mutex > lock( _mutex );
+        return _stats;
+    }
+
+    MTL::Library* ShaderRegistry::getLibraryLocked( const std::string& libraryName )
+    {
+        auto it = _libraries.find( libraryName );
+        if ( it != _libraries.end() )
+        {
+            return it->second;
+        }
+        
+        MTL::Library* pLibrary = _pCompiler->loadLibrary( libraryName );
+        if ( pLibrary )
+        {
+            ++_stats.libraryLoads;
+        }
+        else
+        {
+            __builtin_printf( "Shader registry: failed to load library \"%s\"\n", libraryName.c_str() );
+            ++_stats.failures;
+        }
+        _libraries.emplace( libraryName, pLibrary );
+        return pLibrary;
+    }
+}
@@ -0,0 +1,92 @@
+//
+//  ShaderRegistry.hpp
+//  Point_Cloud_Renderer
+//
+//  Created by Vatsalya Yadav on 10/19/26.
+//
+
+#ifndef ShaderRegistry_hpp
+#define ShaderRegistry_hpp
+
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+
+#include "Core/Core.hpp"
+#include "Renderer/Pipeline/FunctionConstants.hpp"
+
+FD_MTL
+
+namespace PCR
+{
+    // What the registry needs from a shader backend. MetalShaderCompiler is the real one;
+    // the handles are opaque to the registry so any stand-in can hand out fake pointers.
+    class ShaderCompiler
+    {
+    public:
+        virtual ~ShaderCompiler() = default;
+        
+        // Empty name is the app's default library, returns nullptr if it can't be loaded
+        virtual MTL::Library* loadLibrary( const std::string& libraryName ) = 0;
+        
+        // Returns nullptr if the function doesn't exist or fails to specialise
+        virtual MTL::Function* newFunction( MTL::Library* pLibrary, const std::string& functionName, const FunctionConstantValues& constants ) = 0;
+        
+        virtual void releaseLibrary( MTL::Library* pLibrary ) = 0;
+        
+        virtual void releaseFunction( MTL::Function* pFunction ) = 0;
+    };
+
+    struct ShaderRegistryStats
+    {
+        uint32_t libraryLoads = 0;
+        
+        uint32_t functionCompiles = 0;
+        
+        uint32_t functionHits = 0;
+        
+        uint32_t failures = 0;
+    };
+
+    // Loads every library once and hands out functions specialised by function constant
+    // values, compiling each library/name/constants combination a single time. Failed
+    // lookups are cached too so a missing function isn't retried every frame.
+    class ShaderRegistry
+    {
+    public:
+        explicit ShaderRegistry( std::unique_ptr< ShaderCompiler > pCompiler );
+        
+        ~ShaderRegistry();
+        
+        ShaderRegistry( const ShaderRegistry& ) = delete;
+        
+        ShaderRegistry& operator=( const ShaderRegistry& ) = delete;
+        
+        // The registry keeps ownership of everything it returns
+        MTL::Library* getLibrary( const std::string& libraryName = "" );
+        
+        MTL::Function* getFunction( const std::string& functionName,
+                                    const FunctionConstantValues& constants = FunctionConstantValues{},
+                                    const std::string& libraryName = "" );
+        
+        static std::string makeFunctionKey( const std::string& libraryName, const std::string& functionName, const FunctionConstantValues& constants );
+        
+        ShaderRegistryStats getStats() const;
+
+    private:
+        std::unique_ptr< ShaderCompiler > _pCompiler;
+        
+        mutable std::mutex _mutex;
+        
+        std::unordered_map< std::string, MTL::Library* > _libraries;
+        
+        std::unordered_map< std::string, MTL::Function* > _functions;
+        
+        ShaderRegistryStats _stats;
+        
+        MTL::Library* getLibraryLocked( const std::string& libraryName );
+    };
+}
+
+#endif /* ShaderRegistry_hpp */
@@ -0,0 +1,94 @@
+//
+//  ShaderRegistryCheck.cpp
+//  Point_Cloud_Renderer
+//
+//  Created by Vatsalya Yadav on 10/19/26.
+//
+
+#include "ShaderRegistryCheck.hpp"
+
+#include <memory>
+
+#include "Renderer/Pipeline/PipelineDesc.hpp"
+#include "Renderer/Pipeline/ShaderRegistry.hpp"
+#include "Renderer/Pipeline/StubShaderCompiler.hpp"
+#include "Renderer/Validation/CheckReport.hpp"
+
+namespace PCR
+{
+    bool runShaderRegistryChecks()
+    {
+        CheckReport report( "Shader registry, stub compiler" );
+        
+        StubShaderCompilerStats stubStats;
+        {
+            auto pStub = std::make_unique< StubShaderCompiler >( stubStats );
+            pStub->declareFunction( "", "vertexMain" );
+            pStub->declareFunction( "", "fragmentMain" );
+            pStub->declareFunction( "Points", "vertexMain" );
+            ShaderRegistry registry( std::move( pStub ) );
+            
+            // Registration
+            MTL::Function* pVertex = registry.getFunction( "vertexMain" );
+            MTL::Function* pFragment = registry.getFunction( "fragmentMain" );
+            report.expect( pVertex && pFragment && pVertex != pFragment, "declared functions resolve to distinct handles" );
+            report.expect( registry.getLibrary() == registry.getLibrary( "" ), "the default library is one handle" );
+            report.expect( stubStats.libraryLoads == 1 && registry.getStats().libraryLoads == 1, "the default library loads once for two functions" );
+            
+            MTL::Function* pPointsVertex = registry.getFunction( "vertexMain", FunctionConstantValues{}, "Points" );
+            report.expect( pPointsVertex && pPointsVertex != pVertex, "the same name in another library is its own function" );
+            
+            // Specialisation
+            const FunctionConstantValues normalColors = FunctionConstantValues{}.setUInt( 0, 1 ).setBool( 2, true );
+            const FunctionConstantValues reordered = FunctionConstantValues{}.setBool( 2, true ).setUInt( 0, 1 );
+            const FunctionConstantValues whiteColors = FunctionConstantValues{}.setUInt( 0, 2 ).setBool( 2, true );
+            
+            MTL::Function* pNormal = registry.getFunction( "vertexMain", normalColors );
+            MTL::Function* pWhite = registry.getFunction( "vertexMain", whiteColors );
+            report.expect( pNormal && pWhite && pNormal != pWhite && pNormal != pVertex, "each constant set is its own variant" );
+            report.expect( pNormal && StubShaderCompiler::getConstants( pNormal ) == normalColors, "the compiler gets the constants asked for" );
+            report.expect( ShaderRegistry::makeFunctionKey( "", "vertexMain", normalColors ) == ShaderRegistry::makeFunctionKey( "", "vertexMain", reordered ),
+                           "fill order doesn't change the key" );
+            report.expect( FunctionConstantValues{}.setFloat( 3, 0.0f ).serialize() != FunctionConstantValues{}.setFloat( 3, -0.0f ).serialize(),
+                           "float constants are keyed by their bits" );
+            
+            FunctionConstantValues parsed;
+            report.expect( FunctionConstantValues::deserialize( normalColors.serialize(), parsed ) && parsed == normalColors, "constants survive serialize and deserialize" );
+            
+            // Cache hits
+            const ShaderRegistryStats beforeHits = registry.getStats();
+            const uint32_t compilesBeforeHits = stubStats.functionCompiles;
+            const bool sameHandles = registry.getFunction( "vertexMain", reordered ) == pNormal
+                                  && registry.getFunction( "vertexMain" ) == pVertex
+                                  && registry.getFunction( "fragmentMain" ) == pFragment;
+            const ShaderRegistryStats afterHits = registry.getStats();
+            report.expect( sameHandles, "repeated lookups return the first handle" );
+            report.expect( afterHits.functionHits == beforeHits.functionHits + 3 && stubStats.functionCompiles == compilesBeforeHits,
+                           "repeated lookups are hits and compile nothing" );
+            report.expect( afterHits.functionCompiles == 5 && stubStats.functionCompiles == 5, "five variants compiled in all" );
+            
+            // Misses
+            const bool missing = registry.getFunction( "noSuchFunction" ) == nullptr && registry.getFunction( "noSuchFunction" ) == nullptr;
+            report.expect( missing && stubStats.misses == 1, "a missing function is asked for once and cached" );
+            report.expect( registry.getFunction( "vertexMain", FunctionConstantValues{}, "NoSuchLibrary" ) == nullptr
+                        && registry.getFunction( "vertexMain", FunctionConstantValues{}, "NoSuchLibrary" ) == nullptr
+                        && registry.getStats().failures == 3,
+                           "a missing library fails once, each of its lookups once" );
+            
+            // Pipeline descriptions carry their constants into the manifest line
+            RenderPipelineDesc desc;
+            desc.vertexFunction = "vertexMain";
+            desc.fragmentFunction = "fragmentMain";
+            desc.constants = normalColors;
+            RenderPipelineDesc white = desc;
+            white.constants = whiteColors;
+            RenderPipelineDesc parsedDesc;
+            report.expect( desc.hash() != white.hash(), "pipelines differing only in constants hash apart" );
+            report.expect( RenderPipelineDesc::deserialize( desc.serialize(), parsedDesc ) && parsedDesc.serialize() == desc.serialize() && parsedDesc.constants == normalColors,
+                           "a pipeline description round trips with its constants" );
+        }
+        report.expect( stubStats.liveObjects == 0, "the registry releases every library and function" );
+        
+        return report.finish();
+    }
+}
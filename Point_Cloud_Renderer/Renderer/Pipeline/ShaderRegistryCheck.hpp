@@ -0,0 +1,20 @@
+//
+//  ShaderRegistryCheck.hpp
+//  Point_Cloud_Renderer
+//
+//  Created by Vatsalya Yadav on 10/19/26.
+//
+
+#ifndef ShaderRegistryCheck_hpp
+#define ShaderRegistryCheck_hpp
+
+namespace PCR
+{
+    // ShaderRegistry over StubShaderCompiler: libraries load once, each function constant set
+    // compiles once and is handed back from then on, misses are cached, pipeline descriptions
+    // keep their constants through the manifest, and everything is released at the end.
+    // Returns false if any check fails.
+    bool runShaderRegistryChecks();
+}
+
+#endif /* ShaderRegistryCheck_hpp */
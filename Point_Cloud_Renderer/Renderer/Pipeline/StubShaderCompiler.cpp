@@ -0,0 +1,84 @@
+//
+//  StubShaderCompiler.cpp
+//  Point_Cloud_Renderer
+//
+//  Created by Vatsalya Yadav on 10/19/26.
+//
+
+#include "StubShaderCompiler.hpp"
+
+#include <algorithm>
+
+namespace PCR
+{
+    namespace
+    {
+        struct StubLibrary
+        {
+            std::string name;
+        };
+        
+        struct StubFunction
+        {
+            std::string name;
+            
+            FunctionConstantValues constants;
+        };
+    }
+
+    StubShaderCompiler::StubShaderCompiler( StubShaderCompilerStats& stats )
+    :   _stats{ stats }
+    {
+    }
+
+    void StubShaderCompiler::declareFunction( const std::string& libraryName, const std::string& functionName )
+    {
+        _declarations.emplace( libraryName, functionName );
+    }
+
+    MTL::Library* StubShaderCompiler::loadLibrary( const std::string& libraryName )
+    {
+        const bool exists = std::any_of( _declarations.begin(), _declarations.end(), [ & ]( const auto& declaration ){
+            return declaration.first == libraryName;
+        });
+        if ( !exists )
+        {
+            return nullptr;
+        }
+        
+        ++_stats.libraryLoads;
+        ++_stats.liveObjects;
+        return reinterpret_cast< MTL::Library* >( new StubLibrary{ libraryName } );
+    }
+
+    MTL::Function* StubShaderCompiler::newFunction( MTL::Library* pLibrary, const std::string& functionName, const FunctionConstantValues& constants )
+    {
+        const std::string& libraryName = reinterpret_cast< StubLibrary* >( pLibrary )->name;
+        if ( _declarations.count( { libraryName, functionName } ) == 0 )
+        {
+            ++_stats.misses;
+            return nullptr;
+        }
+        
+        ++_stats.functionCompiles;
+        ++_stats.liveObjects;
+        return reinterpret_cast< MTL::Function* >( new StubFunction{ functionName, constants } );
+    }
+
+    void StubShaderCompiler::releaseLibrary( MTL::Library* pLibrary )
+    {
+        --_stats.liveObjects;
+        delete reinterpret_cast< StubLibrary* >( pLibrary );
+    }
+
+    void StubShaderCompiler::releaseFunction( MTL::Function* pFunction )
+    {
+        --_stats.liveObjects;
+        delete reinterpret_cast< StubFunction* >( pFunction );
+    }
+
+    const FunctionConstantValues& StubShaderCompiler::getConstants( const MTL::Function* pFunction )
+    {
+        return reinterpret_cast< const StubFunction* >( pFunction )->constants;
+    }
+}
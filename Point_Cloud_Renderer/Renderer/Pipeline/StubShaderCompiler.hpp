@@ -0,0 +1,64 @@
+//
+//  StubShaderCompiler.hpp
+//  Point_Cloud_Renderer
+//
+//  Created by Vatsalya Yadav on 10/19/26.
+//
+
+#ifndef StubShaderCompiler_hpp
+#define StubShaderCompiler_hpp
+
+#include <set>
+#include <string>
+#include <utility>
+
+#include "Renderer/Pipeline/ShaderRegistry.hpp"
+
+namespace PCR
+{
+    // Counted across the stub's lifetime, the registry owns and destroys the stub itself
+    struct StubShaderCompilerStats
+    {
+        uint32_t libraryLoads = 0;
+        
+        uint32_t functionCompiles = 0;
+        
+        // Requests for functions that were never declared
+        uint32_t misses = 0;
+        
+        // Handles handed out and not released yet
+        int32_t liveObjects = 0;
+    };
+
+    // ShaderCompiler without a GPU, for driving the registry's keys and caching on any host.
+    // The handles point at host objects and mustn't reach Metal. Libraries exist once they
+    // have a declared function, and functions specialise for any constants, like Metal does
+    // for constants a function doesn't read.
+    class StubShaderCompiler : public ShaderCompiler
+    {
+    public:
+        explicit StubShaderCompiler( StubShaderCompilerStats& stats );
+        
+        // Empty library name is the default library
+        void declareFunction( const std::string& libraryName, const std::string& functionName );
+        
+        MTL::Library* loadLibrary( const std::string& libraryName ) override;
+        
+        MTL::Function* newFunction( MTL::Library* pLibrary, const std::string& functionName, const FunctionConstantValues& constants ) override;
+        
+        void releaseLibrary( MTL::Library* pLibrary ) override;
+        
+        void releaseFunction( MTL::Function* pFunction ) override;
+        
+        // What a function handle from this stub was specialised with
+        static const FunctionConstantValues& getConstants( const MTL::Function* pFunction );
+
+    private:
+        StubShaderCompilerStats& _stats;
+        
+        // Library, function
+        std::set< std::pair< std::string, std::string > > _declarations;
+    };
+}
+
+#endif /* StubShaderCompiler_hpp */
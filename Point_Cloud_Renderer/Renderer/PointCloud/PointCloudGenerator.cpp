@@ -0,0 +1,45 @@
+//
+//  PointCloudGenerator.cpp
+//  Point_Cloud_Renderer
+//
+//  Created by Vatsalya Yadav on 10/19/26.
+//
+
+#include "PointCloudGenerator.hpp"
+
+#include <algorithm>
+#include <cmath>
+
+namespace PCR::PointCloudGenerator
+{
+    namespace
+    {
+        uint32_t packColor( const simd::float3& direction )
+        {
+            const auto channel = [ ]( float value ){
+                return static_cast< uint32_t >( ( value * 0.5f + 0.5f ) * 255.0f + 0.5f );
+            };
+            return channel( direction.x ) | ( channel( direction.y ) << 8 ) | ( channel( direction.z ) << 16 ) | 0xFF000000u;
+        }
+    }
+
+    std::vector< PointData > makeSphere( size_t pointCount, float radius )
+    {
+        // Fibonacci spiral from pole to pole. The angle is taken in doubles, a million
+        // turns in is past where floats resolve a fraction of one.
+        const double goldenAngle = M_PI * ( 3.0 - std::sqrt( 5.0 ) );
+        
+        std::vector< PointData > points( pointCount );
+        for ( size_t i = 0; i < pointCount; ++i )
+        {
+            const float y = 1.0f - 2.0f * ( i + 0.5f ) / pointCount;
+            const float ring = std::sqrt( std::max( 0.0f, 1.0f - y * y ) );
+            const auto phi = static_cast< float >( std::fmod( goldenAngle * static_cast< double >( i ), 2.0 * M_PI ) );
+            
+            const simd::float3 direction{ ring * std::cos( phi ), y, ring * std::sin( phi ) };
+            points[ i ].position = direction * radius;
+            points[ i ].color = packColor( direction );
+        }
+        return points;
+    }
+}
@@ -0,0 +1,26 @@
+//
+//  PointCloudGenerator.hpp
+//  Point_Cloud_Renderer
+//
+//  Created by Vatsalya Yadav on 10/19/26.
+//
+
+#ifndef PointCloudGenerator_hpp
+#define PointCloudGenerator_hpp
+
+#include <cstddef>
+#include <vector>
+
+#include <simd/simd.h>
+
+#include "Renderer/Structures/PointData.hpp"
+
+// Point sets for when there's no scanned data at hand
+namespace PCR::PointCloudGenerator
+{
+    // Evenly spread over a sphere around the origin, colored by direction. Consecutive
+    // points are neighbours, so every POINT_NODE_SIZE of them form a compact node.
+    std::vector< PointData > makeSphere( size_t pointCount, float radius );
+}
+
+#endif /* PointCloudGenerator_hpp */
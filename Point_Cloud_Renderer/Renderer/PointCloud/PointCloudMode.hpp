@@ -0,0 +1,30 @@
+//
+//  PointCloudMode.hpp
+//  Point_Cloud_Renderer
+//
+//  Created by Vatsalya Yadav on 10/19/26.
+//
+
+#ifndef PointCloudMode_hpp
+#define PointCloudMode_hpp
+
+#include <cstdint>
+
+namespace PCR
+{
+    // What Renderer shows in place of the instanced cubes
+    enum class PointCloudMode : uint32_t
+    {
+        // The cubes, no point cloud
+        Off,
+        
+        // PointRasterizer on the worker pool, reusing last frame's samples through
+        // PointReprojector, uploaded for the upscale to read
+        Reprojected,
+        
+        // SplatPass on the GPU, each of its passes timed into the renderer's profiler
+        Splats
+    };
+}
+
+#endif /* PointCloudMode_hpp */
@@ -0,0 +1,126 @@
+//
+//  PointRasterBenchmark.cpp
+//  Point_Cloud_Renderer
+//
+//  Created by Vatsalya Yadav on 10/19/26.
+//
+
+#include "PointRasterBenchmark.hpp"
+
+#include <algorithm>
+#include <cmath>
+
+#include "Math/Utility.hpp"
+#include "Renderer/PointCloud/PointCloudGenerator.hpp"
+#include "Renderer/PointCloud/PointRasterizer.hpp"
+#include "Renderer/Threading/WorkerPool.hpp"
+
+namespace PCR
+{
+    namespace
+    {
+        constexpr uint32_t WIDTH{ 1920 };
+        
+        constexpr uint32_t HEIGHT{ 1080 };
+        
+        constexpr uint32_t RUNS{ 5 };
+        
+        constexpr size_t DUPLICATE_STRIDE{ 8 };
+        
+        // The sphere fills about half the image height
+        constexpr float CAMERA_DISTANCE{ 3.0f };
+        
+        std::vector< PointData > makePoints( size_t pointCount )
+        {
+            const size_t uniqueCount = pointCount - pointCount / ( DUPLICATE_STRIDE + 1 );
+            std::vector< PointData > points = PointCloudGenerator::makeSphere( uniqueCount, 1.0f );
+            for ( size_t i = 0; points.size() < pointCount; i += DUPLICATE_STRIDE )
+            {
+                points.push_back( points[ i ] );
+            }
+            return points;
+        }
+        
+        // Runs every mode once before timing, so both start with warm caches
+        PointRasterStats measure( PointRasterizer& rasterizer, const std::vector< PointData >& points, const simd::float4x4& viewProjection, PointRasterMode mode )
+        {
+            PointRasterStats best;
+            best.totalMs = INFINITY;
+            for ( uint32_t run = 0; run <= RUNS; ++run )
+            {
+                rasterizer.clear();
+                rasterizer.rasterize( points.data(), points.size(), viewProjection, mode );
+                if ( run > 0 && rasterizer.getStats().totalMs < best.totalMs )
+                {
+                    best = rasterizer.getStats();
+                }
+            }
+            return best;
+        }
+    }
+
+    std::vector< PointRasterBenchmarkResult > runPointRasterBenchmark( const std::vector< size_t >& pointCounts )
+    {
+        std::vector< PointRasterBenchmarkResult > results;
+        
+        WorkerPool workerPool;
+        PointRasterizer scatter( WIDTH, HEIGHT, workerPool );
+        PointRasterizer binned( WIDTH, HEIGHT, workerPool );
+        
+        const simd::float4x4 viewProjection = Math::makePerspective( 45.0f * M_PI / 180.0f, static_cast< float >( WIDTH ) / HEIGHT, 0.03f, 500.0f )
+                                            * Math::makeTranslate( simd::float3{ 0.0f, 0.0f, -CAMERA_DISTANCE } );
+        
+        for ( size_t pointCount : pointCounts )
+        {
+            const std::vector< PointData > points = makePoints( pointCount );
+            
+            PointRasterBenchmarkResult result;
+            result.pointCount = pointCount;
+            
+            const PointRasterStats scatterStats = measure( scatter, points, viewProjection, PointRasterMode::Scatter );
+            result.scatterMs = scatterStats.totalMs;
+            result.visiblePoints = scatterStats.visiblePoints;
+            
+            const PointRasterStats binnedStats = measure( binned, points, viewProjection, PointRasterMode::Binned );
+            result.binnedMs = binnedStats.totalMs;
+            result.binnedProjectMs = binnedStats.projectMs;
+            result.binnedBinMs = binnedStats.binMs;
+            result.binnedResolveMs = binnedStats.resolveMs;
+            
+            for ( uint32_t y = 0; y < HEIGHT; ++y )
+            {
+                for ( uint32_t x = 0; x < WIDTH; ++x )
+                {
+                    result.mismatchedPixels += scatter.getPixel( x, y ) != binned.getPixel( x, y );
+                }
+            }
+            
+            results.push_back( result );
+        }
+        
+        return results;
+    }
+
+    bool printPointRasterBenchmark( const std::vector< PointRasterBenchmarkResult >& results )
+    {
+        bool passed = true;
+        
+        __builtin_printf( "Point raster at %ux%u, ms per frame, best of %u, scatter framebuffer against binned\n", WIDTH, HEIGHT, RUNS );
+        __builtin_printf( "%10s %10s %10s %10s %8s %10s %10s %10s %10s\n", "points", "visible", "scatter", "binned", "speedup", "project", "bin", "resolve", "mismatch" );
+        for ( const PointRasterBenchmarkResult& result : results )
+        {
+            passed = passed && result.mismatchedPixels == 0;
+            __builtin_printf( "%10zu %10zu %10.2f %10.2f %7.2fx %10.2f %10.2f %10.2f %10zu\n",
+                              result.pointCount,
+                              result.visiblePoints,
+                              result.scatterMs,
+                              result.binnedMs,
+                              result.scatterMs / result.binnedMs,
+                              result.binnedProjectMs,
+                              result.binnedBinMs,
+                              result.binnedResolveMs,
+                              result.mismatchedPixels );
+        }
+        return passed;
+    }
+}
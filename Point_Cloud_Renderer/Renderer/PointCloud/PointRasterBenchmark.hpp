@@ -0,0 +1,46 @@
+//
+//  PointRasterBenchmark.hpp
+//  Point_Cloud_Renderer
+//
+//  Created by Vatsalya Yadav on 10/19/26.
+//
+
+#ifndef PointRasterBenchmark_hpp
+#define PointRasterBenchmark_hpp
+
+#include <cstddef>
+#include <vector>
+
+namespace PCR
+{
+    // Milliseconds per rasterize, the best of a few runs
+    struct PointRasterBenchmarkResult
+    {
+        size_t pointCount = 0;
+        
+        size_t visiblePoints = 0;
+        
+        double scatterMs = 0.0;
+        
+        double binnedMs = 0.0;
+        
+        // The binned run's phases
+        double binnedProjectMs = 0.0;
+        
+        double binnedBinMs = 0.0;
+        
+        double binnedResolveMs = 0.0;
+        
+        // Pixels whose depth | index differs between the two modes
+        size_t mismatchedPixels = 0;
+    };
+
+    // PointRasterizer in both modes on a generated sphere at 1920x1080 with every eighth point
+    // repeated, so equal depths have to fall to the lower index in both.
+    std::vector< PointRasterBenchmarkResult > runPointRasterBenchmark( const std::vector< size_t >& pointCounts );
+
+    // Returns false if scatter and binned framebuffers differ anywhere
+    bool printPointRasterBenchmark( const std::vector< PointRasterBenchmarkResult >& results );
+}
+
+#endif /* PointRasterBenchmark_hpp */
@@ -0,0 +1,242 @@
+//
+//  PointRasterPass.cpp
+//  Point_Cloud_Renderer
+//
+//  Created by Vatsalya Yadav on 10/19/26.
+//
+
+#include "PointRasterPass.hpp"
+
+#include <cassert>
+
+#include "Renderer/Structures/PointRasterUniforms.hpp"
+
+namespace PCR
+{
+    namespace
+    {
+        // Must match the constants in PointRaster_Compute.metal
+        constexpr NS::UInteger RESOLVE_THREADS{ 256 };
+        constexpr NS::UInteger PREFIX_THREADS{ 256 };
+        
+        struct BinnedPoint
+        {
+            uint32_t pointIndex;
+            uint32_t depth;
+            uint32_t localPixel;
+        };
+    }
+
+    PointRasterPass::PointRasterPass( MTL::Device* pDevice, MTL::Library* pLibrary )
+    :   _pDevice{ pDevice->retain() }
+    ,   _pDepthBuffer{ nullptr }
+    ,   _pIndexBuffer{ nullptr }
+    ,   _pTileCountBuffer{ nullptr }
+    ,   _pTileOffsetBuffer{ nullptr }
+    ,   _pBinnedPointBuffer{ nullptr }
+    ,   _width{ 0 }
+    ,   _height{ 0 }
+    ,   _tilesX{ 0 }
+    ,   _tileCount{ 0 }
+    {
+        _pScatterDepthPipeline = buildPipeline( pLibrary, "point_scatter_depth" );
+        _pScatterIndexPipeline = buildPipeline( pLibrary, "point_scatter_index" );
+        _pBinCountPipeline = buildPipeline( pLibrary, "point_bin_count" );
+        _pBinPrefixPipeline = buildPipeline( pLibrary, "point_bin_prefix" );
+        _pBinScatterPipeline = buildPipeline( pLibrary, "point_bin_scatter" );
+        _pTileResolvePipeline = buildPipeline( pLibrary, "point_tile_resolve" );
+        _pResolveColorPipeline = buildPipeline( pLibrary, "point_resolve_color" );
+    }
+
+    PointRasterPass::~PointRasterPass()
+    {
+        if ( _pDepthBuffer )
+        {
+            _pDepthBuffer->release();
+            _pIndexBuffer->release();
+            _pTileCountBuffer->release();
+            _pTileOffsetBuffer->release();
+        }
+        if ( _pBinnedPointBuffer )
+        {
+            _pBinnedPointBuffer->release();
+        }
+        _pScatterDepthPipeline->release();
+        _pScatterIndexPipeline->release();
+        _pBinCountPipeline->release();
+        _pBinPrefixPipeline->release();
+        _pBinScatterPipeline->release();
+        _pTileResolvePipeline->release();
+        _pResolveColorPipeline->release();
+        _pDevice->release();
+    }
+
+    void PointRasterPass::resize( uint32_t width, uint32_t height )
+    {
+        if ( width == _width && height == _height )
+        {
+            return;
+        }
+        
+        if ( _pDepthBuffer )
+        {
+            _pDepthBuffer->release();
+            _pIndexBuffer->release();
+            _pTileCountBuffer->release();
+            _pTileOffsetBuffer->release();
+        }
+        
+        _width = width;
+        _height = height;
+        _tilesX = ( width + POINT_RASTER_TILE_SIZE - 1 ) / POINT_RASTER_TILE_SIZE;
+        _tileCount = _tilesX * ( ( height + POINT_RASTER_TILE_SIZE - 1 ) / POINT_RASTER_TILE_SIZE );
+        
+        const NS::UInteger pixelBufferSize = static_cast< NS::UInteger >( width ) * height * sizeof( uint32_t );
+        _pDepthBuffer = _pDevice->newBuffer( pixelBufferSize, MTL::ResourceStorageModePrivate );
+        _pIndexBuffer = _pDevice->newBuffer( pixelBufferSize, MTL::ResourceStorageModePrivate );
+        _pTileCountBuffer = _pDevice->newBuffer( _tileCount * sizeof( uint32_t ), MTL::ResourceStorageModePrivate );
+        _pTileOffsetBuffer = _pDevice->newBuffer( ( _tileCount + 1 ) * sizeof( uint32_t ), MTL::ResourceStorageModePrivate );
+    }
+
+    void PointRasterPass::encodeClear( MTL::CommandBuffer* pCommandBuffer )
+    {
+        assert( _pDepthBuffer );
+        
+        MTL::BlitCommandEncoder* pBlitEncoder = pCommandBuffer->blitCommandEncoder();
+        pBlitEncoder->fillBuffer( _pDepthBuffer, NS::Range::Make( 0, _pDepthBuffer->length() ), 0xFF );
+        pBlitEncoder->fillBuffer( _pIndexBuffer, NS::Range::Make( 0, _pIndexBuffer->length() ), 0xFF );
+        pBlitEncoder->endEncoding();
+    }
+
+    void PointRasterPass::encode( MTL::CommandBuffer* pCommandBuffer,
+                                  MTL::Buffer* pPointBuffer,
+                                  uint32_t pointCount,
+                                  const simd::float4x4& viewProjection,
+                                  PointRasterMode mode )
+    {
+        assert( pCommandBuffer );
+        assert( _pDepthBuffer );
+        
+        if ( pointCount == 0 )
+        {
+            return;
+        }
+        
+        PointRasterUniforms uniforms;
+        uniforms.viewProjection = viewProjection;
+        uniforms.width = _width;
+        uniforms.height = _height;
+        uniforms.tilesX = _tilesX;
+        uniforms.tileCount = _tileCount;
+        uniforms.pointCount = pointCount;
+        
+        if ( mode == PointRasterMode::Scatter )
+        {
+            MTL::ComputeCommandEncoder* pComputeEncoder = pCommandBuffer->computeCommandEncoder();
+            pComputeEncoder->setBuffer( pPointBuffer, 0, 0 );
+            pComputeEncoder->setBytes( &uniforms, sizeof( uniforms ), 1 );
+            pComputeEncoder->setBuffer( _pDepthBuffer, 0, 2 );
+            pComputeEncoder->setBuffer( _pIndexBuffer, 0, 3 );
+            
+            dispatchPoints( pComputeEncoder, _pScatterDepthPipeline, pointCount );
+            dispatchPoints( pComputeEncoder, _pScatterIndexPipeline, pointCount );
+            
+            pComputeEncoder->endEncoding();
+            return;
+        }
+        
+        const NS::UInteger binnedSize = static_cast< NS::UInteger >( pointCount ) * sizeof( BinnedPoint );
+        if ( !_pBinnedPointBuffer || _pBinnedPointBuffer->length() < binnedSize )
+        {
+            if ( _pBinnedPointBuffer )
+            {
+                _pBinnedPointBuffer->release();
+            }
+            _pBinnedPointBuffer = _pDevice->newBuffer( binnedSize, MTL::ResourceStorageModePrivate );
+        }
+        
+        MTL::BlitCommandEncoder* pBlitEncoder = pCommandBuffer->blitCommandEncoder();
+        pBlitEncoder->fillBuffer( _pTileCountBuffer, NS::Range::Make( 0, _pTileCountBuffer->length() ), 0 );
+        pBlitEncoder->endEncoding();
+        
+        MTL::ComputeCommandEncoder* pComputeEncoder = pCommandBuffer->computeCommandEncoder();
+        pComputeEncoder->setBuffer( pPointBuffer, 0, 0 );
+        pComputeEncoder->setBytes( &uniforms, sizeof( uniforms ), 1 );
+        pComputeEncoder->setBuffer( _pTileCountBuffer, 0, 2 );
+        pComputeEncoder->setBuffer( _pTileOffsetBuffer, 0, 3 );
+        pComputeEncoder->setBuffer( _pBinnedPointBuffer, 0, 4 );
+        pComputeEncoder->setBuffer( _pDepthBuffer, 0, 5 );
+        pComputeEncoder->setBuffer( _pIndexBuffer, 0, 6 );
+        
+        dispatchPoints( pComputeEncoder, _pBinCountPipeline, pointCount );
+        
+        pComputeEncoder->setComputePipelineState( _pBinPrefixPipeline );
+        pComputeEncoder->dispatchThreadgroups( MTL::Size( 1, 1, 1 ), MTL::Size( PREFIX_THREADS, 1, 1 ) );
+        
+        dispatchPoints( pComputeEncoder, _pBinScatterPipeline, pointCount );
+        
+        pComputeEncoder->setComputePipelineState( _pTileResolvePipeline );
+        pComputeEncoder->dispatchThreadgroups( MTL::Size( _tileCount, 1, 1 ), MTL::Size( RESOLVE_THREADS, 1, 1 ) );
+        
+        pComputeEncoder->endEncoding();
+    }
+
+    void PointRasterPass::encodeResolve( MTL::CommandBuffer* pCommandBuffer,
+                                         MTL::Buffer* pPointBuffer,
+                                         MTL::Texture* pTarget )
+    {
+        assert( pCommandBuffer );
+        
+        PointRasterUniforms uniforms{};
+        uniforms.width = _width;
+        uniforms.height = _height;
+        
+        MTL::ComputeCommandEncoder* pComputeEncoder = pCommandBuffer->computeCommandEncoder();
+        pComputeEncoder->setComputePipelineState( _pResolveColorPipeline );
+        pComputeEncoder->setBuffer( pPointBuffer, 0, 0 );
+        pComputeEncoder->setBytes( &uniforms, sizeof( uniforms ), 1 );
+        pComputeEncoder->setBuffer( _pIndexBuffer, 0, 6 );
+        pComputeEncoder->setTexture( pTarget, 0 );
+        
+        const NS::UInteger threadGroupX = _pResolveColorPipeline->threadExecutionWidth();
+        const NS::UInteger threadGroupY = _pResolveColorPipeline->maxTotalThreadsPerThreadgroup() / threadGroupX;
+        pComputeEncoder->dispatchThreads( MTL::Size( _width, _height, 1 ), MTL::Size( threadGroupX, threadGroupY, 1 ) );
+        
+        pComputeEncoder->endEncoding();
+    }
+
+    MTL::Buffer* PointRasterPass::getDepthBuffer() const
+    {
+        return _pDepthBuffer;
+    }
+
+    MTL::Buffer* PointRasterPass::getIndexBuffer() const
+    {
+        return _pIndexBuffer;
+    }
+
+    MTL::ComputePipelineState* PointRasterPass::buildPipeline( MTL::Library* pLibrary, const char* functionName )
+    {
+        auto pFunction = NS::TransferPtr< MTL::Function >( pLibrary->newFunction( CreateUTF8String( functionName ) ) );
+        
+        NS::Error* pError = nullptr;
+        MTL::ComputePipelineState* pPipelineState = _pDevice->newComputePipelineState( pFunction.get(), &pError );
+        if ( !pPipelineState )
+        {
+            __builtin_printf( "%s", pError->localizedDescription()->utf8String() );
+            assert( false );
+        }
+        
+        return pPipelineState;
+    }
+
+    void PointRasterPass::dispatchPoints( MTL::ComputeCommandEncoder* pEncoder,
+                                          MTL::ComputePipelineState* pPipeline,
+                                          uint32_t pointCount )
+    {
+        pEncoder->setComputePipelineState( pPipeline );
+        
+        const NS::UInteger threadGroupX = pPipeline->maxTotalThreadsPerThreadgroup();
+        pEncoder->dispatchThreads( MTL::Size( pointCount, 1, 1 ), MTL::Size( threadGroupX, 1, 1 ) );
+    }
+}
@@ -0,0 +1,93 @@
+//
+//  PointRasterPass.hpp
+//  Point_Cloud_Renderer
+//
+//  Created by Vatsalya Yadav on 10/19/26.
+//
+
+#ifndef PointRasterPass_hpp
+#define PointRasterPass_hpp
+
+#include <Metal/Metal.hpp>
+#include <simd/simd.h>
+
+#include "Core/Core.hpp"
+#include "Renderer/PointCloud/PointRasterizer.hpp"
+
+FD_MTL
+
+namespace PCR
+{
+    // Compute-shader point rasterizer, the GPU counterpart of PointRasterizer.
+    // Produces a depth and a point-index buffer per pixel and resolves colors
+    // into a caller-provided texture.
+    class PointRasterPass
+    {
+    public:
+        PointRasterPass( MTL::Device* pDevice, MTL::Library* pLibrary );
+        
+        ~PointRasterPass();
+        
+        void resize( uint32_t width, uint32_t height );
+        
+        // Clears the depth and index buffers, call once per frame before encode.
+        void encodeClear( MTL::CommandBuffer* pCommandBuffer );
+        
+        void encode( MTL::CommandBuffer* pCommandBuffer,
+                     MTL::Buffer* pPointBuffer,
+                     uint32_t pointCount,
+                     const simd::float4x4& viewProjection,
+                     PointRasterMode mode );
+        
+        void encodeResolve( MTL::CommandBuffer* pCommandBuffer,
+                            MTL::Buffer* pPointBuffer,
+                            MTL::Texture* pTarget );
+        
+        MTL::Buffer* getDepthBuffer() const;
+        
+        MTL::Buffer* getIndexBuffer() const;
+        
+    private:
+        MTL::Device* _pDevice;
+        
+        MTL::ComputePipelineState* _pScatterDepthPipeline;
+        
+        MTL::ComputePipelineState* _pScatterIndexPipeline;
+        
+        MTL::ComputePipelineState* _pBinCountPipeline;
+        
+        MTL::ComputePipelineState* _pBinPrefixPipeline;
+        
+        MTL::ComputePipelineState* _pBinScatterPipeline;
+        
+        MTL::ComputePipelineState* _pTileResolvePipeline;
+        
+        MTL::ComputePipelineState* _pResolveColorPipeline;
+        
+        MTL::Buffer* _pDepthBuffer;
+        
+        MTL::Buffer* _pIndexBuffer;
+        
+        MTL::Buffer* _pTileCountBuffer;
+        
+        MTL::Buffer* _pTileOffsetBuffer;
+        
+        MTL::Buffer* _pBinnedPointBuffer;
+        
+        uint32_t _width;
+        
+        uint32_t _height;
+        
+        uint32_t _tilesX;
+        
+        uint32_t _tileCount;
+        
+        MTL::ComputePipelineState* buildPipeline( MTL::Library* pLibrary, const char* functionName );
+        
+        void dispatchPoints( MTL::ComputeCommandEncoder* pEncoder,
+                             MTL::ComputePipelineState* pPipeline,
+                             uint32_t pointCount );
+    };
+}
+
+#endif /* PointRasterPass_hpp */
@@ -0,0 +1,347 @@
+//
+//  PointRasterizer.cpp
+//  Point_Cloud_Renderer
+//
+//  Created by Vatsalya Yadav on 10/19/26.
+//
+
+#include "PointRasterizer.hpp"
+
+#include <algorithm>
+#include <chrono>
+#include <cstring>
+
+#include "Renderer/Threading/WorkerPool.hpp"
+
+namespace PCR
+{
+    namespace
+    {
+        constexpr uint32_t INVALID_TILE{ UINT32_MAX };
+        
+        constexpr size_t MIN_POINTS_PER_BLOCK{ 16 * 1024 };
+        
+        using Clock = std::chrono::steady_clock;
+        
+        double elapsedMs( Clock::time_point start, Clock::time_point end )
+        {
+            return std::chrono::duration< double, std::milli >( end - start ).count();
+        }
+        
+        void atomicMin( std::atomic< uint64_t >& target, uint64_t value )
+        {
+            uint64_t current = target.load( std::memory_order_relaxed );
+            while ( value < current && !target.compare_exchange_weak( current, value, std::memory_order_relaxed ) )
+            { }
+        }
+    }
+
+    PointRasterizer::PointRasterizer( uint32_t width, uint32_t height, WorkerPool& workerPool )
+    :   _workerPool{ workerPool }
+    ,   _width{ 0 }
+    ,   _height{ 0 }
+    ,   _tilesX{ 0 }
+    ,   _tilesY{ 0 }
+    {
+        resize( width, height );
+    }
+
+    void PointRasterizer::resize( uint32_t width, uint32_t height )
+    {
+        _width = width;
+        _height = height;
+        _tilesX = ( width + POINT_RASTER_TILE_SIZE - 1 ) / POINT_RASTER_TILE_SIZE;
+        _tilesY = ( height + POINT_RASTER_TILE_SIZE - 1 ) / POINT_RASTER_TILE_SIZE;
+        _framebuffer = std::make_unique< std::atomic< uint64_t >[] >( static_cast< size_t >( width ) * height );
+        clear();
+    }
+
+    void PointRasterizer::clear()
+    {
+        const size_t pixelCount = static_cast< size_t >( _width ) * _height;
+        _workerPool.parallelFor( pixelCount, 64 * 1024, [ this ]( size_t begin, size_t end, uint32_t ){
+            for ( size_t i = begin; i < end; ++i )
+            {
+                _framebuffer[ i ].store( EMPTY_PIXEL, std::memory_order_relaxed );
+            }
+        } );
+    }
+
+    void PointRasterizer::rasterize( const PointData* pPoints,
+                                     size_t pointCount,
+                                     const simd::float4x4& viewProjection,
+                                     PointRasterMode mode )
+    {
+        rasterize( pPoints, nullptr, pointCount, viewProjection, mode );
+    }
+
+    void PointRasterizer::rasterize( const PointData* pPoints,
+                                     const uint32_t* pIndices,
+                                     size_t indexCount,
+                                     const simd::float4x4& viewProjection,
+                                     PointRasterMode mode )
+    {
+        _stats = PointRasterStats{};
+        
+        const auto start = Clock::now();
+        
+        if ( mode == PointRasterMode::Binned )
+        {
+            rasterizeBinned( pPoints, pIndices, indexCount, viewProjection );
+        }
+        else
+        {
+            rasterizeScatter( pPoints, pIndices, indexCount, viewProjection );
+        }
+        
+        _stats.totalMs = elapsedMs( start, Clock::now() );
+    }
+
+    void PointRasterizer::resolve( const PointData* pPoints, uint32_t* pColors, uint32_t clearColor ) const
+    {
+        const size_t pixelCount = static_cast< size_t >( _width ) * _height;
+        _workerPool.parallelFor( pixelCount, 64 * 1024, [ & ]( size_t begin, size_t end, uint32_t ){
+            for ( size_t i = begin; i < end; ++i )
+            {
+                const uint64_t pixel = _framebuffer[ i ].load( std::memory_order_relaxed );
+                pColors[ i ] = ( pixel == EMPTY_PIXEL ) ? clearColor : pPoints[ getPointIndex( pixel ) ].color;
+            }
+        } );
+    }
+
+    uint64_t PointRasterizer::getPixel( uint32_t x, uint32_t y ) const
+    {
+        return _framebuffer[ static_cast< size_t >( y ) * _width + x ].load( std::memory_order_relaxed );
+    }
+
+    uint32_t PointRasterizer::getWidth() const
+    {
+        return _width;
+    }
+
+    uint32_t PointRasterizer::getHeight() const
+    {
+        return _height;
+    }
+
+    const PointRasterStats& PointRasterizer::getStats() const
+    {
+        return _stats;
+    }
+
+    uint32_t PointRasterizer::getPointIndex( uint64_t pixel )
+    {
+        return static_cast< uint32_t >( pixel & 0xFFFFFFFFull );
+    }
+
+    float PointRasterizer::getDepth( uint64_t pixel )
+    {
+        const auto depthBits = static_cast< uint32_t >( pixel >> 32 );
+        float depth;
+        memcpy( &depth, &depthBits, sizeof( float ) );
+        return depth;
+    }
+
+    bool PointRasterizer::projectPoint( const PointData& point,
+                                        uint32_t pointIndex,
+                                        const simd::float4x4& viewProjection,
+                                        BinnedSample& outSample ) const
+    {
+        const simd::float4 clip = viewProjection * simd::float4{ point.position.x, point.position.y, point.position.z, 1.0f };
+        if ( clip.w <= 0.0f )
+        {
+            return false;
+        }
+        
+        const float invW = 1.0f / clip.w;
+        const float ndcX = clip.x * invW;
+        const float ndcY = clip.y * invW;
+        const float depth = clip.z * invW;
+        if ( ndcX < -1.0f || ndcX >= 1.0f || ndcY <= -1.0f || ndcY > 1.0f || depth < 0.0f || depth > 1.0f )
+        {
+            return false;
+        }
+        
+        // Metal NDC has +y up, texture rows go down
+        const auto x = std::min( static_cast< uint32_t >( ( ndcX * 0.5f + 0.5f ) * _width ), _width - 1 );
+        const auto y = std::min( static_cast< uint32_t >( ( 0.5f - ndcY * 0.5f ) * _height ), _height - 1 );
+        
+        // Positive floats keep their order when compared as integers
+        uint32_t depthBits;
+        memcpy( &depthBits, &depth, sizeof( float ) );
+        
+        outSample.pixel = y * _width + x;
+        outSample.value = ( static_cast< uint64_t >( depthBits ) << 32 ) | pointIndex;
+        return true;
+    }
+
+    void PointRasterizer::rasterizeScatter( const PointData* pPoints,
+                                            const uint32_t* pIndices,
+                                            size_t pointCount,
+                                            const simd::float4x4& viewProjection )
+    {
+        std::atomic< size_t > visiblePoints{ 0 };
+        
+        const auto start = Clock::now();
+        
+        _workerPool.parallelFor( pointCount, MIN_POINTS_PER_BLOCK, [ & ]( size_t begin, size_t end, uint32_t ){
+            size_t visible = 0;
+            BinnedSample sample;
+            for ( size_t i = begin; i < end; ++i )
+            {
+                const uint32_t pointIndex = pIndices ? pIndices[ i ] : static_cast< uint32_t >( i );
+                if ( projectPoint( pPoints[ pointIndex ], pointIndex, viewProjection, sample ) )
+                {
+                    atomicMin( _framebuffer[ sample.pixel ], sample.value );
+                    ++visible;
+                }
+            }
+            visiblePoints.fetch_add( visible, std::memory_order_relaxed );
+        } );
+        
+        // Projection and the framebuffer writes are interleaved, there is nothing to split
+        _stats.projectMs = elapsedMs( start, Clock::now() );
+        _stats.visiblePoints = visiblePoints.load();
+    }
+
+    void PointRasterizer::rasterizeBinned( const PointData* pPoints,
+                                           const uint32_t* pIndices,
+                                           size_t pointCount,
+                                           const simd::float4x4& viewProjection )
+    {
+        const uint32_t tileCount = _tilesX * _tilesY;
+        
+        // Fixed block partition so the counting and scattering passes see the same
+        // points per histogram, whichever thread happens to pick the block up.
+        const size_t blockCount = std::max< size_t >( 1, std::min< size_t >( _workerPool.getWorkerCount() * 4,
+                                                                            pointCount / MIN_POINTS_PER_BLOCK ) );
+        const size_t pointsPerBlock = ( pointCount + blockCount - 1 ) / blockCount;
+        
+        _projected.resize( pointCount );
+        _pointTiles.resize( pointCount );
+        _blockHistograms.assign( blockCount * tileCount, 0 );
+        _tileOffsets.resize( tileCount + 1 );
+        
+        // Project and count
+        
+        auto phaseStart = Clock::now();
+        
+        _workerPool.parallelFor( blockCount, 1, [ & ]( size_t blockBegin, size_t blockEnd, uint32_t ){
+            for ( size_t block = blockBegin; block < blockEnd; ++block )
+            {
+                uint32_t* pHistogram = &_blockHistograms[ block * tileCount ];
+                const size_t end = std::min( pointCount, ( block + 1 ) * pointsPerBlock );
+                for ( size_t i = block * pointsPerBlock; i < end; ++i )
+                {
+                    const uint32_t pointIndex = pIndices ? pIndices[ i ] : static_cast< uint32_t >( i );
+                    BinnedSample& sample = _projected[ i ];
+                    if ( !projectPoint( pPoints[ pointIndex ], pointIndex, viewProjection, sample ) )
+                    {
+                        _pointTiles[ i ] = INVALID_TILE;
+                        continue;
+                    }
+                    
+                    const uint32_t tileX = ( sample.pixel % _width ) / POINT_RASTER_TILE_SIZE;
+                    const uint32_t tileY = ( sample.pixel / _width ) / POINT_RASTER_TILE_SIZE;
+                    const uint32_t tile = tileY * _tilesX + tileX;
+                    _pointTiles[ i ] = tile;
+                    ++pHistogram[ tile ];
+                }
+            }
+        } );
+        
+        auto phaseEnd = Clock::now();
+        _stats.projectMs = elapsedMs( phaseStart, phaseEnd );
+        phaseStart = phaseEnd;
+        
+        // Exclusive prefix sum, tile-major so each tile's points end up contiguous.
+        // The histograms are turned into per-block write cursors in place.
+        
+        uint32_t running = 0;
+        for ( uint32_t tile = 0; tile < tileCount; ++tile )
+        {
+            _tileOffsets[ tile ] = running;
+            for ( size_t block = 0; block < blockCount; ++block )
+            {
+                uint32_t& count = _blockHistograms[ block * tileCount + tile ];
+                const uint32_t blockPoints = count;
+                count = running;
+                running += blockPoints;
+            }
+        }
+        _tileOffsets[ tileCount ] = running;
+        _stats.visiblePoints = running;
+        
+        _binned.resize( running );
+        
+        _workerPool.parallelFor( blockCount, 1, [ & ]( size_t blockBegin, size_t blockEnd, uint32_t ){
+            for ( size_t block = blockBegin; block < blockEnd; ++block )
+            {
+                uint32_t* pCursors = &_blockHistograms[ block * tileCount ];
+                const size_t end = std::min( pointCount, ( block + 1 ) * pointsPerBlock );
+                for ( size_t i = block * pointsPerBlock; i < end; ++i )
+                {
+                    const uint32_t tile = _pointTiles[ i ];
+                    if ( tile != INVALID_TILE )
+                    {
+                        _binned[ pCursors[ tile ]++ ] = _projected[ i ];
+                    }
+                }
+            }
+        } );
+        
+        phaseEnd = Clock::now();
+        _stats.binMs = elapsedMs( phaseStart, phaseEnd );
+        phaseStart = phaseEnd;
+        
+        // Resolve every tile in a local buffer that stays in L1
+        
+        _workerPool.parallelFor( tileCount, 4, [ & ]( size_t tileBegin, size_t tileEnd, uint32_t ){
+            uint64_t localTile[ POINT_RASTER_TILE_PIXELS ];
+            
+            for ( size_t tile = tileBegin; tile < tileEnd; ++tile )
+            {
+                const uint32_t first = _tileOffsets[ tile ];
+                const uint32_t last = _tileOffsets[ tile + 1 ];
+                if ( first == last )
+                {
+                    continue;
+                }
+                
+                const uint32_t originX = static_cast< uint32_t >( tile % _tilesX ) * POINT_RASTER_TILE_SIZE;
+                const uint32_t originY = static_cast< uint32_t >( tile / _tilesX ) * POINT_RASTER_TILE_SIZE;
+                const uint32_t tileWidth = std::min( POINT_RASTER_TILE_SIZE, _width - originX );
+                const uint32_t tileHeight = std::min( POINT_RASTER_TILE_SIZE, _height - originY );
+                
+                for ( uint32_t y = 0; y < tileHeight; ++y )
+                {
+                    const size_t row = static_cast< size_t >( originY + y ) * _width + originX;
+                    for ( uint32_t x = 0; x < tileWidth; ++x )
+                    {
+                        localTile[ y * POINT_RASTER_TILE_SIZE + x ] = _framebuffer[ row + x ].load( std::memory_order_relaxed );
+                    }
+                }
+                
+                for ( uint32_t i = first; i < last; ++i )
+                {
+                    const BinnedSample& sample = _binned[ i ];
+                    const uint32_t x = ( sample.pixel % _width ) - originX;
+                    const uint32_t y = ( sample.pixel / _width ) - originY;
+                    uint64_t& local = localTile[ y * POINT_RASTER_TILE_SIZE + x ];
+                    local = std::min( local, sample.value );
+                }
+                
+                for ( uint32_t y = 0; y < tileHeight; ++y )
+                {
+                    const size_t row = static_cast< size_t >( originY + y ) * _width + originX;
+                    for ( uint32_t x = 0; x < tileWidth; ++x )
+                    {
+                        _framebuffer[ row + x ].store( localTile[ y * POINT_RASTER_TILE_SIZE + x ], std::memory_order_relaxed );
+                    }
+                }
+            }
+        } );
+        
+        _stats.resolveMs = elapsedMs( phaseStart, Clock::now() );
+    }
+}
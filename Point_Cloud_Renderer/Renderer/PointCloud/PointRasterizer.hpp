@@ -0,0 +1,138 @@
+//
+//  PointRasterizer.hpp
+//  Point_Cloud_Renderer
+//
+//  Created by Vatsalya Yadav on 10/19/26.
+//
+
+#ifndef PointRasterizer_hpp
+#define PointRasterizer_hpp
+
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+#include <simd/simd.h>
+
+#include "Renderer/Data/Constants.hpp"
+#include "Renderer/Structures/PointData.hpp"
+
+namespace PCR
+{
+    class WorkerPool;
+
+    enum class PointRasterMode
+    {
+        // Every point does an atomic min straight into the full framebuffer.
+        Scatter,
+        
+        // Points are counting-sorted into screen tiles first, then every tile is
+        // resolved in a small local buffer without atomics.
+        Binned
+    };
+
+    struct PointRasterStats
+    {
+        double projectMs = 0.0;
+        
+        double binMs = 0.0;
+        
+        double resolveMs = 0.0;
+        
+        double totalMs = 0.0;
+        
+        size_t visiblePoints = 0;
+    };
+
+    // CPU reference rasterizer for point clouds. Each pixel holds a 64-bit value with
+    // the depth bits on top and the point index below, so a plain integer min is a
+    // depth test and the winning point can be looked up afterwards.
+    class PointRasterizer
+    {
+    public:
+        static constexpr uint64_t EMPTY_PIXEL{ UINT64_MAX };
+        
+        PointRasterizer( uint32_t width, uint32_t height, WorkerPool& workerPool );
+        
+        void resize( uint32_t width, uint32_t height );
+        
+        void clear();
+        
+        void rasterize( const PointData* pPoints,
+                        size_t pointCount,
+                        const simd::float4x4& viewProjection,
+                        PointRasterMode mode );
+        
+        // Rasterizes only pPoints[ pIndices[ 0 .. indexCount ) ], pixels keep the original point index.
+        void rasterize( const PointData* pPoints,
+                        const uint32_t* pIndices,
+                        size_t indexCount,
+                        const simd::float4x4& viewProjection,
+                        PointRasterMode mode );
+        
+        // Writes one RGBA8 value per pixel into pColors.
+        void resolve( const PointData* pPoints, uint32_t* pColors, uint32_t clearColor ) const;
+        
+        uint64_t getPixel( uint32_t x, uint32_t y ) const;
+        
+        uint32_t getWidth() const;
+        
+        uint32_t getHeight() const;
+        
+        const PointRasterStats& getStats() const;
+        
+        static uint32_t getPointIndex( uint64_t pixel );
+        
+        static float getDepth( uint64_t pixel );
+        
+    private:
+        struct BinnedSample
+        {
+            uint32_t pixel;
+            
+            uint64_t value;
+        };
+        
+        WorkerPool& _workerPool;
+        
+        uint32_t _width;
+        
+        uint32_t _height;
+        
+        uint32_t _tilesX;
+        
+        uint32_t _tilesY;
+        
+        std::unique_ptr< std::atomic< uint64_t >[] > _framebuffer;
+        
+        std::vector< BinnedSample > _projected;
+        
+        std::vector< uint32_t > _pointTiles;
+        
+        std::vector< uint32_t > _blockHistograms;
+        
+        std::vector< uint32_t > _tileOffsets;
+        
+        std::vector< BinnedSample > _binned;
+        
+        PointRasterStats _stats;
+        
+        bool projectPoint( const PointData& point,
+                           uint32_t pointIndex,
+                           const simd::float4x4& viewProjection,
+                           BinnedSample& outSample ) const;
+        
+        void rasterizeScatter( const PointData* pPoints,
+                               const uint32_t* pIndices,
+                               size_t pointCount,
+                               const simd::float4x4& viewProjection );
+        
+        void rasterizeBinned( const PointData* pPoints,
+                              const uint32_t* pIndices,
+                              size_t pointCount,
+                              const simd::float4x4& viewProjection );
+    };
+}
+
+#endif /* PointRasterizer_hpp */
@@ -0,0 +1,261 @@
+//
+//  PointReprojectionCheck.cpp
+//  Point_Cloud_Renderer
+//
+//  Created by Vatsalya Yadav on 10/19/26.
+//
+
+#include "PointReprojectionCheck.hpp"
+
+#include <unordered_set>
+#include <vector>
+
+#include "Math/Utility.hpp"
+#include "Renderer/PointCloud/PointReprojector.hpp"
+#include "Renderer/Threading/WorkerPool.hpp"
+#include "Renderer/Validation/CheckReport.hpp"
+
+namespace PCR
+{
+    namespace
+    {
+        // One background point per pixel, row-major, so node n is rows 32n to 32n + 31
+        constexpr uint32_t SIZE{ 128 };
+        
+        constexpr uint32_t BACKGROUND_COUNT{ SIZE * SIZE };
+        
+        constexpr uint32_t OCCLUDER_X{ 40 };
+        
+        constexpr uint32_t OCCLUDER_Y{ 16 };
+        
+        constexpr uint32_t OCCLUDER_WIDTH{ 32 };
+        
+        // Spans all four background nodes
+        constexpr uint32_t OCCLUDER_HEIGHT{ 96 };
+        
+        constexpr uint32_t OCCLUDER_SHIFT{ 3 };
+        
+        constexpr uint32_t ROWS_PER_NODE{ POINT_NODE_SIZE / SIZE };
+        
+        constexpr uint32_t WORKER_COUNT{ 4 };
+        
+        // The camera matrices are identity, positions are NDC x and y and depth
+        PointData makePoint( uint32_t x, uint32_t y, float depth )
+        {
+            const float ndcX = ( x + 0.5f ) / SIZE * 2.0f - 1.0f;
+            const float ndcY = 1.0f - ( y + 0.5f ) / SIZE * 2.0f;
+            return PointData{ simd::float3{ ndcX, ndcY, depth }, 0xFF000000u | ( x << 8 ) | y };
+        }
+        
+        // Background first, then the occluder starting occluderX pixels from the left
+        std::vector< PointData > makeScene( uint32_t occluderX )
+        {
+            std::vector< PointData > points;
+            for ( uint32_t y = 0; y < SIZE; ++y )
+            {
+                for ( uint32_t x = 0; x < SIZE; ++x )
+                {
+                    points.push_back( makePoint( x, y, 0.8f ) );
+                }
+            }
+            for ( uint32_t y = 0; y < OCCLUDER_HEIGHT; ++y )
+            {
+                for ( uint32_t x = 0; x < OCCLUDER_WIDTH; ++x )
+                {
+                    points.push_back( makePoint( occluderX + x, OCCLUDER_Y + y, 0.4f ) );
+                }
+            }
+            return points;
+        }
+        
+        CameraData makeCamera( float offsetX )
+        {
+            CameraData camera;
+            camera.perspectiveTransform = Math::makeIdentity();
+            camera.worldTransform = Math::makeTranslate( simd::float3{ offsetX, 0.0f, 0.0f } );
+            camera.worldNormalTransform = Math::discardTranslation( camera.worldTransform );
+            return camera;
+        }
+        
+        bool inUncoveredColumns( uint32_t x, uint32_t y )
+        {
+            return x >= OCCLUDER_X && x < OCCLUDER_X + OCCLUDER_SHIFT && y >= OCCLUDER_Y && y < OCCLUDER_Y + OCCLUDER_HEIGHT;
+        }
+        
+        size_t countEmptyPixels( const PointRasterizer& rasterizer )
+        {
+            size_t empty = 0;
+            for ( uint32_t y = 0; y < SIZE; ++y )
+            {
+                for ( uint32_t x = 0; x < SIZE; ++x )
+                {
+                    empty += rasterizer.getPixel( x, y ) == PointRasterizer::EMPTY_PIXEL;
+                }
+            }
+            return empty;
+        }
+        
+        // Holes left in the uncovered columns are exactly the rows no refresh has reached yet
+        bool holesBelow( const PointRasterizer& rasterizer, uint32_t filledRows )
+        {
+            for ( uint32_t y = 0; y < SIZE; ++y )
+            {
+                for ( uint32_t x = 0; x < SIZE; ++x )
+                {
+                    const bool hole = inUncoveredColumns( x, y ) && y >= filledRows;
+                    if ( ( rasterizer.getPixel( x, y ) == PointRasterizer::EMPTY_PIXEL ) != hole )
+                    {
+                        return false;
+                    }
+                }
+            }
+            return true;
+        }
+        
+        // Last frame's winners plus every point in slice's nodes
+        size_t countDistinctDrawn( const PointRasterizer& rasterizer, size_t pointCount, uint32_t slice )
+        {
+            std::unordered_set< uint32_t > drawn;
+            for ( uint32_t y = 0; y < SIZE; ++y )
+            {
+                for ( uint32_t x = 0; x < SIZE; ++x )
+                {
+                    const uint64_t pixel = rasterizer.getPixel( x, y );
+                    if ( pixel != PointRasterizer::EMPTY_PIXEL )
+                    {
+                        drawn.insert( PointRasterizer::getPointIndex( pixel ) );
+                    }
+                }
+            }
+            for ( uint32_t i = 0; i < pointCount; ++i )
+            {
+                if ( ( i / POINT_NODE_SIZE ) % REPROJECTION_REFRESH_PERIOD == slice )
+                {
+                    drawn.insert( i );
+                }
+            }
+            return drawn.size();
+        }
+        
+        bool masksUncoveredColumns( const std::vector< uint8_t >& mask )
+        {
+            for ( uint32_t y = 0; y < SIZE; ++y )
+            {
+                for ( uint32_t x = 0; x < SIZE; ++x )
+                {
+                    if ( ( mask[ y * SIZE + x ] != 0 ) != inUncoveredColumns( x, y ) )
+                    {
+                        return false;
+                    }
+                }
+            }
+            return true;
+        }
+        
+        bool isEmpty( const std::vector< uint8_t >& mask )
+        {
+            for ( uint8_t value : mask )
+            {
+                if ( value )
+                {
+                    return false;
+                }
+            }
+            return true;
+        }
+        
+        bool matchesFullRender( const PointRasterizer& rasterizer, const std::vector< PointData >& points, WorkerPool& workerPool )
+        {
+            PointRasterizer reference( SIZE, SIZE, workerPool );
+            reference.rasterize( points.data(), points.size(), Math::makeIdentity(), PointRasterMode::Binned );
+            for ( uint32_t y = 0; y < SIZE; ++y )
+            {
+                for ( uint32_t x = 0; x < SIZE; ++x )
+                {
+                    if ( rasterizer.getPixel( x, y ) != reference.getPixel( x, y ) )
+                    {
+                        return false;
+                    }
+                }
+            }
+            return true;
+        }
+    }
+
+    bool runPointReprojectionChecks()
+    {
+        CheckReport report( "Point reprojection, 128x128 background and a moving occluder" );
+        
+        WorkerPool workerPool( WORKER_COUNT );
+        PointRasterizer rasterizer( SIZE, SIZE, workerPool );
+        PointReprojector reprojector( rasterizer );
+        
+        const CameraData camera = makeCamera( 0.0f );
+        std::vector< PointData > points = makeScene( OCCLUDER_X );
+        const size_t occluderCount = OCCLUDER_WIDTH * OCCLUDER_HEIGHT;
+        const size_t uncoveredCount = OCCLUDER_SHIFT * OCCLUDER_HEIGHT;
+        
+        reprojector.render( points.data(), points.size(), camera, PointRasterMode::Binned );
+        const ReprojectionStats first = reprojector.getStats();
+        report.expect( first.fullRefresh && first.pointsDrawn == points.size() && countEmptyPixels( rasterizer ) == 0 && isEmpty( reprojector.getDisocclusionMask() ),
+                       "first frame: every point is drawn and nothing is disoccluded" );
+        
+        // The occluder moves right, its old left edge shows background nobody drew last frame
+        
+        points = makeScene( OCCLUDER_X + OCCLUDER_SHIFT );
+        const size_t expectedDrawn = countDistinctDrawn( rasterizer, points.size(), 0 );
+        reprojector.render( points.data(), points.size(), camera, PointRasterMode::Binned );
+        const ReprojectionStats moved = reprojector.getStats();
+        report.expect( !moved.fullRefresh && moved.reprojectedPoints == BACKGROUND_COUNT && moved.validPoints == BACKGROUND_COUNT - uncoveredCount,
+                       "move: every covered pixel's point is reprojected, the ones under the occluder's new columns lose" );
+        report.expect( moved.disoccludedPixels == uncoveredCount && masksUncoveredColumns( reprojector.getDisocclusionMask() ),
+                       "move: the mask is exactly the columns the occluder left" );
+        report.expect( moved.refreshedPoints == POINT_NODE_SIZE + occluderCount, "move: slice 0 redraws background node 0 and the occluder's node" );
+        report.expect( moved.pointsDrawn == expectedDrawn && moved.pointsDrawn < moved.reprojectedPoints + moved.refreshedPoints,
+                       "move: points drawn by both the warp and the refresh count once" );
+        report.expect( holesBelow( rasterizer, ROWS_PER_NODE ), "move: node 0's rows of the uncovered columns are filled in, the rest are holes" );
+        
+        // The occluder stays put, one more node of the holes is refreshed every frame
+        
+        bool noFurtherDisocclusions = true;
+        bool holesShrinkByNode = true;
+        bool oneNodePerFrame = true;
+        for ( uint32_t slice = 1; slice < REPROJECTION_REFRESH_PERIOD; ++slice )
+        {
+            reprojector.render( points.data(), points.size(), camera, PointRasterMode::Binned );
+            const ReprojectionStats& stats = reprojector.getStats();
+            noFurtherDisocclusions = noFurtherDisocclusions && stats.disoccludedPixels == 0 && isEmpty( reprojector.getDisocclusionMask() );
+            oneNodePerFrame = oneNodePerFrame && stats.refreshedPoints == POINT_NODE_SIZE;
+            holesShrinkByNode = holesShrinkByNode && holesBelow( rasterizer, ( slice + 1 ) * ROWS_PER_NODE );
+        }
+        report.expect( noFurtherDisocclusions, "settle: holes that were already empty aren't marked again" );
+        report.expect( oneNodePerFrame, "settle: slices 1 to 3 redraw one background node each" );
+        report.expect( holesShrinkByNode, "settle: each frame fills in the next node's rows" );
+        report.expect( matchesFullRender( rasterizer, points, workerPool ), "settle: after a full rotation the image equals a full render" );
+        
+        reprojector.render( points.data(), points.size(), camera, PointRasterMode::Binned );
+        report.expect( reprojector.getStats().refreshedPoints == POINT_NODE_SIZE + occluderCount, "settle: the rotation wraps back to slice 0" );
+        
+        // A camera cut leaves nothing of last frame on screen
+        
+        reprojector.render( points.data(), points.size(), makeCamera( 10.0f ), PointRasterMode::Binned );
+        const ReprojectionStats cut = reprojector.getStats();
+        report.expect( !cut.fullRefresh && cut.validPoints == 0 && cut.getValidRatio() == 0.0f, "cut: no reprojected point survives" );
+        
+        reprojector.render( points.data(), points.size(), camera, PointRasterMode::Binned );
+        const ReprojectionStats recovered = reprojector.getStats();
+        report.expect( recovered.fullRefresh && recovered.pointsDrawn == points.size() && matchesFullRender( rasterizer, points, workerPool ),
+                       "cut: the next frame falls back to a full render" );
+        
+        reprojector.invalidate();
+        reprojector.render( points.data(), points.size(), camera, PointRasterMode::Binned );
+        report.expect( reprojector.getStats().fullRefresh, "invalidate: forces a full render" );
+        
+        // Full renders at the start, after the cut and after invalidate
+        const ReprojectionTotals& totals = reprojector.getTotals();
+        report.expect( totals.frames == 9 && totals.fullRefreshes == 3 && totals.pointCount == 9 * points.size(),
+                       "totals: every render and full refresh is counted" );
+        
+        return report.finish();
+    }
+}
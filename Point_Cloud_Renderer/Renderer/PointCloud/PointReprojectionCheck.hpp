@@ -0,0 +1,21 @@
+//
+//  PointReprojectionCheck.hpp
+//  Point_Cloud_Renderer
+//
+//  Created by Vatsalya Yadav on 10/19/26.
+//
+
+#ifndef PointReprojectionCheck_hpp
+#define PointReprojectionCheck_hpp
+
+namespace PCR
+{
+    // PointReprojector on a background plane with an occluder in front that moves a few
+    // pixels: the uncovered pixels are marked as disocclusions and nothing else is, the
+    // rotating refresh fills them in one node slice per frame until the image equals a full
+    // render, pointsDrawn counts distinct points, and a camera cut falls back to a full render.
+    // Returns false if any check fails.
+    bool runPointReprojectionChecks();
+}
+
+#endif /* PointReprojectionCheck_hpp */
@@ -0,0 +1,191 @@
+//
+//  PointReprojector.cpp
+//  Point_Cloud_Renderer
+//
+//  Created by Vatsalya Yadav on 10/19/26.
+//
+
+#include "PointReprojector.hpp"
+
+#include <algorithm>
+
+namespace PCR
+{
+    PointReprojector::PointReprojector( PointRasterizer& rasterizer )
+    :   _rasterizer{ rasterizer }
+    ,   _refreshSlice{ 0 }
+    ,   _minValidRatio{ 0.5f }
+    ,   _hasHistory{ false }
+    { }
+
+    void PointReprojector::invalidate()
+    {
+        _hasHistory = false;
+    }
+
+    void PointReprojector::render( const PointData* pPoints,
+                                   size_t pointCount,
+                                   const CameraData& cameraData,
+                                   PointRasterMode mode )
+    {
+        const simd::float4x4 viewProjection = cameraData.perspectiveTransform * cameraData.worldTransform;
+        
+        const uint32_t width = _rasterizer.getWidth();
+        const uint32_t height = _rasterizer.getHeight();
+        const size_t pixelCount = static_cast< size_t >( width ) * height;
+        
+        const bool historyUsable = _hasHistory
+                                && _previousCoverage.size() == pixelCount
+                                && ( _stats.fullRefresh || _stats.getValidRatio() >= _minValidRatio );
+        
+        _stats = ReprojectionStats{};
+        _disocclusionMask.assign( pixelCount, 0 );
+        
+        if ( !historyUsable )
+        {
+            renderFull( pPoints, pointCount, viewProjection, mode );
+            addToTotals( pointCount );
+            return;
+        }
+        
+        // Gather last frame's winners. The ones in this frame's refresh slice get drawn
+        // twice, they only count once towards pointsDrawn.
+        
+        _drawList.clear();
+        size_t reprojectedOutsideSlice = 0;
+        for ( uint32_t y = 0; y < height; ++y )
+        {
+            for ( uint32_t x = 0; x < width; ++x )
+            {
+                const uint64_t pixel = _rasterizer.getPixel( x, y );
+                const uint32_t pointIndex = PointRasterizer::getPointIndex( pixel );
+                if ( pixel != PointRasterizer::EMPTY_PIXEL && pointIndex < pointCount )
+                {
+                    _drawList.push_back( pointIndex );
+                    if ( ( pointIndex / POINT_NODE_SIZE ) % REPROJECTION_REFRESH_PERIOD != _refreshSlice )
+                    {
+                        ++reprojectedOutsideSlice;
+                    }
+                }
+            }
+        }
+        _stats.reprojectedPoints = _drawList.size();
+        
+        _rasterizer.clear();
+        _rasterizer.rasterize( pPoints, _drawList.data(), _drawList.size(), viewProjection, mode );
+        
+        // Every point lands in at most one pixel, so covered pixels == surviving points
+        
+        size_t pixelIndex = 0;
+        for ( uint32_t y = 0; y < height; ++y )
+        {
+            for ( uint32_t x = 0; x < width; ++x, ++pixelIndex )
+            {
+                const bool covered = _rasterizer.getPixel( x, y ) != PointRasterizer::EMPTY_PIXEL;
+                if ( covered )
+                {
+                    ++_stats.validPoints;
+                }
+                else if ( _previousCoverage[ pixelIndex ] )
+                {
+                    _disocclusionMask[ pixelIndex ] = 1;
+                    ++_stats.disoccludedPixels;
+                }
+            }
+        }
+        
+        // Refresh this frame's slice of nodes
+        
+        _drawList.clear();
+        const size_t nodeCount = ( pointCount + POINT_NODE_SIZE - 1 ) / POINT_NODE_SIZE;
+        for ( size_t node = _refreshSlice; node < nodeCount; node += REPROJECTION_REFRESH_PERIOD )
+        {
+            const size_t first = node * POINT_NODE_SIZE;
+            const size_t last = std::min( pointCount, first + POINT_NODE_SIZE );
+            for ( size_t i = first; i < last; ++i )
+            {
+                _drawList.push_back( static_cast< uint32_t >( i ) );
+            }
+        }
+        _refreshSlice = ( _refreshSlice + 1 ) % REPROJECTION_REFRESH_PERIOD;
+        
+        _rasterizer.rasterize( pPoints, _drawList.data(), _drawList.size(), viewProjection, mode );
+        
+        _stats.refreshedPoints = _drawList.size();
+        _stats.pointsDrawn = reprojectedOutsideSlice + _stats.refreshedPoints;
+        
+        pixelIndex = 0;
+        for ( uint32_t y = 0; y < height; ++y )
+        {
+            for ( uint32_t x = 0; x < width; ++x, ++pixelIndex )
+            {
+                _previousCoverage[ pixelIndex ] = _rasterizer.getPixel( x, y ) != PointRasterizer::EMPTY_PIXEL;
+            }
+        }
+        
+        addToTotals( pointCount );
+    }
+
+    void PointReprojector::setMinValidRatio( float minValidRatio )
+    {
+        _minValidRatio = minValidRatio;
+    }
+
+    const ReprojectionStats& PointReprojector::getStats() const
+    {
+        return _stats;
+    }
+
+    const ReprojectionTotals& PointReprojector::getTotals() const
+    {
+        return _totals;
+    }
+
+    void PointReprojector::resetTotals()
+    {
+        _totals = ReprojectionTotals{};
+    }
+
+    const std::vector< uint8_t >& PointReprojector::getDisocclusionMask() const
+    {
+        return _disocclusionMask;
+    }
+
+    void PointReprojector::addToTotals( size_t pointCount )
+    {
+        ++_totals.frames;
+        _totals.fullRefreshes += _stats.fullRefresh;
+        _totals.reprojectedPoints += _stats.reprojectedPoints;
+        _totals.validPoints += _stats.validPoints;
+        _totals.disoccludedPixels += _stats.disoccludedPixels;
+        _totals.pointsDrawn += _stats.pointsDrawn;
+        _totals.pointCount += pointCount;
+    }
+
+    void PointReprojector::renderFull( const PointData* pPoints,
+                                       size_t pointCount,
+                                       const simd::float4x4& viewProjection,
+                                       PointRasterMode mode )
+    {
+        _rasterizer.clear();
+        _rasterizer.rasterize( pPoints, pointCount, viewProjection, mode );
+        
+        const uint32_t width = _rasterizer.getWidth();
+        const uint32_t height = _rasterizer.getHeight();
+        _previousCoverage.resize( static_cast< size_t >( width ) * height );
+        
+        size_t pixelIndex = 0;
+        for ( uint32_t y = 0; y < height; ++y )
+        {
+            for ( uint32_t x = 0; x < width; ++x, ++pixelIndex )
+            {
+                _previousCoverage[ pixelIndex ] = _rasterizer.getPixel( x, y ) != PointRasterizer::EMPTY_PIXEL;
+            }
+        }
+        
+        _stats.fullRefresh = true;
+        _stats.refreshedPoints = pointCount;
+        _stats.pointsDrawn = pointCount;
+        _hasHistory = true;
+    }
+}
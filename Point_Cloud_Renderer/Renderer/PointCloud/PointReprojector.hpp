@@ -0,0 +1,130 @@
+//
+//  PointReprojector.hpp
+//  Point_Cloud_Renderer
+//
+//  Created by Vatsalya Yadav on 10/19/26.
+//
+
+#ifndef PointReprojector_hpp
+#define PointReprojector_hpp
+
+#include <cstdint>
+#include <vector>
+
+#include <simd/simd.h>
+
+#include "Renderer/PointCloud/PointRasterizer.hpp"
+#include "Renderer/Structures/CameraData.hpp"
+
+namespace PCR
+{
+    struct ReprojectionStats
+    {
+        // Points that owned a pixel last frame and were fed back in
+        size_t reprojectedPoints = 0;
+        
+        // Reprojected points that still own a pixel under the new camera
+        size_t validPoints = 0;
+        
+        // Pixels covered last frame that came out empty after reprojection
+        size_t disoccludedPixels = 0;
+        
+        // Points from this frame's slice of nodes
+        size_t refreshedPoints = 0;
+        
+        // Distinct points, a reprojected point in the refresh slice counts once
+        size_t pointsDrawn = 0;
+        
+        bool fullRefresh = false;
+        
+        float getValidRatio() const
+        {
+            return reprojectedPoints ? static_cast< float >( validPoints ) / reprojectedPoints : 0.0f;
+        }
+    };
+
+    // ReprojectionStats summed over every render since the last reset
+    struct ReprojectionTotals
+    {
+        uint64_t frames = 0;
+        
+        uint64_t fullRefreshes = 0;
+        
+        uint64_t reprojectedPoints = 0;
+        
+        uint64_t validPoints = 0;
+        
+        uint64_t disoccludedPixels = 0;
+        
+        uint64_t pointsDrawn = 0;
+        
+        // What full renders of every frame would have drawn
+        uint64_t pointCount = 0;
+        
+        float getValidRatio() const
+        {
+            return reprojectedPoints ? static_cast< float >( validPoints ) / reprojectedPoints : 0.0f;
+        }
+        
+        float getDrawnRatio() const
+        {
+            return pointCount ? static_cast< float >( pointsDrawn ) / pointCount : 0.0f;
+        }
+    };
+
+    // Reuses last frame's visible samples. Because every pixel stores the index of the
+    // point that won it, warping to the new camera is just re-rasterizing those points.
+    // On top of that one in REPROJECTION_REFRESH_PERIOD nodes (POINT_NODE_SIZE consecutive
+    // points) is drawn in full each frame, which fills in disocclusions over a few frames.
+    class PointReprojector
+    {
+    public:
+        explicit PointReprojector( PointRasterizer& rasterizer );
+        
+        // Next render draws every point, e.g. after the point set changed.
+        void invalidate();
+        
+        void render( const PointData* pPoints,
+                     size_t pointCount,
+                     const CameraData& cameraData,
+                     PointRasterMode mode );
+        
+        // Falls back to a full render on the next frame when fewer than this
+        // fraction of reprojected points survive, e.g. after a camera cut.
+        void setMinValidRatio( float minValidRatio );
+        
+        const ReprojectionStats& getStats() const;
+        
+        const ReprojectionTotals& getTotals() const;
+        
+        void resetTotals();
+        
+        // One byte per pixel, non-zero where the last render found a disocclusion.
+        const std::vector< uint8_t >& getDisocclusionMask() const;
+        
+    private:
+        PointRasterizer& _rasterizer;
+        
+        std::vector< uint32_t > _drawList;
+        
+        std::vector< uint8_t > _previousCoverage;
+        
+        std::vector< uint8_t > _disocclusionMask;
+        
+        uint32_t _refreshSlice;
+        
+        float _minValidRatio;
+        
+        bool _hasHistory;
+        
+        ReprojectionStats _stats;
+        
+        ReprojectionTotals _totals;
+        
+        void addToTotals( size_t pointCount );
+        
+        void renderFull( const PointData* pPoints, size_t pointCount, const simd::float4x4& viewProjection, PointRasterMode mode );
+    };
+}
+
+#endif /* PointReprojector_hpp */
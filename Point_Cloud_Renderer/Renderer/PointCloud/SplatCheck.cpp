@@ -0,0 +1,152 @@
+//
+//  SplatCheck.cpp
+//  Point_Cloud_Renderer
+//
+//  Created by Vatsalya Yadav on 10/19/26.
+//
+
+#include "SplatCheck.hpp"
+
+#include <algorithm>
+#include <random>
+#include <vector>
+
+#include "Math/Utility.hpp"
+#include "Renderer/PointCloud/PointCloudGenerator.hpp"
+#include "Renderer/PointCloud/SplatRasterizer.hpp"
+#include "Renderer/Profiler/FrameProfiler.hpp"
+#include "Renderer/Threading/WorkerPool.hpp"
+#include "Renderer/Validation/CheckReport.hpp"
+
+namespace PCR
+{
+    namespace
+    {
+        constexpr uint32_t SIZE{ 64 };
+        
+        constexpr uint32_t CLEAR_COLOR{ 0xFF191919 };
+        
+        constexpr uint32_t RED{ 0xFF0000FF };
+        
+        constexpr uint32_t BLUE{ 0xFFFF0000 };
+        
+        constexpr uint32_t SPHERE_SIZE{ 256 };
+        
+        // Several points per pixel, so most pixels blend
+        constexpr size_t SPHERE_POINT_COUNT{ 200000 };
+        
+        constexpr uint32_t WORKER_COUNT{ 4 };
+        
+        // Clip w is the position's z and NDC is x / z, y / z, so a splat's pixel and view depth
+        // are picked directly
+        simd::float4x4 makeDepthProjection()
+        {
+            simd::float4x4 projection = Math::makeIdentity();
+            projection.columns[ 2 ] = simd::float4{ 0.0f, 0.0f, 0.0f, 1.0f };
+            projection.columns[ 3 ] = simd::float4{ 0.0f, 0.0f, 0.5f, 0.0f };
+            return projection;
+        }
+        
+        PointData makeSplat( uint32_t x, uint32_t y, float depth, uint32_t color )
+        {
+            const float ndcX = ( x + 0.5f ) / SIZE * 2.0f - 1.0f;
+            const float ndcY = 1.0f - ( y + 0.5f ) / SIZE * 2.0f;
+            return PointData{ simd::float3{ ndcX * depth, ndcY * depth, depth }, color };
+        }
+        
+        std::vector< uint32_t > render( SplatRasterizer& rasterizer, const std::vector< PointData >& points, const simd::float4x4& viewProjection, uint32_t size )
+        {
+            std::vector< uint32_t > colors( static_cast< size_t >( size ) * size );
+            rasterizer.render( points.data(), points.size(), viewProjection, colors.data(), CLEAR_COLOR );
+            return colors;
+        }
+        
+        uint32_t pixel( const std::vector< uint32_t >& colors, uint32_t x, uint32_t y )
+        {
+            return colors[ static_cast< size_t >( y ) * SIZE + x ];
+        }
+        
+        bool coversDisc( const std::vector< uint32_t >& colors, uint32_t x, uint32_t y, uint32_t color )
+        {
+            for ( uint32_t dy = 0; dy < 3; ++dy )
+            {
+                for ( uint32_t dx = 0; dx < 3; ++dx )
+                {
+                    if ( pixel( colors, x + dx - 1, y + dy - 1 ) != color )
+                    {
+                        return false;
+                    }
+                }
+            }
+            return true;
+        }
+    }
+
+    bool runSplatChecks()
+    {
+        CheckReport report( "Splat rasterizer, hand-placed splats and a 200K point sphere" );
+        
+        WorkerPool workerPool( WORKER_COUNT );
+        SplatRasterizer rasterizer( SIZE, SIZE, workerPool );
+        const simd::float4x4 projection = makeDepthProjection();
+        
+        // Radius 1 takes the eight neighbours, diagonals included, and nothing two pixels out
+        const std::vector< uint32_t > lone = render( rasterizer, { makeSplat( 10, 10, 1.0f, RED ) }, projection, SIZE );
+        report.expect( coversDisc( lone, 10, 10, RED ), "coverage: a lone splat colors its pixel and the eight around it" );
+        report.expect( pixel( lone, 12, 10 ) == CLEAR_COLOR && pixel( lone, 10, 8 ) == CLEAR_COLOR, "coverage: pixels past the radius keep the clear color" );
+        report.expect( std::count( lone.begin(), lone.end(), CLEAR_COLOR ) == SIZE * SIZE - 9, "coverage: nothing else is drawn" );
+        
+        // Equal weights, ( 255 + 0 ) / 2 rounds to 128
+        const std::vector< uint32_t > blended = render( rasterizer, { makeSplat( 20, 20, 1.0f, RED ), makeSplat( 20, 20, 1.005f, BLUE ) }, projection, SIZE );
+        report.expect( coversDisc( blended, 20, 20, 0xFF800080 ), "depth: splats within depthEpsilon of the front blend evenly" );
+        
+        const std::vector< uint32_t > occluded = render( rasterizer, { makeSplat( 30, 30, 1.5f, BLUE ), makeSplat( 30, 30, 1.0f, RED ) }, projection, SIZE );
+        report.expect( coversDisc( occluded, 30, 30, RED ), "depth: a splat past depthEpsilon behind the front is hidden" );
+        
+        // One pixel apart, the two discs overlap in two columns and blend by distance there
+        const std::vector< uint32_t > overlap = render( rasterizer, { makeSplat( 40, 40, 1.0f, RED ), makeSplat( 41, 40, 1.0f, BLUE ) }, projection, SIZE );
+        report.expect( pixel( overlap, 39, 40 ) == RED && pixel( overlap, 42, 40 ) == BLUE, "weights: pixels only one splat reaches take its color" );
+        report.expect( ( pixel( overlap, 40, 40 ) & 0xFF ) > ( pixel( overlap, 40, 40 ) >> 16 & 0xFF ), "weights: a splat's own centre leans towards it" );
+        
+        // The atomics land in a different order every run, the sums can't depend on it
+        rasterizer.resize( SPHERE_SIZE, SPHERE_SIZE );
+        const simd::float4x4 viewProjection = Math::makePerspective( 45.0f * M_PI / 180.0f, 1.0f, 0.03f, 500.0f )
+                                            * Math::makeTranslate( simd::float3{ 0.0f, 0.0f, -3.0f } );
+        
+        std::vector< PointData > sphere = PointCloudGenerator::makeSphere( SPHERE_POINT_COUNT, 1.0f );
+        FrameProfiler profiler;
+        std::vector< uint32_t > reference( static_cast< size_t >( SPHERE_SIZE ) * SPHERE_SIZE );
+        rasterizer.render( sphere.data(), sphere.size(), viewProjection, reference.data(), CLEAR_COLOR, &profiler );
+        
+        const auto drawn = static_cast< size_t >( std::count_if( reference.begin(), reference.end(), []( uint32_t color ){ return color != CLEAR_COLOR; } ) );
+        report.expect( drawn > reference.size() / 4 && drawn < reference.size(), "order: the sphere covers part of the image" );
+        
+        std::reverse( sphere.begin(), sphere.end() );
+        report.expect( render( rasterizer, sphere, viewProjection, SPHERE_SIZE ) == reference, "order: reversed points give the same image" );
+        
+        std::mt19937 random( 7 );
+        std::shuffle( sphere.begin(), sphere.end(), random );
+        report.expect( render( rasterizer, sphere, viewProjection, SPHERE_SIZE ) == reference, "order: shuffled points give the same image" );
+        
+        WorkerPool serialPool( 1 );
+        SplatRasterizer serialRasterizer( SPHERE_SIZE, SPHERE_SIZE, serialPool );
+        report.expect( render( serialRasterizer, sphere, viewProjection, SPHERE_SIZE ) == reference, "order: one worker gives the same image as four" );
+        
+        const FrameProfiler::TimingMap timings = profiler.getCpuTimings();
+        bool timed = true;
+        for ( const char* name : { "Splat Depth", "Splat Accumulate", "Splat Normalize" } )
+        {
+            const auto timing = timings.find( name );
+            timed = timed && timing != timings.end() && timing->second.sampleCount == 1;
+        }
+        report.expect( timed && timings.size() == 3, "profiler: one timing per pass under the GPU pass names" );
+        
+        // What the readback comparison allows
+        const uint32_t expected[]{ 0xFF102030, 0xFF102030, 0xFF102030 };
+        const uint32_t colors[]{ 0xFF102030, 0xFF112030, 0xFE10201E };
+        report.expect( countSplatMismatches( expected, colors, 2, SPLAT_VALIDATION_CHANNEL_TOLERANCE ) == 0, "tolerance: a channel one step off still matches" );
+        report.expect( countSplatMismatches( expected, colors, 3, SPLAT_VALIDATION_CHANNEL_TOLERANCE ) == 1, "tolerance: a channel two steps off is a mismatch" );
+        
+        return report.finish();
+    }
+}
@@ -0,0 +1,21 @@
+//
+//  SplatCheck.hpp
+//  Point_Cloud_Renderer
+//
+//  Created by Vatsalya Yadav on 10/19/26.
+//
+
+#ifndef SplatCheck_hpp
+#define SplatCheck_hpp
+
+namespace PCR
+{
+    // SplatRasterizer on hand-placed splats: coverage of one splat, blending within depthEpsilon
+    // and occlusion past it. Then a generated sphere drawn with its points in three orders and on
+    // one and several workers, which must give the same image, the profiler's pass timings and
+    // the tolerance --validate-gpu compares the GPU splats with.
+    // Returns false if any check fails.
+    bool runSplatChecks();
+}
+
+#endif /* SplatCheck_hpp */
@@ -0,0 +1,207 @@
+//
+//  SplatPass.cpp
+//  Point_Cloud_Renderer
+//
+//  Created by Vatsalya Yadav on 10/19/26.
+//
+
+#include "SplatPass.hpp"
+
+#include <algorithm>
+#include <cassert>
+
+#include "Renderer/Profiler/FrameProfiler.hpp"
+#include "Renderer/Structures/SplatUniforms.hpp"
+
+namespace PCR
+{
+    namespace
+    {
+        // Stages of the splat pass's GpuStageTimer
+        constexpr uint32_t SPLAT_DEPTH_STAGE{ 0 };
+        constexpr uint32_t SPLAT_ACCUMULATE_STAGE{ 1 };
+        constexpr uint32_t SPLAT_NORMALIZE_STAGE{ 2 };
+    }
+
+    SplatPass::SplatPass( MTL::Device* pDevice, MTL::Library* pLibrary )
+    :   _pDevice{ pDevice->retain() }
+    ,   _pDepthBuffer{ nullptr }
+    ,   _pAccumulationBuffer{ nullptr }
+    ,   _width{ 0 }
+    ,   _height{ 0 }
+    ,   _radius{ SPLAT_DEFAULT_RADIUS }
+    ,   _depthEpsilon{ SPLAT_DEFAULT_DEPTH_EPSILON }
+    ,   _stageTimer{ pDevice, { "Splat Depth", "Splat Accumulate", "Splat Normalize" } }
+    {
+        _pDepthPipeline = buildPipeline( pLibrary, "splat_depth" );
+        _pAccumulatePipeline = buildPipeline( pLibrary, "splat_accumulate" );
+        _pNormalizePipeline = buildPipeline( pLibrary, "splat_normalize" );
+    }
+
+    SplatPass::~SplatPass()
+    {
+        if ( _pDepthBuffer )
+        {
+            _pDepthBuffer->release();
+            _pAccumulationBuffer->release();
+        }
+        _pDepthPipeline->release();
+        _pAccumulatePipeline->release();
+        _pNormalizePipeline->release();
+        _pDevice->release();
+    }
+
+    void SplatPass::resize( uint32_t width, uint32_t height )
+    {
+        if ( width == _width && height == _height )
+        {
+            return;
+        }
+        
+        if ( _pDepthBuffer )
+        {
+            _pDepthBuffer->release();
+            _pAccumulationBuffer->release();
+        }
+        
+        _width = width;
+        _height = height;
+        
+        const NS::UInteger pixelCount = static_cast< NS::UInteger >( width ) * height;
+        _pDepthBuffer = _pDevice->newBuffer( pixelCount * sizeof( uint32_t ), MTL::ResourceStorageModePrivate );
+        _pAccumulationBuffer = _pDevice->newBuffer( pixelCount * 4 * sizeof( uint32_t ), MTL::ResourceStorageModePrivate );
+    }
+
+    void SplatPass::setRadius( int32_t radius )
+    {
+        _radius = std::max( 0, radius );
+    }
+
+    void SplatPass::setDepthEpsilon( float depthEpsilon )
+    {
+        _depthEpsilon = depthEpsilon;
+    }
+
+    void SplatPass::encodeDepth( MTL::CommandBuffer* pCommandBuffer,
+                                 MTL::Buffer* pPointBuffer,
+                                 uint32_t pointCount,
+                                 const simd::float4x4& viewProjection )
+    {
+        assert( _pDepthBuffer );
+        
+        // The clears count towards the depth pass, it starts with them
+        MTL::BlitPassDescriptor* pBlitPassDescriptor = MTL::BlitPassDescriptor::blitPassDescriptor();
+        _stageTimer.attach( pBlitPassDescriptor, SPLAT_DEPTH_STAGE, StageBoundary::Start );
+        
+        MTL::BlitCommandEncoder* pBlitEncoder = pCommandBuffer->blitCommandEncoder( pBlitPassDescriptor );
+        pBlitEncoder->fillBuffer( _pDepthBuffer, NS::Range::Make( 0, _pDepthBuffer->length() ), 0xFF );
+        pBlitEncoder->fillBuffer( _pAccumulationBuffer, NS::Range::Make( 0, _pAccumulationBuffer->length() ), 0 );
+        pBlitEncoder->endEncoding();
+        
+        MTL::ComputePassDescriptor* pPassDescriptor = MTL::ComputePassDescriptor::computePassDescriptor();
+        _stageTimer.attach( pPassDescriptor, SPLAT_DEPTH_STAGE, StageBoundary::End );
+        encodePointPass( pCommandBuffer, pPassDescriptor, _pDepthPipeline, pPointBuffer, pointCount, viewProjection );
+    }
+
+    void SplatPass::encodeAccumulate( MTL::CommandBuffer* pCommandBuffer,
+                                      MTL::Buffer* pPointBuffer,
+                                      uint32_t pointCount,
+                                      const simd::float4x4& viewProjection )
+    {
+        MTL::ComputePassDescriptor* pPassDescriptor = MTL::ComputePassDescriptor::computePassDescriptor();
+        _stageTimer.attach( pPassDescriptor, SPLAT_ACCUMULATE_STAGE );
+        encodePointPass( pCommandBuffer, pPassDescriptor, _pAccumulatePipeline, pPointBuffer, pointCount, viewProjection );
+    }
+
+    void SplatPass::encodeNormalize( MTL::CommandBuffer* pCommandBuffer, MTL::Texture* pTarget )
+    {
+        SplatUniforms uniforms{};
+        uniforms.width = _width;
+        uniforms.height = _height;
+        
+        MTL::ComputePassDescriptor* pPassDescriptor = MTL::ComputePassDescriptor::computePassDescriptor();
+        _stageTimer.attach( pPassDescriptor, SPLAT_NORMALIZE_STAGE );
+        
+        MTL::ComputeCommandEncoder* pComputeEncoder = pCommandBuffer->computeCommandEncoder( pPassDescriptor );
+        pComputeEncoder->setComputePipelineState( _pNormalizePipeline );
+        pComputeEncoder->setBytes( &uniforms, sizeof( uniforms ), 1 );
+        pComputeEncoder->setBuffer( _pAccumulationBuffer, 0, 3 );
+        pComputeEncoder->setTexture( pTarget, 0 );
+        
+        const NS::UInteger threadGroupX = _pNormalizePipeline->threadExecutionWidth();
+        const NS::UInteger threadGroupY = _pNormalizePipeline->maxTotalThreadsPerThreadgroup() / threadGroupX;
+        pComputeEncoder->dispatchThreads( MTL::Size( _width, _height, 1 ), MTL::Size( threadGroupX, threadGroupY, 1 ) );
+        
+        pComputeEncoder->endEncoding();
+    }
+
+    void SplatPass::encode( MTL::CommandBuffer* pCommandBuffer,
+                            MTL::Buffer* pPointBuffer,
+                            uint32_t pointCount,
+                            const simd::float4x4& viewProjection,
+                            MTL::Texture* pTarget,
+                            uint64_t frameIndex,
+                            FrameProfiler* pProfiler /* = nullptr */ )
+    {
+        _stageTimer.beginFrame( frameIndex );
+        
+        encodeDepth( pCommandBuffer, pPointBuffer, pointCount, viewProjection );
+        encodeAccumulate( pCommandBuffer, pPointBuffer, pointCount, viewProjection );
+        encodeNormalize( pCommandBuffer, pTarget );
+        
+        if ( pProfiler )
+        {
+            _stageTimer.track( pCommandBuffer, *pProfiler );
+        }
+    }
+
+    MTL::ComputePipelineState* SplatPass::buildPipeline( MTL::Library* pLibrary, const char* functionName )
+    {
+        auto pFunction = NS::TransferPtr< MTL::Function >( pLibrary->newFunction( CreateUTF8String( functionName ) ) );
+        
+        NS::Error* pError = nullptr;
+        MTL::ComputePipelineState* pPipelineState = _pDevice->newComputePipelineState( pFunction.get(), &pError );
+        if ( !pPipelineState )
+        {
+            __builtin_printf( "%s", pError->localizedDescription()->utf8String() );
+            assert( false );
+        }
+        
+        return pPipelineState;
+    }
+
+    void SplatPass::encodePointPass( MTL::CommandBuffer* pCommandBuffer,
+                                     MTL::ComputePassDescriptor* pPassDescriptor,
+                                     MTL::ComputePipelineState* pPipeline,
+                                     MTL::Buffer* pPointBuffer,
+                                     uint32_t pointCount,
+                                     const simd::float4x4& viewProjection )
+    {
+        SplatUniforms uniforms;
+        uniforms.viewProjection = viewProjection;
+        uniforms.width = _width;
+        uniforms.height = _height;
+        uniforms.radius = _radius;
+        uniforms.depthEpsilon = _depthEpsilon;
+        uniforms.pointCount = pointCount;
+        
+        // An empty pass still takes the samples, the stage then times as nothing
+        MTL::ComputeCommandEncoder* pComputeEncoder = pCommandBuffer->computeCommandEncoder( pPassDescriptor );
+        if ( pointCount == 0 )
+        {
+            pComputeEncoder->endEncoding();
+            return;
+        }
+        
+        pComputeEncoder->setComputePipelineState( pPipeline );
+        pComputeEncoder->setBuffer( pPointBuffer, 0, 0 );
+        pComputeEncoder->setBytes( &uniforms, sizeof( uniforms ), 1 );
+        pComputeEncoder->setBuffer( _pDepthBuffer, 0, 2 );
+        pComputeEncoder->setBuffer( _pAccumulationBuffer, 0, 3 );
+        
+        const NS::UInteger threadGroupX = pPipeline->maxTotalThreadsPerThreadgroup();
+        pComputeEncoder->dispatchThreads( MTL::Size( pointCount, 1, 1 ), MTL::Size( threadGroupX, 1, 1 ) );
+        
+        pComputeEncoder->endEncoding();
+    }
+}
@@ -0,0 +1,95 @@
+//
+//  SplatPass.hpp
+//  Point_Cloud_Renderer
+//
+//  Created by Vatsalya Yadav on 10/19/26.
+//
+
+#ifndef SplatPass_hpp
+#define SplatPass_hpp
+
+#include <Metal/Metal.hpp>
+#include <simd/simd.h>
+
+#include "Core/Core.hpp"
+#include "Renderer/Data/Constants.hpp"
+#include "Renderer/Profiler/GpuStageTimer.hpp"
+
+FD_MTL
+
+namespace PCR
+{
+    class FrameProfiler;
+
+    // GPU side of the three-pass splat renderer, see SplatRasterizer for the CPU reference.
+    class SplatPass
+    {
+    public:
+        SplatPass( MTL::Device* pDevice, MTL::Library* pLibrary );
+        
+        ~SplatPass();
+        
+        void resize( uint32_t width, uint32_t height );
+        
+        void setRadius( int32_t radius );
+        
+        void setDepthEpsilon( float depthEpsilon );
+        
+        // All three passes into one command buffer. With a profiler each pass gets a GPU time
+        // from stage-boundary samples where the device has them, under the same names as
+        // SplatRasterizer's CPU timings. The normalize pass writes pTarget's top-left corner.
+        void encode( MTL::CommandBuffer* pCommandBuffer,
+                     MTL::Buffer* pPointBuffer,
+                     uint32_t pointCount,
+                     const simd::float4x4& viewProjection,
+                     MTL::Texture* pTarget,
+                     uint64_t frameIndex,
+                     FrameProfiler* pProfiler = nullptr );
+        
+    private:
+        MTL::Device* _pDevice;
+        
+        MTL::ComputePipelineState* _pDepthPipeline;
+        
+        MTL::ComputePipelineState* _pAccumulatePipeline;
+        
+        MTL::ComputePipelineState* _pNormalizePipeline;
+        
+        MTL::Buffer* _pDepthBuffer;
+        
+        MTL::Buffer* _pAccumulationBuffer;
+        
+        uint32_t _width;
+        
+        uint32_t _height;
+        
+        int32_t _radius;
+        
+        float _depthEpsilon;
+        
+        GpuStageTimer _stageTimer;
+        
+        MTL::ComputePipelineState* buildPipeline( MTL::Library* pLibrary, const char* functionName );
+        
+        void encodeDepth( MTL::CommandBuffer* pCommandBuffer,
+                          MTL::Buffer* pPointBuffer,
+                          uint32_t pointCount,
+                          const simd::float4x4& viewProjection );
+        
+        void encodeAccumulate( MTL::CommandBuffer* pCommandBuffer,
+                               MTL::Buffer* pPointBuffer,
+                               uint32_t pointCount,
+                               const simd::float4x4& viewProjection );
+        
+        void encodeNormalize( MTL::CommandBuffer* pCommandBuffer, MTL::Texture* pTarget );
+        
+        void encodePointPass( MTL::CommandBuffer* pCommandBuffer,
+                              MTL::ComputePassDescriptor* pPassDescriptor,
+                              MTL::ComputePipelineState* pPipeline,
+                              MTL::Buffer* pPointBuffer,
+                              uint32_t pointCount,
+                              const simd::float4x4& viewProjection );
+    };
+}
+
+#endif /* SplatPass_hpp */
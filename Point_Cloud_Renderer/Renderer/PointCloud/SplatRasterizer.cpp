@@ -0,0 +1,241 @@
+//
+//  SplatRasterizer.cpp
+//  Point_Cloud_Renderer
+//
+//  Created by Vatsalya Yadav on 10/19/26.
+//
+
+#include "SplatRasterizer.hpp"
+
+#include <algorithm>
+#include <cstdlib>
+#include <cstring>
+
+#include "Renderer/Profiler/FrameProfiler.hpp"
+#include "Renderer/Threading/WorkerPool.hpp"
+
+namespace PCR
+{
+    namespace
+    {
+        constexpr size_t POINTS_PER_CHUNK{ 16 * 1024 };
+        
+        constexpr size_t PIXELS_PER_CHUNK{ 64 * 1024 };
+        
+        uint32_t floatBits( float value )
+        {
+            uint32_t bits;
+            memcpy( &bits, &value, sizeof( float ) );
+            return bits;
+        }
+        
+        float bitsToFloat( uint32_t bits )
+        {
+            float value;
+            memcpy( &value, &bits, sizeof( float ) );
+            return value;
+        }
+    }
+
+    SplatRasterizer::SplatRasterizer( uint32_t width, uint32_t height, WorkerPool& workerPool )
+    :   _workerPool{ workerPool }
+    ,   _width{ 0 }
+    ,   _height{ 0 }
+    ,   _radius{ SPLAT_DEFAULT_RADIUS }
+    ,   _depthEpsilon{ SPLAT_DEFAULT_DEPTH_EPSILON }
+    {
+        resize( width, height );
+    }
+
+    void SplatRasterizer::resize( uint32_t width, uint32_t height )
+    {
+        _width = width;
+        _height = height;
+        
+        const size_t pixelCount = static_cast< size_t >( width ) * height;
+        _depth = std::make_unique< std::atomic< uint32_t >[] >( pixelCount );
+        _accumulation = std::make_unique< std::atomic< uint32_t >[] >( pixelCount * 4 );
+    }
+
+    void SplatRasterizer::setRadius( int32_t radius )
+    {
+        _radius = std::max( 0, radius );
+    }
+
+    void SplatRasterizer::setDepthEpsilon( float depthEpsilon )
+    {
+        _depthEpsilon = depthEpsilon;
+    }
+
+    template < typename PixelFunction >
+    void SplatRasterizer::forEachSplatPixel( int32_t x, int32_t y, PixelFunction&& function ) const
+    {
+        for ( int32_t dy = -_radius; dy <= _radius; ++dy )
+        {
+            for ( int32_t dx = -_radius; dx <= _radius; ++dx )
+            {
+                const int32_t px = x + dx;
+                const int32_t py = y + dy;
+                if ( dx * dx + dy * dy > _radius * _radius + _radius
+                  || px < 0 || py < 0 || px >= static_cast< int32_t >( _width ) || py >= static_cast< int32_t >( _height ) )
+                {
+                    continue;
+                }
+                
+                function( static_cast< size_t >( py ) * _width + px, dx, dy );
+            }
+        }
+    }
+
+    void SplatRasterizer::render( const PointData* pPoints,
+                                  size_t pointCount,
+                                  const simd::float4x4& viewProjection,
+                                  uint32_t* pColors,
+                                  uint32_t clearColor,
+                                  FrameProfiler* pProfiler /* = nullptr */ )
+    {
+        const size_t pixelCount = static_cast< size_t >( _width ) * _height;
+        
+        {
+            ScopedCpuTimer timer( pProfiler, "Splat Depth" );
+            
+            _workerPool.parallelFor( pixelCount, PIXELS_PER_CHUNK, [ this ]( size_t begin, size_t end, uint32_t ){
+                for ( size_t i = begin; i < end; ++i )
+                {
+                    _depth[ i ].store( UINT32_MAX, std::memory_order_relaxed );
+                    for ( size_t c = 0; c < 4; ++c )
+                    {
+                        _accumulation[ i * 4 + c ].store( 0, std::memory_order_relaxed );
+                    }
+                }
+            } );
+            
+            _workerPool.parallelFor( pointCount, POINTS_PER_CHUNK, [ & ]( size_t begin, size_t end, uint32_t ){
+                for ( size_t i = begin; i < end; ++i )
+                {
+                    int32_t x, y;
+                    float viewDepth;
+                    if ( !projectSplat( pPoints[ i ].position, viewProjection, x, y, viewDepth ) )
+                    {
+                        continue;
+                    }
+                    
+                    const uint32_t depthBits = floatBits( viewDepth );
+                    forEachSplatPixel( x, y, [ & ]( size_t pixelIndex, int32_t, int32_t ){
+                        std::atomic< uint32_t >& depth = _depth[ pixelIndex ];
+                        uint32_t current = depth.load( std::memory_order_relaxed );
+                        while ( depthBits < current && !depth.compare_exchange_weak( current, depthBits, std::memory_order_relaxed ) )
+                        { }
+                    } );
+                }
+            } );
+        }
+        
+        {
+            ScopedCpuTimer timer( pProfiler, "Splat Accumulate" );
+            
+            const int32_t outer = ( _radius + 1 ) * ( _radius + 1 );
+            
+            _workerPool.parallelFor( pointCount, POINTS_PER_CHUNK, [ & ]( size_t begin, size_t end, uint32_t ){
+                for ( size_t i = begin; i < end; ++i )
+                {
+                    int32_t x, y;
+                    float viewDepth;
+                    if ( !projectSplat( pPoints[ i ].position, viewProjection, x, y, viewDepth ) )
+                    {
+                        continue;
+                    }
+                    
+                    const uint32_t color = pPoints[ i ].color;
+                    const uint32_t r = color & 0xFF;
+                    const uint32_t g = ( color >> 8 ) & 0xFF;
+                    const uint32_t b = ( color >> 16 ) & 0xFF;
+                    
+                    forEachSplatPixel( x, y, [ & ]( size_t pixelIndex, int32_t dx, int32_t dy ){
+                        const float frontDepth = bitsToFloat( _depth[ pixelIndex ].load( std::memory_order_relaxed ) );
+                        if ( viewDepth > frontDepth + _depthEpsilon )
+                        {
+                            return;
+                        }
+                        
+                        const auto weight = static_cast< uint32_t >( ( outer - ( dx * dx + dy * dy ) ) * 255 / outer );
+                        _accumulation[ pixelIndex * 4 + 0 ].fetch_add( r * weight, std::memory_order_relaxed );
+                        _accumulation[ pixelIndex * 4 + 1 ].fetch_add( g * weight, std::memory_order_relaxed );
+                        _accumulation[ pixelIndex * 4 + 2 ].fetch_add( b * weight, std::memory_order_relaxed );
+                        _accumulation[ pixelIndex * 4 + 3 ].fetch_add( weight, std::memory_order_relaxed );
+                    } );
+                }
+            } );
+        }
+        
+        {
+            ScopedCpuTimer timer( pProfiler, "Splat Normalize" );
+            
+            _workerPool.parallelFor( pixelCount, PIXELS_PER_CHUNK, [ & ]( size_t begin, size_t end, uint32_t ){
+                for ( size_t i = begin; i < end; ++i )
+                {
+                    const uint32_t weight = _accumulation[ i * 4 + 3 ].load( std::memory_order_relaxed );
+                    if ( weight == 0 )
+                    {
+                        pColors[ i ] = clearColor;
+                        continue;
+                    }
+                    
+                    uint32_t color = 0xFF000000;
+                    for ( uint32_t c = 0; c < 3; ++c )
+                    {
+                        const uint32_t sum = _accumulation[ i * 4 + c ].load( std::memory_order_relaxed );
+                        color |= ( ( sum + weight / 2 ) / weight ) << ( c * 8 );
+                    }
+                    pColors[ i ] = color;
+                }
+            } );
+        }
+    }
+
+    bool SplatRasterizer::projectSplat( const simd::float3& position,
+                                        const simd::float4x4& viewProjection,
+                                        int32_t& outX,
+                                        int32_t& outY,
+                                        float& outViewDepth ) const
+    {
+        const simd::float4 clip = viewProjection * simd::float4{ position.x, position.y, position.z, 1.0f };
+        if ( clip.w <= 0.0f )
+        {
+            return false;
+        }
+        
+        // Divide rather than multiply by 1/w like the shader, fast-math may still round differently
+        const float ndcX = clip.x / clip.w;
+        const float ndcY = clip.y / clip.w;
+        const float ndcZ = clip.z / clip.w;
+        if ( ndcX < -1.0f || ndcX >= 1.0f || ndcY <= -1.0f || ndcY > 1.0f || ndcZ < 0.0f || ndcZ > 1.0f )
+        {
+            return false;
+        }
+        
+        outX = std::min( static_cast< int32_t >( ( ndcX * 0.5f + 0.5f ) * _width ), static_cast< int32_t >( _width ) - 1 );
+        outY = std::min( static_cast< int32_t >( ( 0.5f - ndcY * 0.5f ) * _height ), static_cast< int32_t >( _height ) - 1 );
+        outViewDepth = clip.w;
+        return true;
+    }
+
+    size_t countSplatMismatches( const uint32_t* pExpected, const uint32_t* pColors, size_t pixelCount, uint32_t channelTolerance )
+    {
+        size_t mismatches = 0;
+        for ( size_t i = 0; i < pixelCount; ++i )
+        {
+            for ( uint32_t c = 0; c < 4; ++c )
+            {
+                const auto expected = static_cast< int32_t >( ( pExpected[ i ] >> ( c * 8 ) ) & 0xFF );
+                const auto color = static_cast< int32_t >( ( pColors[ i ] >> ( c * 8 ) ) & 0xFF );
+                if ( static_cast< uint32_t >( std::abs( expected - color ) ) > channelTolerance )
+                {
+                    ++mismatches;
+                    break;
+                }
+            }
+        }
+        return mismatches;
+    }
+}
@@ -0,0 +1,83 @@
+//
+//  SplatRasterizer.hpp
+//  Point_Cloud_Renderer
+//
+//  Created by Vatsalya Yadav on 10/19/26.
+//
+
+#ifndef SplatRasterizer_hpp
+#define SplatRasterizer_hpp
+
+#include <atomic>
+#include <cstdint>
+#include <memory>
+
+#include <simd/simd.h>
+
+#include "Renderer/Data/Constants.hpp"
+#include "Renderer/Structures/PointData.hpp"
+
+namespace PCR
+{
+    class WorkerPool;
+    class FrameProfiler;
+
+    // CPU reference for the three-pass splat renderer in Splat_Compute.metal:
+    //  1. depth prepass, nearest view depth per pixel
+    //  2. accumulate weighted colors of every splat within depthEpsilon of that depth
+    //  3. normalize by the summed weight
+    // Weights and sums are integers on both sides, so neither image depends on the order the
+    // atomics land in. The projection is float math and the shaders build with fast-math, so
+    // the two only agree within a tolerance: a splat whose centre lands within a few ulps of a
+    // pixel edge may move one pixel over, and one whose depth is that close to depthEpsilon
+    // behind the front may blend on one side only. Every other pixel has the same 8-bit color.
+    class SplatRasterizer
+    {
+    public:
+        SplatRasterizer( uint32_t width, uint32_t height, WorkerPool& workerPool );
+        
+        void resize( uint32_t width, uint32_t height );
+        
+        void setRadius( int32_t radius );
+        
+        void setDepthEpsilon( float depthEpsilon );
+        
+        // Writes one RGBA8 value per pixel into pColors. Pass timings go to pProfiler if given.
+        void render( const PointData* pPoints,
+                     size_t pointCount,
+                     const simd::float4x4& viewProjection,
+                     uint32_t* pColors,
+                     uint32_t clearColor,
+                     FrameProfiler* pProfiler = nullptr );
+        
+    private:
+        WorkerPool& _workerPool;
+        
+        uint32_t _width;
+        
+        uint32_t _height;
+        
+        int32_t _radius;
+        
+        float _depthEpsilon;
+        
+        std::unique_ptr< std::atomic< uint32_t >[] > _depth;
+        
+        // r, g, b, weight per pixel
+        std::unique_ptr< std::atomic< uint32_t >[] > _accumulation;
+        
+        bool projectSplat( const simd::float3& position,
+                           const simd::float4x4& viewProjection,
+                           int32_t& outX,
+                           int32_t& outY,
+                           float& outViewDepth ) const;
+        
+        template < typename PixelFunction >
+        void forEachSplatPixel( int32_t x, int32_t y, PixelFunction&& function ) const;
+    };
+
+    // Pixels with a channel more than channelTolerance apart, both images RGBA8 with red in the lowest byte
+    size_t countSplatMismatches( const uint32_t* pExpected, const uint32_t* pColors, size_t pixelCount, uint32_t channelTolerance );
+}
+
+#endif /* SplatRasterizer_hpp */
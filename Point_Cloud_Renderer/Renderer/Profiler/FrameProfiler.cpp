@@ -0,0 +1,80 @@
+//
+//  FrameProfiler.cpp
+//  Point_Cloud_Renderer
+//
+//  Created by Vatsalya Yadav on 10/19/26.
+//
+
+#include "FrameProfiler.hpp"
+
+#include <Metal/Metal.hpp>
+
+namespace PCR
+{
+    FrameProfiler::FrameProfiler( double smoothing /* = 0.1 */ )
+    :   _smoothing{ smoothing }
+    { }
+
+    void FrameProfiler::recordCpu( const std::string& name, double milliseconds )
+    {
+        std::lock_guard< std::mutex > lock( _mutex );
+        record( _cpuTimings, name, milliseconds );
+    }
+
+    void FrameProfiler::recordGpu( const std::string& name, double milliseconds )
+    {
+        std::lock_guard< std::mutex > lock( _mutex );
+        record( _gpuTimings, name, milliseconds );
+    }
+
+    void FrameProfiler::trackGpu( const std::string& name, MTL::CommandBuffer* pCommandBuffer )
+    {
+        const std::string timingName = name;
+        pCommandBuffer->addCompletedHandler( ^void( MTL::CommandBuffer* pCmd ){
+            this->recordGpu( timingName, ( pCmd->GPUEndTime() - pCmd->GPUStartTime() ) * 1000.0 );
+        });
+    }
+
+    FrameProfiler::TimingMap FrameProfiler::getCpuTimings() const
+    {
+        std::lock_guard< std::mutex > lock( _mutex );
+        return _cpuTimings;
+    }
+
+    FrameProfiler::TimingMap FrameProfiler::getGpuTimings() const
+    {
+        std::lock_guard< std::mutex > lock( _mutex );
+        return _gpuTimings;
+    }
+
+    void FrameProfiler::reset()
+    {
+        std::lock_guard< std::mutex > lock( _mutex );
+        _cpuTimings.clear();
+        _gpuTimings.clear();
+    }
+
+    void FrameProfiler::record( TimingMap& timings, const std::string& name, double milliseconds )
+    {
+        ProfilerTiming& timing = timings[ name ];
+        timing.lastMs = milliseconds;
+        timing.averageMs = ( timing.sampleCount == 0 ) ? milliseconds
+                                                       : timing.averageMs + ( milliseconds - timing.averageMs ) * _smoothing;
+        ++timing.sampleCount;
+    }
+
+    ScopedCpuTimer::ScopedCpuTimer( FrameProfiler* pProfiler, const char* name )
+    :   _pProfiler{ pProfiler }
+    ,   _name{ name }
+    ,   _start{ std::chrono::steady_clock::now() }
+    { }
+
+    ScopedCpuTimer::~ScopedCpuTimer()
+    {
+        if ( _pProfiler )
+        {
+            const auto elapsed = std::chrono::steady_clock::now() - _start;
+            _pProfiler->recordCpu( _name, std::chrono::duration< double, std::milli >( elapsed ).count() );
+        }
+    }
+}
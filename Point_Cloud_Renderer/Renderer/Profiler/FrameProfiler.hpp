@@ -0,0 +1,83 @@
+//
+//  FrameProfiler.hpp
+//  Point_Cloud_Renderer
+//
+//  Created by Vatsalya Yadav on 10/19/26.
+//
+
+#ifndef FrameProfiler_hpp
+#define FrameProfiler_hpp
+
+#include <chrono>
+#include <map>
+#include <mutex>
+#include <string>
+
+#include "Core/Core.hpp"
+
+FD_MTL
+
+namespace PCR
+{
+    struct ProfilerTiming
+    {
+        double lastMs = 0.0;
+        
+        // Exponential moving average
+        double averageMs = 0.0;
+        
+        uint64_t sampleCount = 0;
+    };
+
+    // Collects named CPU and GPU timings. trackGpu times a whole command buffer, see
+    // GpuStageTimer for passes inside one.
+    class FrameProfiler
+    {
+    public:
+        using TimingMap = std::map< std::string, ProfilerTiming >;
+        
+        explicit FrameProfiler( double smoothing = 0.1 );
+        
+        void recordCpu( const std::string& name, double milliseconds );
+        
+        void recordGpu( const std::string& name, double milliseconds );
+        
+        // Records GPUEndTime - GPUStartTime once the command buffer completes.
+        // Must be called before the command buffer is committed.
+        void trackGpu( const std::string& name, MTL::CommandBuffer* pCommandBuffer );
+        
+        TimingMap getCpuTimings() const;
+        
+        TimingMap getGpuTimings() const;
+        
+        void reset();
+        
+    private:
+        mutable std::mutex _mutex;
+        
+        TimingMap _cpuTimings;
+        
+        TimingMap _gpuTimings;
+        
+        double _smoothing;
+        
+        void record( TimingMap& timings, const std::string& name, double milliseconds );
+    };
+
+    class ScopedCpuTimer
+    {
+    public:
+        ScopedCpuTimer( FrameProfiler* pProfiler, const char* name );
+        
+        ~ScopedCpuTimer();
+        
+    private:
+        FrameProfiler* _pProfiler;
+        
+        const char* _name;
+        
+        std::chrono::steady_clock::time_point _start;
+    };
+}
+
+#endif /* FrameProfiler_hpp */
@@ -0,0 +1,176 @@
+//
+//  GpuStageTimer.cpp
+//  Point_Cloud_Renderer
+//
+//  Created by Vatsalya Yadav on 10/19/26.
+//
+
+#include "GpuStageTimer.hpp"
+
+#include <Metal/Metal.hpp>
+
+#include <cassert>
+
+#include "Renderer/Data/Constants.hpp"
+#include "Renderer/Profiler/FrameProfiler.hpp"
+
+namespace PCR
+{
+    namespace
+    {
+        // MTLCounterDontSample and MTLCounterErrorValue, metal-cpp has neither
+        constexpr NS::UInteger COUNTER_DONT_SAMPLE{ NS::UIntegerMax };
+        
+        constexpr uint64_t COUNTER_ERROR_VALUE{ UINT64_MAX };
+        
+        MTL::CounterSet* findTimestampCounterSet( MTL::Device* pDevice )
+        {
+            NS::Array* pCounterSets = pDevice->counterSets();
+            for ( NS::UInteger i = 0; pCounterSets && i < pCounterSets->count(); ++i )
+            {
+                auto* pCounterSet = pCounterSets->object< MTL::CounterSet >( i );
+                if ( pCounterSet->name()->isEqualToString( MTL::CommonCounterSetTimestamp ) )
+                {
+                    return pCounterSet;
+                }
+            }
+            return nullptr;
+        }
+        
+        bool hasBoundary( StageBoundary boundary, StageBoundary end )
+        {
+            return ( static_cast< uint32_t >( boundary ) & static_cast< uint32_t >( end ) ) != 0;
+        }
+    }
+
+    GpuStageTimer::GpuStageTimer( MTL::Device* pDevice, std::vector< std::string > stageNames )
+    :   _pDevice{ pDevice->retain() }
+    ,   _pSampleBuffer{ nullptr }
+    ,   _stageNames{ std::move( stageNames ) }
+    ,   _sampleSet{ 0 }
+    ,   _startedStages{ 0 }
+    ,   _endedStages{ 0 }
+    ,   _cpuTimestamp{ 0 }
+    ,   _gpuTimestamp{ 0 }
+    {
+        assert( _stageNames.size() <= 32 );
+        
+        MTL::CounterSet* pCounterSet = findTimestampCounterSet( _pDevice );
+        if ( !pCounterSet || !_pDevice->supportsCounterSampling( MTL::CounterSamplingPointAtStageBoundary ) )
+        {
+            return;
+        }
+        
+        auto pSampleBufferDesc = NS::TransferPtr( MTL::CounterSampleBufferDescriptor::alloc()->init() );
+        pSampleBufferDesc->setCounterSet( pCounterSet );
+        pSampleBufferDesc->setStorageMode( MTL::StorageModeShared );
+        pSampleBufferDesc->setSampleCount( _stageNames.size() * 2 * MAX_FRAMES_IN_FLIGHT );
+        
+        NS::Error* pError = nullptr;
+        _pSampleBuffer = _pDevice->newCounterSampleBuffer( pSampleBufferDesc.get(), &pError );
+        if ( !_pSampleBuffer )
+        {
+            __builtin_printf( "%s", pError->localizedDescription()->utf8String() );
+            return;
+        }
+        
+        _pDevice->sampleTimestamps( &_cpuTimestamp, &_gpuTimestamp );
+    }
+
+    GpuStageTimer::~GpuStageTimer()
+    {
+        if ( _pSampleBuffer )
+        {
+            _pSampleBuffer->release();
+        }
+        _pDevice->release();
+    }
+
+    bool GpuStageTimer::isSupported() const
+    {
+        return _pSampleBuffer != nullptr;
+    }
+
+    void GpuStageTimer::beginFrame( uint64_t frameIndex )
+    {
+        _sampleSet = static_cast< uint32_t >( frameIndex % MAX_FRAMES_IN_FLIGHT );
+        _startedStages = 0;
+        _endedStages = 0;
+    }
+
+    void GpuStageTimer::attach( MTL::ComputePassDescriptor* pPassDescriptor, uint32_t stage, StageBoundary boundary /* = StageBoundary::Both */ )
+    {
+        attachSamples( pPassDescriptor, stage, boundary );
+    }
+
+    void GpuStageTimer::attach( MTL::BlitPassDescriptor* pPassDescriptor, uint32_t stage, StageBoundary boundary /* = StageBoundary::Both */ )
+    {
+        attachSamples( pPassDescriptor, stage, boundary );
+    }
+
+    template < typename PassDescriptor >
+    void GpuStageTimer::attachSamples( PassDescriptor* pPassDescriptor, uint32_t stage, StageBoundary boundary )
+    {
+        assert( stage < _stageNames.size() );
+        if ( !_pSampleBuffer )
+        {
+            return;
+        }
+        
+        // Each set holds a start and an end sample per stage
+        const NS::UInteger startIndex = ( static_cast< NS::UInteger >( _sampleSet ) * _stageNames.size() + stage ) * 2;
+        
+        auto* pAttachment = pPassDescriptor->sampleBufferAttachments()->object( 0 );
+        pAttachment->setSampleBuffer( _pSampleBuffer );
+        pAttachment->setStartOfEncoderSampleIndex( hasBoundary( boundary, StageBoundary::Start ) ? startIndex : COUNTER_DONT_SAMPLE );
+        pAttachment->setEndOfEncoderSampleIndex( hasBoundary( boundary, StageBoundary::End ) ? startIndex + 1 : COUNTER_DONT_SAMPLE );
+        
+        if ( hasBoundary( boundary, StageBoundary::Start ) )
+        {
+            _startedStages |= 1u << stage;
+        }
+        if ( hasBoundary( boundary, StageBoundary::End ) )
+        {
+            _endedStages |= 1u << stage;
+        }
+    }
+
+    void GpuStageTimer::track( MTL::CommandBuffer* pCommandBuffer, FrameProfiler& profiler )
+    {
+        const uint32_t sampledStages = _startedStages & _endedStages;
+        if ( !_pSampleBuffer || sampledStages == 0 )
+        {
+            return;
+        }
+        
+        const auto stageCount = static_cast< NS::UInteger >( _stageNames.size() );
+        const NS::Range sampleRange = NS::Range::Make( _sampleSet * stageCount * 2, stageCount * 2 );
+        FrameProfiler* pProfiler = &profiler;
+        pCommandBuffer->addCompletedHandler( ^void( MTL::CommandBuffer* ){
+            NS::Data* pData = this->_pSampleBuffer->resolveCounterRange( sampleRange );
+            if ( !pData )
+            {
+                return;
+            }
+            const auto* pSamples = static_cast< const MTL::CounterResultTimestamp* >( pData->mutableBytes() );
+            
+            // Ticks aren't nanoseconds on every GPU, the CPU clock since the timer was made gives the scale
+            uint64_t cpuTimestamp = 0;
+            uint64_t gpuTimestamp = 0;
+            this->_pDevice->sampleTimestamps( &cpuTimestamp, &gpuTimestamp );
+            const double nanosecondsPerTick = gpuTimestamp > this->_gpuTimestamp ? static_cast< double >( cpuTimestamp - this->_cpuTimestamp ) / ( gpuTimestamp - this->_gpuTimestamp )
+                                                                                 : 1.0;
+            
+            for ( uint32_t stage = 0; stage < stageCount; ++stage )
+            {
+                const uint64_t start = pSamples[ stage * 2 ].timestamp;
+                const uint64_t end = pSamples[ stage * 2 + 1 ].timestamp;
+                if ( ( sampledStages & ( 1u << stage ) ) == 0 || start == COUNTER_ERROR_VALUE || end == COUNTER_ERROR_VALUE || end < start )
+                {
+                    continue;
+                }
+                pProfiler->recordGpu( this->_stageNames[ stage ], ( end - start ) * nanosecondsPerTick * 1e-6 );
+            }
+        });
+    }
+}
@@ -0,0 +1,86 @@
+//
+//  GpuStageTimer.hpp
+//  Point_Cloud_Renderer
+//
+//  Created by Vatsalya Yadav on 10/19/26.
+//
+
+#ifndef GpuStageTimer_hpp
+#define GpuStageTimer_hpp
+
+#include <string>
+#include <vector>
+
+#include "Core/Core.hpp"
+
+FD_MTL
+
+namespace PCR
+{
+    class FrameProfiler;
+
+    // Which end of a pass samples the timestamp for a stage
+    enum class StageBoundary : uint32_t
+    {
+        Start = 1 << 0,
+        
+        End = 1 << 1,
+        
+        Both = Start | End
+    };
+
+    // Times named stages inside one command buffer from stage-boundary counter samples. A stage
+    // runs from the start sample of one pass to the end sample of another, so it may span several
+    // passes. Holds a set of samples per frame in flight; frames must complete before the timer
+    // is destroyed.
+    class GpuStageTimer
+    {
+    public:
+        GpuStageTimer( MTL::Device* pDevice, std::vector< std::string > stageNames );
+        
+        ~GpuStageTimer();
+        
+        GpuStageTimer( const GpuStageTimer& ) = delete;
+        
+        GpuStageTimer& operator=( const GpuStageTimer& ) = delete;
+        
+        // False where the device can't sample at stage boundaries, attach then does nothing
+        bool isSupported() const;
+        
+        // Picks this frame's set of samples, the pacer keeps its last frame from still being in flight
+        void beginFrame( uint64_t frameIndex );
+        
+        // Call before the encoder is made from pPassDescriptor
+        void attach( MTL::ComputePassDescriptor* pPassDescriptor, uint32_t stage, StageBoundary boundary = StageBoundary::Both );
+        
+        void attach( MTL::BlitPassDescriptor* pPassDescriptor, uint32_t stage, StageBoundary boundary = StageBoundary::Both );
+        
+        // Records every stage sampled at both ends this frame as a GPU timing once the command
+        // buffer completes. Must be called before the command buffer is committed.
+        void track( MTL::CommandBuffer* pCommandBuffer, FrameProfiler& profiler );
+
+    private:
+        MTL::Device* _pDevice;
+        
+        MTL::CounterSampleBuffer* _pSampleBuffer;
+        
+        std::vector< std::string > _stageNames;
+        
+        uint32_t _sampleSet;
+        
+        // Stages whose start and end were attached this frame, one bit each
+        uint32_t _startedStages;
+        
+        uint32_t _endedStages;
+        
+        // When the timer was made, GPU ticks are scaled to nanoseconds against it
+        uint64_t _cpuTimestamp;
+        
+        uint64_t _gpuTimestamp;
+        
+        template < typename PassDescriptor >
+        void attachSamples( PassDescriptor* pPassDescriptor, uint32_t stage, StageBoundary boundary );
+    };
+}
+
+#endif /* GpuStageTimer_hpp */
@@ -0,0 +1,508 @@
+//
+//  RenderGraph.cpp
+//  Point_Cloud_Renderer
+//
+//  Created by Vatsalya Yadav on 10/19/26.
+//
+
+#include "RenderGraph.hpp"
+
+#include <algorithm>
+#include <cassert>
+
+namespace PCR
+{
+    namespace
+    {
+        struct ResourceAccess
+        {
+            RenderGraphResource resource;
+            
+            bool reads;
+            
+            bool writes;
+            
+            uint32_t usage;
+        };
+        
+        void addAccess( std::vector< ResourceAccess >& accesses, RenderGraphResource resource, bool reads, bool writes, uint32_t usage )
+        {
+            for ( ResourceAccess& access : accesses )
+            {
+                if ( access.resource == resource )
+                {
+                    access.reads |= reads;
+                    access.writes |= writes;
+                    access.usage |= usage;
+                    return;
+                }
+            }
+            accesses.push_back( ResourceAccess{ resource, reads, writes, usage } );
+        }
+        
+        // Attachments without a clear load what is already there, so they read as well
+        std::vector< ResourceAccess > gatherAccesses( const RenderGraphPass& pass )
+        {
+            std::vector< ResourceAccess > accesses;
+            for ( RenderGraphResource resource : pass.reads )
+            {
+                addAccess( accesses, resource, true, false, RenderGraphTextureUsageShaderRead );
+            }
+            for ( RenderGraphResource resource : pass.writes )
+            {
+                addAccess( accesses, resource, false, true, RenderGraphTextureUsageShaderWrite );
+            }
+            for ( const RenderGraphAttachment& attachment : pass.colorAttachments )
+            {
+                addAccess( accesses, attachment.resource, !attachment.clear, true, RenderGraphTextureUsageRenderTarget );
+            }
+            if ( pass.depthAttachment.resource != INVALID_RENDER_GRAPH_RESOURCE )
+            {
+                addAccess( accesses, pass.depthAttachment.resource, !pass.depthAttachment.clear, true, RenderGraphTextureUsageRenderTarget );
+            }
+            return accesses;
+        }
+        
+        uint64_t alignUp( uint64_t value, uint64_t alignment )
+        {
+            return ( value + alignment - 1 ) / alignment * alignment;
+        }
+    }
+
+    RenderGraphPassBuilder::RenderGraphPassBuilder( RenderGraph* pGraph, uint32_t passIndex )
+    :   _pGraph{ pGraph }
+    ,   _passIndex{ passIndex }
+    {
+    }
+
+    RenderGraphPassBuilder& RenderGraphPassBuilder::read( RenderGraphResource resource )
+    {
+        assert( resource < _pGraph->_textures.size() );
+        _pGraph->_passes[ _passIndex ].reads.push_back( resource );
+        return *this;
+    }
+
+    RenderGraphPassBuilder& RenderGraphPassBuilder::write( RenderGraphResource resource )
+    {
+        assert( resource < _pGraph->_textures.size() );
+        _pGraph->_passes[ _passIndex ].writes.push_back( resource );
+        return *this;
+    }
+
+    RenderGraphPassBuilder& RenderGraphPassBuilder::colorAttachment( RenderGraphResource resource, uint32_t index )
+    {
+        assert( resource < _pGraph->_textures.size() );
+        RenderGraphAttachment attachment;
+        attachment.resource = resource;
+        attachment.index = index;
+        _pGraph->_passes[ _passIndex ].colorAttachments.push_back( attachment );
+        return *this;
+    }
+
+    RenderGraphPassBuilder& RenderGraphPassBuilder::colorAttachment( RenderGraphResource resource, uint32_t index, double r, double g, double b, double a )
+    {
+        colorAttachment( resource, index );
+        RenderGraphAttachment& attachment = _pGraph->_passes[ _passIndex ].colorAttachments.back();
+        attachment.clear = true;
+        attachment.clearValue[ 0 ] = r;
+        attachment.clearValue[ 1 ] = g;
+        attachment.clearValue[ 2 ] = b;
+        attachment.clearValue[ 3 ] = a;
+        return *this;
+    }
+
+    RenderGraphPassBuilder& RenderGraphPassBuilder::depthAttachment( RenderGraphResource resource )
+    {
+        assert( resource < _pGraph->_textures.size() );
+        _pGraph->_passes[ _passIndex ].depthAttachment.resource = resource;
+        return *this;
+    }
+
+    RenderGraphPassBuilder& RenderGraphPassBuilder::depthAttachment( RenderGraphResource resource, double clearDepth )
+    {
+        depthAttachment( resource );
+        RenderGraphAttachment& attachment = _pGraph->_passes[ _passIndex ].depthAttachment;
+        attachment.clear = true;
+        attachment.clearValue[ 0 ] = clearDepth;
+        return *this;
+    }
+
+    RenderGraphPassBuilder& RenderGraphPassBuilder::sideEffects()
+    {
+        _pGraph->_passes[ _passIndex ].sideEffects = true;
+        return *this;
+    }
+
+    void RenderGraph::reset()
+    {
+        _passes.clear();
+        _textures.clear();
+        _compiledPasses.clear();
+        _transientMemorySize = 0;
+        _unaliasedMemorySize = 0;
+    }
+
+    RenderGraphResource RenderGraph::createTexture( const char* name, const RenderGraphTextureDesc& desc )
+    {
+        RenderGraphTexture texture;
+        texture.name = name;
+        texture.desc = desc;
+        _textures.push_back( texture );
+        return static_cast< RenderGraphResource >( _textures.size() - 1 );
+    }
+
+    RenderGraphResource RenderGraph::importTexture( const char* name, MTL::Texture* pTexture )
+    {
+        RenderGraphTexture texture;
+        texture.name = name;
+        texture.imported = true;
+        texture.pImported = pTexture;
+        texture.output = true;
+        _textures.push_back( texture );
+        return static_cast< RenderGraphResource >( _textures.size() - 1 );
+    }
+
+    void RenderGraph::markOutput( RenderGraphResource resource )
+    {
+        assert( resource < _textures.size() );
+        _textures[ resource ].output = true;
+    }
+
+    RenderGraphPassBuilder RenderGraph::addPass( const char* name, RenderGraphPassType type, std::function< void( RenderGraphContext& ) > execute )
+    {
+        RenderGraphPass pass;
+        pass.name = name;
+        pass.type = type;
+        pass.execute = std::move( execute );
+        _passes.push_back( std::move( pass ) );
+        return RenderGraphPassBuilder( this, static_cast< uint32_t >( _passes.size() - 1 ) );
+    }
+
+    void RenderGraph::compile( const RenderGraphSizeFunction& sizeFunction )
+    {
+        _compiledPasses.clear();
+        for ( RenderGraphTexture& texture : _textures )
+        {
+            texture.usage = 0;
+            texture.firstPass = UINT32_MAX;
+            texture.lastPass = 0;
+            texture.heapOffset = 0;
+            texture.size = 0;
+        }
+        
+        const std::vector< bool > livePasses = cullPasses();
+        buildDependencies( livePasses );
+        assignAttachmentActions();
+        allocateTransients( sizeFunction );
+        
+        for ( const RenderGraphCompiledPass& compiledPass : _compiledPasses )
+        {
+            for ( uint32_t producer : compiledPass.waitFor )
+            {
+                _compiledPasses[ producer ].signals = true;
+            }
+        }
+    }
+
+    std::vector< bool > RenderGraph::cullPasses() const
+    {
+        // Walk backwards keeping track of which resources a later live pass still needs.
+        // A pass survives if it has side effects or writes something that is needed; a
+        // write satisfies the need, a read (including a loading attachment) creates one.
+        std::vector< bool > needed( _textures.size(), false );
+        for ( size_t i = 0; i < _textures.size(); ++i )
+        {
+            needed[ i ] = _textures[ i ].output;
+        }
+        
+        std::vector< bool > livePasses( _passes.size(), false );
+        for ( size_t p = _passes.size(); p-- > 0; )
+        {
+            const std::vector< ResourceAccess > accesses = gatherAccesses( _passes[ p ] );
+            
+            bool live = _passes[ p ].sideEffects;
+            for ( const ResourceAccess& access : accesses )
+            {
+                live |= access.writes && needed[ access.resource ];
+            }
+            if ( !live )
+            {
+                continue;
+            }
+            
+            livePasses[ p ] = true;
+            for ( const ResourceAccess& access : accesses )
+            {
+                if ( access.writes )
+                {
+                    needed[ access.resource ] = false;
+                }
+            }
+            for ( const ResourceAccess& access : accesses )
+            {
+                if ( access.reads )
+                {
+                    needed[ access.resource ] = true;
+                }
+            }
+        }
+        return livePasses;
+    }
+
+    void RenderGraph::buildDependencies( const std::vector< bool >& livePasses )
+    {
+        // Passes can only consume what earlier declarations produced, so declaration order
+        // of the surviving passes is already a valid topological order.
+        for ( uint32_t p = 0; p < _passes.size(); ++p )
+        {
+            if ( livePasses[ p ] )
+            {
+                RenderGraphCompiledPass compiledPass;
+                compiledPass.passIndex = p;
+                _compiledPasses.push_back( compiledPass );
+            }
+        }
+        
+        // Imported textures are regular tracked Metal resources, only the heap-placed
+        // transients need explicit synchronisation between passes
+        std::vector< uint32_t > lastWriter( _textures.size(), UINT32_MAX );
+        std::vector< std::vector< uint32_t > > readersSinceWrite( _textures.size() );
+        
+        for ( uint32_t c = 0; c < _compiledPasses.size(); ++c )
+        {
+            std::vector< uint32_t >& waitFor = _compiledPasses[ c ].waitFor;
+            
+            for ( const ResourceAccess& access : gatherAccesses( _passes[ _compiledPasses[ c ].passIndex ] ) )
+            {
+                RenderGraphTexture& texture = _textures[ access.resource ];
+                texture.usage |= access.usage;
+                texture.firstPass = std::min( texture.firstPass, c );
+                texture.lastPass = std::max( texture.lastPass, c );
+                
+                if ( texture.imported )
+                {
+                    continue;
+                }
+                
+                // Read after write, write after write
+                if ( lastWriter[ access.resource ] != UINT32_MAX )
+                {
+                    waitFor.push_back( lastWriter[ access.resource ] );
+                }
+                
+                if ( access.writes )
+                {
+                    // Write after read
+                    for ( uint32_t reader : readersSinceWrite[ access.resource ] )
+                    {
+                        waitFor.push_back( reader );
+                    }
+                    readersSinceWrite[ access.resource ].clear();
+                    lastWriter[ access.resource ] = c;
+                }
+                else
+                {
+                    readersSinceWrite[ access.resource ].push_back( c );
+                }
+            }
+        }
+    }
+
+    void RenderGraph::assignAttachmentActions()
+    {
+        auto isReadAfter = [ this ]( RenderGraphResource resource, uint32_t compiledIndex )
+        {
+            for ( uint32_t c = compiledIndex + 1; c < _compiledPasses.size(); ++c )
+            {
+                for ( const ResourceAccess& access : gatherAccesses( _passes[ _compiledPasses[ c ].passIndex ] ) )
+                {
+                    if ( access.resource == resource )
+                    {
+                        if ( access.reads )
+                        {
+                            return true;
+                        }
+                        if ( access.writes )
+                        {
+                            return false;
+                        }
+                    }
+                }
+            }
+            return false;
+        };
+        
+        auto assign = [ & ]( RenderGraphAttachment& attachment, uint32_t compiledIndex )
+        {
+            const RenderGraphTexture& texture = _textures[ attachment.resource ];
+            
+            if ( attachment.clear )
+            {
+                attachment.loadAction = RenderGraphLoadAction::Clear;
+            }
+            else if ( texture.imported || texture.firstPass < compiledIndex )
+            {
+                attachment.loadAction = RenderGraphLoadAction::Load;
+            }
+            else
+            {
+                // First use of a transient, there is nothing to load
+                attachment.loadAction = RenderGraphLoadAction::DontCare;
+            }
+            
+            const bool keep = ( texture.output && texture.lastPass == compiledIndex ) || isReadAfter( attachment.resource, compiledIndex );
+            attachment.storeAction = keep ? RenderGraphStoreAction::Store : RenderGraphStoreAction::DontCare;
+        };
+        
+        for ( uint32_t c = 0; c < _compiledPasses.size(); ++c )
+        {
+            RenderGraphPass& pass = _passes[ _compiledPasses[ c ].passIndex ];
+            for ( RenderGraphAttachment& attachment : pass.colorAttachments )
+            {
+                assign( attachment, c );
+            }
+            if ( pass.depthAttachment.resource != INVALID_RENDER_GRAPH_RESOURCE )
+            {
+                assign( pass.depthAttachment, c );
+            }
+        }
+    }
+
+    void RenderGraph::allocateTransients( const RenderGraphSizeFunction& sizeFunction )
+    {
+        std::vector< RenderGraphResource > transients;
+        for ( RenderGraphResource r = 0; r < _textures.size(); ++r )
+        {
+            RenderGraphTexture& texture = _textures[ r ];
+            if ( !texture.imported && texture.firstPass != UINT32_MAX )
+            {
+                transients.push_back( r );
+            }
+        }
+        
+        std::vector< RenderGraphAllocationSize > sizes( _textures.size() );
+        _unaliasedMemorySize = 0;
+        for ( RenderGraphResource r : transients )
+        {
+            sizes[ r ] = sizeFunction( _textures[ r ].desc, _textures[ r ].usage );
+            _textures[ r ].size = sizes[ r ].size;
+            _unaliasedMemorySize += alignUp( sizes[ r ].size, sizes[ r ].alignment );
+        }
+        
+        // Largest first, each texture goes into the lowest gap that none of the already
+        // placed textures alive at the same time occupies
+        std::stable_sort( transients.begin(), transients.end(), [ & ]( RenderGraphResource a, RenderGraphResource b ){
+            return sizes[ a ].size > sizes[ b ].size;
+        });
+        
+        std::vector< RenderGraphResource > placed;
+        _transientMemorySize = 0;
+        for ( RenderGraphResource r : transients )
+        {
+            RenderGraphTexture& texture = _textures[ r ];
+            
+            std::vector< RenderGraphResource > overlapping;
+            for ( RenderGraphResource other : placed )
+            {
+                const RenderGraphTexture& otherTexture = _textures[ other ];
+                if ( otherTexture.firstPass <= texture.lastPass && texture.firstPass <= otherTexture.lastPass )
+                {
+                    overlapping.push_back( other );
+                }
+            }
+            std::sort( overlapping.begin(), overlapping.end(), [ this ]( RenderGraphResource a, RenderGraphResource b ){
+                return _textures[ a ].heapOffset < _textures[ b ].heapOffset;
+            });
+            
+            uint64_t offset = 0;
+            for ( RenderGraphResource other : overlapping )
+            {
+                const RenderGraphTexture& otherTexture = _textures[ other ];
+                if ( alignUp( offset, sizes[ r ].alignment ) + texture.size <= otherTexture.heapOffset )
+                {
+                    break;
+                }
+                offset = std::max( offset, otherTexture.heapOffset + otherTexture.size );
+            }
+            texture.heapOffset = alignUp( offset, sizes[ r ].alignment );
+            _transientMemorySize = std::max( _transientMemorySize, texture.heapOffset + texture.size );
+            placed.push_back( r );
+        }
+        
+        // Memory handed from one texture to the next: the new owner's first pass has to
+        // wait until every pass that touched the previous owner is done with it
+        for ( RenderGraphResource r : transients )
+        {
+            const RenderGraphTexture& texture = _textures[ r ];
+            for ( RenderGraphResource other : transients )
+            {
+                const RenderGraphTexture& otherTexture = _textures[ other ];
+                const bool before = otherTexture.lastPass < texture.firstPass;
+                const bool sharesMemory = otherTexture.heapOffset < texture.heapOffset + texture.size
+                                       && texture.heapOffset < otherTexture.heapOffset + otherTexture.size;
+                if ( !before || !sharesMemory )
+                {
+                    continue;
+                }
+                
+                for ( uint32_t c = otherTexture.firstPass; c <= otherTexture.lastPass; ++c )
+                {
+                    for ( const ResourceAccess& access : gatherAccesses( _passes[ _compiledPasses[ c ].passIndex ] ) )
+                    {
+                        if ( access.resource == other )
+                        {
+                            _compiledPasses[ texture.firstPass ].waitFor.push_back( c );
+                        }
+                    }
+                }
+            }
+        }
+        
+        for ( RenderGraphCompiledPass& compiledPass : _compiledPasses )
+        {
+            std::vector< uint32_t >& waitFor = compiledPass.waitFor;
+            std::sort( waitFor.begin(), waitFor.end() );
+            waitFor.erase( std::unique( waitFor.begin(), waitFor.end() ), waitFor.end() );
+        }
+    }
+
+    const std::vector< RenderGraphCompiledPass >& RenderGraph::getCompiledPasses() const
+    {
+        return _compiledPasses;
+    }
+
+    const RenderGraphPass& RenderGraph::getPass( uint32_t passIndex ) const
+    {
+        return _passes[ passIndex ];
+    }
+
+    const RenderGraphTexture& RenderGraph::getTexture( RenderGraphResource resource ) const
+    {
+        return _textures[ resource ];
+    }
+
+    uint32_t RenderGraph::getPassCount() const
+    {
+        return static_cast< uint32_t >( _passes.size() );
+    }
+
+    uint32_t RenderGraph::getTextureCount() const
+    {
+        return static_cast< uint32_t >( _textures.size() );
+    }
+
+    uint32_t RenderGraph::getCulledPassCount() const
+    {
+        return static_cast< uint32_t >( _passes.size() - _compiledPasses.size() );
+    }
+
+    uint64_t RenderGraph::getTransientMemorySize() const
+    {
+        return _transientMemorySize;
+    }
+
+    uint64_t RenderGraph::getUnaliasedMemorySize() const
+    {
+        return _unaliasedMemorySize;
+    }
+}
@@ -0,0 +1,245 @@
+//
+//  RenderGraph.hpp
+//  Point_Cloud_Renderer
+//
+//  Created by Vatsalya Yadav on 10/19/26.
+//
+
+#ifndef RenderGraph_hpp
+#define RenderGraph_hpp
+
+#include <cstdint>
+#include <functional>
+#include <string>
+#include <vector>
+
+#include "Core/Core.hpp"
+
+FD_MTL
+
+namespace PCR
+{
+    class RenderGraphContext;
+
+    using RenderGraphResource = uint32_t;
+
+    constexpr RenderGraphResource INVALID_RENDER_GRAPH_RESOURCE{ UINT32_MAX };
+
+    // Bit values match MTL::TextureUsage so the executor can pass them straight through
+    enum RenderGraphTextureUsage : uint32_t
+    {
+        RenderGraphTextureUsageShaderRead   = 1 << 0,
+        RenderGraphTextureUsageShaderWrite  = 1 << 1,
+        RenderGraphTextureUsageRenderTarget = 1 << 2
+    };
+
+    struct RenderGraphTextureDesc
+    {
+        uint32_t width = 0;
+        
+        uint32_t height = 0;
+        
+        // MTL::PixelFormat value, kept as an integer so the graph compiles without Metal
+        uint64_t pixelFormat = 0;
+        
+        bool operator==( const RenderGraphTextureDesc& other ) const = default;
+    };
+
+    struct RenderGraphAllocationSize
+    {
+        uint64_t size = 0;
+        
+        uint64_t alignment = 1;
+    };
+
+    // Device specific, MTL::Device::heapTextureSizeAndAlign on Metal
+    using RenderGraphSizeFunction = std::function< RenderGraphAllocationSize( const RenderGraphTextureDesc&, uint32_t usage ) >;
+
+    enum class RenderGraphPassType
+    {
+        Render,
+        Compute,
+        // Copies, read() and write() still order it against the other passes
+        Blit
+    };
+
+    enum class RenderGraphLoadAction
+    {
+        DontCare,
+        Load,
+        Clear
+    };
+
+    enum class RenderGraphStoreAction
+    {
+        DontCare,
+        Store
+    };
+
+    struct RenderGraphAttachment
+    {
+        RenderGraphResource resource = INVALID_RENDER_GRAPH_RESOURCE;
+        
+        // Only used for colour attachments
+        uint32_t index = 0;
+        
+        bool clear = false;
+        
+        double clearValue[ 4 ] = { 0.0, 0.0, 0.0, 0.0 };
+        
+        // Filled in by compile()
+        RenderGraphLoadAction loadAction = RenderGraphLoadAction::DontCare;
+        
+        RenderGraphStoreAction storeAction = RenderGraphStoreAction::Store;
+    };
+
+    struct RenderGraphPass
+    {
+        std::string name;
+        
+        RenderGraphPassType type = RenderGraphPassType::Render;
+        
+        std::function< void( RenderGraphContext& ) > execute;
+        
+        std::vector< RenderGraphResource > reads;
+        
+        std::vector< RenderGraphResource > writes;
+        
+        std::vector< RenderGraphAttachment > colorAttachments;
+        
+        RenderGraphAttachment depthAttachment;
+        
+        // Never culled, e.g. passes writing persistent data the graph doesn't see
+        bool sideEffects = false;
+    };
+
+    struct RenderGraphTexture
+    {
+        std::string name;
+        
+        RenderGraphTextureDesc desc;
+        
+        // Owned outside the graph, pImported may be null when compiling without a device
+        bool imported = false;
+        
+        MTL::Texture* pImported = nullptr;
+        
+        bool output = false;
+        
+        // Filled in by compile(), transient textures only
+        uint32_t usage = 0;
+        
+        uint32_t firstPass = UINT32_MAX;
+        
+        uint32_t lastPass = 0;
+        
+        uint64_t heapOffset = 0;
+        
+        uint64_t size = 0;
+    };
+
+    struct RenderGraphCompiledPass
+    {
+        uint32_t passIndex = 0;
+        
+        // Earlier compiled passes whose GPU work has to finish first, either because they
+        // produce something this pass uses or because they last used memory it now reuses
+        std::vector< uint32_t > waitFor;
+        
+        // Some later compiled pass waits on this one
+        bool signals = false;
+    };
+
+    class RenderGraph;
+
+    class RenderGraphPassBuilder
+    {
+    public:
+        RenderGraphPassBuilder( RenderGraph* pGraph, uint32_t passIndex );
+        
+        // Sampled or read in a shader
+        RenderGraphPassBuilder& read( RenderGraphResource resource );
+        
+        // Written from a compute shader
+        RenderGraphPassBuilder& write( RenderGraphResource resource );
+        
+        // Without a clear the previous contents are loaded
+        RenderGraphPassBuilder& colorAttachment( RenderGraphResource resource, uint32_t index );
+        
+        RenderGraphPassBuilder& colorAttachment( RenderGraphResource resource, uint32_t index, double r, double g, double b, double a );
+        
+        RenderGraphPassBuilder& depthAttachment( RenderGraphResource resource );
+        
+        RenderGraphPassBuilder& depthAttachment( RenderGraphResource resource, double clearDepth );
+        
+        RenderGraphPassBuilder& sideEffects();
+
+    private:
+        RenderGraph* _pGraph;
+        
+        uint32_t _passIndex;
+    };
+
+    // Declarative frame description. Passes are declared in submission order with the
+    // resources they touch; compile() culls passes nothing depends on, works out which
+    // passes have to wait for which, picks attachment load/store actions and places the
+    // transient textures in one heap, sharing memory between textures whose lifetimes
+    // don't overlap. Nothing here talks to Metal, see RenderGraphExecutor for that.
+    class RenderGraph
+    {
+    public:
+        void reset();
+        
+        RenderGraphResource createTexture( const char* name, const RenderGraphTextureDesc& desc );
+        
+        RenderGraphResource importTexture( const char* name, MTL::Texture* pTexture );
+        
+        // Keeps the passes producing this resource alive, imported textures are always outputs
+        void markOutput( RenderGraphResource resource );
+        
+        RenderGraphPassBuilder addPass( const char* name, RenderGraphPassType type, std::function< void( RenderGraphContext& ) > execute );
+        
+        void compile( const RenderGraphSizeFunction& sizeFunction );
+        
+        const std::vector< RenderGraphCompiledPass >& getCompiledPasses() const;
+        
+        const RenderGraphPass& getPass( uint32_t passIndex ) const;
+        
+        const RenderGraphTexture& getTexture( RenderGraphResource resource ) const;
+        
+        uint32_t getPassCount() const;
+        
+        uint32_t getTextureCount() const;
+        
+        uint32_t getCulledPassCount() const;
+        
+        // Heap size the transient textures need after aliasing
+        uint64_t getTransientMemorySize() const;
+        
+        // What the same textures would take with one allocation each
+        uint64_t getUnaliasedMemorySize() const;
+
+    private:
+        friend class RenderGraphPassBuilder;
+        
+        std::vector< RenderGraphPass > _passes;
+        
+        std::vector< RenderGraphTexture > _textures;
+        
+        std::vector< RenderGraphCompiledPass > _compiledPasses;
+        
+        uint64_t _transientMemorySize = 0;
+        
+        uint64_t _unaliasedMemorySize = 0;
+        
+        std::vector< bool > cullPasses() const;
+        
+        void buildDependencies( const std::vector< bool >& livePasses );
+        
+        void assignAttachmentActions();
+        
+        void allocateTransients( const RenderGraphSizeFunction& sizeFunction );
+    };
+}
+
+#endif /* RenderGraph_hpp */
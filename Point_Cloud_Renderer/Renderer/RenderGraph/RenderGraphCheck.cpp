@@ -0,0 +1,208 @@
+//
+//  RenderGraphCheck.cpp
+//  Point_Cloud_Renderer
+//
+//  Created by Vatsalya Yadav on 10/19/26.
+//
+
+#include "RenderGraphCheck.hpp"
+
+#include <vector>
+
+#include "Renderer/RenderGraph/RenderGraph.hpp"
+#include "Renderer/Validation/CheckReport.hpp"
+
+namespace PCR
+{
+    namespace
+    {
+        // MTL::PixelFormat values, the graph only passes them to the size function
+        constexpr uint64_t PIXEL_FORMAT_RGBA8_UNORM{ 70 };
+        
+        constexpr uint64_t PIXEL_FORMAT_RGBA16_FLOAT{ 115 };
+        
+        constexpr uint64_t PIXEL_FORMAT_DEPTH32_FLOAT{ 252 };
+        
+        constexpr uint32_t SIZE{ 256 };
+        
+        // What heapTextureSizeAndAlign reports is device specific, pages are enough here
+        constexpr uint64_t ALIGNMENT{ 4096 };
+        
+        constexpr uint64_t KB{ 1024 };
+        
+        RenderGraphAllocationSize getStubSize( const RenderGraphTextureDesc& desc, uint32_t )
+        {
+            const uint64_t bytesPerPixel = desc.pixelFormat == PIXEL_FORMAT_RGBA16_FLOAT ? 8 : 4;
+            return RenderGraphAllocationSize{ desc.width * desc.height * bytesPerPixel, ALIGNMENT };
+        }
+        
+        void noop( RenderGraphContext& )
+        {
+        }
+        
+        struct Frame
+        {
+            RenderGraphResource shadow;
+            
+            RenderGraphResource depth;
+            
+            RenderGraphResource gbuffer;
+            
+            RenderGraphResource lighting;
+            
+            RenderGraphResource debug;
+            
+            RenderGraphResource post;
+            
+            RenderGraphResource backbuffer;
+        };
+        
+        // Declared   compiled   touches
+        // shadow     0          clears the shadow map
+        // geometry   1          reads the shadow map, clears gbuffer and depth
+        // debug      -          reads gbuffer into debug, which nothing reads
+        // lighting   2          reads gbuffer, writes lighting
+        // bloom      3          overwrites gbuffer
+        // post       4          reads gbuffer and lighting, clears post
+        // composite  5          reads post, loads the imported backbuffer
+        Frame buildFrame( RenderGraph& graph )
+        {
+            Frame frame;
+            frame.shadow = graph.createTexture( "shadow", RenderGraphTextureDesc{ 2 * SIZE, 2 * SIZE, PIXEL_FORMAT_DEPTH32_FLOAT } );
+            frame.depth = graph.createTexture( "depth", RenderGraphTextureDesc{ SIZE, SIZE, PIXEL_FORMAT_DEPTH32_FLOAT } );
+            frame.gbuffer = graph.createTexture( "gbuffer", RenderGraphTextureDesc{ SIZE, SIZE, PIXEL_FORMAT_RGBA16_FLOAT } );
+            frame.lighting = graph.createTexture( "lighting", RenderGraphTextureDesc{ SIZE, SIZE, PIXEL_FORMAT_RGBA16_FLOAT } );
+            frame.debug = graph.createTexture( "debug", RenderGraphTextureDesc{ SIZE, SIZE, PIXEL_FORMAT_RGBA8_UNORM } );
+            frame.post = graph.createTexture( "post", RenderGraphTextureDesc{ SIZE, SIZE, PIXEL_FORMAT_RGBA8_UNORM } );
+            frame.backbuffer = graph.importTexture( "backbuffer", nullptr );
+            
+            graph.addPass( "shadow", RenderGraphPassType::Render, noop ).depthAttachment( frame.shadow, 1.0 );
+            graph.addPass( "geometry", RenderGraphPassType::Render, noop ).read( frame.shadow ).colorAttachment( frame.gbuffer, 0, 0.0, 0.0, 0.0, 1.0 ).depthAttachment( frame.depth, 1.0 );
+            graph.addPass( "debug", RenderGraphPassType::Render, noop ).read( frame.gbuffer ).colorAttachment( frame.debug, 0, 0.0, 0.0, 0.0, 1.0 );
+            graph.addPass( "lighting", RenderGraphPassType::Compute, noop ).read( frame.gbuffer ).write( frame.lighting );
+            graph.addPass( "bloom", RenderGraphPassType::Compute, noop ).write( frame.gbuffer );
+            graph.addPass( "post", RenderGraphPassType::Render, noop ).read( frame.gbuffer ).read( frame.lighting ).colorAttachment( frame.post, 0, 0.0, 0.0, 0.0, 1.0 );
+            graph.addPass( "composite", RenderGraphPassType::Render, noop ).read( frame.post ).colorAttachment( frame.backbuffer, 0 );
+            return frame;
+        }
+        
+        bool waitsFor( const RenderGraph& graph, uint32_t compiledIndex, const std::vector< uint32_t >& expected )
+        {
+            return graph.getCompiledPasses()[ compiledIndex ].waitFor == expected;
+        }
+        
+        // No two transients alive in a common pass share a byte, and each is aligned
+        bool aliasesSafely( const RenderGraph& graph )
+        {
+            for ( RenderGraphResource a = 0; a < graph.getTextureCount(); ++a )
+            {
+                const RenderGraphTexture& textureA = graph.getTexture( a );
+                if ( textureA.imported || textureA.firstPass == UINT32_MAX )
+                {
+                    continue;
+                }
+                if ( textureA.heapOffset % ALIGNMENT != 0 || textureA.heapOffset + textureA.size > graph.getTransientMemorySize() )
+                {
+                    return false;
+                }
+                
+                for ( RenderGraphResource b = a + 1; b < graph.getTextureCount(); ++b )
+                {
+                    const RenderGraphTexture& textureB = graph.getTexture( b );
+                    if ( textureB.imported || textureB.firstPass == UINT32_MAX )
+                    {
+                        continue;
+                    }
+                    
+                    const bool liveTogether = textureA.firstPass <= textureB.lastPass && textureB.firstPass <= textureA.lastPass;
+                    const bool sharesMemory = textureA.heapOffset < textureB.heapOffset + textureB.size && textureB.heapOffset < textureA.heapOffset + textureA.size;
+                    if ( liveTogether && sharesMemory )
+                    {
+                        return false;
+                    }
+                }
+            }
+            return true;
+        }
+        
+        void checkCulling( CheckReport& report, const RenderGraph& graph, const Frame& frame )
+        {
+            const std::vector< RenderGraphCompiledPass >& passes = graph.getCompiledPasses();
+            std::vector< uint32_t > passIndices;
+            for ( const RenderGraphCompiledPass& pass : passes )
+            {
+                passIndices.push_back( pass.passIndex );
+            }
+            
+            report.expect( graph.getCulledPassCount() == 1 && passIndices == std::vector< uint32_t >{ 0, 1, 3, 4, 5, 6 }, "culling: only the pass whose output nobody reads is dropped" );
+            report.expect( graph.getTexture( frame.debug ).firstPass == UINT32_MAX && graph.getTexture( frame.debug ).size == 0, "culling: the culled pass's texture gets no memory" );
+        }
+        
+        void checkDependencies( CheckReport& report, const RenderGraph& graph )
+        {
+            report.expect( waitsFor( graph, 0, {} ), "waits: shadow waits on nothing" );
+            report.expect( waitsFor( graph, 1, { 0 } ), "waits: geometry reads the shadow map" );
+            
+            // lighting's memory was the shadow map's, which geometry read last
+            report.expect( waitsFor( graph, 2, { 0, 1 } ), "waits: lighting waits on the gbuffer's writer and on the previous owners of its memory" );
+            report.expect( waitsFor( graph, 3, { 1, 2 } ), "waits: bloom overwriting the gbuffer waits on geometry's write and lighting's read" );
+            report.expect( waitsFor( graph, 4, { 0, 1, 2, 3 } ), "waits: post waits on lighting and bloom, and on the shadow map's passes for its memory" );
+            report.expect( waitsFor( graph, 5, { 4 } ), "waits: composite waits on post only, the imported backbuffer is tracked by Metal" );
+            
+            const std::vector< RenderGraphCompiledPass >& passes = graph.getCompiledPasses();
+            bool signalsMatch = true;
+            for ( uint32_t c = 0; c < passes.size(); ++c )
+            {
+                signalsMatch = signalsMatch && passes[ c ].signals == ( c + 1 < passes.size() );
+            }
+            report.expect( signalsMatch, "waits: exactly the passes someone waits on signal" );
+        }
+        
+        void checkAttachmentActions( CheckReport& report, const RenderGraph& graph )
+        {
+            const RenderGraphPass& geometry = graph.getPass( 1 );
+            report.expect( geometry.colorAttachments[ 0 ].loadAction == RenderGraphLoadAction::Clear && geometry.colorAttachments[ 0 ].storeAction == RenderGraphStoreAction::Store,
+                           "attachments: a cleared target read later is stored" );
+            report.expect( geometry.depthAttachment.loadAction == RenderGraphLoadAction::Clear && geometry.depthAttachment.storeAction == RenderGraphStoreAction::DontCare,
+                           "attachments: depth nobody reads afterwards isn't stored" );
+            
+            const RenderGraphPass& composite = graph.getPass( 6 );
+            report.expect( composite.colorAttachments[ 0 ].loadAction == RenderGraphLoadAction::Load && composite.colorAttachments[ 0 ].storeAction == RenderGraphStoreAction::Store,
+                           "attachments: the imported output is loaded and stored" );
+        }
+        
+        void checkAliasing( CheckReport& report, const RenderGraph& graph, const Frame& frame )
+        {
+            // Lifetimes in compiled passes: shadow 0-1, depth 1, gbuffer 1-4, lighting 2-4, post
+            // 4-5. Largest first, lighting and then post land inside the shadow map's megabyte.
+            report.expect( aliasesSafely( graph ), "aliasing: no two textures alive together overlap in the heap" );
+            report.expect( graph.getTexture( frame.shadow ).heapOffset == 0
+                        && graph.getTexture( frame.gbuffer ).heapOffset == 1024 * KB
+                        && graph.getTexture( frame.depth ).heapOffset == 1536 * KB
+                        && graph.getTexture( frame.lighting ).heapOffset == 0
+                        && graph.getTexture( frame.post ).heapOffset == 512 * KB,
+                           "aliasing: lighting and post reuse the shadow map's memory" );
+            report.expect( graph.getUnaliasedMemorySize() == 2560 * KB && graph.getTransientMemorySize() == 1792 * KB,
+                           "aliasing: 1.75 MB of heap against 2.5 MB unaliased" );
+        }
+    }
+
+    bool runRenderGraphChecks()
+    {
+        CheckReport report( "Render graph compile, stub sizes" );
+        
+        RenderGraph graph;
+        const Frame frame = buildFrame( graph );
+        graph.compile( getStubSize );
+        
+        checkCulling( report, graph, frame );
+        checkDependencies( report, graph );
+        checkAttachmentActions( report, graph );
+        checkAliasing( report, graph, frame );
+        
+        // A second compile of the same graph gives the same result
+        graph.compile( getStubSize );
+        report.expect( aliasesSafely( graph ) && waitsFor( graph, 4, { 0, 1, 2, 3 } ) && graph.getTransientMemorySize() == 1792 * KB, "recompile: the result doesn't depend on the previous compile" );
+        return report.finish();
+    }
+}
@@ -0,0 +1,22 @@
+//
+//  RenderGraphCheck.hpp
+//  Point_Cloud_Renderer
+//
+//  Created by Vatsalya Yadav on 10/19/26.
+//
+
+#ifndef RenderGraphCheck_hpp
+#define RenderGraphCheck_hpp
+
+namespace PCR
+{
+    // RenderGraph::compile on a small deferred-style frame with a stand-in size function, no
+    // device involved: a pass nobody reads from is culled, every pass waits on exactly the
+    // producers, earlier readers and previous memory owners it has to, attachments get the
+    // load and store actions their neighbours imply, and transients whose lifetimes don't
+    // overlap share heap memory without any live pair colliding.
+    // Returns false if any check fails.
+    bool runRenderGraphChecks();
+}
+
+#endif /* RenderGraphCheck_hpp */
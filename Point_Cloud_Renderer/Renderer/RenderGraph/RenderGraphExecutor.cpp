@@ -0,0 +1,319 @@
+//
+//  RenderGraphExecutor.cpp
+//  Point_Cloud_Renderer
+//
+//  Created by Vatsalya Yadav on 10/19/26.
+//
+
+#include "RenderGraphExecutor.hpp"
+
+#include <algorithm>
+#include <cassert>
+
+#include <Metal/Metal.hpp>
+
+namespace PCR
+{
+    namespace
+    {
+        NS::SharedPtr< MTL::TextureDescriptor > makeTextureDescriptor( const RenderGraphTextureDesc& desc, uint32_t usage )
+        {
+            auto pTextureDesc = NS::TransferPtr( MTL::TextureDescriptor::alloc()->init() );
+            pTextureDesc->setTextureType( MTL::TextureType2D );
+            pTextureDesc->setWidth( desc.width );
+            pTextureDesc->setHeight( desc.height );
+            pTextureDesc->setPixelFormat( static_cast< MTL::PixelFormat >( desc.pixelFormat ) );
+            pTextureDesc->setStorageMode( MTL::StorageModePrivate );
+            pTextureDesc->setUsage( static_cast< MTL::TextureUsage >( usage ) );
+            return pTextureDesc;
+        }
+        
+        MTL::LoadAction toMetal( RenderGraphLoadAction loadAction )
+        {
+            switch ( loadAction )
+            {
+                case RenderGraphLoadAction::Load:  return MTL::LoadActionLoad;
+                case RenderGraphLoadAction::Clear: return MTL::LoadActionClear;
+                default:                           return MTL::LoadActionDontCare;
+            }
+        }
+        
+        MTL::StoreAction toMetal( RenderGraphStoreAction storeAction )
+        {
+            return storeAction == RenderGraphStoreAction::Store ? MTL::StoreActionStore : MTL::StoreActionDontCare;
+        }
+    }
+
+    MTL::Texture* RenderGraphContext::getTexture( RenderGraphResource resource ) const
+    {
+        return ( *_pTextures )[ resource ];
+    }
+
+    MTL::CommandBuffer* RenderGraphContext::getCommandBuffer() const
+    {
+        return _pCommandBuffer;
+    }
+
+    MTL::RenderCommandEncoder* RenderGraphContext::getRenderEncoder() const
+    {
+        assert( _pRenderEncoder );
+        return _pRenderEncoder;
+    }
+
+    MTL::ComputeCommandEncoder* RenderGraphContext::getComputeEncoder() const
+    {
+        assert( _pComputeEncoder );
+        return _pComputeEncoder;
+    }
+
+    MTL::BlitCommandEncoder* RenderGraphContext::getBlitEncoder() const
+    {
+        assert( _pBlitEncoder );
+        return _pBlitEncoder;
+    }
+
+    RenderGraphExecutor::RenderGraphExecutor( MTL::Device* pDevice, uint32_t frameCount /* = MAX_FRAMES_IN_FLIGHT */ )
+    :   _pDevice{ pDevice->retain() }
+    ,   _frames( frameCount )
+    ,   _frameIndex{ 0 }
+    {
+    }
+
+    RenderGraphExecutor::~RenderGraphExecutor()
+    {
+        for ( FrameResources& frame : _frames )
+        {
+            for ( TransientTexture& texture : frame.textures )
+            {
+                texture.pTexture->release();
+            }
+            if ( frame.pHeap )
+            {
+                frame.pHeap->release();
+            }
+        }
+        for ( MTL::Fence* pFence : _fences )
+        {
+            pFence->release();
+        }
+        _pDevice->release();
+    }
+
+    RenderGraphSizeFunction RenderGraphExecutor::getSizeFunction() const
+    {
+        MTL::Device* pDevice = _pDevice;
+        return [ pDevice ]( const RenderGraphTextureDesc& desc, uint32_t usage )
+        {
+            auto pTextureDesc = makeTextureDescriptor( desc, usage );
+            const MTL::SizeAndAlign sizeAndAlign = pDevice->heapTextureSizeAndAlign( pTextureDesc.get() );
+            return RenderGraphAllocationSize{ sizeAndAlign.size, sizeAndAlign.align };
+        };
+    }
+
+    uint64_t RenderGraphExecutor::getHeapSize() const
+    {
+        const FrameResources& frame = _frames[ _frameIndex ];
+        return frame.pHeap ? frame.pHeap->size() : 0;
+    }
+
+    void RenderGraphExecutor::execute( RenderGraph& graph, MTL::CommandBuffer* pCommandBuffer )
+    {
+        graph.compile( getSizeFunction() );
+        
+        _frameIndex = ( _frameIndex + 1 ) % _frames.size();
+        FrameResources& frame = _frames[ _frameIndex ];
+        reserveHeap( frame, graph.getTransientMemorySize() );
+        
+        _resolvedTextures.assign( graph.getTextureCount(), nullptr );
+        for ( RenderGraphResource r = 0; r < graph.getTextureCount(); ++r )
+        {
+            const RenderGraphTexture& texture = graph.getTexture( r );
+            if ( texture.imported )
+            {
+                _resolvedTextures[ r ] = texture.pImported;
+            }
+            else if ( texture.firstPass != UINT32_MAX )
+            {
+                _resolvedTextures[ r ] = acquireTexture( frame, texture );
+            }
+        }
+        releaseUnusedTextures( frame );
+        
+        const std::vector< RenderGraphCompiledPass >& compiledPasses = graph.getCompiledPasses();
+        while ( _fences.size() < compiledPasses.size() )
+        {
+            _fences.push_back( _pDevice->newFence() );
+        }
+        
+        RenderGraphContext context;
+        context._pTextures = &_resolvedTextures;
+        context._pCommandBuffer = pCommandBuffer;
+        
+        for ( uint32_t c = 0; c < compiledPasses.size(); ++c )
+        {
+            const RenderGraphCompiledPass& compiledPass = compiledPasses[ c ];
+            const RenderGraphPass& pass = graph.getPass( compiledPass.passIndex );
+            
+            context._pRenderEncoder = nullptr;
+            context._pComputeEncoder = nullptr;
+            context._pBlitEncoder = nullptr;
+            
+            if ( pass.type == RenderGraphPassType::Render )
+            {
+                MTL::RenderPassDescriptor* pRenderPassDescriptor = MTL::RenderPassDescriptor::renderPassDescriptor();
+                for ( const RenderGraphAttachment& attachment : pass.colorAttachments )
+                {
+                    MTL::RenderPassColorAttachmentDescriptor* pColorAttachment = pRenderPassDescriptor->colorAttachments()->object( attachment.index );
+                    pColorAttachment->setTexture( _resolvedTextures[ attachment.resource ] );
+                    pColorAttachment->setLoadAction( toMetal( attachment.loadAction ) );
+                    pColorAttachment->setStoreAction( toMetal( attachment.storeAction ) );
+                    pColorAttachment->setClearColor( MTL::ClearColor::Make( attachment.clearValue[ 0 ],
+                                                                            attachment.clearValue[ 1 ],
+                                                                            attachment.clearValue[ 2 ],
+                                                                            attachment.clearValue[ 3 ] ) );
+                }
+                if ( pass.depthAttachment.resource != INVALID_RENDER_GRAPH_RESOURCE )
+                {
+                    MTL::RenderPassDepthAttachmentDescriptor* pDepthAttachment = pRenderPassDescriptor->depthAttachment();
+                    pDepthAttachment->setTexture( _resolvedTextures[ pass.depthAttachment.resource ] );
+                    pDepthAttachment->setLoadAction( toMetal( pass.depthAttachment.loadAction ) );
+                    pDepthAttachment->setStoreAction( toMetal( pass.depthAttachment.storeAction ) );
+                    pDepthAttachment->setClearDepth( pass.depthAttachment.clearValue[ 0 ] );
+                }
+                
+                MTL::RenderCommandEncoder* pEncoder = pCommandBuffer->renderCommandEncoder( pRenderPassDescriptor );
+                pEncoder->setLabel( CreateUTF8String( pass.name.c_str() ) );
+                for ( uint32_t producer : compiledPass.waitFor )
+                {
+                    pEncoder->waitForFence( _fences[ producer ], MTL::RenderStageVertex );
+                }
+                
+                context._pRenderEncoder = pEncoder;
+                if ( pass.execute )
+                {
+                    pass.execute( context );
+                }
+                
+                if ( compiledPass.signals )
+                {
+                    pEncoder->updateFence( _fences[ c ], MTL::RenderStageFragment );
+                }
+                pEncoder->endEncoding();
+            }
+            else if ( pass.type == RenderGraphPassType::Blit )
+            {
+                MTL::BlitCommandEncoder* pEncoder = pCommandBuffer->blitCommandEncoder();
+                pEncoder->setLabel( CreateUTF8String( pass.name.c_str() ) );
+                for ( uint32_t producer : compiledPass.waitFor )
+                {
+                    pEncoder->waitForFence( _fences[ producer ] );
+                }
+                
+                context._pBlitEncoder = pEncoder;
+                if ( pass.execute )
+                {
+                    pass.execute( context );
+                }
+                
+                if ( compiledPass.signals )
+                {
+                    pEncoder->updateFence( _fences[ c ] );
+                }
+                pEncoder->endEncoding();
+            }
+            else
+            {
+                MTL::ComputeCommandEncoder* pEncoder = pCommandBuffer->computeCommandEncoder();
+                pEncoder->setLabel( CreateUTF8String( pass.name.c_str() ) );
+                for ( uint32_t producer : compiledPass.waitFor )
+                {
+                    pEncoder->waitForFence( _fences[ producer ] );
+                }
+                
+                context._pComputeEncoder = pEncoder;
+                if ( pass.execute )
+                {
+                    pass.execute( context );
+                }
+                
+                if ( compiledPass.signals )
+                {
+                    pEncoder->updateFence( _fences[ c ] );
+                }
+                pEncoder->endEncoding();
+            }
+        }
+    }
+
+    void RenderGraphExecutor::reserveHeap( FrameResources& frame, uint64_t size )
+    {
+        if ( size == 0 || ( frame.pHeap && frame.pHeap->size() >= size ) )
+        {
+            return;
+        }
+        
+        // Textures placed in the old heap go with it
+        for ( TransientTexture& texture : frame.textures )
+        {
+            texture.pTexture->release();
+        }
+        frame.textures.clear();
+        if ( frame.pHeap )
+        {
+            frame.pHeap->release();
+        }
+        
+        auto pHeapDesc = NS::TransferPtr( MTL::HeapDescriptor::alloc()->init() );
+        pHeapDesc->setType( MTL::HeapTypePlacement );
+        pHeapDesc->setStorageMode( MTL::StorageModePrivate );
+        pHeapDesc->setHazardTrackingMode( MTL::HazardTrackingModeUntracked );
+        pHeapDesc->setSize( size );
+        frame.pHeap = _pDevice->newHeap( pHeapDesc.get() );
+        assert( frame.pHeap );
+    }
+
+    MTL::Texture* RenderGraphExecutor::acquireTexture( FrameResources& frame, const RenderGraphTexture& texture )
+    {
+        // Same description at the same offset across frames reuses the texture object
+        for ( TransientTexture& cached : frame.textures )
+        {
+            if ( !cached.used && cached.desc == texture.desc && cached.usage == texture.usage && cached.heapOffset == texture.heapOffset )
+            {
+                cached.used = true;
+                return cached.pTexture;
+            }
+        }
+        
+        auto pTextureDesc = makeTextureDescriptor( texture.desc, texture.usage );
+        
+        TransientTexture transient;
+        transient.desc = texture.desc;
+        transient.usage = texture.usage;
+        transient.heapOffset = texture.heapOffset;
+        transient.pTexture = frame.pHeap->newTexture( pTextureDesc.get(), texture.heapOffset );
+        transient.pTexture->setLabel( CreateUTF8String( texture.name.c_str() ) );
+        transient.used = true;
+        frame.textures.push_back( transient );
+        return transient.pTexture;
+    }
+
+    void RenderGraphExecutor::releaseUnusedTextures( FrameResources& frame )
+    {
+        for ( TransientTexture& texture : frame.textures )
+        {
+            if ( !texture.used )
+            {
+                texture.pTexture->release();
+                texture.pTexture = nullptr;
+            }
+        }
+        frame.textures.erase( std::remove_if( frame.textures.begin(), frame.textures.end(), []( const TransientTexture& texture ){
+            return texture.pTexture == nullptr;
+        }), frame.textures.end() );
+        
+        for ( TransientTexture& texture : frame.textures )
+        {
+            texture.used = false;
+        }
+    }
+}
@@ -0,0 +1,112 @@
+//
+//  RenderGraphExecutor.hpp
+//  Point_Cloud_Renderer
+//
+//  Created by Vatsalya Yadav on 10/19/26.
+//
+
+#ifndef RenderGraphExecutor_hpp
+#define RenderGraphExecutor_hpp
+
+#include <vector>
+
+#include "Core/Core.hpp"
+#include "Renderer/Data/Constants.hpp"
+#include "Renderer/RenderGraph/RenderGraph.hpp"
+
+FD_MTL
+
+namespace PCR
+{
+    // Handed to a pass while it executes. The encoder matching the pass type has already
+    // been created with the right attachments and is ended by the executor afterwards.
+    class RenderGraphContext
+    {
+    public:
+        MTL::Texture* getTexture( RenderGraphResource resource ) const;
+        
+        MTL::CommandBuffer* getCommandBuffer() const;
+        
+        MTL::RenderCommandEncoder* getRenderEncoder() const;
+        
+        MTL::ComputeCommandEncoder* getComputeEncoder() const;
+        
+        MTL::BlitCommandEncoder* getBlitEncoder() const;
+
+    private:
+        friend class RenderGraphExecutor;
+        
+        const std::vector< MTL::Texture* >* _pTextures = nullptr;
+        
+        MTL::CommandBuffer* _pCommandBuffer = nullptr;
+        
+        MTL::RenderCommandEncoder* _pRenderEncoder = nullptr;
+        
+        MTL::ComputeCommandEncoder* _pComputeEncoder = nullptr;
+        
+        MTL::BlitCommandEncoder* _pBlitEncoder = nullptr;
+    };
+
+    // Runs compiled render graphs on Metal. Transient textures are placed in a placement
+    // heap at the offsets the graph picked, one heap per frame in flight so a frame never
+    // aliases memory the previous one is still using, and the waits the graph computed
+    // become fences since heap resources are not hazard tracked.
+    class RenderGraphExecutor
+    {
+    public:
+        RenderGraphExecutor( MTL::Device* pDevice, uint32_t frameCount = MAX_FRAMES_IN_FLIGHT );
+        
+        ~RenderGraphExecutor();
+        
+        RenderGraphExecutor( const RenderGraphExecutor& ) = delete;
+        
+        RenderGraphExecutor& operator=( const RenderGraphExecutor& ) = delete;
+        
+        // Compiles against this device and encodes every surviving pass into pCommandBuffer.
+        // Relies on the caller throttling to frameCount frames in flight.
+        void execute( RenderGraph& graph, MTL::CommandBuffer* pCommandBuffer );
+        
+        RenderGraphSizeFunction getSizeFunction() const;
+        
+        uint64_t getHeapSize() const;
+
+    private:
+        struct TransientTexture
+        {
+            RenderGraphTextureDesc desc;
+            
+            uint32_t usage = 0;
+            
+            uint64_t heapOffset = 0;
+            
+            MTL::Texture* pTexture = nullptr;
+            
+            bool used = false;
+        };
+        
+        struct FrameResources
+        {
+            MTL::Heap* pHeap = nullptr;
+            
+            std::vector< TransientTexture > textures;
+        };
+        
+        MTL::Device* _pDevice;
+        
+        std::vector< FrameResources > _frames;
+        
+        uint32_t _frameIndex;
+        
+        std::vector< MTL::Fence* > _fences;
+        
+        std::vector< MTL::Texture* > _resolvedTextures;
+        
+        void reserveHeap( FrameResources& frame, uint64_t size );
+        
+        MTL::Texture* acquireTexture( FrameResources& frame, const RenderGraphTexture& texture );
+        
+        void releaseUnusedTextures( FrameResources& frame );
+    };
+}
+
+#endif /* RenderGraphExecutor_hpp */
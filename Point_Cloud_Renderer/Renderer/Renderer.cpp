@@ -7,51 +7,156 @@
 
 #include "Renderer.hpp"
 
+#include <algorithm>
+#include <array>
 #include <cassert>
+#include <chrono>
+#include <cstdlib>
+#include <string>
 
 #include <AppKit/AppKit.hpp>
 #include <MetalKit/MetalKit.hpp>
 #include <simd/simd.h>
 
+#include "Renderer/Culling/InstanceCulling.hpp"
+#include "Renderer/Instances/InstanceAnimation.hpp"
+#include "Renderer/Instances/InstanceUpdate.hpp"
+#include "Renderer/Pipeline/MetalShaderCompiler.hpp"
+#include "Renderer/PointCloud/PointCloudGenerator.hpp"
+#include "Renderer/PointCloud/SplatPass.hpp"
+#include "Renderer/Scene/RenderSystems.hpp"
 #include "Renderer/Structures/FrameData.hpp"
 #include "Renderer/Structures/InstanceData.hpp"
+#include "Renderer/Structures/InstanceAnimationUniforms.hpp"
 #include "Renderer/Structures/CameraData.hpp"
+#include "Renderer/Structures/CullUniforms.hpp"
+#include "Renderer/Structures/UpscaleUniforms.hpp"
+#include "Renderer/Structures/VisibilityResolveUniforms.hpp"
 #include "Math/Utility.hpp"
 #include "Renderer/Mesh/Types/VertexData.h"
 
 namespace PCR
 {
+    namespace
+    {
+        // Everything draw takes from the frame allocator, the partitions are sized from this
+        enum FrameAllocationIndex : size_t
+        {
+            CAMERA_ALLOCATION,
+            ANIMATION_ALLOCATION,
+            DRAW_ARGUMENT_ALLOCATION,
+            FRAME_ALLOCATION_COUNT
+        };
+        
+        constexpr std::array< NS::UInteger, FRAME_ALLOCATION_COUNT > FRAME_ALLOCATION_SIZES
+        {
+            sizeof( CameraData ),
+            sizeof( uint ),
+            sizeof( InstanceCulling::DrawIndexedArguments ) * INSTANCE_LOD_COUNT
+        };
+        
+        // The generated cloud and how the camera looks at it
+        constexpr size_t DEFAULT_POINT_CLOUD_SIZE{ 1024 * 1024 };
+        
+        constexpr float POINT_CLOUD_RADIUS{ 1.0f };
+        
+        constexpr float POINT_CLOUD_DISTANCE{ 3.0f };
+        
+        // Radians per unit of _angle, slow enough that most samples reproject
+        constexpr float POINT_CLOUD_ORBIT_SPEED{ 0.25f };
+    }
+
     Renderer::Renderer( MTL::Device* pDevice )
     :   _pDevice{ pDevice->retain() }
-    ,   _frame{ 0 }
     ,   _angle{ 0.0f }
+    ,   _instanceRows{ DEFAULT_INSTANCE_ROWS }
+    ,   _instanceColumns{ DEFAULT_INSTANCE_COLUMNS }
+    ,   _instanceDepth{ DEFAULT_INSTANCE_DEPTH }
+    ,   _drawInstanceCount{ 0 }
+    ,   _cpuInstancesStale{ true }
+    ,   _gatherEntities{ false }
+    ,   _animateInstances{ true }
+    ,   _instanceFormat{ InstanceFormat::Compact }
+    ,   _gpuAnimation{ true }
     ,   _animationIndex{ 0 }
+    ,   _renderPath{ RenderPath::Forward }
+    ,   _colorMode{ ColorMode::Instance }
+    ,   _gpuCulling{ true }
+    ,   _instanceLod{ true }
+    ,   _pGpuValidator{ nullptr }
+    ,   _gpuValidation{ false }
+    ,   _pointCloudMode{ PointCloudMode::Off }
+    ,   _pPointCloudTextures{}
+    ,   _pSplatPass{ nullptr }
+    ,   _pPointCloudBuffer{ nullptr }
+    ,   _pSplatTargets{}
+    ,   _pSplatTargetViews{}
+    ,   _lastCpuFrameMs{ 0.0 }
+    ,   _lastGpuFrameMs{ 0.0 }
     {
         _pCommandQueue = _pDevice->newCommandQueue();
+        _pUploadManager = new UploadManager( _pDevice );
+        _pWorkerPool = new WorkerPool();
+        _pPointRasterizer = new PointRasterizer( 0, 0, *_pWorkerPool );
+        _pPointReprojector = new PointReprojector( *_pPointRasterizer );
         buildShaders();
         buildDepthStencilStates();
         buildComputePipeline();
+        buildUpscalePipeline();
+        buildVisibilityPipelines();
+        buildCullPipeline();
+        buildAnimationPipeline();
         buildTextures();
         buildBuffers();
+        buildSceneTransforms();
+        buildInstances();
         
-        _semaphore = dispatch_semaphore_create( MAX_FRAMES_IN_FLIGHT );
+        _pRenderGraphExecutor = new RenderGraphExecutor( _pDevice );
     }
 
     Renderer::~Renderer()
     {
+        // Completion handlers still reference this, and deferred releases need their frames done
+        _framePacer.waitForIdle();
+        _deletionQueue.releaseAll();
+        
         _pTexture->release();
-        _pShaderLibrary->release();
+        for ( MTL::Texture* pPointCloudTexture : _pPointCloudTextures )
+        {
+            if ( pPointCloudTexture )
+            {
+                pPointCloudTexture->release();
+            }
+        }
+        for ( size_t i = 0; i < MAX_FRAMES_IN_FLIGHT; ++i )
+        {
+            if ( _pSplatTargets[ i ] )
+            {
+                _pSplatTargetViews[ i ]->release();
+                _pSplatTargets[ i ]->release();
+            }
+        }
+        if ( _pPointCloudBuffer )
+        {
+            _pPointCloudBuffer->release();
+        }
+        delete _pSplatPass;
+        delete _pPointReprojector;
+        delete _pPointRasterizer;
+        delete _pRenderGraphExecutor;
+        delete _pGpuValidator;
         _pDepthStencilState->release();
         _pVertexDataBuffer->release();
         _pIndexBuffer->release();
-        _pTextureAnimationBuffer->release();
-        for ( int i = 0; i < MAX_FRAMES_IN_FLIGHT; ++i )
-        {
-            _pInstanceDataBuffers[ i ]->release();
-            _pCameraDataBuffers[ i ]->release();
-        }
-        _pComputePipelineStateObject->release();
-        _pRenderPipelineStateObject->release();
+        delete _pAnimatedInstances;
+        delete _pVisibleInstances;
+        delete _pFrameAllocator;
+        delete _pInstanceBuffer;
+        delete _pUploadManager;
+        delete _pWorkerPool;
+        // Pipeline states belong to the cache, functions to the registry
+        delete _pPipelineCache;
+        delete _pShaderRegistry;
         _pCommandQueue->release();
         _pDevice->release();
     }
@@ -60,152 +165,605 @@ namespace PCR
     {
         auto pAutoReleasePool = NS::TransferPtr< NS::AutoreleasePool >( NS::AutoreleasePool::alloc()->init() );
         
-        _frame = (_frame + 1) % MAX_FRAMES_IN_FLIGHT;
-        MTL::Buffer* pCurrentInstanceDataBuffer = _pInstanceDataBuffers[ _frame ];
-
+        const auto cpuFrameStart = std::chrono::steady_clock::now();
+        
+        // Timings of the last completed frame pick this frame's resolution
+        _resolutionController.addFrame( _lastCpuFrameMs, _lastGpuFrameMs.load( std::memory_order_relaxed ) );
+        
         MTL::CommandBuffer* pCommandBuffer = _pCommandQueue->commandBuffer();
-        dispatch_semaphore_wait( _semaphore, DISPATCH_TIME_FOREVER );
-        pCommandBuffer->addCompletedHandler( ^void( MTL::CommandBuffer* pCmd ){
-            dispatch_semaphore_signal( this->_semaphore );
-        });
+        const uint64_t frameIndex = _framePacer.beginFrame();
         
-        _angle += 0.01f;
+        // Whatever the completed frames were the last to use goes in one batch
+        _deletionQueue.collect();
         
-        constexpr float scl = 0.2f;
-        constexpr float doubleScl = scl * 2.0f;
-        InstanceData* pInstanceData = reinterpret_cast< InstanceData* >( pCurrentInstanceDataBuffer->contents() );
+        // Grown buffers take over from this frame on, they're rewritten before they're read
+        _pAnimatedInstances->beginFrame( _deletionQueue, frameIndex );
+        _pVisibleInstances->beginFrame( _deletionQueue, frameIndex );
         
-        simd::float3 cameraPosition{ 0.0f, 0.0f, -10.0f };
+        // Until then frames draw what fits the buffers they have, the CPU path's instance
+        // buffer is always large enough
+        _drawInstanceCount = _instancePool.getCount();
+        if ( _gpuAnimation )
+        {
+            _drawInstanceCount = std::min< size_t >( _drawInstanceCount, _pAnimatedInstances->getSize() / sizeof( InstanceData ) );
+        }
+        if ( _gpuCulling )
+        {
+            _drawInstanceCount = std::min< size_t >( _drawInstanceCount, _pVisibleInstances->getSize() / ( sizeof( uint32_t ) * INSTANCE_LOD_COUNT ) );
+        }
         
-        simd::float4x4 rt = Math::makeTranslate( cameraPosition );
-        simd::float4x4 rr1 = Math::makeYRotate( -_angle );
-        simd::float4x4 rr0 = Math::makeYRotate( _angle * 0.5f );
-        simd::float4x4 rtInv = Math::makeTranslate( { -cameraPosition.x, -cameraPosition.y, -cameraPosition.z } );
-        simd::float4x4 fullObjectRot = rt * rr1 * rr0 * rtInv;
+        // The pacer never lets more than MAX_FRAMES_IN_FLIGHT frames overlap, so this
+        // partition's last frame has completed
+        _pFrameAllocator->beginFrame();
+        FrameAllocation cameraData = _pFrameAllocator->allocate( FRAME_ALLOCATION_SIZES[ CAMERA_ALLOCATION ] );
+        FrameAllocation animationData = _pFrameAllocator->allocate( FRAME_ALLOCATION_SIZES[ ANIMATION_ALLOCATION ] );
+        FrameAllocation drawArgumentData = _pFrameAllocator->allocate( FRAME_ALLOCATION_SIZES[ DRAW_ARGUMENT_ALLOCATION ] );
         
-        size_t ix = 0;
-        size_t iy = 0;
-        size_t iz = 0;
+        FrameAllocation visibleInstanceData;
+        visibleInstanceData.pBuffer = _pVisibleInstances->getBuffer();
+        visibleInstanceData.size = _pVisibleInstances->getSize();
         
-        // Instance Data
-        for ( size_t i = 0; i < MAX_NUM_INSTANCES; ++i )
+        if ( _animateInstances )
         {
-            if ( ix == INSTANCE_ROWS )
+            _angle += 0.01f;
+        }
+        
+        const InstanceAnimationUniforms animationUniforms = InstanceAnimation::makeUniforms( _angle, _instanceRows, _instanceColumns, _instanceDepth );
+        
+        FrameAllocation instanceData;
+        if ( _gpuAnimation )
+        {
+            // Filled in by the Instance Animation pass, nothing to write from here
+            instanceData.pBuffer = _pAnimatedInstances->getBuffer();
+            instanceData.size = _pAnimatedInstances->getSize();
+        }
+        else
+        {
+            if ( _animateInstances )
             {
-                ix = 0;
-                iy += 1;
+                updateCpuInstances();
             }
             
-            if ( iy == INSTANCE_COLUMNS )
+            // Instance Data, the pacer keeps this copy's last frame from still being in flight
+            const auto instanceCopy = static_cast< uint32_t >( frameIndex % MAX_FRAMES_IN_FLIGHT );
+            // Turning by -angle then angle / 2 is one turn by -angle / 2
+            _sceneTransforms.setLocal( _gridTurnNode, Math::makeYRotate( -0.5f * _angle ) );
+            _sceneTransforms.update();
+            
+            if ( _gatherEntities )
             {
-                iy = 0;
-                iz += 1;
+                _pInstanceBuffer->gather( _entities, _sceneTransforms.getWorld( _gridNode ), *_pWorkerPool, instanceCopy );
             }
-            
-            auto fx = static_cast< float >( ix );
-            auto fy = static_cast< float >( iy );
-            auto fz = static_cast< float >( iz );
-            
-            constexpr float HALF_ROWS = static_cast< float >( INSTANCE_ROWS ) / 2.0f;
-            constexpr float HALF_COLUMNS = static_cast< float >( INSTANCE_COLUMNS ) / 2.0f;
-            constexpr float HALF_DEPTH = static_cast< float >( INSTANCE_DEPTH ) / 2.0f;
-            
-            // Instance Object Transform
-            simd::float4x4 zRotation = Math::makeZRotate( _angle * sinf( fx ) );
-            simd::float4x4 yRotation = Math::makeZRotate( _angle * cosf( fy ) );
-            simd::float4x4 scale = Math::makeScale( simd::float3{ scl, scl, scl } );
-            
-            float x = ( fx - HALF_ROWS ) * doubleScl + scl;
-            float y = ( fy - HALF_COLUMNS ) * doubleScl + scl;
-            float z = ( fz - HALF_DEPTH ) * doubleScl;
-            simd::float4x4 translate = Math::makeTranslate( cameraPosition + simd::float3{ x, y, z } );
-            
-            // Instance Transform
-            pInstanceData[ i ].transform = fullObjectRot * translate * yRotation * zRotation * scale;
-            pInstanceData[ i ].normalTransform = Math::discardTranslation( pInstanceData[ i ].transform );
-
-            // Instance Color
-            float iDivNumInstances = i / static_cast<float>( MAX_NUM_INSTANCES );
-            float r = iDivNumInstances;
-            float g = 1.0f - r;
-            float b = sinf( M_PI * 2.0f * iDivNumInstances );
-            pInstanceData[ i ].color = { r, g, b, 1.0f };
-            
-            ix += 1;
+            else
+            {
+                _pInstanceBuffer->update( _instanceStore, _sceneTransforms.getWorld( _gridNode ), *_pWorkerPool, instanceCopy );
+            }
+            instanceData = _pInstanceBuffer->getAllocation( instanceCopy );
         }
-        pCurrentInstanceDataBuffer->didModifyRange( NS::Range::Make( 0, pCurrentInstanceDataBuffer->length() ) );
         
         // Update Camera State
         
-        MTL::Buffer* pCurrentCameraBuffer = _pCameraDataBuffers[ _frame ];
-        auto* pCameraData = reinterpret_cast< CameraData* >( pCurrentCameraBuffer->contents() );
+        auto* pCameraData = cameraData.as< CameraData >();
         pCameraData->perspectiveTransform = Math::makePerspective( 45.0f * M_PI / 180.0f, 1.0f, 0.03f, 500.0f );
         pCameraData->worldTransform = Math::makeIdentity();
         pCameraData->worldNormalTransform = Math::discardTranslation( pCameraData->worldTransform );
-        pCurrentCameraBuffer->didModifyRange( NS::Range::Make( 0, pCurrentCameraBuffer->length() ) );
         
-        // Update Texture
+        // The cull pass counts visible instances into each LOD's instanceCount
+        auto* pDrawArguments = drawArgumentData.as< InstanceCulling::DrawIndexedArguments >();
+        for ( uint32_t lod = 0; lod < INSTANCE_LOD_COUNT; ++lod )
+        {
+            pDrawArguments[ lod ] = InstanceCulling::DrawIndexedArguments{};
+            pDrawArguments[ lod ].indexCount = InstanceCulling::LOD_INDEX_COUNTS[ lod ];
+        }
         
-        generateMandelbrotTexture( pCommandBuffer );
+        // Half the cube's diagonal, see buildBuffers
+        constexpr float cubeBoundingRadius = 0.5f * 1.7320508f;
+        CullUniforms cullUniforms = InstanceCulling::makeUniforms( pCameraData->perspectiveTransform * pCameraData->worldTransform,
+                                                                   cubeBoundingRadius,
+                                                                   static_cast< uint32_t >( _drawInstanceCount ) );
+        if ( usesInstanceLod() )
+        {
+            const simd::float3 cameraPosition = simd_inverse( pCameraData->worldTransform ).columns[ 3 ].xyz;
+            InstanceCulling::setLodDistances( cullUniforms, cameraPosition, INSTANCE_LOD_REDUCED_DISTANCE, INSTANCE_LOD_IMPOSTOR_DISTANCE );
+        }
         
-        // Begin Render Pass
+        // Build Frame Graph
         
-        MTL::RenderPassDescriptor* pRenderPassDescriptor = pView->currentRenderPassDescriptor();
-        MTL::RenderCommandEncoder* pRenderCommandEncoder = pCommandBuffer->renderCommandEncoder( pRenderPassDescriptor );
+        // The scene renders into the top-left corner of drawable-sized targets and is
+        // upscaled afterwards, so changing the scale never changes the graph's textures
+        CA::MetalDrawable* pDrawable = pView->currentDrawable();
+        const auto drawableWidth = static_cast< uint32_t >( pDrawable->texture()->width() );
+        const auto drawableHeight = static_cast< uint32_t >( pDrawable->texture()->height() );
         
-        pRenderCommandEncoder->setRenderPipelineState( _pRenderPipelineStateObject );
-        pRenderCommandEncoder->setDepthStencilState( _pDepthStencilState );
+        uint32_t renderWidth = 0;
+        uint32_t renderHeight = 0;
+        _resolutionController.getRenderSize( drawableWidth, drawableHeight, renderWidth, renderHeight );
         
-        /* MTL::Buffer*, offset, index */
-        pRenderCommandEncoder->setVertexBuffer( _pVertexDataBuffer, 0, 0 );
-        pRenderCommandEncoder->setVertexBuffer( pCurrentInstanceDataBuffer, 0, 1 );
-        pRenderCommandEncoder->setVertexBuffer( pCurrentCameraBuffer, 0, 2 );
+        const MTL::ClearColor clearColor = pView->clearColor();
         
-        /* MTL::Texture*, index */
-        pRenderCommandEncoder->setFragmentTexture( _pTexture, 0 );
+        // The pacer keeps this copy's last frame from still being in flight
+        const auto pointCloudCopy = static_cast< uint32_t >( frameIndex % MAX_FRAMES_IN_FLIGHT );
+        MTL::Texture* pPointCloudTexture = nullptr;
+        MTL::Texture* pSplatTarget = nullptr;
+        simd::float4x4 splatViewProjection = Math::makeIdentity();
+        if ( _pointCloudMode == PointCloudMode::Reprojected )
+        {
+            pPointCloudTexture = renderPointCloud( pointCloudCopy, makePointCloudCamera( *pCameraData ), renderWidth, renderHeight, drawableWidth, drawableHeight );
+        }
+        else if ( _pointCloudMode == PointCloudMode::Splats )
+        {
+            const CameraData splatCamera = makePointCloudCamera( *pCameraData );
+            splatViewProjection = splatCamera.perspectiveTransform * splatCamera.worldTransform;
+            pSplatTarget = prepareSplatTarget( pointCloudCopy, drawableWidth, drawableHeight );
+            pPointCloudTexture = _pSplatTargetViews[ pointCloudCopy ];
+        }
         
-        pRenderCommandEncoder->setCullMode( MTL::CullMode::CullModeBack );
-        pRenderCommandEncoder->setFrontFacingWinding( MTL::Winding::WindingCounterClockwise );
+        _renderGraph.reset();
+        const RenderGraphResource mandelbrotTexture = _renderGraph.importTexture( "Mandelbrot", _pTexture );
+        const RenderGraphResource drawableTexture = _renderGraph.importTexture( "Drawable", pDrawable->texture() );
+        const RenderGraphResource sceneColorTexture = _renderGraph.createTexture( "Scene Color", RenderGraphTextureDesc{ drawableWidth, drawableHeight, MTL::PixelFormatBGRA8Unorm_sRGB } );
+        const RenderGraphResource sceneDepthTexture = _renderGraph.createTexture( "Scene Depth", RenderGraphTextureDesc{ drawableWidth, drawableHeight, MTL::PixelFormatDepth16Unorm } );
         
-        // Draw-call
-        pRenderCommandEncoder->drawIndexedPrimitives( MTL::PrimitiveType::PrimitiveTypeTriangle,
-                                                     /* indexCount */ 6 * 6,
-                                                     MTL::IndexType::IndexTypeUInt16,
-                                                     _pIndexBuffer,
-                                                     /* indexBufferOffset */ 0,
-                                                     MAX_NUM_INSTANCES);
+        _renderGraph.addPass( "Mandelbrot", RenderGraphPassType::Compute, [ & ]( RenderGraphContext& context ){
+            generateMandelbrotTexture( context.getComputeEncoder(), animationData );
+        }).write( mandelbrotTexture );
+        
+        if ( _gpuAnimation )
+        {
+            // Writes a buffer the graph doesn't track, hazard tracking orders the passes reading it
+            _renderGraph.addPass( "Instance Animation", RenderGraphPassType::Compute, [ & ]( RenderGraphContext& context ){
+                encodeInstanceAnimation( context.getComputeEncoder(), instanceData, animationUniforms );
+            }).sideEffects();
+        }
+        
+        if ( _gpuCulling )
+        {
+            // Only writes buffers the graph doesn't track, the frame allocator's buffer is
+            // hazard tracked so the draws below still wait for it
+            _renderGraph.addPass( "Instance Culling", RenderGraphPassType::Compute, [ & ]( RenderGraphContext& context ){
+                encodeInstanceCulling( context.getComputeEncoder(), instanceData, visibleInstanceData, drawArgumentData, cullUniforms );
+            }).sideEffects();
+        }
+        
+        if ( _renderPath == RenderPath::VisibilityBuffer )
+        {
+            const RenderGraphResource visibilityTexture = _renderGraph.createTexture( "Visibility", RenderGraphTextureDesc{ drawableWidth, drawableHeight, MTL::PixelFormatRG32Uint } );
+            
+            // Raster pass, IDs only. Integer targets take the clear value as is, this is the empty ID
+            _renderGraph.addPass( "Visibility", RenderGraphPassType::Render, [ & ]( RenderGraphContext& context ){
+                encodeVisibility( context.getRenderEncoder(), instanceData, cameraData, visibleInstanceData, drawArgumentData, renderWidth, renderHeight );
+            }).colorAttachment( visibilityTexture, 0, 4294967295.0, 4294967295.0, 0.0, 0.0 )
+              .depthAttachment( sceneDepthTexture, 1.0 );
+            
+            // Resolve pass, one shading invocation per covered pixel
+            _renderGraph.addPass( "Visibility Resolve", RenderGraphPassType::Render, [ &, visibilityTexture ]( RenderGraphContext& context ){
+                encodeVisibilityResolve( context.getRenderEncoder(), context.getTexture( visibilityTexture ), instanceData, cameraData, renderWidth, renderHeight );
+            }).read( visibilityTexture )
+              .read( mandelbrotTexture )
+              .colorAttachment( sceneColorTexture, 0, clearColor.red, clearColor.green, clearColor.blue, clearColor.alpha );
+            
+            if ( _gpuValidation )
+            {
+                _renderGraph.addPass( "Visibility Readback", RenderGraphPassType::Blit, [ &, visibilityTexture ]( RenderGraphContext& context ){
+                    VisibilityReadbackSources sources;
+                    sources.pVisibility = context.getTexture( visibilityTexture );
+                    sources.pColor = context.getTexture( sceneColorTexture );
+                    sources.pTexture = _pTexture;
+                    sources.pVertices = _pVertexDataBuffer;
+                    sources.vertexBytes = _pVertexDataBuffer->length();
+                    sources.pIndices = _pIndexBuffer;
+                    sources.indexBytes = _pIndexBuffer->length();
+                    sources.instanceData = instanceData;
+                    sources.instanceCount = static_cast< uint32_t >( _drawInstanceCount );
+                    sources.cameraData = cameraData;
+                    sources.renderWidth = renderWidth;
+                    sources.renderHeight = renderHeight;
+                    sources.clearColor = simd::float4{ static_cast< float >( clearColor.red ),
+                                                       static_cast< float >( clearColor.green ),
+                                                       static_cast< float >( clearColor.blue ),
+                                                       static_cast< float >( clearColor.alpha ) };
+                    _pGpuValidator->encodeVisibilityReadback( context.getCommandBuffer(), context.getBlitEncoder(), _instanceFormat, sources );
+                }).read( visibilityTexture )
+                  .read( sceneColorTexture )
+                  .read( mandelbrotTexture )
+                  .sideEffects();
+            }
+        }
+        else
+        {
+            _renderGraph.addPass( "Forward", RenderGraphPassType::Render, [ & ]( RenderGraphContext& context ){
+                encodeForward( context.getRenderEncoder(), instanceData, cameraData, visibleInstanceData, drawArgumentData, renderWidth, renderHeight );
+            }).read( mandelbrotTexture )
+              .colorAttachment( sceneColorTexture, 0, clearColor.red, clearColor.green, clearColor.blue, clearColor.alpha )
+              .depthAttachment( sceneDepthTexture, pView->clearDepth() );
+        }
+        
+        // Nothing reads the scene color with a point cloud up, the graph culls the passes drawing it
+        const RenderGraphResource upscaleSource = pPointCloudTexture ? _renderGraph.importTexture( "Point Cloud", pPointCloudTexture ) : sceneColorTexture;
+        
+        _renderGraph.addPass( "Upscale", RenderGraphPassType::Render, [ & ]( RenderGraphContext& context ){
+            encodeUpscale( context.getRenderEncoder(), context.getTexture( upscaleSource ), renderWidth, renderHeight );
+        }).read( upscaleSource )
+          .colorAttachment( drawableTexture, 0, clearColor.red, clearColor.green, clearColor.blue, clearColor.alpha );
+        
+        // Copies go first, every pass below may read what they write
+        _pUploadManager->flush( pCommandBuffer );
+        
+        // Outside the graph, the splat pass makes its own encoders so each can take stage-boundary
+        // samples. Hazard tracking puts the upscale behind it.
+        if ( pSplatTarget )
+        {
+            _pSplatPass->resize( renderWidth, renderHeight );
+            _pSplatPass->encode( pCommandBuffer, _pPointCloudBuffer, static_cast< uint32_t >( _pointCloud.size() ), splatViewProjection, pSplatTarget, frameIndex, &_profiler );
+        }
+        
+        _pRenderGraphExecutor->execute( _renderGraph, pCommandBuffer );
+        
+        if ( _gpuValidation && pSplatTarget )
+        {
+            SplatReadbackSources sources;
+            sources.pTarget = pSplatTarget;
+            sources.pPoints = _pPointCloudBuffer;
+            sources.pointCount = static_cast< uint32_t >( _pointCloud.size() );
+            sources.viewProjection = splatViewProjection;
+            sources.renderWidth = renderWidth;
+            sources.renderHeight = renderHeight;
+            _pGpuValidator->encodeSplatReadback( pCommandBuffer, sources );
+        }
+        
+        // The animation check's completion handler goes first, so a frame counts as checked
+        // once both comparisons are done
+        if ( _gpuValidation && _gpuAnimation )
+        {
+            _pGpuValidator->encodeAnimationReadback( pCommandBuffer, _instanceFormat, instanceData, animationUniforms, static_cast< uint32_t >( _drawInstanceCount ) );
+        }
+        if ( _gpuValidation && _gpuCulling )
+        {
+            _pGpuValidator->encodeCullReadback( pCommandBuffer, _instanceFormat, instanceData, visibleInstanceData, drawArgumentData, cullUniforms );
+        }
+        
+        // Everything for this frame has been written, flush it in one range
+        _pFrameAllocator->endFrame( pCommandBuffer );
         
-        pRenderCommandEncoder->endEncoding();
-        pCommandBuffer->presentDrawable( pView->currentDrawable() );
+        // Completion handlers run in the order they were added, so the partition is
+        // released before the pacer lets the next frame reuse it
+        pCommandBuffer->addCompletedHandler( ^void( MTL::CommandBuffer* pCmd ){
+            const double gpuFrameMs = ( pCmd->GPUEndTime() - pCmd->GPUStartTime() ) * 1000.0;
+            this->_lastGpuFrameMs.store( gpuFrameMs, std::memory_order_relaxed );
+            this->_profiler.recordGpu( "Frame", gpuFrameMs );
+            this->_deletionQueue.markFrameCompleted( frameIndex );
+            this->_framePacer.frameCompleted( frameIndex );
+        });
+        
+        pCommandBuffer->presentDrawable( pDrawable );
         pCommandBuffer->commit();
+        
+        // Time spent blocked on the GPU isn't CPU cost, leave it out of the resolution decision
+        _lastCpuFrameMs = std::chrono::duration< double, std::milli >( std::chrono::steady_clock::now() - cpuFrameStart ).count()
+                        - _framePacer.getStats().lastWaitMs;
+        _profiler.recordCpu( "Frame", _lastCpuFrameMs );
+    }
+    
+    void Renderer::setRenderPath( RenderPath renderPath )
+    {
+        _renderPath = renderPath;
+    }
+    
+    RenderPath Renderer::getRenderPath() const
+    {
+        return _renderPath;
+    }
+    
+    void Renderer::setColorMode( ColorMode colorMode )
+    {
+        _colorMode = colorMode;
+        buildForwardPipelines();
+    }
+    
+    ColorMode Renderer::getColorMode() const
+    {
+        return _colorMode;
+    }
+    
+    void Renderer::setGpuCulling( bool gpuCulling )
+    {
+        _gpuCulling = gpuCulling;
+        buildForwardPipelines();
+        _pVisibilityPipelineStateObject = _pPipelineCache->getRenderPipeline( makeVisibilityPipelineDesc() );
+    }
+    
+    bool Renderer::getGpuCulling() const
+    {
+        return _gpuCulling;
+    }
+    
+    void Renderer::setInstanceLod( bool instanceLod )
+    {
+        _instanceLod = instanceLod;
+    }
+    
+    bool Renderer::getInstanceLod() const
+    {
+        return _instanceLod;
+    }
+    
+    void Renderer::releaseDeferred( MTL::Resource* pResource )
+    {
+        _deletionQueue.retire( pResource, _framePacer.getFrameIndex() );
+    }
+    
+    void Renderer::setFramesInFlight( uint32_t framesInFlight )
+    {
+        _framePacer.setFramesInFlight( framesInFlight );
+    }
+    
+    uint32_t Renderer::getFramesInFlight() const
+    {
+        return _framePacer.getFramesInFlight();
+    }
+    
+    const FramePacingStats& Renderer::getFramePacingStats() const
+    {
+        return _framePacer.getStats();
+    }
+
+    void Renderer::setAnimateInstances( bool animateInstances )
+    {
+        _animateInstances = animateInstances;
+    }
+
+    bool Renderer::getAnimateInstances() const
+    {
+        return _animateInstances;
+    }
+
+    void Renderer::setGpuValidation( bool gpuValidation )
+    {
+        _gpuValidation = gpuValidation;
+        if ( _gpuValidation && !_pGpuValidator )
+        {
+            _pGpuValidator = new GpuReadbackValidator( _pDevice );
+        }
+    }
+
+    bool Renderer::getGpuValidation() const
+    {
+        return _gpuValidation;
+    }
+
+    GpuValidationStats Renderer::getGpuValidationStats() const
+    {
+        return _pGpuValidator ? _pGpuValidator->getStats() : GpuValidationStats{};
+    }
+
+    void Renderer::setPointCloudMode( PointCloudMode pointCloudMode )
+    {
+        if ( pointCloudMode != PointCloudMode::Off && _pointCloud.empty() )
+        {
+            setPointCloud( PointCloudGenerator::makeSphere( DEFAULT_POINT_CLOUD_SIZE, POINT_CLOUD_RADIUS ) );
+        }
+        if ( pointCloudMode == PointCloudMode::Splats && !_pSplatPass )
+        {
+            _pSplatPass = new SplatPass( _pDevice, _pShaderRegistry->getLibrary() );
+        }
+        _pointCloudMode = pointCloudMode;
+        _pPointReprojector->invalidate();
+        _pPointReprojector->resetTotals();
+    }
+
+    PointCloudMode Renderer::getPointCloudMode() const
+    {
+        return _pointCloudMode;
+    }
+
+    void Renderer::setPointCloud( std::vector< PointData > points )
+    {
+        _pointCloud = std::move( points );
+        if ( _pPointCloudBuffer )
+        {
+            releaseDeferred( _pPointCloudBuffer );
+            _pPointCloudBuffer = nullptr;
+        }
+        _pPointReprojector->invalidate();
+        _pPointReprojector->resetTotals();
+    }
+
+    size_t Renderer::getPointCount() const
+    {
+        return _pointCloud.size();
+    }
+
+    const ReprojectionStats& Renderer::getReprojectionStats() const
+    {
+        return _pPointReprojector->getStats();
+    }
+
+    const ReprojectionTotals& Renderer::getReprojectionTotals() const
+    {
+        return _pPointReprojector->getTotals();
+    }
+
+    FrameProfiler& Renderer::getProfiler()
+    {
+        return _profiler;
+    }
+
+    const InstanceBufferStats& Renderer::getInstanceBufferStats() const
+    {
+        return _pInstanceBuffer->getStats();
+    }
+
+    void Renderer::setInstanceFormat( InstanceFormat instanceFormat )
+    {
+        if ( instanceFormat == _instanceFormat )
+        {
+            return;
+        }
+        
+        _instanceFormat = instanceFormat;
+        
+        // Frames in flight still read the old layout, the new buffer starts out fully dirty
+        _deletionQueue.retire( _pInstanceBuffer, []( void* pObject ){ delete static_cast< InstanceBuffer* >( pObject ); }, _framePacer.getFrameIndex() );
+        _pInstanceBuffer = new InstanceBuffer( _pDevice, _instancePool.getCapacity(), _instanceFormat );
+        
+        buildForwardPipelines();
+        _pVisibilityPipelineStateObject = _pPipelineCache->getRenderPipeline( makeVisibilityPipelineDesc() );
+        _pVisibilityResolvePipelineStateObject = _pPipelineCache->getRenderPipeline( makeVisibilityResolvePipelineDesc() );
+        _pCullPipelineStateObject = _pPipelineCache->getComputePipeline( makeCullPipelineDesc() );
+        _pAnimationPipelineStateObject = _pPipelineCache->getComputePipeline( makeAnimationPipelineDesc() );
+    }
+
+    InstanceFormat Renderer::getInstanceFormat() const
+    {
+        return _instanceFormat;
+    }
+
+    void Renderer::setGpuAnimation( bool gpuAnimation )
+    {
+        if ( gpuAnimation == _gpuAnimation )
+        {
+            return;
+        }
+        
+        _gpuAnimation = gpuAnimation;
+        
+        // The CPU rotations stopped at the angle the kernel took over from
+        if ( !_gpuAnimation )
+        {
+            updateCpuInstances();
+        }
+    }
+
+    bool Renderer::getGpuAnimation() const
+    {
+        return _gpuAnimation;
+    }
+
+    void Renderer::setGatherEntities( bool gatherEntities )
+    {
+        if ( gatherEntities == _gatherEntities )
+        {
+            return;
+        }
+        
+        _gatherEntities = gatherEntities;
+        updateCpuInstances();
+    }
+
+    bool Renderer::getGatherEntities() const
+    {
+        return _gatherEntities;
+    }
+
+    void Renderer::setInstanceGrid( uint32_t rows, uint32_t columns, uint32_t depth )
+    {
+        if ( rows == _instanceRows && columns == _instanceColumns && depth == _instanceDepth )
+        {
+            return;
+        }
+        
+        _instanceRows = rows;
+        _instanceColumns = columns;
+        _instanceDepth = depth;
+        buildInstances();
+        
+        // The rest pose has no rotations yet
+        if ( !_gpuAnimation )
+        {
+            updateCpuInstances();
+        }
+    }
+
+    size_t Renderer::getInstanceCount() const
+    {
+        return _instancePool.getCount();
     }
     
     void Renderer::buildShaders()
     {
-        auto pLibrary = NS::TransferPtr( _pDevice->newDefaultLibrary() );
-        if ( !pLibrary )
+        _pShaderRegistry = new ShaderRegistry( std::make_unique< MetalShaderCompiler >( _pDevice ) );
+        if ( !_pShaderRegistry->getLibrary() )
         {
             assert( false );
         }
         
-        auto pVertexMainFn = NS::TransferPtr( pLibrary->newFunction( CreateUTF8String( "vertexMain" ) ) );
-        auto pFragmentMainFn = NS::TransferPtr( pLibrary->newFunction( CreateUTF8String( "fragmentMain" ) ) );
+        const char* pHomeDirectory = std::getenv( "HOME" );
+        const std::string manifestPath = std::string( pHomeDirectory ? pHomeDirectory : "." ) + "/Library/Caches/" + PIPELINE_MANIFEST_FILE_NAME;
+        _pPipelineCache = new PipelineCache( _pDevice, _pShaderRegistry, manifestPath );
         
-        auto pRenderPipelineDesc = NS::TransferPtr( MTL::RenderPipelineDescriptor::alloc()->init() );
-        pRenderPipelineDesc->setVertexFunction( pVertexMainFn.get() );
-        pRenderPipelineDesc->setFragmentFunction( pFragmentMainFn.get() );
-        pRenderPipelineDesc->colorAttachments()->object( 0 )->setPixelFormat( MTL::PixelFormatBGRA8Unorm_sRGB );
-        pRenderPipelineDesc->setDepthAttachmentPixelFormat( MTL::PixelFormat::PixelFormatDepth16Unorm );
+        // Everything the last run used starts compiling in the background right away
+        _pPipelineCache->precompileManifest();
         
-        NS::Error* pError = nullptr;
-        _pRenderPipelineStateObject = _pDevice->newRenderPipelineState( pRenderPipelineDesc.get(), &pError );
-        if ( !_pRenderPipelineStateObject )
+        buildForwardPipelines();
+    }
+    
+    RenderPipelineDesc Renderer::makeForwardPipelineDesc( InstanceCulling::InstanceLod lod ) const
+    {
+        RenderPipelineDesc renderPipelineDesc;
+        renderPipelineDesc.vertexFunction = "vertexMain";
+        renderPipelineDesc.fragmentFunction = "fragmentMain";
+        renderPipelineDesc.constants.setUInt( FUNCTION_CONSTANT_COLOR_MODE, static_cast< uint32_t >( _colorMode ) );
+        renderPipelineDesc.constants.setBool( FUNCTION_CONSTANT_INSTANCE_INDIRECTION, _gpuCulling );
+        renderPipelineDesc.constants.setBool( FUNCTION_CONSTANT_COMPACT_INSTANCES, _instanceFormat == InstanceFormat::Compact );
+        renderPipelineDesc.constants.setUInt( FUNCTION_CONSTANT_INSTANCE_LOD, static_cast< uint32_t >( lod ) );
+        renderPipelineDesc.colorAttachments.push_back( PipelineColorAttachment{ MTL::PixelFormatBGRA8Unorm_sRGB } );
+        renderPipelineDesc.depthPixelFormat = MTL::PixelFormat::PixelFormatDepth16Unorm;
+        return renderPipelineDesc;
+    }
+    
+    void Renderer::buildForwardPipelines()
+    {
+        // All LODs compile concurrently
+        for ( uint32_t lod = 0; lod < INSTANCE_LOD_COUNT; ++lod )
         {
-            __builtin_printf( "%s", pError->localizedDescription()->utf8String() );
-            assert( false );
+            _pPipelineCache->prepare( makeForwardPipelineDesc( static_cast< InstanceCulling::InstanceLod >( lod ) ) );
         }
         
-        _pShaderLibrary = pLibrary->retain();
+        for ( uint32_t lod = 0; lod < INSTANCE_LOD_COUNT; ++lod )
+        {
+            _pRenderPipelineStateObjects[ lod ] = _pPipelineCache->getRenderPipeline( makeForwardPipelineDesc( static_cast< InstanceCulling::InstanceLod >( lod ) ) );
+        }
+    }
+    
+    bool Renderer::usesInstanceLod() const
+    {
+        return _instanceLod && _gpuCulling && _renderPath == RenderPath::Forward;
+    }
+    
+    RenderPipelineDesc Renderer::makeVisibilityPipelineDesc() const
+    {
+        RenderPipelineDesc visibilityPipelineDesc;
+        visibilityPipelineDesc.vertexFunction = "visibilityVertex";
+        visibilityPipelineDesc.fragmentFunction = "visibilityFragment";
+        visibilityPipelineDesc.constants.setBool( FUNCTION_CONSTANT_INSTANCE_INDIRECTION, _gpuCulling );
+        visibilityPipelineDesc.constants.setBool( FUNCTION_CONSTANT_COMPACT_INSTANCES, _instanceFormat == InstanceFormat::Compact );
+        visibilityPipelineDesc.colorAttachments.push_back( PipelineColorAttachment{ MTL::PixelFormatRG32Uint } );
+        visibilityPipelineDesc.depthPixelFormat = MTL::PixelFormat::PixelFormatDepth16Unorm;
+        return visibilityPipelineDesc;
+    }
+    
+    RenderPipelineDesc Renderer::makeVisibilityResolvePipelineDesc() const
+    {
+        RenderPipelineDesc resolvePipelineDesc;
+        resolvePipelineDesc.vertexFunction = "visibilityResolveVertex";
+        resolvePipelineDesc.fragmentFunction = "visibilityResolveFragment";
+        resolvePipelineDesc.constants.setBool( FUNCTION_CONSTANT_COMPACT_INSTANCES, _instanceFormat == InstanceFormat::Compact );
+        resolvePipelineDesc.colorAttachments.push_back( PipelineColorAttachment{ MTL::PixelFormatBGRA8Unorm_sRGB } );
+        return resolvePipelineDesc;
+    }
+    
+    ComputePipelineDesc Renderer::makeCullPipelineDesc() const
+    {
+        ComputePipelineDesc cullPipelineDesc{ "cull_instances" };
+        cullPipelineDesc.constants.setBool( FUNCTION_CONSTANT_COMPACT_INSTANCES, _instanceFormat == InstanceFormat::Compact );
+        return cullPipelineDesc;
+    }
+    
+    ComputePipelineDesc Renderer::makeAnimationPipelineDesc() const
+    {
+        ComputePipelineDesc animationPipelineDesc{ "animate_instances" };
+        animationPipelineDesc.constants.setBool( FUNCTION_CONSTANT_COMPACT_INSTANCES, _instanceFormat == InstanceFormat::Compact );
+        return animationPipelineDesc;
     }
     
     void Renderer::buildBuffers()
@@ -247,40 +805,146 @@ namespace PCR
             { { -s, -s, +s }, {  0.f, -1.f,  0.f }, { 0.f, 0.f } }
         };
         
+        // Coarser LODs draw a prefix: the impostor only the front face, the reduced mesh
+        // front, right and top mirrored towards the camera
         uint16_t indices[] = {
              0,  1,  2,  2,  3,  0, /* front */
              4,  5,  6,  6,  7,  4, /* right */
+            16, 17, 18, 18, 19, 16, /* top */
              8,  9, 10, 10, 11,  8, /* back */
             12, 13, 14, 14, 15, 12, /* left */
-            16, 17, 18, 18, 19, 16, /* top */
             20, 21, 22, 22, 23, 20, /* bottom */
         };
         
         constexpr size_t vertexDataSize = sizeof( verts );
         constexpr size_t indexDataSize = sizeof( indices );
         
-        _pVertexDataBuffer = _pDevice->newBuffer( vertexDataSize, MTL::ResourceStorageModeManaged );
-        _pIndexBuffer = _pDevice->newBuffer( indexDataSize, MTL::ResourceStorageModeManaged );
+        _pVertexDataBuffer = _pUploadManager->newPrivateBuffer( vertexDataSize );
+        _pIndexBuffer = _pUploadManager->newPrivateBuffer( indexDataSize );
         
-        memcpy( _pVertexDataBuffer->contents(), verts, vertexDataSize );
-        memcpy( _pIndexBuffer->contents(), indices, indexDataSize );
+        // Copied on the GPU at the start of the first frame
+        _pUploadManager->upload( _pVertexDataBuffer, 0, verts, vertexDataSize );
+        _pUploadManager->upload( _pIndexBuffer, 0, indices, indexDataSize );
         
-        _pVertexDataBuffer->didModifyRange( NS::Range::Make( 0, _pVertexDataBuffer->length() ) );
-        _pIndexBuffer->didModifyRange( NS::Range::Make( 0, _pIndexBuffer->length() ) );
+        // One partition per frame in flight, each fits everything draw allocates
+        constexpr NS::UInteger frameDataSize = FrameRingAllocator::computePartitionSize( FRAME_ALLOCATION_SIZES );
+        _pFrameAllocator = new FrameRingAllocator( _pDevice, frameDataSize, MAX_FRAMES_IN_FLIGHT );
         
-        constexpr size_t instanceDataSize = MAX_FRAMES_IN_FLIGHT * MAX_NUM_INSTANCES * sizeof( InstanceData );
-        for ( size_t i = 0; i < MAX_FRAMES_IN_FLIGHT; ++i )
+        // Sized for the pool's capacity, buildInstances grows them once it's outgrown
+        _pInstanceBuffer = new InstanceBuffer( _pDevice, _instancePool.getCapacity(), _instanceFormat );
+        
+        // Never touched by the CPU, switching formats just changes what the kernel writes.
+        // The animation and cull passes rewrite these every frame before reading them.
+        _pAnimatedInstances = new GrowableBuffer( _pDevice, _instancePool.getCapacity() * sizeof( InstanceData ) );
+        _pVisibleInstances = new GrowableBuffer( _pDevice, _instancePool.getCapacity() * sizeof( uint32_t ) * INSTANCE_LOD_COUNT );
+    }
+    
+    void Renderer::buildSceneTransforms()
+    {
+        // InstanceAnimation::makeParentTransform as a hierarchy, only the turn changes per frame
+        const simd::float3 origin = InstanceAnimation::makeUniforms( _angle, _instanceRows, _instanceColumns, _instanceDepth ).origin.xyz;
+        const TransformNode pivotNode = _sceneTransforms.addNode( INVALID_TRANSFORM_NODE, Math::makeTranslate( origin ) );
+        _gridTurnNode = _sceneTransforms.addNode( pivotNode, Math::makeIdentity() );
+        _gridNode = _sceneTransforms.addNode( _gridTurnNode, Math::makeTranslate( { -origin.x, -origin.y, -origin.z } ) );
+        _sceneTransforms.update();
+    }
+    
+    void Renderer::buildInstances()
+    {
+        const size_t instanceCount = InstanceAnimation::makeUniforms( _angle, _instanceRows, _instanceColumns, _instanceDepth ).instanceCount;
+        
+        // The grid's instances are its first slots, so resizing only adds or frees the last
+        // ones and nothing has to move
+        while ( _instancePool.getCount() < instanceCount )
+        {
+            _instancePool.allocate();
+        }
+        while ( _instancePool.getCount() > instanceCount )
         {
-            _pInstanceDataBuffers[ i ] = _pDevice->newBuffer( instanceDataSize, MTL::ResourceStorageModeManaged );
+            _instancePool.free( _instancePool.getHandle( _instancePool.getCount() - 1 ) );
         }
         
-        constexpr size_t cameraDataSize = MAX_FRAMES_IN_FLIGHT * sizeof( CameraData );
-        for ( size_t i = 0; i < MAX_FRAMES_IN_FLIGHT; ++i )
+        // The CPU path's copies are refilled from the store before they're read. Buffers the
+        // GPU fills are swapped for larger ones at the next frame.
+        const size_t capacity = _instancePool.getCapacity();
+        _pInstanceBuffer->reserve( capacity, _deletionQueue, _framePacer.getFrameIndex() );
+        _pAnimatedInstances->reserve( capacity * sizeof( InstanceData ) );
+        _pVisibleInstances->reserve( capacity * sizeof( uint32_t ) * INSTANCE_LOD_COUNT );
+        
+        // animate_instances derives the rest pose from the grid itself, the store and the
+        // entities only catch up once the CPU path runs
+        _cpuInstancesStale = true;
+    }
+    
+    void Renderer::syncCpuInstances()
+    {
+        if ( !_cpuInstancesStale )
         {
-            _pCameraDataBuffers[ i ] = _pDevice->newBuffer( cameraDataSize, MTL::ResourceStorageModeManaged );
+            return;
         }
+        _cpuInstancesStale = false;
+        
+        const InstanceAnimationUniforms animationUniforms = InstanceAnimation::makeUniforms( _angle, _instanceRows, _instanceColumns, _instanceDepth );
+        const size_t instanceCount = _instancePool.getCount();
         
-        _pTextureAnimationBuffer = _pDevice->newBuffer( sizeof( uint ), MTL::ResourceStorageModeManaged );
+        // The same rest pose animate_instances derives on the GPU, the grid is centred so every instance moves
+        _instanceStore.resize( instanceCount );
+        _instanceSpin.resize( instanceCount );
+        InstanceAnimation::writeRestPose( animationUniforms, _instanceStore, _instanceSpin.data(), 0 );
+        
+        // Last first, so destroying never moves an entity
+        while ( _instanceEntities.size() > instanceCount )
+        {
+            _entities.destroy( _instanceEntities.back() );
+            _instanceEntities.pop_back();
+        }
+        _instanceEntities.reserve( instanceCount );
+        
+        // The same rest pose again as entities, for setGatherEntities. Entities that are
+        // still there take it in place, only the grown part of the grid is created.
+        for ( size_t i = 0; i < instanceCount; ++i )
+        {
+            InstanceTransformComponent transform{};
+            transform.rotation = simd::float4{ 0.0f, 0.0f, 0.0f, 1.0f };
+            transform.translation[ 0 ] = _instanceStore.getStream( InstanceStream::TranslationX )[ i ];
+            transform.translation[ 1 ] = _instanceStore.getStream( InstanceStream::TranslationY )[ i ];
+            transform.translation[ 2 ] = _instanceStore.getStream( InstanceStream::TranslationZ )[ i ];
+            transform.scale = _instanceStore.getStream( InstanceStream::ScaleX )[ i ];
+            
+            InstanceColorComponent color{};
+            color.color = simd::float4{ _instanceStore.getStream( InstanceStream::ColorR )[ i ],
+                                        _instanceStore.getStream( InstanceStream::ColorG )[ i ],
+                                        _instanceStore.getStream( InstanceStream::ColorB )[ i ],
+                                        _instanceStore.getStream( InstanceStream::ColorA )[ i ] };
+            
+            const InstanceSpinComponent spin{ _instanceSpin[ i ] };
+            if ( i < _instanceEntities.size() )
+            {
+                const Entity entity = _instanceEntities[ i ];
+                *_entities.get< InstanceTransformComponent >( entity ) = transform;
+                *_entities.get< InstanceColorComponent >( entity ) = color;
+                *_entities.get< InstanceSpinComponent >( entity ) = spin;
+            }
+            else
+            {
+                _instanceEntities.push_back( _entities.create( transform, color, spin, InstancedMeshComponent{ 0 } ) );
+            }
+        }
+    }
+    
+    void Renderer::updateCpuInstances()
+    {
+        syncCpuInstances();
+        
+        if ( _gatherEntities )
+        {
+            spinInstances( _entities, *_pWorkerPool, _angle );
+        }
+        else
+        {
+            // Every worker writes its own range of the rotations
+            updateInstancesParallel( *_pWorkerPool, _instanceStore, _instanceSpin.data(), _angle );
+        }
     }
     
     void Renderer::buildDepthStencilStates()
@@ -306,41 +970,186 @@ namespace PCR
     
     void Renderer::buildComputePipeline()
     {
-        auto pComputeLibrary = NS::TransferPtr( _pDevice->newDefaultLibrary() );
-        if ( !pComputeLibrary )
-        {
-            assert( false );
-        }
+        _pComputePipelineStateObject = _pPipelineCache->getComputePipeline( ComputePipelineDesc{ "mandelbrot_set" } );
+    }
+    
+    void Renderer::buildUpscalePipeline()
+    {
+        RenderPipelineDesc renderPipelineDesc;
+        renderPipelineDesc.vertexFunction = "upscaleVertex";
+        renderPipelineDesc.fragmentFunction = "upscaleFragment";
+        renderPipelineDesc.colorAttachments.push_back( PipelineColorAttachment{ MTL::PixelFormatBGRA8Unorm_sRGB } );
+        _pUpscalePipelineStateObject = _pPipelineCache->getRenderPipeline( renderPipelineDesc );
+    }
+    
+    void Renderer::buildVisibilityPipelines()
+    {
+        const RenderPipelineDesc visibilityPipelineDesc = makeVisibilityPipelineDesc();
+        
+        const RenderPipelineDesc resolvePipelineDesc = makeVisibilityResolvePipelineDesc();
+        
+        // Both compile concurrently
+        _pPipelineCache->prepare( visibilityPipelineDesc );
+        _pPipelineCache->prepare( resolvePipelineDesc );
+        
+        _pVisibilityPipelineStateObject = _pPipelineCache->getRenderPipeline( visibilityPipelineDesc );
+        _pVisibilityResolvePipelineStateObject = _pPipelineCache->getRenderPipeline( resolvePipelineDesc );
+    }
+    
+    void Renderer::buildCullPipeline()
+    {
+        _pCullPipelineStateObject = _pPipelineCache->getComputePipeline( makeCullPipelineDesc() );
+    }
+    
+    void Renderer::buildAnimationPipeline()
+    {
+        _pAnimationPipelineStateObject = _pPipelineCache->getComputePipeline( makeAnimationPipelineDesc() );
+    }
+    
+    void Renderer::encodeForward( MTL::RenderCommandEncoder* pRenderCommandEncoder,
+                                  const FrameAllocation& instanceData,
+                                  const FrameAllocation& cameraData,
+                                  const FrameAllocation& visibleInstanceData,
+                                  const FrameAllocation& drawArgumentData,
+                                  NS::UInteger renderWidth,
+                                  NS::UInteger renderHeight )
+    {
+        pRenderCommandEncoder->setViewport( MTL::Viewport{ 0.0, 0.0, static_cast< double >( renderWidth ), static_cast< double >( renderHeight ), 0.0, 1.0 } );
+        pRenderCommandEncoder->setScissorRect( MTL::ScissorRect{ 0, 0, renderWidth, renderHeight } );
+        
+        pRenderCommandEncoder->setDepthStencilState( _pDepthStencilState );
+        
+        /* MTL::Buffer*, offset, index */
+        pRenderCommandEncoder->setVertexBuffer( _pVertexDataBuffer, 0, 0 );
+        pRenderCommandEncoder->setVertexBuffer( instanceData.pBuffer, instanceData.offset, 1 );
+        pRenderCommandEncoder->setVertexBuffer( cameraData.pBuffer, cameraData.offset, 2 );
+        
+        /* MTL::Texture*, index */
+        pRenderCommandEncoder->setFragmentTexture( _pTexture, 0 );
         
-        auto pMandelbrotFn = NS::TransferPtr< MTL::Function >( pComputeLibrary->newFunction( CreateUTF8String( "mandelbrot_set" ) ) );
+        pRenderCommandEncoder->setFrontFacingWinding( MTL::Winding::WindingCounterClockwise );
         
-        NS::Error* pError = nullptr;
-        MTL::ComputePipelineState* pComputePipelineStateObject = _pDevice->newComputePipelineState( pMandelbrotFn.get(), &pError );
-        if ( !pComputePipelineStateObject )
+        // Draw-calls, one per LOD bucket
+        const uint32_t lodCount = usesInstanceLod() ? INSTANCE_LOD_COUNT : 1;
+        for ( uint32_t lod = 0; lod < lodCount; ++lod )
         {
-            __builtin_printf( "%s", pError->localizedDescription()->utf8String() );
-            assert( false );
+            const auto instanceLod = static_cast< InstanceCulling::InstanceLod >( lod );
+            pRenderCommandEncoder->setRenderPipelineState( _pRenderPipelineStateObjects[ lod ] );
+            
+            // Mirroring turns some of the reduced mesh's faces inside out, they all face the camera anyway
+            pRenderCommandEncoder->setCullMode( instanceLod == InstanceCulling::InstanceLod::Reduced ? MTL::CullMode::CullModeNone : MTL::CullMode::CullModeBack );
+            encodeInstancedDraw( pRenderCommandEncoder, visibleInstanceData, drawArgumentData, instanceLod );
         }
-        _pComputePipelineStateObject = pComputePipelineStateObject;
     }
     
-    void Renderer::generateMandelbrotTexture( MTL::CommandBuffer* pCommandBuffer )
+    void Renderer::encodeVisibility( MTL::RenderCommandEncoder* pVisibilityEncoder,
+                                     const FrameAllocation& instanceData,
+                                     const FrameAllocation& cameraData,
+                                     const FrameAllocation& visibleInstanceData,
+                                     const FrameAllocation& drawArgumentData,
+                                     NS::UInteger renderWidth,
+                                     NS::UInteger renderHeight )
     {
-        assert( pCommandBuffer );
+        pVisibilityEncoder->setViewport( MTL::Viewport{ 0.0, 0.0, static_cast< double >( renderWidth ), static_cast< double >( renderHeight ), 0.0, 1.0 } );
+        pVisibilityEncoder->setScissorRect( MTL::ScissorRect{ 0, 0, renderWidth, renderHeight } );
+        pVisibilityEncoder->setRenderPipelineState( _pVisibilityPipelineStateObject );
+        pVisibilityEncoder->setDepthStencilState( _pDepthStencilState );
+        pVisibilityEncoder->setVertexBuffer( _pVertexDataBuffer, 0, 0 );
+        pVisibilityEncoder->setVertexBuffer( instanceData.pBuffer, instanceData.offset, 1 );
+        pVisibilityEncoder->setVertexBuffer( cameraData.pBuffer, cameraData.offset, 2 );
+        pVisibilityEncoder->setCullMode( MTL::CullMode::CullModeBack );
+        pVisibilityEncoder->setFrontFacingWinding( MTL::Winding::WindingCounterClockwise );
+        encodeInstancedDraw( pVisibilityEncoder, visibleInstanceData, drawArgumentData, InstanceCulling::InstanceLod::Full );
+    }
+    
+    void Renderer::encodeInstancedDraw( MTL::RenderCommandEncoder* pRenderCommandEncoder,
+                                        const FrameAllocation& visibleInstanceData,
+                                        const FrameAllocation& drawArgumentData,
+                                        InstanceCulling::InstanceLod lod )
+    {
+        if ( !_gpuCulling )
+        {
+            // An empty grid, or nothing fits yet
+            if ( _drawInstanceCount == 0 )
+            {
+                return;
+            }
+            
+            pRenderCommandEncoder->drawIndexedPrimitives( MTL::PrimitiveType::PrimitiveTypeTriangle,
+                                                         /* indexCount */ 6 * 6,
+                                                         MTL::IndexType::IndexTypeUInt16,
+                                                         _pIndexBuffer,
+                                                         /* indexBufferOffset */ 0,
+                                                         _drawInstanceCount );
+            return;
+        }
         
-        uint* ptr = reinterpret_cast< uint* >( _pTextureAnimationBuffer->contents() );
+        // Each LOD's list is _drawInstanceCount long, as in the cull uniforms
+        const auto lodIndex = static_cast< NS::UInteger >( lod );
+        pRenderCommandEncoder->setVertexBuffer( visibleInstanceData.pBuffer, visibleInstanceData.offset + lodIndex * _drawInstanceCount * sizeof( uint32_t ), 3 );
+        pRenderCommandEncoder->drawIndexedPrimitives( MTL::PrimitiveType::PrimitiveTypeTriangle,
+                                                     MTL::IndexType::IndexTypeUInt16,
+                                                     _pIndexBuffer,
+                                                     /* indexBufferOffset */ 0,
+                                                     drawArgumentData.pBuffer,
+                                                     drawArgumentData.offset + lodIndex * sizeof( InstanceCulling::DrawIndexedArguments ) );
+    }
+    
+    void Renderer::encodeVisibilityResolve( MTL::RenderCommandEncoder* pResolveEncoder,
+                                            MTL::Texture* pVisibilityTexture,
+                                            const FrameAllocation& instanceData,
+                                            const FrameAllocation& cameraData,
+                                            NS::UInteger renderWidth,
+                                            NS::UInteger renderHeight )
+    {
+        VisibilityResolveUniforms uniforms;
+        uniforms.renderSize = simd::float2{ static_cast< float >( renderWidth ), static_cast< float >( renderHeight ) };
+        
+        pResolveEncoder->setViewport( MTL::Viewport{ 0.0, 0.0, static_cast< double >( renderWidth ), static_cast< double >( renderHeight ), 0.0, 1.0 } );
+        pResolveEncoder->setScissorRect( MTL::ScissorRect{ 0, 0, renderWidth, renderHeight } );
+        pResolveEncoder->setRenderPipelineState( _pVisibilityResolvePipelineStateObject );
+        pResolveEncoder->setFragmentTexture( pVisibilityTexture, 0 );
+        pResolveEncoder->setFragmentTexture( _pTexture, 1 );
+        pResolveEncoder->setFragmentBuffer( _pVertexDataBuffer, 0, 0 );
+        pResolveEncoder->setFragmentBuffer( instanceData.pBuffer, instanceData.offset, 1 );
+        pResolveEncoder->setFragmentBuffer( cameraData.pBuffer, cameraData.offset, 2 );
+        pResolveEncoder->setFragmentBuffer( _pIndexBuffer, 0, 3 );
+        pResolveEncoder->setFragmentBytes( &uniforms, sizeof( uniforms ), 4 );
+        pResolveEncoder->drawPrimitives( MTL::PrimitiveType::PrimitiveTypeTriangle, NS::UInteger( 0 ), NS::UInteger( 3 ) );
+    }
+    
+    void Renderer::encodeUpscale( MTL::RenderCommandEncoder* pUpscaleEncoder,
+                                  MTL::Texture* pSceneColorTexture,
+                                  NS::UInteger renderWidth,
+                                  NS::UInteger renderHeight )
+    {
+        const auto textureWidth = static_cast< float >( pSceneColorTexture->width() );
+        const auto textureHeight = static_cast< float >( pSceneColorTexture->height() );
+        
+        UpscaleUniforms uniforms;
+        uniforms.uvScale = simd::float2{ renderWidth / textureWidth, renderHeight / textureHeight };
+        uniforms.uvMax = simd::float2{ ( renderWidth - 0.5f ) / textureWidth, ( renderHeight - 0.5f ) / textureHeight };
+        
+        pUpscaleEncoder->setRenderPipelineState( _pUpscalePipelineStateObject );
+        pUpscaleEncoder->setFragmentTexture( pSceneColorTexture, 0 );
+        pUpscaleEncoder->setFragmentBytes( &uniforms, sizeof( uniforms ), 0 );
+        pUpscaleEncoder->drawPrimitives( MTL::PrimitiveType::PrimitiveTypeTriangle, NS::UInteger( 0 ), NS::UInteger( 3 ) );
+    }
+    
+    void Renderer::generateMandelbrotTexture( MTL::ComputeCommandEncoder* pComputeEncoder, const FrameAllocation& animationData )
+    {
+        assert( pComputeEncoder );
+        
+        uint* ptr = animationData.as< uint >();
         *ptr = ( _animationIndex++ );
         if ( _animationIndex >= 5000 )
         {
             _animationIndex = 0;
         }
-        _pTextureAnimationBuffer->didModifyRange( NS::Range( 0, sizeof( uint ) ) );
-        
-        MTL::ComputeCommandEncoder* pComputeEncoder = pCommandBuffer->computeCommandEncoder();
         
         pComputeEncoder->setComputePipelineState( _pComputePipelineStateObject );
         pComputeEncoder->setTexture( _pTexture, 0 );
-        pComputeEncoder->setBuffer( _pTextureAnimationBuffer, /* offset */ 0 , /* index */ 0);
+        pComputeEncoder->setBuffer( animationData.pBuffer, animationData.offset, /* index */ 0 );
         
         MTL::Size gridSize = MTL::Size( DEFAULT_TEXTURE_WIDTH, DEFAULT_TEXTURE_HEIGHT, 1 );
         
@@ -348,7 +1157,126 @@ namespace PCR
         MTL::Size threadGroupSize = MTL::Size( threadGroupX, 1, 1 );
         
         pComputeEncoder->dispatchThreads( gridSize, threadGroupSize );
+    }
+    
+    void Renderer::encodeInstanceCulling( MTL::ComputeCommandEncoder* pComputeEncoder,
+                                          const FrameAllocation& instanceData,
+                                          const FrameAllocation& visibleInstanceData,
+                                          const FrameAllocation& drawArgumentData,
+                                          const CullUniforms& cullUniforms )
+    {
+        assert( pComputeEncoder );
+        
+        if ( _drawInstanceCount == 0 )
+        {
+            return;
+        }
+        
+        pComputeEncoder->setComputePipelineState( _pCullPipelineStateObject );
+        pComputeEncoder->setBuffer( instanceData.pBuffer, instanceData.offset, 0 );
+        pComputeEncoder->setBytes( &cullUniforms, sizeof( cullUniforms ), 1 );
+        pComputeEncoder->setBuffer( visibleInstanceData.pBuffer, visibleInstanceData.offset, 2 );
+        pComputeEncoder->setBuffer( drawArgumentData.pBuffer, drawArgumentData.offset, 3 );
+        
+        const NS::UInteger threadGroupX = std::min< NS::UInteger >( _pCullPipelineStateObject->maxTotalThreadsPerThreadgroup(), 64 );
+        pComputeEncoder->dispatchThreads( MTL::Size( cullUniforms.instanceCount, 1, 1 ), MTL::Size( threadGroupX, 1, 1 ) );
+    }
+    
+    void Renderer::encodeInstanceAnimation( MTL::ComputeCommandEncoder* pComputeEncoder,
+                                            const FrameAllocation& instanceData,
+                                            const InstanceAnimationUniforms& animationUniforms )
+    {
+        assert( pComputeEncoder );
+        
+        if ( _drawInstanceCount == 0 )
+        {
+            return;
+        }
+        
+        pComputeEncoder->setComputePipelineState( _pAnimationPipelineStateObject );
+        pComputeEncoder->setBuffer( instanceData.pBuffer, instanceData.offset, 0 );
+        pComputeEncoder->setBytes( &animationUniforms, sizeof( animationUniforms ), 1 );
+        
+        const NS::UInteger threadGroupX = std::min< NS::UInteger >( _pAnimationPipelineStateObject->maxTotalThreadsPerThreadgroup(), 64 );
+        pComputeEncoder->dispatchThreads( MTL::Size( _drawInstanceCount, 1, 1 ), MTL::Size( threadGroupX, 1, 1 ) );
+    }
+    
+    CameraData Renderer::makePointCloudCamera( const CameraData& cameraData ) const
+    {
+        CameraData pointCloudCamera = cameraData;
+        pointCloudCamera.worldTransform = Math::makeTranslate( simd::float3{ 0.0f, 0.0f, -POINT_CLOUD_DISTANCE } )
+                                        * Math::makeYRotate( POINT_CLOUD_ORBIT_SPEED * _angle )
+                                        * cameraData.worldTransform;
+        pointCloudCamera.worldNormalTransform = Math::discardTranslation( pointCloudCamera.worldTransform );
+        return pointCloudCamera;
+    }
+    
+    MTL::Texture* Renderer::renderPointCloud( uint32_t textureIndex,
+                                              const CameraData& cameraData,
+                                              uint32_t renderWidth,
+                                              uint32_t renderHeight,
+                                              uint32_t drawableWidth,
+                                              uint32_t drawableHeight )
+    {
+        ScopedCpuTimer timer( &_profiler, "Point Cloud" );
+        
+        MTL::Texture*& pTexture = _pPointCloudTextures[ textureIndex ];
+        if ( !pTexture || pTexture->width() != drawableWidth || pTexture->height() != drawableHeight )
+        {
+            if ( pTexture )
+            {
+                releaseDeferred( pTexture );
+            }
+            
+            // Point colors are display values, the sRGB view gives them back unchanged
+            auto pTextureDesc = NS::TransferPtr( MTL::TextureDescriptor::texture2DDescriptor( MTL::PixelFormatRGBA8Unorm_sRGB, drawableWidth, drawableHeight, false ) );
+            pTextureDesc->setStorageMode( MTL::StorageModeManaged );
+            pTextureDesc->setUsage( MTL::TextureUsageShaderRead );
+            pTexture = _pDevice->newTexture( pTextureDesc.get() );
+        }
+        
+        // A different size can't reuse the history, even with the same pixel count
+        if ( _pPointRasterizer->getWidth() != renderWidth || _pPointRasterizer->getHeight() != renderHeight )
+        {
+            _pPointRasterizer->resize( renderWidth, renderHeight );
+            _pPointReprojector->invalidate();
+        }
+        
+        _pPointReprojector->render( _pointCloud.data(), _pointCloud.size(), cameraData, PointRasterMode::Binned );
+        
+        _pointColors.resize( static_cast< size_t >( renderWidth ) * renderHeight );
+        _pPointRasterizer->resolve( _pointCloud.data(), _pointColors.data(), 0 );
+        pTexture->replaceRegion( MTL::Region::Make2D( 0, 0, renderWidth, renderHeight ), 0, _pointColors.data(), renderWidth * sizeof( uint32_t ) );
+        
+        return pTexture;
+    }
+    
+    MTL::Texture* Renderer::prepareSplatTarget( uint32_t textureIndex, uint32_t drawableWidth, uint32_t drawableHeight )
+    {
+        // Shared so the splat pass reads the points straight from the copy setPointCloud kept
+        if ( !_pPointCloudBuffer && !_pointCloud.empty() )
+        {
+            _pPointCloudBuffer = _pDevice->newBuffer( _pointCloud.data(), _pointCloud.size() * sizeof( PointData ), MTL::ResourceStorageModeShared );
+        }
+        
+        MTL::Texture*& pTarget = _pSplatTargets[ textureIndex ];
+        MTL::Texture*& pTargetView = _pSplatTargetViews[ textureIndex ];
+        if ( !pTarget || pTarget->width() != drawableWidth || pTarget->height() != drawableHeight )
+        {
+            if ( pTarget )
+            {
+                releaseDeferred( pTargetView );
+                releaseDeferred( pTarget );
+            }
+            
+            // Compute can't write sRGB everywhere, the kernel writes the 8-bit values as they are
+            auto pTextureDesc = NS::TransferPtr( MTL::TextureDescriptor::texture2DDescriptor( MTL::PixelFormatRGBA8Unorm, drawableWidth, drawableHeight, false ) );
+            pTextureDesc->setStorageMode( MTL::StorageModePrivate );
+            pTextureDesc->setUsage( MTL::TextureUsageShaderRead | MTL::TextureUsageShaderWrite | MTL::TextureUsagePixelFormatView );
+            pTarget = _pDevice->newTexture( pTextureDesc.get() );
+            pTargetView = pTarget->newTextureView( MTL::PixelFormatRGBA8Unorm_sRGB );
+        }
         
-        pComputeEncoder->endEncoding();
+        return pTarget;
     }
 }
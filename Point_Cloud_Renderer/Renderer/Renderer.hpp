@@ -10,14 +10,61 @@
 
 #include <Metal/Metal.hpp>
 
+#include <array>
+#include <atomic>
+#include <vector>
+
 #include "Core/Core.hpp"
 #include "Renderer/Data/Constants.hpp"
+#include "Renderer/Buffer/DeferredDeletionQueue.hpp"
+#include "Renderer/Buffer/FrameRingAllocator.hpp"
+#include "Renderer/Buffer/GrowableBuffer.hpp"
+#include "Renderer/Buffer/UploadManager.hpp"
+#include "Renderer/Culling/InstanceCulling.hpp"
+#include "Renderer/DynamicResolution/DynamicResolutionController.hpp"
+#include "Renderer/Instances/InstanceBuffer.hpp"
+#include "Renderer/Instances/InstancePool.hpp"
+#include "Renderer/Instances/InstanceStore.hpp"
+#include "Renderer/Pipeline/PipelineCache.hpp"
+#include "Renderer/PointCloud/PointCloudMode.hpp"
+#include "Renderer/PointCloud/PointRasterizer.hpp"
+#include "Renderer/PointCloud/PointReprojector.hpp"
+#include "Renderer/Profiler/FrameProfiler.hpp"
+#include "Renderer/RenderGraph/RenderGraph.hpp"
+#include "Renderer/RenderGraph/RenderGraphExecutor.hpp"
+#include "Renderer/Scene/EntityWorld.hpp"
+#include "Renderer/Scene/TransformHierarchy.hpp"
+#include "Renderer/Threading/FramePacer.hpp"
+#include "Renderer/Threading/WorkerPool.hpp"
+#include "Renderer/Validation/GpuReadbackValidator.hpp"
 
 FD_MTL
 FD_MTK
 
 namespace PCR
 {
+    class SplatPass;
+    struct CullUniforms;
+    struct InstanceAnimationUniforms;
+
+    enum class RenderPath
+    {
+        // vertexMain / fragmentMain, shades every fragment that passes the depth test
+        Forward,
+        
+        // Raster pass writes instance + primitive IDs only, a full-screen
+        // resolve then shades every visible pixel exactly once
+        VisibilityBuffer
+    };
+
+    // Values of the colorMode function constant in Basic.metal
+    enum class ColorMode : uint32_t
+    {
+        Instance,
+        Normal,
+        White
+    };
+
     class Renderer
     {
     public:
@@ -26,15 +73,113 @@ namespace PCR
         ~Renderer();
         
         void draw( MTK::View* pView );
+        
+        void setRenderPath( RenderPath renderPath );
+        
+        RenderPath getRenderPath() const;
+        
+        // Switches the forward pipeline to the matching vertexMain specialisation
+        void setColorMode( ColorMode colorMode );
+        
+        ColorMode getColorMode() const;
+        
+        // Instances are frustum culled in a compute pass that writes the indirect draw
+        // arguments, so the CPU encodes the same commands however many are visible
+        void setGpuCulling( bool gpuCulling );
+        
+        bool getGpuCulling() const;
+        
+        // The cull pass also buckets the visible instances by distance into the full cube,
+        // three faces, or a quad, each bucket its own indirect draw. Forward path only, the
+        // visibility buffer's resolve refetches full-cube triangles.
+        void setInstanceLod( bool instanceLod );
+        
+        bool getInstanceLod() const;
+        
+        // Releases pResource once every frame encoded so far has completed, safe to
+        // call for buffers or textures the frames in flight may still read
+        void releaseDeferred( MTL::Resource* pResource );
+        
+        // 1 to MAX_FRAMES_IN_FLIGHT, fewer frames ahead means less latency and less overlap
+        void setFramesInFlight( uint32_t framesInFlight );
+        
+        uint32_t getFramesInFlight() const;
+        
+        const FramePacingStats& getFramePacingStats() const;
+        
+        // Paused instances keep their transforms, on the CPU path the instance buffer stops being rewritten
+        void setAnimateInstances( bool animateInstances );
+        
+        bool getAnimateInstances() const;
+        
+        const InstanceBufferStats& getInstanceBufferStats() const;
+        
+        // Compact instances are a quarter of the size, every instance shader decodes them
+        void setInstanceFormat( InstanceFormat instanceFormat );
+        
+        InstanceFormat getInstanceFormat() const;
+        
+        // Instances are animated by a compute kernel writing straight into a private
+        // buffer, the CPU only passes the frame's angle. Off falls back to InstanceBuffer.
+        void setGpuAnimation( bool gpuAnimation );
+        
+        bool getGpuAnimation() const;
+        
+        // With GPU animation off, gathers the instances from entities rather than the
+        // InstanceStore, straight into the instance buffer
+        void setGatherEntities( bool gatherEntities );
+        
+        bool getGatherEntities() const;
+        
+        // Rebuilds the instances as a rows x columns x depth grid. Buffers that are too small
+        // grow in the background, until they have frames draw what fits the old ones.
+        void setInstanceGrid( uint32_t rows, uint32_t columns, uint32_t depth );
+        
+        size_t getInstanceCount() const;
+        
+        // Reads back what the GPU animated and culled each frame and checks it against the CPU
+        // references, see GpuReadbackValidator. Slow, for validation runs only.
+        void setGpuValidation( bool gpuValidation );
+        
+        bool getGpuValidation() const;
+        
+        GpuValidationStats getGpuValidationStats() const;
+        
+        // Shows a point cloud orbited by the camera instead of the cubes. The first time a
+        // mode is picked without a cloud set, a generated sphere is used.
+        void setPointCloudMode( PointCloudMode pointCloudMode );
+        
+        PointCloudMode getPointCloudMode() const;
+        
+        void setPointCloud( std::vector< PointData > points );
+        
+        size_t getPointCount() const;
+        
+        // The last frame's and the sums since the point cloud or its mode last changed
+        const ReprojectionStats& getReprojectionStats() const;
+        
+        const ReprojectionTotals& getReprojectionTotals() const;
+        
+        // CPU timings of the frame and the point cloud, GPU timings of the frame and each splat pass
+        FrameProfiler& getProfiler();
 
     private:
         MTL::Device* _pDevice;
         
         MTL::CommandQueue* _pCommandQueue;
         
-        MTL::RenderPipelineState* _pRenderPipelineStateObject;
+        // Forward pipelines, indexed by InstanceCulling::InstanceLod
+        std::array< MTL::RenderPipelineState*, INSTANCE_LOD_COUNT > _pRenderPipelineStateObjects;
+        
+        MTL::RenderPipelineState* _pUpscalePipelineStateObject;
+        
+        MTL::RenderPipelineState* _pVisibilityPipelineStateObject;
+        
+        MTL::RenderPipelineState* _pVisibilityResolvePipelineStateObject;
         
-        MTL::Library* _pShaderLibrary;
+        ShaderRegistry* _pShaderRegistry;
+        
+        PipelineCache* _pPipelineCache;
         
         MTL::DepthStencilState* _pDepthStencilState;
         
@@ -42,35 +187,245 @@ namespace PCR
         
         MTL::ComputePipelineState* _pComputePipelineStateObject;
         
-        MTL::Buffer* _pVertexDataBuffer;
+        MTL::ComputePipelineState* _pCullPipelineStateObject;
         
-        MTL::Buffer* _pInstanceDataBuffers[ MAX_FRAMES_IN_FLIGHT ];
+        MTL::ComputePipelineState* _pAnimationPipelineStateObject;
         
-        MTL::Buffer* _pCameraDataBuffers[ MAX_FRAMES_IN_FLIGHT ];
+        MTL::Buffer* _pVertexDataBuffer;
         
         MTL::Buffer* _pIndexBuffer;
         
-        MTL::Buffer* _pTextureAnimationBuffer;
+        // Camera, culling and texture animation data for every frame in flight
+        FrameRingAllocator* _pFrameAllocator;
         
-        int _frame;
+        // Static data lives in private buffers filled through here
+        UploadManager* _pUploadManager;
         
         float _angle;
         
+        uint32_t _instanceRows;
+        
+        uint32_t _instanceColumns;
+        
+        uint32_t _instanceDepth;
+        
+        // One slot per instance, its capacity sizes every per-instance buffer
+        InstancePool _instancePool;
+        
+        // Instances this frame draws, short of the pool's count while a buffer is growing
+        size_t _drawInstanceCount;
+        
+        // Translation, scale and color are set in syncCpuInstances, only the
+        // rotations change per frame
+        InstanceStore _instanceStore;
+        
+        // Radians per unit of _angle, about Z
+        std::vector< float > _instanceSpin;
+        
+        // Pivot at the grid centre, the turn about it, and the grid moved back onto the
+        // pivot. The grid node's world matrix is the instances' parent on the CPU path.
+        TransformHierarchy _sceneTransforms;
+        
+        TransformNode _gridTurnNode;
+        
+        TransformNode _gridNode;
+        
+        // The same cubes as entities, one archetype so far
+        EntityWorld _entities;
+        
+        // In slot order
+        std::vector< Entity > _instanceEntities;
+        
+        // The grid changed since the store and the entities were last written
+        bool _cpuInstancesStale;
+        
+        bool _gatherEntities;
+        
+        bool _animateInstances;
+        
+        InstanceFormat _instanceFormat;
+        
+        // One copy per frame in flight, only the ranges that changed get rewritten
+        InstanceBuffer* _pInstanceBuffer;
+        
+        // Runs the instance update over disjoint ranges of the instances
+        WorkerPool* _pWorkerPool;
+        
+        bool _gpuAnimation;
+        
+        // Written by animate_instances every frame, sized for the larger instance layout.
+        // Hazard tracking keeps a frame's kernel behind the previous frame's draws.
+        GrowableBuffer* _pAnimatedInstances;
+        
+        // The cull pass's list of visible instance indices, shared by the frames like the
+        // animated instances
+        GrowableBuffer* _pVisibleInstances;
+        
         uint _animationIndex;
         
-        dispatch_semaphore_t _semaphore;
+        RenderPath _renderPath;
+        
+        ColorMode _colorMode;
+        
+        bool _gpuCulling;
+        
+        bool _instanceLod;
+        
+        // Null until validation is first turned on
+        GpuReadbackValidator* _pGpuValidator;
+        
+        bool _gpuValidation;
+        
+        // Rebuilt every frame, scene targets are transients placed by the executor
+        RenderGraph _renderGraph;
+        
+        RenderGraphExecutor* _pRenderGraphExecutor;
+        
+        DeferredDeletionQueue _deletionQueue;
+        
+        // Numbers the frames, completion handlers report them back
+        FramePacer _framePacer;
+        
+        DynamicResolutionController _resolutionController;
+        
+        PointCloudMode _pointCloudMode;
+        
+        std::vector< PointData > _pointCloud;
+        
+        PointRasterizer* _pPointRasterizer;
+        
+        PointReprojector* _pPointReprojector;
+        
+        // The CPU raster resolved to RGBA8, one per render pixel
+        std::vector< uint32_t > _pointColors;
+        
+        // Drawable sized like the scene targets, one per frame in flight so the CPU only
+        // writes the copy whose last frame has completed
+        std::array< MTL::Texture*, MAX_FRAMES_IN_FLIGHT > _pPointCloudTextures;
+        
+        // Null until splats are first drawn
+        SplatPass* _pSplatPass;
+        
+        // The point cloud for the GPU, null until splats need it
+        MTL::Buffer* _pPointCloudBuffer;
+        
+        // Written by the splat pass, one per frame in flight like the point cloud textures, and
+        // the sRGB views the upscale samples so splats come out the same as the CPU raster
+        std::array< MTL::Texture*, MAX_FRAMES_IN_FLIGHT > _pSplatTargets;
+        
+        std::array< MTL::Texture*, MAX_FRAMES_IN_FLIGHT > _pSplatTargetViews;
+        
+        FrameProfiler _profiler;
+        
+        double _lastCpuFrameMs;
+        
+        // Written from the command buffer completion handler
+        std::atomic< double > _lastGpuFrameMs;
         
         void buildShaders();
         
+        RenderPipelineDesc makeForwardPipelineDesc( InstanceCulling::InstanceLod lod ) const;
+        
+        void buildForwardPipelines();
+        
+        // LOD buckets get drawn this frame
+        bool usesInstanceLod() const;
+        
+        RenderPipelineDesc makeVisibilityPipelineDesc() const;
+        
+        RenderPipelineDesc makeVisibilityResolvePipelineDesc() const;
+        
+        ComputePipelineDesc makeCullPipelineDesc() const;
+        
+        ComputePipelineDesc makeAnimationPipelineDesc() const;
+        
         void buildBuffers();
         
+        void buildSceneTransforms();
+        
+        // Sizes the pool for the current grid and grows what's too small
+        void buildInstances();
+        
+        // Writes the rest pose into the store and the entities if the grid changed since they were last written
+        void syncCpuInstances();
+        
+        // Spins the CPU side instances, whichever source is in use, to _angle, syncing them first
+        void updateCpuInstances();
+        
         void buildDepthStencilStates();
         
         void buildTextures();
         
         void buildComputePipeline();
         
-        void generateMandelbrotTexture( MTL::CommandBuffer* pCommandBuffer );
+        void buildUpscalePipeline();
+        
+        void buildVisibilityPipelines();
+        
+        void buildCullPipeline();
+        
+        void buildAnimationPipeline();
+        
+        void encodeForward( MTL::RenderCommandEncoder* pRenderCommandEncoder,
+                            const FrameAllocation& instanceData,
+                            const FrameAllocation& cameraData,
+                            const FrameAllocation& visibleInstanceData,
+                            const FrameAllocation& drawArgumentData,
+                            NS::UInteger renderWidth,
+                            NS::UInteger renderHeight );
+        
+        void encodeVisibility( MTL::RenderCommandEncoder* pVisibilityEncoder,
+                               const FrameAllocation& instanceData,
+                               const FrameAllocation& cameraData,
+                               const FrameAllocation& visibleInstanceData,
+                               const FrameAllocation& drawArgumentData,
+                               NS::UInteger renderWidth,
+                               NS::UInteger renderHeight );
+        
+        void encodeVisibilityResolve( MTL::RenderCommandEncoder* pResolveEncoder,
+                                      MTL::Texture* pVisibilityTexture,
+                                      const FrameAllocation& instanceData,
+                                      const FrameAllocation& cameraData,
+                                      NS::UInteger renderWidth,
+                                      NS::UInteger renderHeight );
+        
+        // Direct draw of every instance, or the indirect draw the cull pass filled in for lod
+        void encodeInstancedDraw( MTL::RenderCommandEncoder* pRenderCommandEncoder,
+                                  const FrameAllocation& visibleInstanceData,
+                                  const FrameAllocation& drawArgumentData,
+                                  InstanceCulling::InstanceLod lod );
+        
+        void encodeUpscale( MTL::RenderCommandEncoder* pUpscaleEncoder,
+                            MTL::Texture* pSceneColorTexture,
+                            NS::UInteger renderWidth,
+                            NS::UInteger renderHeight );
+        
+        void generateMandelbrotTexture( MTL::ComputeCommandEncoder* pComputeEncoder, const FrameAllocation& animationData );
+        
+        void encodeInstanceCulling( MTL::ComputeCommandEncoder* pComputeEncoder,
+                                    const FrameAllocation& instanceData,
+                                    const FrameAllocation& visibleInstanceData,
+                                    const FrameAllocation& drawArgumentData,
+                                    const CullUniforms& cullUniforms );
+        
+        void encodeInstanceAnimation( MTL::ComputeCommandEncoder* pComputeEncoder,
+                                      const FrameAllocation& instanceData,
+                                      const InstanceAnimationUniforms& animationUniforms );
+        
+        // The frame's camera moved back from the cloud and turned about it with _angle
+        CameraData makePointCloudCamera( const CameraData& cameraData ) const;
+        
+        // Reprojects the cloud on the CPU and uploads the image into this frame's texture,
+        // top-left renderWidth x renderHeight like the scene targets
+        MTL::Texture* renderPointCloud( uint32_t textureIndex,
+                                        const CameraData& cameraData,
+                                        uint32_t renderWidth,
+                                        uint32_t renderHeight,
+                                        uint32_t drawableWidth,
+                                        uint32_t drawableHeight );
+        
+        // This frame's splat target, grown with the drawable like the point cloud textures
+        MTL::Texture* prepareSplatTarget( uint32_t textureIndex, uint32_t drawableWidth, uint32_t drawableHeight );
     };
 }
 
@@ -0,0 +1,284 @@
+//
+//  EntityWorld.cpp
+//  Point_Cloud_Renderer
+//
+//  Created by Vatsalya Yadav on 10/19/26.
+//
+
+#include "EntityWorld.hpp"
+
+#include <algorithm>
+#include <cassert>
+#include <new>
+
+namespace PCR
+{
+    namespace
+    {
+        // Component arrays start on cache lines, so no two arrays share one
+        constexpr size_t CHUNK_ALIGNMENT{ 64 };
+        
+        struct ComponentInfo
+        {
+            size_t size = 0;
+            
+            size_t alignment = 0;
+        };
+        
+        // Filled before main or on first use of each component type, only read afterwards
+        std::vector< ComponentInfo >& getComponentInfos()
+        {
+            static std::vector< ComponentInfo > componentInfos;
+            return componentInfos;
+        }
+        
+        size_t alignUp( size_t value, size_t alignment )
+        {
+            return ( value + alignment - 1 ) / alignment * alignment;
+        }
+    }
+
+    ComponentId registerComponent( size_t size, size_t alignment )
+    {
+        std::vector< ComponentInfo >& componentInfos = getComponentInfos();
+        if ( componentInfos.size() >= MAX_COMPONENT_TYPES || alignment > CHUNK_ALIGNMENT )
+        {
+            __builtin_printf( "Too many component types or a component aligned beyond a cache line\n" );
+            assert( false );
+        }
+        
+        componentInfos.push_back( ComponentInfo{ size, alignment } );
+        return static_cast< ComponentId >( componentInfos.size() - 1 );
+    }
+
+    EntityArchetype::EntityArchetype( ComponentMask mask )
+    :   _mask{ mask }
+    ,   _chunkCapacity{ 0 }
+    ,   _entityCount{ 0 }
+    ,   _componentOffsets{}
+    ,   _componentSizes{}
+    {
+        const std::vector< ComponentInfo >& componentInfos = getComponentInfos();
+        
+        size_t bytesPerEntity = sizeof( Entity );
+        for ( ComponentId component = 0; component < componentInfos.size(); ++component )
+        {
+            if ( _mask & ( ComponentMask{ 1 } << component ) )
+            {
+                bytesPerEntity += componentInfos[ component ].size;
+            }
+        }
+        
+        // Start from the unpadded fit and back off until the aligned arrays fit too
+        for ( _chunkCapacity = ENTITY_CHUNK_SIZE / bytesPerEntity; _chunkCapacity > 0; --_chunkCapacity )
+        {
+            size_t offset = alignUp( sizeof( Entity ) * _chunkCapacity, CHUNK_ALIGNMENT );
+            for ( ComponentId component = 0; component < componentInfos.size(); ++component )
+            {
+                if ( _mask & ( ComponentMask{ 1 } << component ) )
+                {
+                    _componentOffsets[ component ] = static_cast< uint32_t >( offset );
+                    _componentSizes[ component ] = static_cast< uint32_t >( componentInfos[ component ].size );
+                    offset = alignUp( offset + componentInfos[ component ].size * _chunkCapacity, CHUNK_ALIGNMENT );
+                }
+            }
+            
+            if ( offset <= ENTITY_CHUNK_SIZE )
+            {
+                break;
+            }
+        }
+        
+        if ( _chunkCapacity == 0 )
+        {
+            __builtin_printf( "Components don't fit an entity chunk\n" );
+            assert( false );
+        }
+    }
+
+    EntityArchetype::~EntityArchetype()
+    {
+        for ( std::byte* pChunk : _chunks )
+        {
+            ::operator delete( pChunk, std::align_val_t{ CHUNK_ALIGNMENT } );
+        }
+    }
+
+    ComponentMask EntityArchetype::getMask() const
+    {
+        return _mask;
+    }
+
+    size_t EntityArchetype::getChunkCapacity() const
+    {
+        return _chunkCapacity;
+    }
+
+    size_t EntityArchetype::getChunkCount() const
+    {
+        return ( _entityCount + _chunkCapacity - 1 ) / _chunkCapacity;
+    }
+
+    size_t EntityArchetype::getChunkSize( size_t chunkIndex ) const
+    {
+        return std::min( _chunkCapacity, _entityCount - chunkIndex * _chunkCapacity );
+    }
+
+    size_t EntityArchetype::getEntityCount() const
+    {
+        return _entityCount;
+    }
+
+    void* EntityArchetype::getComponents( size_t chunkIndex, ComponentId component ) const
+    {
+        if ( !( _mask & ( ComponentMask{ 1 } << component ) ) )
+        {
+            return nullptr;
+        }
+        return _chunks[ chunkIndex ] + _componentOffsets[ component ];
+    }
+
+    Entity* EntityArchetype::getEntities( size_t chunkIndex ) const
+    {
+        return reinterpret_cast< Entity* >( _chunks[ chunkIndex ] );
+    }
+
+    size_t EntityArchetype::appendEntity( Entity entity )
+    {
+        const size_t row = _entityCount;
+        const size_t chunkIndex = row / _chunkCapacity;
+        if ( chunkIndex == _chunks.size() )
+        {
+            _chunks.push_back( static_cast< std::byte* >( ::operator new( ENTITY_CHUNK_SIZE, std::align_val_t{ CHUNK_ALIGNMENT } ) ) );
+        }
+        
+        getEntities( chunkIndex )[ row % _chunkCapacity ] = entity;
+        ++_entityCount;
+        return row;
+    }
+
+    Entity EntityArchetype::removeEntity( size_t row )
+    {
+        assert( row < _entityCount );
+        
+        const size_t last = --_entityCount;
+        if ( row == last )
+        {
+            return INVALID_ENTITY;
+        }
+        
+        const size_t rowChunk = row / _chunkCapacity;
+        const size_t rowSlot = row % _chunkCapacity;
+        const size_t lastChunk = last / _chunkCapacity;
+        const size_t lastSlot = last % _chunkCapacity;
+        
+        for ( ComponentId component = 0; component < MAX_COMPONENT_TYPES; ++component )
+        {
+            if ( _mask & ( ComponentMask{ 1 } << component ) )
+            {
+                const size_t size = _componentSizes[ component ];
+                std::memcpy( static_cast< std::byte* >( getComponents( rowChunk, component ) ) + rowSlot * size,
+                             static_cast< std::byte* >( getComponents( lastChunk, component ) ) + lastSlot * size,
+                             size );
+            }
+        }
+        
+        const Entity moved = getEntities( lastChunk )[ lastSlot ];
+        getEntities( rowChunk )[ rowSlot ] = moved;
+        return moved;
+    }
+
+    void EntityWorld::destroy( Entity entity )
+    {
+        if ( !isAlive( entity ) )
+        {
+            return;
+        }
+        
+        EntityRecord& record = _records[ entity.index ];
+        const Entity moved = record.pArchetype->removeEntity( record.row );
+        if ( moved != INVALID_ENTITY )
+        {
+            _records[ moved.index ].row = record.row;
+        }
+        
+        record.pArchetype = nullptr;
+        ++record.generation;
+        _freeIndices.push_back( entity.index );
+        --_entityCount;
+    }
+
+    bool EntityWorld::isAlive( Entity entity ) const
+    {
+        return entity.index < _records.size()
+            && _records[ entity.index ].pArchetype
+            && _records[ entity.index ].generation == entity.generation;
+    }
+
+    size_t EntityWorld::getEntityCount() const
+    {
+        return _entityCount;
+    }
+
+    size_t EntityWorld::getArchetypeCount() const
+    {
+        return _archetypes.size();
+    }
+
+    EntityArchetype& EntityWorld::getArchetype( ComponentMask mask )
+    {
+        // A handful of archetypes, a linear search beats hashing
+        for ( const auto& pArchetype : _archetypes )
+        {
+            if ( pArchetype->getMask() == mask )
+            {
+                return *pArchetype;
+            }
+        }
+        
+        _archetypes.push_back( std::make_unique< EntityArchetype >( mask ) );
+        return *_archetypes.back();
+    }
+
+    Entity EntityWorld::allocateEntity( EntityArchetype& archetype )
+    {
+        Entity entity;
+        if ( _freeIndices.empty() )
+        {
+            entity.index = static_cast< uint32_t >( _records.size() );
+            _records.emplace_back();
+        }
+        else
+        {
+            entity.index = _freeIndices.back();
+            _freeIndices.pop_back();
+        }
+        
+        EntityRecord& record = _records[ entity.index ];
+        entity.generation = record.generation;
+        record.pArchetype = &archetype;
+        record.row = archetype.appendEntity( entity );
+        ++_entityCount;
+        return entity;
+    }
+
+    std::vector< EntityWorld::ChunkReference > EntityWorld::gatherChunks( ComponentMask mask ) const
+    {
+        std::vector< ChunkReference > chunks;
+        size_t firstIndex = 0;
+        for ( const auto& pArchetype : _archetypes )
+        {
+            if ( ( pArchetype->getMask() & mask ) != mask )
+            {
+                continue;
+            }
+            
+            for ( size_t chunk = 0; chunk < pArchetype->getChunkCount(); ++chunk )
+            {
+                chunks.push_back( ChunkReference{ pArchetype.get(), chunk, firstIndex } );
+                firstIndex += pArchetype->getChunkSize( chunk );
+            }
+        }
+        return chunks;
+    }
+}
@@ -0,0 +1,270 @@
+//
+//  EntityWorld.hpp
+//  Point_Cloud_Renderer
+//
+//  Created by Vatsalya Yadav on 10/19/26.
+//
+
+#ifndef EntityWorld_hpp
+#define EntityWorld_hpp
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <memory>
+#include <type_traits>
+#include <vector>
+
+#include "Renderer/Data/Constants.hpp"
+#include "Renderer/Threading/WorkerPool.hpp"
+
+namespace PCR
+{
+    using ComponentId = uint32_t;
+
+    // One bit per component type
+    using ComponentMask = uint64_t;
+
+    constexpr size_t MAX_COMPONENT_TYPES{ 64 };
+
+    struct Entity
+    {
+        uint32_t index = UINT32_MAX;
+        
+        // Bumped when the index is reused, so stale handles stop resolving
+        uint32_t generation = 0;
+        
+        bool operator==( const Entity& other ) const = default;
+    };
+
+    constexpr Entity INVALID_ENTITY{};
+
+    // Ids are handed out on first use. Components are plain data, they're moved around with memcpy.
+    ComponentId registerComponent( size_t size, size_t alignment );
+
+    template < typename T >
+    ComponentId getComponentId()
+    {
+        static_assert( std::is_trivially_copyable_v< T > && std::is_trivially_destructible_v< T >, "Components are plain data" );
+        static const ComponentId id = registerComponent( sizeof( T ), alignof( T ) );
+        return id;
+    }
+
+    // Every entity with exactly one set of components. Entities live in fixed-size chunks,
+    // one array per component inside each chunk, and removal moves the archetype's last
+    // entity into the hole, so every chunk but the last is full and iteration never skips.
+    class EntityArchetype
+    {
+    public:
+        EntityArchetype( ComponentMask mask );
+        
+        ~EntityArchetype();
+        
+        EntityArchetype( const EntityArchetype& ) = delete;
+        
+        EntityArchetype& operator=( const EntityArchetype& ) = delete;
+        
+        ComponentMask getMask() const;
+        
+        size_t getChunkCapacity() const;
+        
+        size_t getChunkCount() const;
+        
+        // Entities in chunkIndex
+        size_t getChunkSize( size_t chunkIndex ) const;
+        
+        size_t getEntityCount() const;
+        
+        // Array of getChunkCapacity() components, null if the archetype doesn't have it
+        void* getComponents( size_t chunkIndex, ComponentId component ) const;
+        
+        Entity* getEntities( size_t chunkIndex ) const;
+        
+        // Uninitialised components, returns the new row
+        size_t appendEntity( Entity entity );
+        
+        // Moves the last entity into row and returns it, INVALID_ENTITY when row was the last
+        Entity removeEntity( size_t row );
+
+    private:
+        ComponentMask _mask;
+        
+        size_t _chunkCapacity;
+        
+        size_t _entityCount;
+        
+        // Byte offset of each component array inside a chunk, indexed by ComponentId
+        std::array< uint32_t, MAX_COMPONENT_TYPES > _componentOffsets;
+        
+        std::array< uint32_t, MAX_COMPONENT_TYPES > _componentSizes;
+        
+        // Chunks are kept once allocated, emptying one doesn't free it
+        std::vector< std::byte* > _chunks;
+    };
+
+    // Archetype storage for renderables. create() places an entity in the archetype of its
+    // component set; queries visit every archetype that has the requested components one
+    // chunk at a time, handing out the component arrays directly. The only allocations
+    // are chunks and archetypes, never one per entity.
+    class EntityWorld
+    {
+    public:
+        EntityWorld() = default;
+        
+        EntityWorld( const EntityWorld& ) = delete;
+        
+        EntityWorld& operator=( const EntityWorld& ) = delete;
+        
+        template < typename... Components >
+        Entity create( const Components&... components );
+        
+        void destroy( Entity entity );
+        
+        bool isAlive( Entity entity ) const;
+        
+        // Null if entity is dead or doesn't have T. Valid until the next create or destroy.
+        template < typename T >
+        T* get( Entity entity );
+        
+        size_t getEntityCount() const;
+        
+        size_t getArchetypeCount() const;
+        
+        // Entities having at least Components
+        template < typename... Components >
+        size_t count() const;
+        
+        // function( size_t count, Components*... ) per matching chunk, archetypes in creation
+        // order. Creating or destroying entities from inside invalidates the iteration.
+        template < typename... Components, typename Function >
+        void forEachChunk( Function&& function );
+        
+        // function( size_t count, size_t firstIndex, Components*... ) with the chunks spread
+        // across the pool. firstIndex numbers the matching entities in forEachChunk order, so
+        // chunks can write disjoint parts of one output array.
+        template < typename... Components, typename Function >
+        void forEachChunkParallel( WorkerPool& workerPool, Function&& function );
+
+    private:
+        struct EntityRecord
+        {
+            EntityArchetype* pArchetype = nullptr;
+            
+            size_t row = 0;
+            
+            uint32_t generation = 0;
+        };
+        
+        struct ChunkReference
+        {
+            EntityArchetype* pArchetype = nullptr;
+            
+            size_t chunkIndex = 0;
+            
+            size_t firstIndex = 0;
+        };
+        
+        std::vector< std::unique_ptr< EntityArchetype > > _archetypes;
+        
+        std::vector< EntityRecord > _records;
+        
+        std::vector< uint32_t > _freeIndices;
+        
+        size_t _entityCount = 0;
+        
+        EntityArchetype& getArchetype( ComponentMask mask );
+        
+        Entity allocateEntity( EntityArchetype& archetype );
+        
+        std::vector< ChunkReference > gatherChunks( ComponentMask mask ) const;
+        
+        template < typename... Components >
+        static ComponentMask makeMask();
+    };
+
+    template < typename... Components >
+    ComponentMask EntityWorld::makeMask()
+    {
+        return ( ComponentMask{ 0 } | ... | ( ComponentMask{ 1 } << getComponentId< Components >() ) );
+    }
+
+    template < typename... Components >
+    Entity EntityWorld::create( const Components&... components )
+    {
+        EntityArchetype& archetype = getArchetype( makeMask< Components... >() );
+        const Entity entity = allocateEntity( archetype );
+        
+        const EntityRecord& record = _records[ entity.index ];
+        const size_t chunkIndex = record.row / archetype.getChunkCapacity();
+        const size_t slot = record.row % archetype.getChunkCapacity();
+        ( std::memcpy( static_cast< Components* >( archetype.getComponents( chunkIndex, getComponentId< Components >() ) ) + slot, &components, sizeof( Components ) ), ... );
+        return entity;
+    }
+
+    template < typename T >
+    T* EntityWorld::get( Entity entity )
+    {
+        if ( !isAlive( entity ) )
+        {
+            return nullptr;
+        }
+        
+        const EntityRecord& record = _records[ entity.index ];
+        const size_t capacity = record.pArchetype->getChunkCapacity();
+        auto* pComponents = static_cast< T* >( record.pArchetype->getComponents( record.row / capacity, getComponentId< T >() ) );
+        return pComponents ? pComponents + record.row % capacity : nullptr;
+    }
+
+    template < typename... Components >
+    size_t EntityWorld::count() const
+    {
+        const ComponentMask mask = makeMask< Components... >();
+        size_t total = 0;
+        for ( const auto& pArchetype : _archetypes )
+        {
+            if ( ( pArchetype->getMask() & mask ) == mask )
+            {
+                total += pArchetype->getEntityCount();
+            }
+        }
+        return total;
+    }
+
+    template < typename... Components, typename Function >
+    void EntityWorld::forEachChunk( Function&& function )
+    {
+        const ComponentMask mask = makeMask< Components... >();
+        for ( const auto& pArchetype : _archetypes )
+        {
+            if ( ( pArchetype->getMask() & mask ) != mask )
+            {
+                continue;
+            }
+            
+            for ( size_t chunk = 0; chunk < pArchetype->getChunkCount(); ++chunk )
+            {
+                function( pArchetype->getChunkSize( chunk ), static_cast< Components* >( pArchetype->getComponents( chunk, getComponentId< Components >() ) )... );
+            }
+        }
+    }
+
+    template < typename... Components, typename Function >
+    void EntityWorld::forEachChunkParallel( WorkerPool& workerPool, Function&& function )
+    {
+        // makeMask registers the component types on this thread before the workers look them up
+        const std::vector< ChunkReference > chunks = gatherChunks( makeMask< Components... >() );
+        
+        workerPool.parallelFor( chunks.size(), 1, [ & ]( size_t begin, size_t end, uint32_t ){
+            for ( size_t i = begin; i < end; ++i )
+            {
+                const ChunkReference& chunk = chunks[ i ];
+                function( chunk.pArchetype->getChunkSize( chunk.chunkIndex ),
+                          chunk.firstIndex,
+                          static_cast< Components* >( chunk.pArchetype->getComponents( chunk.chunkIndex, getComponentId< Components >() ) )... );
+            }
+        });
+    }
+}
+
+#endif /* EntityWorld_hpp */
@@ -0,0 +1,212 @@
+//
+//  EntityWorldCheck.cpp
+//  Point_Cloud_Renderer
+//
+//  Created by Vatsalya Yadav on 10/19/26.
+//
+
+#include "EntityWorldCheck.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <vector>
+
+#include "Renderer/Scene/EntityWorld.hpp"
+#include "Renderer/Threading/WorkerPool.hpp"
+#include "Renderer/Validation/CheckReport.hpp"
+
+namespace PCR
+{
+    namespace
+    {
+        // Several chunks of either archetype
+        constexpr uint32_t POSITIONED_COUNT{ 5000 };
+        
+        constexpr uint32_t TAGGED_COUNT{ 3000 };
+        
+        constexpr uint32_t WORKER_COUNT{ 4 };
+        
+        // Every entity carries its creation order, so it can be found wherever it was moved
+        struct CheckId
+        {
+            uint32_t value;
+        };
+        
+        struct CheckPosition
+        {
+            float x;
+            
+            float y;
+            
+            float z;
+        };
+        
+        struct CreatedEntity
+        {
+            Entity entity;
+            
+            bool destroyed = false;
+        };
+        
+        // Alive entities resolve to their own components, destroyed ones to nothing
+        bool resolvesAll( EntityWorld& world, const std::vector< CreatedEntity >& created )
+        {
+            for ( uint32_t i = 0; i < created.size(); ++i )
+            {
+                const CheckId* pId = world.get< CheckId >( created[ i ].entity );
+                if ( created[ i ].destroyed ? ( pId || world.isAlive( created[ i ].entity ) ) : ( !pId || pId->value != i ) )
+                {
+                    return false;
+                }
+                
+                const CheckPosition* pPosition = world.get< CheckPosition >( created[ i ].entity );
+                if ( !created[ i ].destroyed && i < POSITIONED_COUNT && ( !pPosition || pPosition->x != static_cast< float >( i ) ) )
+                {
+                    return false;
+                }
+            }
+            return true;
+        }
+        
+        // Each alive entity visited once, and within each archetype every chunk is full up to
+        // the last one in use, so chunk sizes only grow again where the next archetype starts
+        bool visitsAllPacked( EntityWorld& world, const std::vector< CreatedEntity >& created )
+        {
+            std::vector< uint32_t > visits( created.size(), 0 );
+            size_t previousCount = 0;
+            size_t rises = 0;
+            world.forEachChunk< CheckId >( [ & ]( size_t count, const CheckId* pIds ){
+                rises += count > previousCount ? 1 : 0;
+                previousCount = count;
+                for ( size_t i = 0; i < count; ++i )
+                {
+                    ++visits[ pIds[ i ].value ];
+                }
+            });
+            
+            for ( uint32_t i = 0; i < created.size(); ++i )
+            {
+                if ( visits[ i ] != ( created[ i ].destroyed ? 0u : 1u ) )
+                {
+                    return false;
+                }
+            }
+            return rises <= world.getArchetypeCount();
+        }
+        
+        void checkCreateDestroy( CheckReport& report )
+        {
+            EntityWorld world;
+            std::vector< CreatedEntity > created;
+            for ( uint32_t i = 0; i < POSITIONED_COUNT + TAGGED_COUNT; ++i )
+            {
+                const Entity entity = i < POSITIONED_COUNT ? world.create( CheckId{ i }, CheckPosition{ static_cast< float >( i ), 0.0f, 0.0f } )
+                                                           : world.create( CheckId{ i } );
+                created.push_back( CreatedEntity{ entity } );
+            }
+            report.expect( world.getArchetypeCount() == 2 && world.count< CheckId >() == POSITIONED_COUNT + TAGGED_COUNT && world.count< CheckId, CheckPosition >() == POSITIONED_COUNT,
+                           "create: one archetype per component set, counted by query" );
+            report.expect( resolvesAll( world, created ), "create: every handle resolves to its own components" );
+            
+            // Every third entity, including ones in the middle of full chunks
+            for ( uint32_t i = 0; i < created.size(); i += 3 )
+            {
+                world.destroy( created[ i ].entity );
+                created[ i ].destroyed = true;
+            }
+            const size_t aliveCount = world.getEntityCount();
+            report.expect( resolvesAll( world, created ), "destroy: the entities moved into the holes still resolve" );
+            report.expect( visitsAllPacked( world, created ), "destroy: chunks stay packed and nothing is visited twice or lost" );
+            
+            world.destroy( created[ 0 ].entity );
+            report.expect( world.getEntityCount() == aliveCount, "destroy: destroying a dead handle does nothing" );
+            
+            // Reused indices get a new generation, the old handles stay dead
+            bool reusesIndices = true;
+            for ( uint32_t i = 0; i < created.size(); i += 3 )
+            {
+                const auto id = static_cast< uint32_t >( created.size() );
+                const Entity entity = world.create( CheckId{ id } );
+                reusesIndices = reusesIndices && entity.index < created.size() && world.isAlive( entity );
+                created.push_back( CreatedEntity{ entity } );
+            }
+            report.expect( reusesIndices, "generations: freed indices are reused" );
+            report.expect( resolvesAll( world, created ), "generations: stale handles to reused indices resolve to nothing" );
+            
+            for ( CreatedEntity& entity : created )
+            {
+                world.destroy( entity.entity );
+                entity.destroyed = true;
+            }
+            report.expect( world.getEntityCount() == 0 && world.count< CheckId >() == 0 && resolvesAll( world, created ), "destroy: emptying the world leaves nothing behind" );
+        }
+        
+        void checkParallelNumbering( CheckReport& report )
+        {
+            EntityWorld world;
+            std::vector< Entity > entities;
+            for ( uint32_t i = 0; i < POSITIONED_COUNT + TAGGED_COUNT; ++i )
+            {
+                entities.push_back( i % 2 == 0 ? world.create( CheckId{ i }, CheckPosition{ static_cast< float >( i ), 0.0f, 0.0f } )
+                                               : world.create( CheckId{ i } ) );
+            }
+            for ( size_t i = 0; i < entities.size(); i += 7 )
+            {
+                world.destroy( entities[ i ] );
+            }
+            
+            std::vector< uint32_t > serialOrder;
+            world.forEachChunk< CheckId >( [ & ]( size_t count, const CheckId* pIds ){
+                for ( size_t i = 0; i < count; ++i )
+                {
+                    serialOrder.push_back( pIds[ i ].value );
+                }
+            });
+            
+            // Disjoint writes into one array, as gatherInstances does
+            const uint32_t unwritten = UINT32_MAX;
+            std::vector< uint32_t > parallelOrder( world.count< CheckId >(), unwritten );
+            std::atomic< bool > inBounds{ true };
+            WorkerPool workerPool( WORKER_COUNT );
+            world.forEachChunkParallel< CheckId >( workerPool, [ & ]( size_t count, size_t firstIndex, const CheckId* pIds ){
+                if ( firstIndex + count > parallelOrder.size() )
+                {
+                    inBounds.store( false );
+                    return;
+                }
+                for ( size_t i = 0; i < count; ++i )
+                {
+                    parallelOrder[ firstIndex + i ] = pIds[ i ].value;
+                }
+            });
+            
+            report.expect( inBounds.load() && serialOrder.size() == parallelOrder.size(), "parallel: firstIndex stays inside the matching entity count" );
+            report.expect( serialOrder == parallelOrder, "parallel: firstIndex numbers the entities in forEachChunk order" );
+            
+            // A query on a component only one archetype has numbers only that archetype's entities
+            std::vector< uint32_t > numbered( world.count< CheckId, CheckPosition >(), 0 );
+            std::atomic< bool > positionedInBounds{ true };
+            world.forEachChunkParallel< CheckId, CheckPosition >( workerPool, [ & ]( size_t count, size_t firstIndex, const CheckId*, const CheckPosition* ){
+                if ( firstIndex + count > numbered.size() )
+                {
+                    positionedInBounds.store( false );
+                    return;
+                }
+                for ( size_t i = 0; i < count; ++i )
+                {
+                    ++numbered[ firstIndex + i ];
+                }
+            });
+            report.expect( positionedInBounds.load() && std::all_of( numbered.begin(), numbered.end(), []( uint32_t n ){ return n == 1; } ),
+                           "parallel: a narrower query numbers only its own entities, each once" );
+        }
+    }
+
+    bool runEntityWorldChecks()
+    {
+        CheckReport report( "Entity world, two archetypes" );
+        checkCreateDestroy( report );
+        checkParallelNumbering( report );
+        return report.finish();
+    }
+}
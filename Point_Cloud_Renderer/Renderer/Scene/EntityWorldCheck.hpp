@@ -0,0 +1,21 @@
+//
+//  EntityWorldCheck.hpp
+//  Point_Cloud_Renderer
+//
+//  Created by Vatsalya Yadav on 10/19/26.
+//
+
+#ifndef EntityWorldCheck_hpp
+#define EntityWorldCheck_hpp
+
+namespace PCR
+{
+    // EntityWorld over two archetypes spanning several chunks: destroying entities moves
+    // the last one into the hole without losing any, stale handles stop resolving once
+    // their index is reused, chunks stay packed, and forEachChunkParallel's firstIndex
+    // numbers the entities exactly as forEachChunk visits them.
+    // Returns false if any check fails.
+    bool runEntityWorldChecks();
+}
+
+#endif /* EntityWorldCheck_hpp */
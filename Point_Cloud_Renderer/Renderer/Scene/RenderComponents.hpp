@@ -0,0 +1,47 @@
+//
+//  RenderComponents.hpp
+//  Point_Cloud_Renderer
+//
+//  Created by Vatsalya Yadav on 10/19/26.
+//
+
+#ifndef RenderComponents_hpp
+#define RenderComponents_hpp
+
+#include <cstdint>
+
+#include <simd/simd.h>
+
+namespace PCR
+{
+    // Rigid transform with uniform scale, relative to the gather's parent. 32 bytes,
+    // the same information CompactInstanceData carries.
+    struct InstanceTransformComponent
+    {
+        // Unit quaternion, w last
+        simd::float4 rotation;
+        
+        float translation[ 3 ];
+        
+        float scale;
+    };
+
+    struct InstanceColorComponent
+    {
+        simd::float4 color;
+    };
+
+    // Turns the instance about its own Z, radiansPerAngle * angle
+    struct InstanceSpinComponent
+    {
+        float radiansPerAngle;
+    };
+
+    // Which instanced mesh draws the entity, only the cube so far
+    struct InstancedMeshComponent
+    {
+        uint32_t meshIndex;
+    };
+}
+
+#endif /* RenderComponents_hpp */
@@ -0,0 +1,132 @@
+//
+//  RenderSystems.cpp
+//  Point_Cloud_Renderer
+//
+//  Created by Vatsalya Yadav on 10/19/26.
+//
+
+#include "RenderSystems.hpp"
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+
+#include "Math/SinCos.hpp"
+#include "Renderer/Instances/CompactInstance.hpp"
+#include "Renderer/Threading/WorkerPool.hpp"
+
+namespace PCR
+{
+    namespace
+    {
+        // Scratch on the stack, a few KB
+        constexpr size_t SPIN_BLOCK_SIZE{ 256 };
+        
+        simd::float3x3 rotationFromQuaternion( const simd::float4& q )
+        {
+            const float x2 = q.x * 2.0f;
+            const float y2 = q.y * 2.0f;
+            const float z2 = q.z * 2.0f;
+            
+            const float xx = q.x * x2;
+            const float yy = q.y * y2;
+            const float zz = q.z * z2;
+            const float xy = q.x * y2;
+            const float xz = q.x * z2;
+            const float yz = q.y * z2;
+            const float wx = q.w * x2;
+            const float wy = q.w * y2;
+            const float wz = q.w * z2;
+            
+            return simd_matrix( simd::float3{ 1.0f - ( yy + zz ), xy + wz, xz - wy },
+                                simd::float3{ xy - wz, 1.0f - ( xx + zz ), yz + wx },
+                                simd::float3{ xz + wy, yz - wx, 1.0f - ( xx + yy ) } );
+        }
+        
+        simd::float4 multiplyQuaternions( const simd::float4& a, const simd::float4& b )
+        {
+            return simd::float4{ a.w * b.x + a.x * b.w + a.y * b.z - a.z * b.y,
+                                 a.w * b.y + a.y * b.w + a.z * b.x - a.x * b.z,
+                                 a.w * b.z + a.z * b.w + a.x * b.y - a.y * b.x,
+                                 a.w * b.w - a.x * b.x - a.y * b.y - a.z * b.z };
+        }
+        
+        // Only the chunks below capacity, and only their part below it
+        template < typename Function >
+        size_t gatherChunks( EntityWorld& world, WorkerPool& workerPool, size_t capacity, Function&& function )
+        {
+            const size_t count = std::min( capacity, world.count< InstanceTransformComponent, InstanceColorComponent, InstancedMeshComponent >() );
+            const auto writeChunk = [ & ]( size_t chunkCount, size_t firstIndex, const InstanceTransformComponent* pTransforms, const InstanceColorComponent* pColors, const InstancedMeshComponent* ){
+                for ( size_t i = 0; i < chunkCount && firstIndex + i < count; ++i )
+                {
+                    function( firstIndex + i, pTransforms[ i ], pColors[ i ] );
+                }
+            };
+            world.forEachChunkParallel< InstanceTransformComponent, InstanceColorComponent, InstancedMeshComponent >( workerPool, writeChunk );
+            return count;
+        }
+    }
+
+    void spinInstances( EntityWorld& world, WorkerPool& workerPool, float angle )
+    {
+        world.forEachChunkParallel< InstanceTransformComponent, InstanceSpinComponent >( workerPool, [ & ]( size_t count, size_t, InstanceTransformComponent* pTransforms, const InstanceSpinComponent* pSpins ){
+            // The spins and rotations are interleaved with other fields, so they go through
+            // small contiguous blocks for the batched sincos
+            std::array< float, SPIN_BLOCK_SIZE > spins;
+            std::array< float, SPIN_BLOCK_SIZE > sines;
+            std::array< float, SPIN_BLOCK_SIZE > cosines;
+            for ( size_t blockBegin = 0; blockBegin < count; blockBegin += SPIN_BLOCK_SIZE )
+            {
+                const size_t blockCount = std::min( SPIN_BLOCK_SIZE, count - blockBegin );
+                for ( size_t i = 0; i < blockCount; ++i )
+                {
+                    spins[ i ] = pSpins[ blockBegin + i ].radiansPerAngle;
+                }
+                
+                Math::sinCos( spins.data(), sines.data(), cosines.data(), blockCount, -0.5f * angle );
+                for ( size_t i = 0; i < blockCount; ++i )
+                {
+                    pTransforms[ blockBegin + i ].rotation = simd::float4{ 0.0f, 0.0f, sines[ i ], cosines[ i ] };
+                }
+            }
+        });
+    }
+
+    size_t gatherInstances( EntityWorld& world, WorkerPool& workerPool, const simd::float4x4& parent, InstanceData* pOut, size_t capacity )
+    {
+        return gatherChunks( world, workerPool, capacity, [ & ]( size_t index, const InstanceTransformComponent& transform, const InstanceColorComponent& color ){
+            const simd::float3x3 rotation = rotationFromQuaternion( transform.rotation );
+            const simd::float4 translation{ transform.translation[ 0 ], transform.translation[ 1 ], transform.translation[ 2 ], 1.0f };
+            
+            InstanceData& out = pOut[ index ];
+            for ( int c = 0; c < 3; ++c )
+            {
+                const simd::float3 column = rotation.columns[ c ] * transform.scale;
+                out.transform.columns[ c ] = parent * simd::float4{ column.x, column.y, column.z, 0.0f };
+                out.normalTransform.columns[ c ] = out.transform.columns[ c ].xyz;
+            }
+            out.transform.columns[ 3 ] = parent * translation;
+            out.color = color.color;
+        });
+    }
+
+    size_t gatherInstances( EntityWorld& world, WorkerPool& workerPool, const simd::float4x4& parent, CompactInstanceData* pOut, size_t capacity )
+    {
+        const CompactInstance::ParentDecomposition parentDecomposition = CompactInstance::decomposeParent( parent );
+        
+        return gatherChunks( world, workerPool, capacity, [ & ]( size_t index, const InstanceTransformComponent& transform, const InstanceColorComponent& color ){
+            const simd::float4 rotation = multiplyQuaternions( parentDecomposition.rotation, transform.rotation );
+            const simd::float4 translation = parent * simd::float4{ transform.translation[ 0 ], transform.translation[ 1 ], transform.translation[ 2 ], 1.0f };
+            
+            CompactInstanceData& out = pOut[ index ];
+            out.translation[ 0 ] = translation.x;
+            out.translation[ 1 ] = translation.y;
+            out.translation[ 2 ] = translation.z;
+            out.scale = parentDecomposition.scale * transform.scale;
+            out.rotation[ 0 ] = CompactInstance::packSnorm16x2( rotation.x, rotation.y );
+            out.rotation[ 1 ] = CompactInstance::packSnorm16x2( rotation.z, rotation.w );
+            out.color = CompactInstance::packUnorm4x8( color.color );
+            out.padding = 0;
+        });
+    }
+}
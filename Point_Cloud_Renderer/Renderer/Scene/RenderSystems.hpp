@@ -0,0 +1,37 @@
+//
+//  RenderSystems.hpp
+//  Point_Cloud_Renderer
+//
+//  Created by Vatsalya Yadav on 10/19/26.
+//
+
+#ifndef RenderSystems_hpp
+#define RenderSystems_hpp
+
+#include <cstddef>
+
+#include <simd/simd.h>
+
+#include "Renderer/Scene/EntityWorld.hpp"
+#include "Renderer/Scene/RenderComponents.hpp"
+#include "Renderer/Structures/CompactInstanceData.hpp"
+#include "Renderer/Structures/InstanceData.hpp"
+
+namespace PCR
+{
+    class WorkerPool;
+
+    // Sets the rotation of every spinning instance to angle * radiansPerAngle about Z,
+    // clockwise like makeZRotate
+    void spinInstances( EntityWorld& world, WorkerPool& workerPool, float angle );
+
+    // Writes every entity with a transform, a color and an instanced mesh straight into
+    // pOut, e.g. a mapped instance buffer, one chunk per job. Entities beyond capacity
+    // are dropped. Returns how many were written, in forEachChunk order.
+    size_t gatherInstances( EntityWorld& world, WorkerPool& workerPool, const simd::float4x4& parent, InstanceData* pOut, size_t capacity );
+
+    // Same in the 32-byte format, parent has to be rigid with uniform scale
+    size_t gatherInstances( EntityWorld& world, WorkerPool& workerPool, const simd::float4x4& parent, CompactInstanceData* pOut, size_t capacity );
+}
+
+#endif /* RenderSystems_hpp */
@@ -0,0 +1,188 @@
+//
+//  TransformBenchmark.cpp
+//  Point_Cloud_Renderer
+//
+//  Created by Vatsalya Yadav on 10/19/26.
+//
+
+#include "TransformBenchmark.hpp"
+
+#include <algorithm>
+#include <chrono>
+#include <cstring>
+#include <functional>
+
+#include <simd/simd.h>
+
+#include "Math/Utility.hpp"
+#include "Renderer/Scene/TransformHierarchy.hpp"
+
+namespace PCR
+{
+    namespace
+    {
+        constexpr size_t NODES_PER_SIZE{ 4 * 1024 * 1024 };
+        
+        constexpr size_t TREE_BRANCHING{ 4 };
+        
+        template < typename Function >
+        double measureNsPerUpdate( size_t nodeCount, Function&& function )
+        {
+            const size_t iterations = std::max< size_t >( 1, NODES_PER_SIZE / nodeCount );
+            
+            function( 0.0f );
+            
+            const auto start = std::chrono::steady_clock::now();
+            for ( size_t iteration = 0; iteration < iterations; ++iteration )
+            {
+                function( 0.01f * static_cast< float >( iteration + 1 ) );
+            }
+            const double elapsedNs = std::chrono::duration< double, std::nano >( std::chrono::steady_clock::now() - start ).count();
+            return elapsedNs / static_cast< double >( iterations );
+        }
+        
+        simd::float4x4 makeLocal( float angle )
+        {
+            return Math::makeTranslate( { 0.4f, 0.0f, 0.0f } ) * Math::makeYRotate( angle );
+        }
+        
+        void buildHierarchy( TransformHierarchy& hierarchy, TransformBenchmarkShape shape, size_t nodeCount )
+        {
+            hierarchy.clear();
+            hierarchy.reserve( nodeCount );
+            
+            if ( shape == TransformBenchmarkShape::Tree )
+            {
+                // Shape of a heap with TREE_BRANCHING children per node, emitted depth first
+                const std::function< void( size_t, TransformNode ) > emit = [ & ]( size_t heapIndex, TransformNode parent ){
+                    const TransformNode node = hierarchy.addNode( parent, makeLocal( 0.1f ) );
+                    for ( size_t child = heapIndex * TREE_BRANCHING + 1; child <= heapIndex * TREE_BRANCHING + TREE_BRANCHING && child < nodeCount; ++child )
+                    {
+                        emit( child, node );
+                    }
+                };
+                emit( 0, INVALID_TRANSFORM_NODE );
+                return;
+            }
+            
+            hierarchy.addNode( INVALID_TRANSFORM_NODE, makeLocal( 0.1f ) );
+            for ( size_t i = 1; i < nodeCount; ++i )
+            {
+                const TransformNode parent = shape == TransformBenchmarkShape::Deep ? static_cast< TransformNode >( i - 1 ) : 0;
+                hierarchy.addNode( parent, makeLocal( 0.1f ) );
+            }
+        }
+        
+        // Recomputes reference from hierarchy's locals with updateAll and compares the results
+        bool matchesFullUpdate( const TransformHierarchy& hierarchy, TransformHierarchy& reference )
+        {
+            for ( size_t i = 0; i < hierarchy.getCount(); ++i )
+            {
+                reference.setLocal( static_cast< TransformNode >( i ), hierarchy.getLocal( static_cast< TransformNode >( i ) ) );
+            }
+            reference.updateAll();
+            reference.takeChangedRanges();
+            return std::memcmp( hierarchy.getWorldMatrices(), reference.getWorldMatrices(), hierarchy.getCount() * sizeof( simd::float4x4 ) ) == 0;
+        }
+        
+        const char* getShapeName( TransformBenchmarkShape shape )
+        {
+            switch ( shape )
+            {
+                case TransformBenchmarkShape::Deep: return "deep";
+                case TransformBenchmarkShape::Wide: return "wide";
+                case TransformBenchmarkShape::Tree: return "tree";
+            }
+            return "";
+        }
+    }
+
+    std::vector< TransformBenchmarkResult > runTransformBenchmark( const std::vector< size_t >& nodeCounts )
+    {
+        std::vector< TransformBenchmarkResult > results;
+        
+        TransformHierarchy hierarchy;
+        TransformHierarchy reference;
+        
+        for ( TransformBenchmarkShape shape : { TransformBenchmarkShape::Deep, TransformBenchmarkShape::Wide, TransformBenchmarkShape::Tree } )
+        {
+            for ( size_t nodeCount : nodeCounts )
+            {
+                buildHierarchy( hierarchy, shape, nodeCount );
+                buildHierarchy( reference, shape, nodeCount );
+                hierarchy.update();
+                
+                const auto middle = static_cast< TransformNode >( nodeCount / 2 );
+                const auto last = static_cast< TransformNode >( nodeCount - 1 );
+                
+                TransformBenchmarkResult result;
+                result.shape = shape;
+                result.nodeCount = nodeCount;
+                
+                result.fullNs = measureNsPerUpdate( nodeCount, [ & ]( float angle ){
+                    hierarchy.setLocal( 0, makeLocal( angle ) );
+                    hierarchy.updateAll();
+                    hierarchy.takeChangedRanges();
+                });
+                
+                result.rootMovedNs = measureNsPerUpdate( nodeCount, [ & ]( float angle ){
+                    hierarchy.setLocal( 0, makeLocal( angle ) );
+                    hierarchy.update();
+                    hierarchy.takeChangedRanges();
+                });
+                
+                result.middleMovedNs = measureNsPerUpdate( nodeCount, [ & ]( float angle ){
+                    hierarchy.setLocal( middle, makeLocal( angle ) );
+                    result.middleRecomputed = hierarchy.update();
+                    hierarchy.takeChangedRanges();
+                });
+                
+                result.leafMovedNs = measureNsPerUpdate( nodeCount, [ & ]( float angle ){
+                    hierarchy.setLocal( last, makeLocal( angle ) );
+                    hierarchy.update();
+                    hierarchy.takeChangedRanges();
+                });
+                
+                result.staticNs = measureNsPerUpdate( nodeCount, [ & ]( float ){
+                    hierarchy.update();
+                });
+                
+                // One more move of each kind outside the timing, each checked on its own
+                for ( TransformNode moved : { TransformNode( 0 ), middle, last } )
+                {
+                    hierarchy.setLocal( moved, makeLocal( 0.37f + static_cast< float >( moved ) ) );
+                    hierarchy.update();
+                    hierarchy.takeChangedRanges();
+                    result.matchesFullUpdate = result.matchesFullUpdate && matchesFullUpdate( hierarchy, reference );
+                }
+                
+                results.push_back( result );
+            }
+        }
+        
+        return results;
+    }
+
+    bool printTransformBenchmark( const std::vector< TransformBenchmarkResult >& results )
+    {
+        bool passed = true;
+        
+        __builtin_printf( "Transform hierarchy, ns per update, world matrices against updateAll\n" );
+        __builtin_printf( "%6s %10s %12s %12s %12s %12s %12s %10s %8s\n", "shape", "nodes", "full", "rootMoved", "middleMoved", "recomputed", "leafMoved", "static", "matches" );
+        for ( const TransformBenchmarkResult& result : results )
+        {
+            passed = passed && result.matchesFullUpdate;
+            __builtin_printf( "%6s %10zu %12.0f %12.0f %12.0f %12zu %12.0f %10.0f %8s\n",
+                              getShapeName( result.shape ),
+                              result.nodeCount,
+                              result.fullNs,
+                              result.rootMovedNs,
+                              result.middleMovedNs,
+                              result.middleRecomputed,
+                              result.leafMovedNs,
+                              result.staticNs,
+                              result.matchesFullUpdate ? "ok" : "FAIL" );
+        }
+        return passed;
+    }
+}
@@ -0,0 +1,63 @@
+//
+//  TransformBenchmark.hpp
+//  Point_Cloud_Renderer
+//
+//  Created by Vatsalya Yadav on 10/19/26.
+//
+
+#ifndef TransformBenchmark_hpp
+#define TransformBenchmark_hpp
+
+#include <cstddef>
+#include <vector>
+
+namespace PCR
+{
+    enum class TransformBenchmarkShape
+    {
+        // One chain, every node the child of the one before
+        Deep,
+        
+        // One root, every other node its child
+        Wide,
+        
+        // Four children per node, depth first
+        Tree
+    };
+
+    // Nanoseconds per update of the whole hierarchy
+    struct TransformBenchmarkResult
+    {
+        TransformBenchmarkShape shape = TransformBenchmarkShape::Deep;
+        
+        size_t nodeCount = 0;
+        
+        // Every world matrix recomputed, what flattening the chain by hand amounts to
+        double fullNs = 0.0;
+        
+        // The root moved, so is everything else
+        double rootMovedNs = 0.0;
+        
+        // A node halfway through the array moved
+        double middleMovedNs = 0.0;
+        
+        size_t middleRecomputed = 0;
+        
+        // Only the last node moved
+        double leafMovedNs = 0.0;
+        
+        // Nothing moved
+        double staticNs = 0.0;
+        
+        // After a root, middle and leaf move, every world matrix update() left was bit for bit
+        // what updateAll() computes from the same locals
+        bool matchesFullUpdate = true;
+    };
+
+    std::vector< TransformBenchmarkResult > runTransformBenchmark( const std::vector< size_t >& nodeCounts );
+
+    // Returns false if an incremental update differed from the full recompute
+    bool printTransformBenchmark( const std::vector< TransformBenchmarkResult >& results );
+}
+
+#endif /* TransformBenchmark_hpp */
@@ -0,0 +1,142 @@
+//
+//  TransformHierarchy.cpp
+//  Point_Cloud_Renderer
+//
+//  Created by Vatsalya Yadav on 10/19/26.
+//
+
+#include "TransformHierarchy.hpp"
+
+#include <algorithm>
+#include <cassert>
+
+namespace PCR
+{
+    TransformNode TransformHierarchy::addNode( TransformNode parent, const simd::float4x4& local )
+    {
+        assert( parent == INVALID_TRANSFORM_NODE || parent < _parents.size() );
+        
+        const auto node = static_cast< TransformNode >( _parents.size() );
+        _parents.push_back( parent );
+        _locals.push_back( local );
+        _worlds.push_back( local );
+        _dirty.push_back( 1 );
+        _firstDirty = std::min< size_t >( _firstDirty, node );
+        return node;
+    }
+
+    void TransformHierarchy::reserve( size_t count )
+    {
+        _parents.reserve( count );
+        _locals.reserve( count );
+        _worlds.reserve( count );
+        _dirty.reserve( count );
+    }
+
+    void TransformHierarchy::clear()
+    {
+        _parents.clear();
+        _locals.clear();
+        _worlds.clear();
+        _dirty.clear();
+        _firstDirty = 0;
+        _changedRanges.clear();
+    }
+
+    size_t TransformHierarchy::getCount() const
+    {
+        return _parents.size();
+    }
+
+    TransformNode TransformHierarchy::getParent( TransformNode node ) const
+    {
+        return _parents[ node ];
+    }
+
+    void TransformHierarchy::setLocal( TransformNode node, const simd::float4x4& local )
+    {
+        _locals[ node ] = local;
+        _dirty[ node ] = 1;
+        _firstDirty = std::min< size_t >( _firstDirty, node );
+    }
+
+    const simd::float4x4& TransformHierarchy::getLocal( TransformNode node ) const
+    {
+        return _locals[ node ];
+    }
+
+    const simd::float4x4& TransformHierarchy::getWorld( TransformNode node ) const
+    {
+        return _worlds[ node ];
+    }
+
+    const simd::float4x4* TransformHierarchy::getWorldMatrices() const
+    {
+        return _worlds.data();
+    }
+
+    size_t TransformHierarchy::update()
+    {
+        const size_t count = _parents.size();
+        const TransformNode* pParents = _parents.data();
+        const simd::float4x4* pLocals = _locals.data();
+        simd::float4x4* pWorlds = _worlds.data();
+        uint8_t* pDirty = _dirty.data();
+        
+        size_t recomputed = 0;
+        size_t runBegin = count;
+        for ( size_t i = _firstDirty; i < count; ++i )
+        {
+            // The parent comes first, so its flag already includes its own ancestors'
+            const TransformNode parent = pParents[ i ];
+            if ( parent != INVALID_TRANSFORM_NODE )
+            {
+                pDirty[ i ] |= pDirty[ parent ];
+            }
+            
+            if ( !pDirty[ i ] )
+            {
+                if ( runBegin < i )
+                {
+                    appendRange( _changedRanges, runBegin, i );
+                    runBegin = count;
+                }
+                continue;
+            }
+            
+            pWorlds[ i ] = parent == INVALID_TRANSFORM_NODE ? pLocals[ i ] : pWorlds[ parent ] * pLocals[ i ];
+            runBegin = std::min( runBegin, i );
+            ++recomputed;
+        }
+        appendRange( _changedRanges, runBegin, count );
+        
+        // Flags are only read through ancestors at or after _firstDirty, so clearing from there is enough
+        if ( _firstDirty < count )
+        {
+            std::fill( _dirty.begin() + static_cast< std::ptrdiff_t >( _firstDirty ), _dirty.end(), 0 );
+        }
+        _firstDirty = count;
+        return recomputed;
+    }
+
+    void TransformHierarchy::updateAll()
+    {
+        for ( size_t i = 0; i < _parents.size(); ++i )
+        {
+            const TransformNode parent = _parents[ i ];
+            _worlds[ i ] = parent == INVALID_TRANSFORM_NODE ? _locals[ i ] : _worlds[ parent ] * _locals[ i ];
+        }
+        
+        std::fill( _dirty.begin(), _dirty.end(), 0 );
+        _firstDirty = _parents.size();
+        _changedRanges.clear();
+        appendRange( _changedRanges, 0, _parents.size() );
+    }
+
+    std::vector< DirtyRange > TransformHierarchy::takeChangedRanges()
+    {
+        std::vector< DirtyRange > ranges;
+        ranges.swap( _changedRanges );
+        return ranges;
+    }
+}
@@ -0,0 +1,79 @@
+//
+//  TransformHierarchy.hpp
+//  Point_Cloud_Renderer
+//
+//  Created by Vatsalya Yadav on 10/19/26.
+//
+
+#ifndef TransformHierarchy_hpp
+#define TransformHierarchy_hpp
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+#include <simd/simd.h>
+
+#include "Renderer/Buffer/DirtyRangeTracker.hpp"
+
+namespace PCR
+{
+    using TransformNode = uint32_t;
+
+    constexpr TransformNode INVALID_TRANSFORM_NODE{ UINT32_MAX };
+
+    // Scene graph transforms in flat arrays, every node stored after its parent. Local and
+    // world matrices are cached; update() walks the arrays once from the first changed
+    // node, a node is recomputed when its own local matrix or any ancestor's changed, so
+    // moving one node only redoes its subtree. Nodes added depth first keep each subtree
+    // contiguous, which keeps the changed world matrices in few ranges.
+    class TransformHierarchy
+    {
+    public:
+        // The parent has to exist already, INVALID_TRANSFORM_NODE for a root
+        TransformNode addNode( TransformNode parent, const simd::float4x4& local );
+        
+        void reserve( size_t count );
+        
+        void clear();
+        
+        size_t getCount() const;
+        
+        TransformNode getParent( TransformNode node ) const;
+        
+        void setLocal( TransformNode node, const simd::float4x4& local );
+        
+        const simd::float4x4& getLocal( TransformNode node ) const;
+        
+        // As of the last update()
+        const simd::float4x4& getWorld( TransformNode node ) const;
+        
+        const simd::float4x4* getWorldMatrices() const;
+        
+        // Returns how many world matrices were recomputed
+        size_t update();
+        
+        // Every world matrix from scratch, the reference update() has to match
+        void updateAll();
+        
+        // Nodes whose world matrix update() or updateAll() recomputed since the last call, coalesced
+        std::vector< DirtyRange > takeChangedRanges();
+
+    private:
+        std::vector< TransformNode > _parents;
+        
+        std::vector< simd::float4x4 > _locals;
+        
+        std::vector< simd::float4x4 > _worlds;
+        
+        // Bytes rather than bits so the propagation is a plain load and or
+        std::vector< uint8_t > _dirty;
+        
+        // Nothing before this is dirty
+        size_t _firstDirty = 0;
+        
+        std::vector< DirtyRange > _changedRanges;
+    };
+}
+
+#endif /* TransformHierarchy_hpp */
@@ -0,0 +1,34 @@
+//
+//  CompactInstanceData.hpp
+//  Point_Cloud_Renderer
+//
+//  Created by Vatsalya Yadav on 10/19/26.
+//
+
+#ifndef CompactInstanceData_hpp
+#define CompactInstanceData_hpp
+
+namespace PCR
+{
+    // A quarter of InstanceData. Rigid transform with uniform scale, the shaders
+    // rebuild the matrices from it, see CompactInstance for the packing.
+    struct CompactInstanceData
+    {
+        // World space, packed_float3 in the shaders
+        float translation[ 3 ];
+        
+        float scale;
+        
+        // Unit quaternion as snorm16, x | y << 16 and z | w << 16
+        uint32_t rotation[ 2 ];
+        
+        // RGBA8 unorm, red in the low byte
+        uint32_t color;
+        
+        uint32_t padding;
+    };
+
+    static_assert( sizeof( CompactInstanceData ) == 32 );
+}
+
+#endif /* CompactInstanceData_hpp */
@@ -0,0 +1,39 @@
+//
+//  CullUniforms.hpp
+//  Point_Cloud_Renderer
+//
+//  Created by Vatsalya Yadav on 10/19/26.
+//
+
+#ifndef CullUniforms_hpp
+#define CullUniforms_hpp
+
+namespace PCR
+{
+    struct CullUniforms
+    {
+        // Normalised, inside is positive: left, right, bottom, top, near, far
+        simd::float4 frustumPlanes[ 6 ];
+        
+        // World space, w unused
+        simd::float4 cameraPosition;
+        
+        // Squared distances, in units of the instance's scale, past which the reduced mesh
+        // and then the impostor are used
+        float lodDistancesSq[ 2 ];
+        
+        // Squared bounding sphere radius of the mesh before the instance transform
+        float boundingRadiusSq;
+        
+        uint32_t instanceCount;
+        
+        // Indices per LOD list, list l starts at l * lodListCapacity
+        uint32_t lodListCapacity;
+        
+        // LODs the selection picks from, finest first. 1 sends every visible instance to the
+        // Full list without reading lodDistancesSq.
+        uint32_t lodCount;
+    };
+}
+
+#endif /* CullUniforms_hpp */
@@ -0,0 +1,34 @@
+//
+//  InstanceAnimationUniforms.hpp
+//  Point_Cloud_Renderer
+//
+//  Created by Vatsalya Yadav on 10/19/26.
+//
+
+#ifndef InstanceAnimationUniforms_hpp
+#define InstanceAnimationUniforms_hpp
+
+namespace PCR
+{
+    struct InstanceAnimationUniforms
+    {
+        // The grid is centred here and turns about the Y axis through it, w unused
+        simd::float4 origin;
+        
+        // The only value that changes from frame to frame
+        float angle;
+        
+        // Uniform instance scale, neighbours are twice this apart
+        float scale;
+        
+        uint32_t rows;
+        
+        uint32_t columns;
+        
+        uint32_t depth;
+        
+        uint32_t instanceCount;
+    };
+}
+
+#endif /* InstanceAnimationUniforms_hpp */
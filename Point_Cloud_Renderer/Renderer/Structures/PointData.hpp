@@ -0,0 +1,22 @@
+//
+//  PointData.h
+//  Point_Cloud_Renderer
+//
+//  Created by Vatsalya Yadav on 10/19/26.
+//
+
+#ifndef PointData_hpp
+#define PointData_hpp
+
+namespace PCR
+{
+    struct PointData
+    {
+        simd::float3 position;
+        
+        // RGBA8, red in the lowest byte
+        uint32_t color;
+    };
+}
+
+#endif /* PointData_hpp */
@@ -0,0 +1,29 @@
+//
+//  PointRasterUniforms.h
+//  Point_Cloud_Renderer
+//
+//  Created by Vatsalya Yadav on 10/19/26.
+//
+
+#ifndef PointRasterUniforms_hpp
+#define PointRasterUniforms_hpp
+
+namespace PCR
+{
+    struct PointRasterUniforms
+    {
+        simd::float4x4 viewProjection;
+        
+        uint32_t width;
+        
+        uint32_t height;
+        
+        uint32_t tilesX;
+        
+        uint32_t tileCount;
+        
+        uint32_t pointCount;
+    };
+}
+
+#endif /* PointRasterUniforms_hpp */
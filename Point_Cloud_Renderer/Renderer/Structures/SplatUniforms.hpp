@@ -0,0 +1,31 @@
+//
+//  SplatUniforms.h
+//  Point_Cloud_Renderer
+//
+//  Created by Vatsalya Yadav on 10/19/26.
+//
+
+#ifndef SplatUniforms_hpp
+#define SplatUniforms_hpp
+
+namespace PCR
+{
+    struct SplatUniforms
+    {
+        simd::float4x4 viewProjection;
+        
+        uint32_t width;
+        
+        uint32_t height;
+        
+        // Splat radius in pixels
+        int32_t radius;
+        
+        // View-space distance behind the front surface that still gets blended
+        float depthEpsilon;
+        
+        uint32_t pointCount;
+    };
+}
+
+#endif /* SplatUniforms_hpp */
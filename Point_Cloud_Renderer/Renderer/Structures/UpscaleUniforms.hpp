@@ -0,0 +1,21 @@
+//
+//  UpscaleUniforms.h
+//  Point_Cloud_Renderer
+//
+//  Created by Vatsalya Yadav on 10/19/26.
+//
+
+#ifndef UpscaleUniforms_hpp
+#define UpscaleUniforms_hpp
+
+namespace PCR
+{
+    struct UpscaleUniforms
+    {
+        simd::float2 uvScale;
+        
+        simd::float2 uvMax;
+    };
+}
+
+#endif /* UpscaleUniforms_hpp */
@@ -0,0 +1,19 @@
+//
+//  VisibilityResolveUniforms.h
+//  Point_Cloud_Renderer
+//
+//  Created by Vatsalya Yadav on 10/19/26.
+//
+
+#ifndef VisibilityResolveUniforms_hpp
+#define VisibilityResolveUniforms_hpp
+
+namespace PCR
+{
+    struct VisibilityResolveUniforms
+    {
+        simd::float2 renderSize;
+    };
+}
+
+#endif /* VisibilityResolveUniforms_hpp */
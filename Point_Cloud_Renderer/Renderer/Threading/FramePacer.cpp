@@ -0,0 +1,77 @@
+//
+//  FramePacer.cpp
+//  Point_Cloud_Renderer
+//
+//  Created by Vatsalya Yadav on 10/19/26.
+//
+
+#include "FramePacer.hpp"
+
+#include <algorithm>
+
+namespace PCR
+{
+    namespace
+    {
+        constexpr double WAIT_SMOOTHING{ 0.1 };
+    }
+
+    FramePacer::FramePacer( uint32_t framesInFlight /* = MAX_FRAMES_IN_FLIGHT */, uint32_t maxFramesInFlight /* = MAX_FRAMES_IN_FLIGHT */ )
+    :   _fence{ 0 }
+    ,   _maxFramesInFlight{ std::max( maxFramesInFlight, 1u ) }
+    ,   _framesInFlight{ 1 }
+    ,   _frameIndex{ 0 }
+    {
+        setFramesInFlight( framesInFlight );
+    }
+
+    uint64_t FramePacer::beginFrame()
+    {
+        const uint64_t frameIndex = ++_frameIndex;
+        const uint32_t framesInFlight = _framesInFlight.load( std::memory_order_relaxed );
+        
+        // Frame N reuses what frame N - framesInFlight was using
+        const double waitMs = frameIndex > framesInFlight ? _fence.wait( frameIndex - framesInFlight ) : 0.0;
+        
+        _stats.framesInFlight = framesInFlight;
+        _stats.lastWaitMs = waitMs;
+        _stats.averageWaitMs += ( waitMs - _stats.averageWaitMs ) * WAIT_SMOOTHING;
+        _stats.framesAhead = frameIndex - 1 - _fence.getCompletedValue();
+        return frameIndex;
+    }
+
+    void FramePacer::frameCompleted( uint64_t frameIndex )
+    {
+        _fence.signal( frameIndex );
+    }
+
+    void FramePacer::waitForIdle()
+    {
+        _fence.wait( _frameIndex );
+    }
+
+    void FramePacer::setFramesInFlight( uint32_t framesInFlight )
+    {
+        _framesInFlight.store( std::clamp( framesInFlight, 1u, _maxFramesInFlight ), std::memory_order_relaxed );
+    }
+
+    uint32_t FramePacer::getFramesInFlight() const
+    {
+        return _framesInFlight.load( std::memory_order_relaxed );
+    }
+
+    uint64_t FramePacer::getFrameIndex() const
+    {
+        return _frameIndex;
+    }
+
+    uint64_t FramePacer::getCompletedFrame() const
+    {
+        return _fence.getCompletedValue();
+    }
+
+    const FramePacingStats& FramePacer::getStats() const
+    {
+        return _stats;
+    }
+}
@@ -0,0 +1,74 @@
+//
+//  FramePacer.hpp
+//  Point_Cloud_Renderer
+//
+//  Created by Vatsalya Yadav on 10/19/26.
+//
+
+#ifndef FramePacer_hpp
+#define FramePacer_hpp
+
+#include <atomic>
+#include <cstdint>
+
+#include "Renderer/Data/Constants.hpp"
+#include "Renderer/Threading/TimelineFence.hpp"
+
+namespace PCR
+{
+    struct FramePacingStats
+    {
+        uint32_t framesInFlight = 0;
+        
+        // Time beginFrame blocked waiting for the GPU
+        double lastWaitMs = 0.0;
+        
+        // Exponential moving average
+        double averageWaitMs = 0.0;
+        
+        // Frames submitted but not completed when the last frame began
+        uint64_t framesAhead = 0;
+    };
+
+    // Throttles the CPU to a number of frames ahead of the GPU. Frame N may start once
+    // frame N - framesInFlight has completed; completion handlers report frames through
+    // frameCompleted. The limit can change at runtime, lowering it trades throughput for
+    // latency, but never above the capacity per-frame resources were sized for.
+    class FramePacer
+    {
+    public:
+        explicit FramePacer( uint32_t framesInFlight = MAX_FRAMES_IN_FLIGHT, uint32_t maxFramesInFlight = MAX_FRAMES_IN_FLIGHT );
+        
+        // Blocks as needed, returns the new frame's index. Indices start at 1.
+        uint64_t beginFrame();
+        
+        // Thread-safe, called from completion handlers
+        void frameCompleted( uint64_t frameIndex );
+        
+        // Blocks until every frame begun so far has completed, e.g. before shutdown
+        void waitForIdle();
+        
+        void setFramesInFlight( uint32_t framesInFlight );
+        
+        uint32_t getFramesInFlight() const;
+        
+        uint64_t getFrameIndex() const;
+        
+        uint64_t getCompletedFrame() const;
+        
+        const FramePacingStats& getStats() const;
+
+    private:
+        TimelineFence _fence;
+        
+        uint32_t _maxFramesInFlight;
+        
+        std::atomic< uint32_t > _framesInFlight;
+        
+        uint64_t _frameIndex;
+        
+        FramePacingStats _stats;
+    };
+}
+
+#endif /* FramePacer_hpp */
@@ -0,0 +1,247 @@
+//
+//  FramePacerCheck.cpp
+//  Point_Cloud_Renderer
+//
+//  Created by Vatsalya Yadav on 10/19/26.
+//
+
+#include "FramePacerCheck.hpp"
+
+#include <algorithm>
+#include <chrono>
+#include <condition_variable>
+#include <deque>
+#include <mutex>
+#include <thread>
+
+#include "Renderer/Threading/FramePacer.hpp"
+#include "Renderer/Threading/TimelineFence.hpp"
+#include "Renderer/Validation/CheckReport.hpp"
+
+namespace PCR
+{
+    namespace
+    {
+        constexpr auto GPU_FRAME_TIME{ std::chrono::milliseconds( 4 ) };
+        
+        // CPU frames alternate between these, so the GPU only keeps up when it can queue work
+        constexpr auto SHORT_CPU_FRAME_TIME{ std::chrono::milliseconds( 1 ) };
+        
+        constexpr auto LONG_CPU_FRAME_TIME{ std::chrono::milliseconds( 6 ) };
+        
+        constexpr uint64_t FRAME_COUNT{ 60 };
+        
+        // Long enough that a wait which returned early can't be mistaken for one that blocked
+        constexpr auto SIGNAL_DELAY{ std::chrono::milliseconds( 20 ) };
+        
+        // Executes submitted frames in order on its own thread and reports each one to the
+        // pacer, what command buffer completion handlers do
+        class SimulatedGpu
+        {
+        public:
+            explicit SimulatedGpu( FramePacer& pacer )
+            :   _pacer{ pacer }
+            ,   _inOrder{ true }
+            ,   _stopping{ false }
+            ,   _thread{ [ this ]{ run(); } }
+            {
+            }
+            
+            ~SimulatedGpu()
+            {
+                {
+                    std::lock_guard< std::mutex > lock( _mutex );
+                    _stopping = true;
+                }
+                _condition.notify_all();
+                _thread.join();
+            }
+            
+            void submit( uint64_t frameIndex )
+            {
+                {
+                    std::lock_guard< std::mutex > lock( _mutex );
+                    _submitted.push_back( frameIndex );
+                }
+                _condition.notify_all();
+            }
+            
+            // Every frame completed after the one submitted before it
+            bool completedInOrder() const
+            {
+                std::lock_guard< std::mutex > lock( _mutex );
+                return _inOrder;
+            }
+        
+        private:
+            void run()
+            {
+                uint64_t lastCompleted = 0;
+                std::unique_lock< std::mutex > lock( _mutex );
+                while ( true )
+                {
+                    _condition.wait( lock, [ this ]{ return _stopping || !_submitted.empty(); } );
+                    if ( _submitted.empty() )
+                    {
+                        return;
+                    }
+                    
+                    const uint64_t frameIndex = _submitted.front();
+                    _submitted.pop_front();
+                    _inOrder = _inOrder && frameIndex == lastCompleted + 1;
+                    lastCompleted = frameIndex;
+                    
+                    lock.unlock();
+                    std::this_thread::sleep_for( GPU_FRAME_TIME );
+                    _pacer.frameCompleted( frameIndex );
+                    lock.lock();
+                }
+            }
+            
+            FramePacer& _pacer;
+            
+            mutable std::mutex _mutex;
+            
+            std::condition_variable _condition;
+            
+            std::deque< uint64_t > _submitted;
+            
+            bool _inOrder;
+            
+            bool _stopping;
+            
+            std::thread _thread;
+        };
+        
+        struct PacingRun
+        {
+            uint64_t maxFramesAhead = 0;
+            
+            double totalWaitMs = 0.0;
+            
+            // Every frame began only once frame N - framesInFlight had completed
+            bool throttled = true;
+            
+            bool completedInOrder = true;
+            
+            bool idleAfterWait = true;
+        };
+        
+        PacingRun runFrames( uint32_t framesInFlight )
+        {
+            PacingRun run;
+            FramePacer pacer( framesInFlight );
+            {
+                SimulatedGpu gpu( pacer );
+                for ( uint64_t frame = 1; frame <= FRAME_COUNT; ++frame )
+                {
+                    const uint64_t frameIndex = pacer.beginFrame();
+                    const FramePacingStats& stats = pacer.getStats();
+                    run.maxFramesAhead = std::max( run.maxFramesAhead, stats.framesAhead );
+                    run.totalWaitMs += stats.lastWaitMs;
+                    run.throttled = run.throttled && frameIndex == frame && pacer.getCompletedFrame() + framesInFlight >= frameIndex;
+                    
+                    std::this_thread::sleep_for( frame % 2 == 0 ? LONG_CPU_FRAME_TIME : SHORT_CPU_FRAME_TIME );
+                    gpu.submit( frameIndex );
+                }
+                
+                pacer.waitForIdle();
+                run.idleAfterWait = pacer.getCompletedFrame() == FRAME_COUNT;
+                run.completedInOrder = gpu.completedInOrder();
+            }
+            return run;
+        }
+        
+        void checkTimelineFence( CheckReport& report )
+        {
+            TimelineFence fence( 5 );
+            fence.signal( 3 );
+            report.expect( fence.getCompletedValue() == 5, "fence: a lower signal is ignored" );
+            report.expect( fence.wait( 5 ) == 0.0 && fence.wait( 2 ) == 0.0, "fence: waiting on a reached value doesn't block" );
+            
+            // Two waiters on different values, one signal past both wakes them
+            double waitMs[ 2 ] = {};
+            std::thread waiters[ 2 ] = { std::thread( [ & ]{ waitMs[ 0 ] = fence.wait( 7 ); } ),
+                                         std::thread( [ & ]{ waitMs[ 1 ] = fence.wait( 8 ); } ) };
+            std::this_thread::sleep_for( SIGNAL_DELAY );
+            fence.signal( 9 );
+            waiters[ 0 ].join();
+            waiters[ 1 ].join();
+            
+            const double minimumWaitMs = std::chrono::duration< double, std::milli >( SIGNAL_DELAY ).count() * 0.5;
+            report.expect( waitMs[ 0 ] >= minimumWaitMs && waitMs[ 1 ] >= minimumWaitMs, "fence: waiters block until the value is signalled" );
+            report.expect( fence.getCompletedValue() == 9, "fence: one signal past several waiters wakes them all" );
+        }
+        
+        void checkFramesInFlight( CheckReport& report )
+        {
+            double totalWaitMs[ MAX_FRAMES_IN_FLIGHT + 1 ] = {};
+            bool withinLimit = true;
+            bool reachedLimit = true;
+            bool throttled = true;
+            bool completedInOrder = true;
+            bool idleAfterWait = true;
+            
+            for ( uint32_t framesInFlight = 1; framesInFlight <= MAX_FRAMES_IN_FLIGHT; ++framesInFlight )
+            {
+                const PacingRun run = runFrames( framesInFlight );
+                __builtin_printf( "       %u in flight: at most %llu ahead, waited %.0f ms over %llu frames\n",
+                                  framesInFlight, static_cast< unsigned long long >( run.maxFramesAhead ), run.totalWaitMs, static_cast< unsigned long long >( FRAME_COUNT ) );
+                
+                totalWaitMs[ framesInFlight ] = run.totalWaitMs;
+                withinLimit = withinLimit && run.maxFramesAhead <= framesInFlight - 1;
+                reachedLimit = reachedLimit && run.maxFramesAhead == framesInFlight - 1;
+                throttled = throttled && run.throttled;
+                completedInOrder = completedInOrder && run.completedInOrder;
+                idleAfterWait = idleAfterWait && run.idleAfterWait;
+            }
+            
+            report.expect( withinLimit, "pacing: the CPU never runs more than framesInFlight - 1 frames ahead" );
+            report.expect( reachedLimit, "pacing: a GPU-bound loop uses every frame it's allowed" );
+            report.expect( throttled, "pacing: frame N begins only after frame N - framesInFlight completed" );
+            report.expect( completedInOrder, "pacing: frames complete in submission order" );
+            report.expect( idleAfterWait, "pacing: waitForIdle returns once every frame has completed" );
+            report.expect( totalWaitMs[ 2 ] < totalWaitMs[ 1 ] && totalWaitMs[ 3 ] < totalWaitMs[ 1 ], "pacing: more frames in flight wait less than one" );
+        }
+        
+        void checkRuntimeLimit( CheckReport& report )
+        {
+            FramePacer pacer( 3 );
+            pacer.setFramesInFlight( 0 );
+            const bool clampedLow = pacer.getFramesInFlight() == 1;
+            pacer.setFramesInFlight( MAX_FRAMES_IN_FLIGHT + 5 );
+            report.expect( clampedLow && pacer.getFramesInFlight() == MAX_FRAMES_IN_FLIGHT, "runtime limit: clamped to [ 1, capacity ]" );
+            
+            bool withinLoweredLimit = true;
+            {
+                SimulatedGpu gpu( pacer );
+                for ( uint64_t frame = 1; frame <= FRAME_COUNT; ++frame )
+                {
+                    // Halfway through, drop to one frame in flight
+                    if ( frame == FRAME_COUNT / 2 )
+                    {
+                        pacer.setFramesInFlight( 1 );
+                    }
+                    
+                    const uint64_t frameIndex = pacer.beginFrame();
+                    if ( frame >= FRAME_COUNT / 2 )
+                    {
+                        withinLoweredLimit = withinLoweredLimit && pacer.getStats().framesAhead == 0 && pacer.getStats().framesInFlight == 1;
+                    }
+                    gpu.submit( frameIndex );
+                }
+                pacer.waitForIdle();
+            }
+            report.expect( withinLoweredLimit, "runtime limit: lowering it takes effect on the next frame" );
+        }
+    }
+
+    bool runFramePacerChecks()
+    {
+        CheckReport report( "Frame pacing, simulated GPU thread" );
+        checkTimelineFence( report );
+        checkFramesInFlight( report );
+        checkRuntimeLimit( report );
+        return report.finish();
+    }
+}
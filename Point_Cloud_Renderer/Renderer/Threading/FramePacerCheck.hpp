@@ -0,0 +1,21 @@
+//
+//  FramePacerCheck.hpp
+//  Point_Cloud_Renderer
+//
+//  Created by Vatsalya Yadav on 10/19/26.
+//
+
+#ifndef FramePacerCheck_hpp
+#define FramePacerCheck_hpp
+
+namespace PCR
+{
+    // TimelineFence ordering and wake-ups, then FramePacer against a simulated GPU thread
+    // that takes a fixed time per frame: with 1, 2 and 3 frames in flight the CPU never runs
+    // more than 0, 1 and 2 frames ahead, more frames in flight cut the time spent waiting,
+    // and lowering the limit at runtime takes effect on the next frame.
+    // Returns false if any check fails.
+    bool runFramePacerChecks();
+}
+
+#endif /* FramePacerCheck_hpp */
@@ -0,0 +1,50 @@
+//
+//  TimelineFence.cpp
+//  Point_Cloud_Renderer
+//
+//  Created by Vatsalya Yadav on 10/19/26.
+//
+
+#include "TimelineFence.hpp"
+
+#include <chrono>
+
+namespace PCR
+{
+    TimelineFence::TimelineFence( uint64_t initialValue /* = 0 */ )
+    :   _value{ initialValue }
+    {
+    }
+
+    void TimelineFence::signal( uint64_t value )
+    {
+        {
+            std::lock_guard< std::mutex > lock( _mutex );
+            if ( value <= _value )
+            {
+                return;
+            }
+            _value = value;
+        }
+        _condition.notify_all();
+    }
+
+    double TimelineFence::wait( uint64_t value )
+    {
+        std::unique_lock< std::mutex > lock( _mutex );
+        if ( _value >= value )
+        {
+            return 0.0;
+        }
+        
+        const auto start = std::chrono::steady_clock::now();
+        _condition.wait( lock, [ this, value ]{ return _value >= value; } );
+        return std::chrono::duration< double, std::milli >( std::chrono::steady_clock::now() - start ).count();
+    }
+
+    uint64_t TimelineFence::getCompletedValue() const
+    {
+        std::lock_guard< std::mutex > lock( _mutex );
+        return _value;
+    }
+}
@@ -0,0 +1,46 @@
+//
+//  TimelineFence.hpp
+//  Point_Cloud_Renderer
+//
+//  Created by Vatsalya Yadav on 10/19/26.
+//
+
+#ifndef TimelineFence_hpp
+#define TimelineFence_hpp
+
+#include <condition_variable>
+#include <cstdint>
+#include <mutex>
+
+namespace PCR
+{
+    // A monotonically increasing counter that can be waited on, the CPU side of a
+    // timeline semaphore. Whoever finishes work signals its value, waiters block until
+    // the counter reaches theirs. Only the standard library, so it runs anywhere.
+    class TimelineFence
+    {
+    public:
+        explicit TimelineFence( uint64_t initialValue = 0 );
+        
+        TimelineFence( const TimelineFence& ) = delete;
+        
+        TimelineFence& operator=( const TimelineFence& ) = delete;
+        
+        // Values lower than the current one are ignored
+        void signal( uint64_t value );
+        
+        // Returns how long it blocked, in milliseconds
+        double wait( uint64_t value );
+        
+        uint64_t getCompletedValue() const;
+
+    private:
+        mutable std::mutex _mutex;
+        
+        std::condition_variable _condition;
+        
+        uint64_t _value;
+    };
+}
+
+#endif /* TimelineFence_hpp */
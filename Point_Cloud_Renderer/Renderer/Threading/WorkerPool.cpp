@@ -0,0 +1,127 @@
+//
+//  WorkerPool.cpp
+//  Point_Cloud_Renderer
+//
+//  Created by Vatsalya Yadav on 10/19/26.
+//
+
+#include "WorkerPool.hpp"
+
+#include <algorithm>
+
+namespace PCR
+{
+    WorkerPool::WorkerPool( uint32_t workerCount /* = 0 */ )
+    :   _pFunction{ nullptr }
+    ,   _count{ 0 }
+    ,   _grainSize{ 1 }
+    ,   _nextIndex{ 0 }
+    ,   _activeWorkers{ 0 }
+    ,   _generation{ 0 }
+    ,   _stopping{ false }
+    {
+        if ( workerCount == 0 )
+        {
+            workerCount = std::max( 1u, std::thread::hardware_concurrency() );
+        }
+
+        for ( uint32_t i = 1; i < workerCount; ++i )
+        {
+            _threads.emplace_back( &WorkerPool::workerLoop, this, i );
+        }
+    }
+
+    WorkerPool::~WorkerPool()
+    {
+        {
+            std::lock_guard< std::mutex > lock( _mutex );
+            _stopping = true;
+        }
+        _wakeCondition.notify_all();
+
+        for ( auto& thread : _threads )
+        {
+            thread.join();
+        }
+    }
+
+    uint32_t WorkerPool::getWorkerCount() const
+    {
+        return static_cast< uint32_t >( _threads.size() ) + 1;
+    }
+
+    void WorkerPool::parallelFor( size_t count, size_t grainSize, const RangeFunction& function )
+    {
+        if ( count == 0 )
+        {
+            return;
+        }
+
+        grainSize = std::max< size_t >( grainSize, 1 );
+
+        // Not worth waking anyone for a single chunk.
+        if ( _threads.empty() || count <= grainSize )
+        {
+            function( 0, count, 0 );
+            return;
+        }
+
+        {
+            std::lock_guard< std::mutex > lock( _mutex );
+            _pFunction = &function;
+            _count = count;
+            _grainSize = grainSize;
+            _nextIndex.store( 0, std::memory_order_relaxed );
+            _activeWorkers = static_cast< uint32_t >( _threads.size() );
+            ++_generation;
+        }
+        _wakeCondition.notify_all();
+
+        runChunks( 0 );
+
+        std::unique_lock< std::mutex > lock( _mutex );
+        _doneCondition.wait( lock, [ this ]{ return _activeWorkers == 0; } );
+        _pFunction = nullptr;
+    }
+
+    void WorkerPool::workerLoop( uint32_t workerIndex )
+    {
+        uint64_t seenGeneration = 0;
+
+        while ( true )
+        {
+            {
+                std::unique_lock< std::mutex > lock( _mutex );
+                _wakeCondition.wait( lock, [ & ]{ return _stopping || _generation != seenGeneration; } );
+                if ( _stopping )
+                {
+                    return;
+                }
+                seenGeneration = _generation;
+            }
+
+            runChunks( workerIndex );
+
+            {
+                std::lock_guard< std::mutex > lock( _mutex );
+                --_activeWorkers;
+            }
+            _doneCondition.notify_one();
+        }
+    }
+
+    void WorkerPool::runChunks( uint32_t workerIndex )
+    {
+        while ( true )
+        {
+            const size_t begin = _nextIndex.fetch_add( _grainSize, std::memory_order_relaxed );
+            if ( begin >= _count )
+            {
+                return;
+            }
+
+            const size_t end = std::min( begin + _grainSize, _count );
+            ( *_pFunction )( begin, end, workerIndex );
+        }
+    }
+}
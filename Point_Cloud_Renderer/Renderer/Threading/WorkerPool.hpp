@@ -0,0 +1,73 @@
+//
+//  WorkerPool.hpp
+//  Point_Cloud_Renderer
+//
+//  Created by Vatsalya Yadav on 10/19/26.
+//
+
+#ifndef WorkerPool_hpp
+#define WorkerPool_hpp
+
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace PCR
+{
+    // Persistent worker threads for data-parallel CPU work. The calling thread
+    // takes part in every job as worker 0, so a pool of one never spawns threads.
+    class WorkerPool
+    {
+    public:
+        using RangeFunction = std::function< void( size_t begin, size_t end, uint32_t workerIndex ) >;
+
+        // workerCount of 0 picks std::thread::hardware_concurrency().
+        explicit WorkerPool( uint32_t workerCount = 0 );
+
+        ~WorkerPool();
+
+        WorkerPool( const WorkerPool& ) = delete;
+
+        WorkerPool& operator=( const WorkerPool& ) = delete;
+
+        uint32_t getWorkerCount() const;
+
+        // Splits [0, count) into chunks of grainSize and blocks until all of them ran.
+        // workerIndex is unique per thread for the duration of the call.
+        void parallelFor( size_t count, size_t grainSize, const RangeFunction& function );
+
+    private:
+        std::vector< std::thread > _threads;
+
+        std::mutex _mutex;
+
+        std::condition_variable _wakeCondition;
+
+        std::condition_variable _doneCondition;
+
+        const RangeFunction* _pFunction;
+
+        size_t _count;
+
+        size_t _grainSize;
+
+        std::atomic< size_t > _nextIndex;
+
+        uint32_t _activeWorkers;
+
+        uint64_t _generation;
+
+        bool _stopping;
+
+        void workerLoop( uint32_t workerIndex );
+
+        void runChunks( uint32_t workerIndex );
+    };
+}
+
+#endif /* WorkerPool_hpp */
@@ -0,0 +1,38 @@
+//
+//  CheckReport.cpp
+//  Point_Cloud_Renderer
+//
+//  Created by Vatsalya Yadav on 10/19/26.
+//
+
+#include "CheckReport.hpp"
+
+namespace PCR
+{
+    CheckReport::CheckReport( const char* title )
+    :   _title{ title }
+    ,   _checkCount{ 0 }
+    ,   _failureCount{ 0 }
+    {
+        __builtin_printf( "%s\n", _title );
+    }
+
+    bool CheckReport::expect( bool condition, const char* description )
+    {
+        ++_checkCount;
+        _failureCount += condition ? 0 : 1;
+        __builtin_printf( "  %-4s %s\n", condition ? "ok" : "FAIL", description );
+        return condition;
+    }
+
+    uint32_t CheckReport::getFailureCount() const
+    {
+        return _failureCount;
+    }
+
+    bool CheckReport::finish() const
+    {
+        __builtin_printf( "%s: %u of %u checks passed\n", _title, _checkCount - _failureCount, _checkCount );
+        return _failureCount == 0;
+    }
+}
@@ -0,0 +1,38 @@
+//
+//  CheckReport.hpp
+//  Point_Cloud_Renderer
+//
+//  Created by Vatsalya Yadav on 10/19/26.
+//
+
+#ifndef CheckReport_hpp
+#define CheckReport_hpp
+
+#include <cstdint>
+
+namespace PCR
+{
+    // What the headless check modes print: a title, one line per check and a summary
+    class CheckReport
+    {
+    public:
+        explicit CheckReport( const char* title );
+        
+        // Returns condition, so a check can guard the ones that depend on it
+        bool expect( bool condition, const char* description );
+        
+        uint32_t getFailureCount() const;
+        
+        // Prints the summary, true if every check passed
+        bool finish() const;
+
+    private:
+        const char* _title;
+        
+        uint32_t _checkCount;
+        
+        uint32_t _failureCount;
+    };
+}
+
+#endif /* CheckReport_hpp */
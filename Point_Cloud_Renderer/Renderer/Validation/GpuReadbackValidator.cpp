@@ -0,0 +1,279 @@
+//
+//  GpuReadbackValidator.cpp
+//  Point_Cloud_Renderer
+//
+//  Created by Vatsalya Yadav on 10/19/26.
+//
+
+#include "GpuReadbackValidator.hpp"
+
+#include <Metal/Metal.hpp>
+
+#include <vector>
+
+#include "Renderer/Culling/InstanceCulling.hpp"
+#include "Renderer/Data/Constants.hpp"
+#include "Renderer/Instances/InstanceAnimation.hpp"
+#include "Renderer/PointCloud/SplatRasterizer.hpp"
+#include "Renderer/Structures/CameraData.hpp"
+#include "Renderer/Structures/CompactInstanceData.hpp"
+#include "Renderer/Structures/InstanceData.hpp"
+#include "Renderer/Threading/WorkerPool.hpp"
+#include "Renderer/VisibilityBuffer/VisibilityResolve.hpp"
+
+namespace PCR
+{
+    namespace
+    {
+        // Readback sections start on a 16-byte boundary so every element type lines up
+        NS::UInteger alignSection( NS::UInteger offset )
+        {
+            return ( offset + 15 ) / 16 * 16;
+        }
+        
+        // What splat_normalize writes where nothing landed, 0.1 as a half rounded to 8 bits
+        constexpr uint32_t SPLAT_CLEAR_TEXEL{ 0xFF191919 };
+    }
+
+    GpuReadbackValidator::GpuReadbackValidator( MTL::Device* pDevice )
+    :   _pDevice{ pDevice->retain() }
+    ,   _checkedFrames{ 0 }
+    ,   _cullMismatches{ 0 }
+    ,   _animationMismatches{ 0 }
+    ,   _visibilityMismatches{ 0 }
+    ,   _splatMismatches{ 0 }
+    {
+    }
+
+    GpuReadbackValidator::~GpuReadbackValidator()
+    {
+        _pDevice->release();
+    }
+
+    void GpuReadbackValidator::encodeCullReadback( MTL::CommandBuffer* pCommandBuffer,
+                                                   InstanceFormat instanceFormat,
+                                                   const FrameAllocation& instanceData,
+                                                   const FrameAllocation& visibleInstanceData,
+                                                   const FrameAllocation& drawArgumentData,
+                                                   const CullUniforms& cullUniforms )
+    {
+        const NS::UInteger stride = instanceFormat == InstanceFormat::Compact ? sizeof( CompactInstanceData ) : sizeof( InstanceData );
+        const NS::UInteger instanceBytes = cullUniforms.instanceCount * stride;
+        const NS::UInteger visibleBytes = static_cast< NS::UInteger >( cullUniforms.lodListCapacity ) * INSTANCE_LOD_COUNT * sizeof( uint32_t );
+        const NS::UInteger argumentBytes = sizeof( InstanceCulling::DrawIndexedArguments ) * INSTANCE_LOD_COUNT;
+        
+        const NS::UInteger visibleOffset = alignSection( instanceBytes );
+        const NS::UInteger argumentOffset = alignSection( visibleOffset + visibleBytes );
+        
+        MTL::Buffer* pReadback = _pDevice->newBuffer( argumentOffset + argumentBytes, MTL::ResourceStorageModeShared );
+        
+        // Hazard tracking puts the copies behind the passes that wrote the sources
+        MTL::BlitCommandEncoder* pBlitEncoder = pCommandBuffer->blitCommandEncoder();
+        if ( cullUniforms.instanceCount > 0 )
+        {
+            pBlitEncoder->copyFromBuffer( instanceData.pBuffer, instanceData.offset, pReadback, 0, instanceBytes );
+            pBlitEncoder->copyFromBuffer( visibleInstanceData.pBuffer, visibleInstanceData.offset, pReadback, visibleOffset, visibleBytes );
+        }
+        pBlitEncoder->copyFromBuffer( drawArgumentData.pBuffer, drawArgumentData.offset, pReadback, argumentOffset, argumentBytes );
+        pBlitEncoder->endEncoding();
+        
+        pCommandBuffer->addCompletedHandler( ^void( MTL::CommandBuffer* ){
+            const auto* pContents = static_cast< const uint8_t* >( pReadback->contents() );
+            const auto* pVisible = reinterpret_cast< const uint32_t* >( pContents + visibleOffset );
+            const auto* pArguments = reinterpret_cast< const InstanceCulling::DrawIndexedArguments* >( pContents + argumentOffset );
+            
+            const bool matches = instanceFormat == InstanceFormat::Compact
+                               ? InstanceCulling::matchesReference( reinterpret_cast< const CompactInstanceData* >( pContents ), cullUniforms, pVisible, pArguments )
+                               : InstanceCulling::matchesReference( reinterpret_cast< const InstanceData* >( pContents ), cullUniforms, pVisible, pArguments );
+            if ( !matches )
+            {
+                __builtin_printf( "GPU validation: %s cull of %u instances differs from the CPU reference, %u %u %u listed\n",
+                                  instanceFormat == InstanceFormat::Compact ? "compact" : "full",
+                                  cullUniforms.instanceCount,
+                                  pArguments[ 0 ].instanceCount,
+                                  pArguments[ 1 ].instanceCount,
+                                  pArguments[ 2 ].instanceCount );
+                this->_cullMismatches.fetch_add( 1, std::memory_order_relaxed );
+            }
+            this->_checkedFrames.fetch_add( 1, std::memory_order_release );
+            pReadback->release();
+        });
+    }
+
+    void GpuReadbackValidator::encodeAnimationReadback( MTL::CommandBuffer* pCommandBuffer,
+                                                        InstanceFormat instanceFormat,
+                                                        const FrameAllocation& animatedInstanceData,
+                                                        const InstanceAnimationUniforms& animationUniforms,
+                                                        uint32_t instanceCount )
+    {
+        if ( instanceCount == 0 )
+        {
+            return;
+        }
+        
+        const NS::UInteger stride = instanceFormat == InstanceFormat::Compact ? sizeof( CompactInstanceData ) : sizeof( InstanceData );
+        const NS::UInteger instanceBytes = instanceCount * stride;
+        
+        MTL::Buffer* pReadback = _pDevice->newBuffer( instanceBytes, MTL::ResourceStorageModeShared );
+        
+        MTL::BlitCommandEncoder* pBlitEncoder = pCommandBuffer->blitCommandEncoder();
+        pBlitEncoder->copyFromBuffer( animatedInstanceData.pBuffer, animatedInstanceData.offset, pReadback, 0, instanceBytes );
+        pBlitEncoder->endEncoding();
+        
+        pCommandBuffer->addCompletedHandler( ^void( MTL::CommandBuffer* ){
+            const auto* pCompact = static_cast< const CompactInstanceData* >( pReadback->contents() );
+            const auto* pFull = static_cast< const InstanceData* >( pReadback->contents() );
+            const bool isCompact = instanceFormat == InstanceFormat::Compact;
+            
+            const bool matches = isCompact
+                               ? InstanceAnimation::matchesReference( pCompact, animationUniforms, instanceCount )
+                               : InstanceAnimation::matchesReference( pFull, animationUniforms, instanceCount );
+            if ( !matches )
+            {
+                __builtin_printf( "GPU validation: %s animation of %u instances is %.3e off the CPU reference\n",
+                                  isCompact ? "compact" : "full",
+                                  instanceCount,
+                                  isCompact ? InstanceAnimation::measureError( pCompact, animationUniforms, instanceCount )
+                                            : InstanceAnimation::measureError( pFull, animationUniforms, instanceCount ) );
+                this->_animationMismatches.fetch_add( 1, std::memory_order_relaxed );
+            }
+            pReadback->release();
+        });
+    }
+
+    void GpuReadbackValidator::encodeVisibilityReadback( MTL::CommandBuffer* pCommandBuffer,
+                                                         MTL::BlitCommandEncoder* pBlitEncoder,
+                                                         InstanceFormat instanceFormat,
+                                                         const VisibilityReadbackSources& sources )
+    {
+        const uint32_t width = sources.renderWidth;
+        const uint32_t height = sources.renderHeight;
+        const auto textureWidth = static_cast< uint32_t >( sources.pTexture->width() );
+        const auto textureHeight = static_cast< uint32_t >( sources.pTexture->height() );
+        if ( width == 0 || height == 0 || sources.instanceCount == 0 )
+        {
+            return;
+        }
+        
+        const NS::UInteger stride = instanceFormat == InstanceFormat::Compact ? sizeof( CompactInstanceData ) : sizeof( InstanceData );
+        const NS::UInteger instanceBytes = sources.instanceCount * stride;
+        const NS::UInteger visibilityBytes = static_cast< NS::UInteger >( width ) * height * sizeof( uint32_t ) * 2;
+        const NS::UInteger colorBytes = static_cast< NS::UInteger >( width ) * height * sizeof( uint32_t );
+        const NS::UInteger texelBytes = static_cast< NS::UInteger >( textureWidth ) * textureHeight * sizeof( uint32_t );
+        
+        const NS::UInteger colorOffset = alignSection( visibilityBytes );
+        const NS::UInteger texelOffset = alignSection( colorOffset + colorBytes );
+        const NS::UInteger vertexOffset = alignSection( texelOffset + texelBytes );
+        const NS::UInteger indexOffset = alignSection( vertexOffset + sources.vertexBytes );
+        const NS::UInteger instanceOffset = alignSection( indexOffset + sources.indexBytes );
+        const NS::UInteger cameraOffset = alignSection( instanceOffset + instanceBytes );
+        
+        MTL::Buffer* pReadback = _pDevice->newBuffer( cameraOffset + sizeof( CameraData ), MTL::ResourceStorageModeShared );
+        
+        const MTL::Origin origin{ 0, 0, 0 };
+        const MTL::Size renderSize{ width, height, 1 };
+        pBlitEncoder->copyFromTexture( sources.pVisibility, 0, 0, origin, renderSize, pReadback, 0, width * sizeof( uint32_t ) * 2, visibilityBytes );
+        pBlitEncoder->copyFromTexture( sources.pColor, 0, 0, origin, renderSize, pReadback, colorOffset, width * sizeof( uint32_t ), colorBytes );
+        pBlitEncoder->copyFromTexture( sources.pTexture, 0, 0, origin, MTL::Size{ textureWidth, textureHeight, 1 }, pReadback, texelOffset, textureWidth * sizeof( uint32_t ), texelBytes );
+        pBlitEncoder->copyFromBuffer( sources.pVertices, 0, pReadback, vertexOffset, sources.vertexBytes );
+        pBlitEncoder->copyFromBuffer( sources.pIndices, 0, pReadback, indexOffset, sources.indexBytes );
+        pBlitEncoder->copyFromBuffer( sources.instanceData.pBuffer, sources.instanceData.offset, pReadback, instanceOffset, instanceBytes );
+        pBlitEncoder->copyFromBuffer( sources.cameraData.pBuffer, sources.cameraData.offset, pReadback, cameraOffset, sizeof( CameraData ) );
+        
+        const simd::float4 clearColor = sources.clearColor;
+        pCommandBuffer->addCompletedHandler( ^void( MTL::CommandBuffer* ){
+            const auto* pContents = static_cast< const uint8_t* >( pReadback->contents() );
+            
+            VisibilityBuffer::ResolveInputs inputs;
+            inputs.pVisibility = reinterpret_cast< const uint32_t* >( pContents );
+            inputs.width = width;
+            inputs.height = height;
+            inputs.pVertices = reinterpret_cast< const VertexData* >( pContents + vertexOffset );
+            inputs.pIndices = reinterpret_cast< const uint16_t* >( pContents + indexOffset );
+            if ( instanceFormat == InstanceFormat::Compact )
+            {
+                inputs.pCompactInstances = reinterpret_cast< const CompactInstanceData* >( pContents + instanceOffset );
+            }
+            else
+            {
+                inputs.pInstances = reinterpret_cast< const InstanceData* >( pContents + instanceOffset );
+            }
+            inputs.pCamera = reinterpret_cast< const CameraData* >( pContents + cameraOffset );
+            inputs.pTexels = reinterpret_cast< const uint32_t* >( pContents + texelOffset );
+            inputs.textureWidth = textureWidth;
+            inputs.textureHeight = textureHeight;
+            
+            const uint32_t mismatches = VisibilityBuffer::countMismatches( inputs, reinterpret_cast< const uint32_t* >( pContents + colorOffset ), clearColor );
+            if ( mismatches > 0 )
+            {
+                __builtin_printf( "GPU validation: %s visibility resolve differs from the CPU reference in %u of %u pixels\n",
+                                  instanceFormat == InstanceFormat::Compact ? "compact" : "full",
+                                  mismatches,
+                                  width * height );
+                this->_visibilityMismatches.fetch_add( 1, std::memory_order_relaxed );
+            }
+            pReadback->release();
+        });
+    }
+
+    void GpuReadbackValidator::encodeSplatReadback( MTL::CommandBuffer* pCommandBuffer, const SplatReadbackSources& sources )
+    {
+        const uint32_t width = sources.renderWidth;
+        const uint32_t height = sources.renderHeight;
+        if ( width == 0 || height == 0 )
+        {
+            return;
+        }
+        
+        const NS::UInteger colorBytes = static_cast< NS::UInteger >( width ) * height * sizeof( uint32_t );
+        const NS::UInteger pointBytes = static_cast< NS::UInteger >( sources.pointCount ) * sizeof( PointData );
+        const NS::UInteger pointOffset = alignSection( colorBytes );
+        
+        MTL::Buffer* pReadback = _pDevice->newBuffer( pointOffset + pointBytes, MTL::ResourceStorageModeShared );
+        
+        MTL::BlitCommandEncoder* pBlitEncoder = pCommandBuffer->blitCommandEncoder();
+        pBlitEncoder->copyFromTexture( sources.pTarget, 0, 0, MTL::Origin{ 0, 0, 0 }, MTL::Size{ width, height, 1 }, pReadback, 0, width * sizeof( uint32_t ), colorBytes );
+        if ( pointBytes > 0 )
+        {
+            pBlitEncoder->copyFromBuffer( sources.pPoints, 0, pReadback, pointOffset, pointBytes );
+        }
+        pBlitEncoder->endEncoding();
+        
+        const SplatReadbackSources splatSources = sources;
+        pCommandBuffer->addCompletedHandler( ^void( MTL::CommandBuffer* ){
+            const auto* pContents = static_cast< const uint8_t* >( pReadback->contents() );
+            const size_t pixelCount = static_cast< size_t >( width ) * height;
+            
+            // Handlers may run on any thread, a pool of one runs the reference on this one
+            WorkerPool workerPool( 1 );
+            SplatRasterizer rasterizer( width, height, workerPool );
+            rasterizer.setRadius( splatSources.radius );
+            rasterizer.setDepthEpsilon( splatSources.depthEpsilon );
+            
+            std::vector< uint32_t > expected( pixelCount );
+            rasterizer.render( reinterpret_cast< const PointData* >( pContents + pointOffset ), splatSources.pointCount, splatSources.viewProjection, expected.data(), SPLAT_CLEAR_TEXEL );
+            
+            const size_t mismatches = countSplatMismatches( expected.data(), reinterpret_cast< const uint32_t* >( pContents ), pixelCount, SPLAT_VALIDATION_CHANNEL_TOLERANCE );
+            if ( mismatches > pixelCount * SPLAT_VALIDATION_PIXEL_TOLERANCE )
+            {
+                __builtin_printf( "GPU validation: splats of %u points differ from the CPU reference in %zu of %zu pixels\n",
+                                  splatSources.pointCount,
+                                  mismatches,
+                                  pixelCount );
+                this->_splatMismatches.fetch_add( 1, std::memory_order_relaxed );
+            }
+            pReadback->release();
+        });
+    }
+
+    GpuValidationStats GpuReadbackValidator::getStats() const
+    {
+        GpuValidationStats stats;
+        stats.checkedFrames = _checkedFrames.load( std::memory_order_acquire );
+        stats.cullMismatches = _cullMismatches.load( std::memory_order_relaxed );
+        stats.animationMismatches = _animationMismatches.load( std::memory_order_relaxed );
+        stats.visibilityMismatches = _visibilityMismatches.load( std::memory_order_relaxed );
+        stats.splatMismatches = _splatMismatches.load( std::memory_order_relaxed );
+        return stats;
+    }
+}
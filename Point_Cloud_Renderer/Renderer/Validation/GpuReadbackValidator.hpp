@@ -0,0 +1,157 @@
+//
+//  GpuReadbackValidator.hpp
+//  Point_Cloud_Renderer
+//
+//  Created by Vatsalya Yadav on 10/19/26.
+//
+
+#ifndef GpuReadbackValidator_hpp
+#define GpuReadbackValidator_hpp
+
+#include <atomic>
+#include <cstdint>
+
+#include <simd/simd.h>
+
+#include "Core/Core.hpp"
+#include "Renderer/Data/Constants.hpp"
+#include "Renderer/Buffer/FrameRingAllocator.hpp"
+#include "Renderer/Instances/InstanceBuffer.hpp"
+#include "Renderer/Structures/CullUniforms.hpp"
+#include "Renderer/Structures/InstanceAnimationUniforms.hpp"
+
+FD_MTL
+
+namespace PCR
+{
+    struct GpuValidationStats
+    {
+        // Frames whose cull readback has been compared
+        uint32_t checkedFrames = 0;
+        
+        uint32_t cullMismatches = 0;
+        
+        uint32_t animationMismatches = 0;
+        
+        // Visibility buffer frames whose resolve differs from the CPU reference
+        uint32_t visibilityMismatches = 0;
+        
+        // Point cloud frames whose splats differ from SplatRasterizer past the tolerance
+        uint32_t splatMismatches = 0;
+    };
+
+    // What the visibility resolve read and wrote. The textures only live for the frame graph,
+    // so the readback is encoded from a pass that reads them.
+    struct VisibilityReadbackSources
+    {
+        MTL::Texture* pVisibility = nullptr;
+        
+        MTL::Texture* pColor = nullptr;
+        
+        // RGBA8, the texture the resolve samples
+        MTL::Texture* pTexture = nullptr;
+        
+        MTL::Buffer* pVertices = nullptr;
+        
+        NS::UInteger vertexBytes = 0;
+        
+        MTL::Buffer* pIndices = nullptr;
+        
+        NS::UInteger indexBytes = 0;
+        
+        FrameAllocation instanceData;
+        
+        uint32_t instanceCount = 0;
+        
+        FrameAllocation cameraData;
+        
+        // The scene covers the top-left corner of the targets
+        uint32_t renderWidth = 0;
+        
+        uint32_t renderHeight = 0;
+        
+        simd::float4 clearColor;
+    };
+
+    // What SplatPass drew from and into
+    struct SplatReadbackSources
+    {
+        // RGBA8Unorm, the splats cover its top-left corner
+        MTL::Texture* pTarget = nullptr;
+        
+        MTL::Buffer* pPoints = nullptr;
+        
+        uint32_t pointCount = 0;
+        
+        simd::float4x4 viewProjection;
+        
+        uint32_t renderWidth = 0;
+        
+        uint32_t renderHeight = 0;
+        
+        int32_t radius = SPLAT_DEFAULT_RADIUS;
+        
+        float depthEpsilon = SPLAT_DEFAULT_DEPTH_EPSILON;
+    };
+
+    // Copies what a frame's compute passes and visibility resolve read and wrote into a shared
+    // buffer, and compares it with the CPU references once the frame has completed. Costs a
+    // buffer, a blit and a full CPU cull, animation and resolve per frame, so it only runs when
+    // asked for.
+    class GpuReadbackValidator
+    {
+    public:
+        explicit GpuReadbackValidator( MTL::Device* pDevice );
+        
+        ~GpuReadbackValidator();
+        
+        GpuReadbackValidator( const GpuReadbackValidator& ) = delete;
+        
+        GpuReadbackValidator& operator=( const GpuReadbackValidator& ) = delete;
+        
+        // Encode after the cull pass. instanceData is what the pass read, in instanceFormat's
+        // layout. Frames must complete before the validator is destroyed.
+        void encodeCullReadback( MTL::CommandBuffer* pCommandBuffer,
+                                 InstanceFormat instanceFormat,
+                                 const FrameAllocation& instanceData,
+                                 const FrameAllocation& visibleInstanceData,
+                                 const FrameAllocation& drawArgumentData,
+                                 const CullUniforms& cullUniforms );
+        
+        // Encode after the animation pass, which wrote its first instanceCount instances into
+        // animatedInstanceData
+        void encodeAnimationReadback( MTL::CommandBuffer* pCommandBuffer,
+                                      InstanceFormat instanceFormat,
+                                      const FrameAllocation& animatedInstanceData,
+                                      const InstanceAnimationUniforms& animationUniforms,
+                                      uint32_t instanceCount );
+        
+        // Encode from a blit pass after the visibility resolve, the readback is compared
+        // with VisibilityBuffer::resolve once the frame has completed
+        void encodeVisibilityReadback( MTL::CommandBuffer* pCommandBuffer,
+                                       MTL::BlitCommandEncoder* pBlitEncoder,
+                                       InstanceFormat instanceFormat,
+                                       const VisibilityReadbackSources& sources );
+        
+        // Encode after SplatPass, the readback is compared with SplatRasterizer once the frame
+        // has completed
+        void encodeSplatReadback( MTL::CommandBuffer* pCommandBuffer, const SplatReadbackSources& sources );
+        
+        GpuValidationStats getStats() const;
+
+    private:
+        MTL::Device* _pDevice;
+        
+        std::atomic< uint32_t > _checkedFrames;
+        
+        std::atomic< uint32_t > _cullMismatches;
+        
+        std::atomic< uint32_t > _animationMismatches;
+        
+        std::atomic< uint32_t > _visibilityMismatches;
+        
+        std::atomic< uint32_t > _splatMismatches;
+    };
+}
+
+#endif /* GpuReadbackValidator_hpp */
@@ -0,0 +1,161 @@
+//
+//  VisibilityResolve.cpp
+//  Point_Cloud_Renderer
+//
+//  Created by Vatsalya Yadav on 10/19/26.
+//
+
+#include "VisibilityResolve.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <vector>
+
+#include "Renderer/Instances/CompactInstance.hpp"
+
+namespace PCR::VisibilityBuffer
+{
+    namespace
+    {
+        simd::float4 unpackTexel( uint32_t texel )
+        {
+            return simd::float4{ static_cast< float >( texel & 0xFF ),
+                                 static_cast< float >( ( texel >> 8 ) & 0xFF ),
+                                 static_cast< float >( ( texel >> 16 ) & 0xFF ),
+                                 static_cast< float >( ( texel >> 24 ) & 0xFF ) } * ( 1.0f / 255.0f );
+        }
+        
+        // Bilinear, repeat addressing, matching the sampler in the resolve shader
+        simd::float4 sampleTexture( const ResolveInputs& inputs, const simd::float2& texCoord )
+        {
+            const float u = texCoord.x * inputs.textureWidth - 0.5f;
+            const float v = texCoord.y * inputs.textureHeight - 0.5f;
+            const float u0 = std::floor( u );
+            const float v0 = std::floor( v );
+            const float fu = u - u0;
+            const float fv = v - v0;
+            
+            auto fetch = [ & ]( float x, float y ){
+                const auto w = static_cast< int64_t >( inputs.textureWidth );
+                const auto h = static_cast< int64_t >( inputs.textureHeight );
+                const int64_t tx = ( ( static_cast< int64_t >( x ) % w ) + w ) % w;
+                const int64_t ty = ( ( static_cast< int64_t >( y ) % h ) + h ) % h;
+                return unpackTexel( inputs.pTexels[ ty * w + tx ] );
+            };
+            
+            const simd::float4 top = fetch( u0, v0 ) * ( 1.0f - fu ) + fetch( u0 + 1.0f, v0 ) * fu;
+            const simd::float4 bottom = fetch( u0, v0 + 1.0f ) * ( 1.0f - fu ) + fetch( u0 + 1.0f, v0 + 1.0f ) * fu;
+            return top * ( 1.0f - fv ) + bottom * fv;
+        }
+        
+        float decodeSrgb( uint32_t value )
+        {
+            const float c = static_cast< float >( value ) * ( 1.0f / 255.0f );
+            return c <= 0.04045f ? c * ( 1.0f / 12.92f ) : std::pow( ( c + 0.055f ) * ( 1.0f / 1.055f ), 2.4f );
+        }
+        
+        // Blue in the lowest byte, alpha isn't sRGB encoded
+        simd::float4 unpackTargetTexel( uint32_t texel )
+        {
+            return simd::float4{ decodeSrgb( ( texel >> 16 ) & 0xFF ),
+                                 decodeSrgb( ( texel >> 8 ) & 0xFF ),
+                                 decodeSrgb( texel & 0xFF ),
+                                 static_cast< float >( texel >> 24 ) * ( 1.0f / 255.0f ) };
+        }
+        
+        simd::float4 transformPoint( const simd::float4x4& m, const simd::float3& p )
+        {
+            return m * simd::float4{ p.x, p.y, p.z, 1.0f };
+        }
+    }
+
+    simd::float3 computeBarycentrics( const simd::float4& c0,
+                                      const simd::float4& c1,
+                                      const simd::float4& c2,
+                                      const simd::float2& ndc )
+    {
+        const simd::float2 s0{ c0.x / c0.w, c0.y / c0.w };
+        const simd::float2 e1{ c1.x / c1.w - s0.x, c1.y / c1.w - s0.y };
+        const simd::float2 e2{ c2.x / c2.w - s0.x, c2.y / c2.w - s0.y };
+        const simd::float2 d{ ndc.x - s0.x, ndc.y - s0.y };
+        
+        const float invDet = 1.0f / ( e1.x * e2.y - e1.y * e2.x );
+        const float l1 = ( d.x * e2.y - d.y * e2.x ) * invDet;
+        const float l2 = ( e1.x * d.y - e1.y * d.x ) * invDet;
+        
+        simd::float3 b{ ( 1.0f - l1 - l2 ) / c0.w, l1 / c1.w, l2 / c2.w };
+        return b * ( 1.0f / ( b.x + b.y + b.z ) );
+    }
+
+    simd::float4 resolvePixel( const ResolveInputs& inputs, uint32_t x, uint32_t y, const simd::float4& clearColor )
+    {
+        const size_t pixelIndex = static_cast< size_t >( y ) * inputs.width + x;
+        const uint32_t instanceID = inputs.pVisibility[ pixelIndex * 2 + 0 ];
+        const uint32_t primitiveID = inputs.pVisibility[ pixelIndex * 2 + 1 ];
+        if ( instanceID == EMPTY_ID )
+        {
+            return clearColor;
+        }
+        
+        const InstanceData instance = inputs.pCompactInstances ? CompactInstance::decode( inputs.pCompactInstances[ instanceID ] ) : inputs.pInstances[ instanceID ];
+        const CameraData& camera = *inputs.pCamera;
+        const simd::float4x4 objectToClip = camera.perspectiveTransform * camera.worldTransform * instance.transform;
+        
+        const VertexData& v0 = inputs.pVertices[ inputs.pIndices[ primitiveID * 3 + 0 ] ];
+        const VertexData& v1 = inputs.pVertices[ inputs.pIndices[ primitiveID * 3 + 1 ] ];
+        const VertexData& v2 = inputs.pVertices[ inputs.pIndices[ primitiveID * 3 + 2 ] ];
+        
+        // Pixel centers, like [[position]] in the fragment shader
+        const simd::float2 ndc{ ( x + 0.5f ) / inputs.width * 2.0f - 1.0f, 1.0f - ( y + 0.5f ) / inputs.height * 2.0f };
+        const simd::float3 b = computeBarycentrics( transformPoint( objectToClip, v0.position ),
+                                                   transformPoint( objectToClip, v1.position ),
+                                                   transformPoint( objectToClip, v2.position ),
+                                                   ndc );
+        
+        simd::float3 normal = v0.normal * b.x + v1.normal * b.y + v2.normal * b.z;
+        normal = camera.worldNormalTransform * ( instance.normalTransform * normal );
+        const simd::float2 texCoord{ v0.texCoord.x * b.x + v1.texCoord.x * b.y + v2.texCoord.x * b.z,
+                                     v0.texCoord.y * b.x + v1.texCoord.y * b.y + v2.texCoord.y * b.z };
+        
+        const simd::float4 texel = sampleTexture( inputs, texCoord );
+        
+        const simd::float3 L = simd::normalize( simd::float3{ 1.0f, 1.0f, 0.8f } );
+        const simd::float3 N = simd::normalize( normal );
+        const float NdotL = std::clamp( simd::dot( N, L ), 0.0f, 1.0f );
+        
+        const simd::float3 base{ instance.color.x * texel.x, instance.color.y * texel.y, instance.color.z * texel.z };
+        const simd::float3 illum = base * 0.1f + base * NdotL;
+        
+        return simd::float4{ illum.x, illum.y, illum.z, 1.0f };
+    }
+
+    void resolve( const ResolveInputs& inputs, simd::float4* pColors, const simd::float4& clearColor )
+    {
+        for ( uint32_t y = 0; y < inputs.height; ++y )
+        {
+            for ( uint32_t x = 0; x < inputs.width; ++x )
+            {
+                pColors[ static_cast< size_t >( y ) * inputs.width + x ] = resolvePixel( inputs, x, y, clearColor );
+            }
+        }
+    }
+
+    uint32_t countMismatches( const ResolveInputs& inputs, const uint32_t* pTargetTexels, const simd::float4& clearColor )
+    {
+        std::vector< simd::float4 > colors( static_cast< size_t >( inputs.width ) * inputs.height );
+        resolve( inputs, colors.data(), clearColor );
+        
+        uint32_t mismatches = 0;
+        for ( size_t p = 0; p < colors.size(); ++p )
+        {
+            // The target saturates what the shader returns
+            const simd::float4 expected = simd_clamp( colors[ p ], simd::float4( 0.0f ), simd::float4( 1.0f ) );
+            const simd::float4 difference = simd_abs( unpackTargetTexel( pTargetTexels[ p ] ) - expected );
+            if ( simd_reduce_max( difference ) > RESOLVE_COLOR_TOLERANCE )
+            {
+                ++mismatches;
+            }
+        }
+        return mismatches;
+    }
+}
@@ -0,0 +1,76 @@
+//
+//  VisibilityResolve.hpp
+//  Point_Cloud_Renderer
+//
+//  Created by Vatsalya Yadav on 10/19/26.
+//
+
+#ifndef VisibilityResolve_hpp
+#define VisibilityResolve_hpp
+
+#include <cstdint>
+
+#include <simd/simd.h>
+
+#include "Renderer/Mesh/Types/VertexData.h"
+#include "Renderer/Structures/CameraData.hpp"
+#include "Renderer/Structures/CompactInstanceData.hpp"
+#include "Renderer/Structures/InstanceData.hpp"
+
+// CPU reference for visibilityResolveFragment in VisibilityBuffer.metal. Takes a
+// read-back visibility buffer and produces the colors the GPU resolve should, up to
+// the half precision the shader shades in.
+namespace PCR::VisibilityBuffer
+{
+    constexpr uint32_t EMPTY_ID{ UINT32_MAX };
+    
+    // Per channel, in linear color. Covers half precision shading, the sRGB target's 8 bits
+    // and the GPU's fixed point bilinear weights.
+    constexpr float RESOLVE_COLOR_TOLERANCE{ 0.02f };
+
+    struct ResolveInputs
+    {
+        // Two values per pixel, instance ID then primitive ID
+        const uint32_t* pVisibility = nullptr;
+        
+        uint32_t width = 0;
+        
+        uint32_t height = 0;
+        
+        const VertexData* pVertices = nullptr;
+        
+        const uint16_t* pIndices = nullptr;
+        
+        // One of the two, matching the compactInstances function constant. Compact instances
+        // are decoded the way decodeInstance in the shaders does.
+        const InstanceData* pInstances = nullptr;
+        
+        const CompactInstanceData* pCompactInstances = nullptr;
+        
+        const CameraData* pCamera = nullptr;
+        
+        // RGBA8, red in the lowest byte
+        const uint32_t* pTexels = nullptr;
+        
+        uint32_t textureWidth = 0;
+        
+        uint32_t textureHeight = 0;
+    };
+
+    // Perspective-correct barycentrics of an NDC position inside a clip-space triangle
+    simd::float3 computeBarycentrics( const simd::float4& c0,
+                                      const simd::float4& c1,
+                                      const simd::float4& c2,
+                                      const simd::float2& ndc );
+
+    simd::float4 resolvePixel( const ResolveInputs& inputs, uint32_t x, uint32_t y, const simd::float4& clearColor );
+
+    // Linear colors, one per pixel
+    void resolve( const ResolveInputs& inputs, simd::float4* pColors, const simd::float4& clearColor );
+
+    // Pixels of a read-back BGRA8 sRGB target, one per visibility pixel, further than the
+    // tolerance from what resolve() produces
+    uint32_t countMismatches( const ResolveInputs& inputs, const uint32_t* pTargetTexels, const simd::float4& clearColor );
+}
+
+#endif /* VisibilityResolve_hpp */